@@ -44,6 +44,111 @@
 
 #include <QDebug>
 
+#include <algorithm>
+
+// The first entries of a listing are delivered in chunks of this size. Later
+// chunks grow with the listing, so that merging them stays O(n log n) overall.
+#define FILEINFOTHREAD_MINIMUM_CHUNK_SIZE 256
+
+// Sorts entries the same way as QDir::entryInfoList() does.
+class FilePropertyLessThan
+{
+public:
+    FilePropertyLessThan(QDir::SortFlags flags)
+        : sortFlags(flags), sortBy((flags & QDir::SortByMask) | (flags & QDir::Type)) {}
+
+    bool isUnsorted() const { return sortBy == QDir::Unsorted; }
+
+    bool operator()(const FileProperty &left, const FileProperty &right) const
+    {
+        return compare(left, right) < 0;
+    }
+
+private:
+    int compare(const FileProperty &left, const FileProperty &right) const
+    {
+        if ((sortFlags & QDir::DirsFirst) && left.isDir() != right.isDir())
+            return left.isDir() ? -1 : 1;
+        if ((sortFlags & QDir::DirsLast) && left.isDir() != right.isDir())
+            return left.isDir() ? 1 : -1;
+
+        int r = 0;
+        switch (sortBy) {
+        case QDir::Time: {
+            // newest first
+            const qint64 difference = right.lastModifiedMSecs() - left.lastModifiedMSecs();
+            r = difference > 0 ? 1 : (difference < 0 ? -1 : 0);
+            break;
+        }
+        case QDir::Size: {
+            // largest first
+            const qint64 difference = right.size() - left.size();
+            r = difference > 0 ? 1 : (difference < 0 ? -1 : 0);
+            break;
+        }
+        case QDir::Type:
+            r = compareNames(lastSuffix(left.fileName()), lastSuffix(right.fileName()));
+            break;
+        default:
+            break;
+        }
+
+        if (r == 0 && sortBy != QDir::Unsorted)
+            r = compareNames(left.fileName(), right.fileName());
+
+        return (sortFlags & QDir::Reversed) ? -r : r;
+    }
+
+    int compareNames(const QString &left, const QString &right) const
+    {
+        if (sortFlags & QDir::LocaleAware) {
+            if (sortFlags & QDir::IgnoreCase)
+                return left.toLower().localeAwareCompare(right.toLower());
+            return left.localeAwareCompare(right);
+        }
+        return left.compare(right, (sortFlags & QDir::IgnoreCase) ? Qt::CaseInsensitive : Qt::CaseSensitive);
+    }
+
+    static QString lastSuffix(const QString &fileName)
+    {
+        const int dot = fileName.lastIndexOf(QLatin1Char('.'));
+        return dot != -1 ? fileName.mid(dot + 1) : QString();
+    }
+
+    QDir::SortFlags sortFlags;
+    int sortBy;
+};
+
+static QString directoryPrefix(const QString &path)
+{
+    return path.endsWith(QLatin1Char('/')) ? path : path + QLatin1Char('/');
+}
+
+static bool propertiesChanged(const FileProperty &before, const FileProperty &after)
+{
+    return before.size() != after.size() || before.lastModifiedMSecs() != after.lastModifiedMSecs()
+            || before.isFile() != after.isFile();
+}
+
+// Merges the sorted \a files into the sorted \a list, recording the index
+// each of them ends up at. Entries comparing equal keep their listing order.
+static QList<FileProperty> mergeFiles(const QList<FileProperty> &list, const QList<FileProperty> &files,
+                                      const FilePropertyLessThan &lessThan, QList<int> *inserted)
+{
+    QList<FileProperty> merged;
+    merged.reserve(list.count() + files.count());
+    int i = 0;
+    for (int j = 0; j < files.count(); ++j) {
+        while (i < list.count() && !lessThan(files.at(j), list.at(i)))
+            merged.append(list.at(i++));
+        inserted->append(merged.count());
+        merged.append(files.at(j));
+    }
+    while (i < list.count())
+        merged.append(list.at(i++));
+    return merged;
+}
+
 
 FileInfoThread::FileInfoThread(QObject *parent)
     : QThread(parent),
@@ -51,6 +156,7 @@ FileInfoThread::FileInfoThread(QObject *parent)
 #ifndef QT_NO_FILESYSTEMWATCHER
       watcher(0),
 #endif
+      currentSortFlags(QDir::Name),
       sortFlags(QDir::Name),
       needUpdate(true),
       folderUpdate(false),
@@ -173,7 +279,6 @@ void FileInfoThread::setShowDotAndDotDot(bool on)
     QMutexLocker locker(&mutex);
     showDotAndDotDot = on;
     folderUpdate = true;
-    needUpdate = true;
     condition.wakeAll();
 }
 
@@ -182,7 +287,6 @@ void FileInfoThread::setShowHidden(bool on)
     QMutexLocker locker(&mutex);
     showHidden = on;
     folderUpdate = true;
-    needUpdate = true;
     condition.wakeAll();
 }
 
@@ -207,12 +311,11 @@ void FileInfoThread::updateFile(const QString &path)
 void FileInfoThread::run()
 {
     forever {
-        bool updateFiles = false;
         QMutexLocker locker(&mutex);
         if (abort) {
             return;
         }
-        if (currentPath.isEmpty() || !needUpdate)
+        if (currentPath.isEmpty() || !(needUpdate || folderUpdate || sortUpdate))
             condition.wait(&mutex);
 
         if (abort) {
@@ -220,11 +323,10 @@ void FileInfoThread::run()
         }
 
         if (!currentPath.isEmpty()) {
-            updateFiles = true;
+            // currentPath may change while the directory is being read
+            const QString path = currentPath;
+            getFileInfos(path);
         }
-        if (updateFiles)
-            getFileInfos(currentPath);
-        locker.unlock();
     }
 }
 
@@ -245,76 +347,154 @@ void FileInfoThread::getFileInfos(const QString &path)
         filter = filter | QDir::Hidden;
     if (showOnlyReadable)
         filter = filter | QDir::Readable;
+
+    QDir::SortFlags flags = sortFlags;
     if (showDirsFirst)
-        sortFlags = sortFlags | QDir::DirsFirst;
+        flags = flags | QDir::DirsFirst;
 
-    QDir currentDir(path, QString(), sortFlags);
-    QFileInfoList fileInfoList;
-    QList<FileProperty> filePropertyList;
+    const QStringList filters = nameFilters;
+    const bool newPath = needUpdate;
+    const bool resort = !newPath && (sortUpdate || flags != currentSortFlags);
+    const bool refresh = !newPath && folderUpdate;
+    needUpdate = false;
+    folderUpdate = false;
+    sortUpdate = false;
+
+    // Read the directory unlocked, so that the model is not blocked from
+    // changing the folder or the filters in the meantime.
+    mutex.unlock();
+    if (newPath) {
+        listFiles(path, filters, filter, flags);
+    } else {
+        if (resort) {
+            std::stable_sort(currentFileList.begin(), currentFileList.end(), FilePropertyLessThan(flags));
+            currentSortFlags = flags;
+            emit sortFinished(currentFileList);
+        }
+        if (refresh)
+            updateFiles(path, filters, filter, flags);
+    }
+    mutex.lock();
+}
 
-    fileInfoList = currentDir.entryInfoList(nameFilters, filter, sortFlags);
+void FileInfoThread::listFiles(const QString &path, const QStringList &filters, QDir::Filters filter, QDir::SortFlags flags)
+{
+    const FilePropertyLessThan lessThan(flags);
+    const QString prefix = directoryPrefix(path);
+    QList<FileProperty> list;
+    QList<FileProperty> chunk;
+    bool started = false;
 
-    if (!fileInfoList.isEmpty()) {
-        foreach (QFileInfo info, fileInfoList) {
-            //qDebug() << "Adding file : " << info.fileName() << "to list ";
-            filePropertyList << FileProperty(info);
-        }
-        if (folderUpdate) {
-            int fromIndex = 0;
-            int toIndex = currentFileList.size()-1;
-            findChangeRange(filePropertyList, fromIndex, toIndex);
-            folderUpdate = false;
-            currentFileList = filePropertyList;
-            //qDebug() << "emit directoryUpdated : " << fromIndex << " " << toIndex;
-            emit directoryUpdated(path, filePropertyList, fromIndex, toIndex);
-        } else {
-            currentFileList = filePropertyList;
-            if (sortUpdate) {
-                emit sortFinished(filePropertyList);
-                sortUpdate = false;
-            } else
-                emit directoryChanged(path, filePropertyList);
+    QDirIterator it(path, filters, filter);
+    forever {
+        const bool atEnd = !it.hasNext();
+        if (!atEnd) {
+            it.next();
+            chunk.append(FileProperty(it.fileInfo(), prefix));
+            if (chunk.count() < qMax(FILEINFOTHREAD_MINIMUM_CHUNK_SIZE, list.count()))
+                continue;
         }
-    } else {
-        // The directory is empty
-        if (folderUpdate) {
-            int fromIndex = 0;
-            int toIndex = currentFileList.size()-1;
-            folderUpdate = false;
-            currentFileList.clear();
-            emit directoryUpdated(path, filePropertyList, fromIndex, toIndex);
-        } else {
-            currentFileList.clear();
-            emit directoryChanged(path, filePropertyList);
+
+        std::stable_sort(chunk.begin(), chunk.end(), lessThan);
+        QList<int> inserted;
+        list = mergeFiles(list, chunk, lessThan, &inserted);
+        chunk.clear();
+        currentFileList = list;
+        currentSortFlags = flags;
+
+        // The first chunk completes the model reset started by setFolder().
+        if (!started) {
+            emit directoryChanged(path, list);
+            started = true;
+        } else if (!inserted.isEmpty()) {
+            emit filesInserted(path, list, inserted);
         }
+
+        if (atEnd)
+            return;
+
+        QMutexLocker locker(&mutex);
+        if (abort || needUpdate)
+            return;
     }
-    needUpdate = false;
 }
 
-void FileInfoThread::findChangeRange(const QList<FileProperty> &list, int &fromIndex, int &toIndex)
+void FileInfoThread::updateFiles(const QString &path, const QStringList &filters, QDir::Filters filter, QDir::SortFlags flags)
 {
-    if (currentFileList.size() == 0) {
-        fromIndex = 0;
-        toIndex = list.size();
-        return;
+    // QFileSystemWatcher does not tell which entries changed, so the directory
+    // is read again, but only the differences are passed on to the model.
+    const QString prefix = directoryPrefix(path);
+    QList<FileProperty> list;
+    QDirIterator it(path, filters, filter);
+    while (it.hasNext()) {
+        it.next();
+        list.append(FileProperty(it.fileInfo(), prefix));
     }
+    std::stable_sort(list.begin(), list.end(), FilePropertyLessThan(flags));
 
-    int i;
-    int listSize = list.size() < currentFileList.size() ? list.size() : currentFileList.size();
-    bool changeFound = false;
+    {
+        QMutexLocker locker(&mutex);
+        if (abort || needUpdate)
+            return;
+    }
 
-    for (i=0; i < listSize; i++) {
-        if (list.at(i) != currentFileList.at(i)) {
-            changeFound = true;
-            break;
+    QList<int> removed;
+    QList<int> inserted;
+    QList<int> changed;
+    findChanges(list, flags, &removed, &inserted, &changed);
+    currentFileList = list;
+    currentSortFlags = flags;
+
+    if (!removed.isEmpty() || !inserted.isEmpty() || !changed.isEmpty())
+        emit directoryUpdated(path, list, removed, inserted, changed);
+}
+
+void FileInfoThread::findChanges(const QList<FileProperty> &list, QDir::SortFlags flags,
+                                 QList<int> *removed, QList<int> *inserted, QList<int> *changed) const
+{
+    const QList<FileProperty> &oldList = currentFileList;
+    const FilePropertyLessThan lessThan(flags);
+
+    if (lessThan.isUnsorted()) {
+        // Without an order to walk both lists by, only the common head and
+        // tail are kept.
+        int head = 0;
+        while (head < oldList.count() && head < list.count() && oldList.at(head) == list.at(head)) {
+            if (propertiesChanged(oldList.at(head), list.at(head)))
+                changed->append(head);
+            ++head;
+        }
+        int tail = 0;
+        while (tail < oldList.count() - head && tail < list.count() - head
+               && oldList.at(oldList.count() - tail - 1) == list.at(list.count() - tail - 1)) {
+            ++tail;
         }
+        for (int i = head; i < oldList.count() - tail; ++i)
+            removed->append(i);
+        for (int i = head; i < list.count() - tail; ++i)
+            inserted->append(i);
+        for (int i = list.count() - tail; i < list.count(); ++i) {
+            if (propertiesChanged(oldList.at(i - list.count() + oldList.count()), list.at(i)))
+                changed->append(i);
+        }
+        return;
     }
 
-    if (changeFound)
-        fromIndex = i;
-    else
-        fromIndex = i-1;
-
-    // For now I let the rest of the list be updated..
-    toIndex = list.size() > currentFileList.size() ? list.size() - 1 : currentFileList.size() - 1;
+    int i = 0;
+    int j = 0;
+    while (i < oldList.count() || j < list.count()) {
+        if (j == list.count() || (i < oldList.count() && lessThan(oldList.at(i), list.at(j)))) {
+            removed->append(i++);
+        } else if (i == oldList.count() || lessThan(list.at(j), oldList.at(i))) {
+            inserted->append(j++);
+        } else if (oldList.at(i) != list.at(j)) {
+            removed->append(i++);
+            inserted->append(j++);
+        } else {
+            if (propertiesChanged(oldList.at(i), list.at(j)))
+                changed->append(j);
+            ++i;
+            ++j;
+        }
+    }
 }
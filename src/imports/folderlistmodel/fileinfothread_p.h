@@ -57,7 +57,9 @@ class FileInfoThread : public QThread
 
 Q_SIGNALS:
     void directoryChanged(const QString &directory, const QList<FileProperty> &list) const;
-    void directoryUpdated(const QString &directory, const QList<FileProperty> &list, int fromIndex, int toIndex) const;
+    void filesInserted(const QString &directory, const QList<FileProperty> &list, const QList<int> &inserted) const;
+    void directoryUpdated(const QString &directory, const QList<FileProperty> &list,
+                          const QList<int> &removed, const QList<int> &inserted, const QList<int> &changed) const;
     void sortFinished(const QList<FileProperty> &list) const;
 
 public:
@@ -86,7 +88,10 @@ public Q_SLOTS:
 protected:
     void run();
     void getFileInfos(const QString &path);
-    void findChangeRange(const QList<FileProperty> &list, int &fromIndex, int &toIndex);
+    void listFiles(const QString &path, const QStringList &filters, QDir::Filters filter, QDir::SortFlags flags);
+    void updateFiles(const QString &path, const QStringList &filters, QDir::Filters filter, QDir::SortFlags flags);
+    void findChanges(const QList<FileProperty> &list, QDir::SortFlags flags,
+                     QList<int> *removed, QList<int> *inserted, QList<int> *changed) const;
 
 private:
     QMutex mutex;
@@ -97,6 +102,7 @@ private:
     QFileSystemWatcher *watcher;
 #endif
     QList<FileProperty> currentFileList;
+    QDir::SortFlags currentSortFlags;
     QDir::SortFlags sortFlags;
     QString currentPath;
     QString rootPath;
@@ -45,33 +45,40 @@
 #include <QFileInfo>
 #include <QDateTime>
 
+#include <limits>
+
+// Directories can hold a very large number of entries, so only the file
+// name is stored per entry. The directory prefix is implicitly shared between
+// all entries of a listing, and the other names are derived on demand.
 class FileProperty
 {
 public:
-    FileProperty(const QFileInfo &info)
+    FileProperty(const QFileInfo &info, const QString &directoryPrefix)
+        : mDirectoryPrefix(directoryPrefix)
     {
         mFileName = info.fileName();
-        mFilePath = info.filePath();
-        mBaseName = info.baseName();
         mSize = info.size();
-        mSuffix = info.completeSuffix();
         mIsDir = info.isDir();
         mIsFile = info.isFile();
-        mLastModified = info.lastModified();
-        mLastRead = info.lastRead();
+        mLastModified = toMSecs(info.lastModified());
+        mLastRead = toMSecs(info.lastRead());
     }
     ~FileProperty()
     {}
 
     inline QString fileName() const { return mFileName; }
-    inline QString filePath() const { return mFilePath; }
-    inline QString baseName() const { return mBaseName; }
+    inline QString filePath() const { return mDirectoryPrefix + mFileName; }
+    inline QString baseName() const { return mFileName.left(mFileName.indexOf(QLatin1Char('.'))); }
     inline qint64 size() const { return mSize; }
-    inline QString suffix() const { return mSuffix; }
+    inline QString suffix() const {
+        const int dot = mFileName.indexOf(QLatin1Char('.'));
+        return dot != -1 ? mFileName.mid(dot + 1) : QString();
+    }
     inline bool isDir() const { return mIsDir; }
     inline bool isFile() const { return mIsFile; }
-    inline QDateTime lastModified() const { return mLastModified; }
-    inline QDateTime lastRead() const { return mLastRead; }
+    inline QDateTime lastModified() const { return fromMSecs(mLastModified); }
+    inline QDateTime lastRead() const { return fromMSecs(mLastRead); }
+    inline qint64 lastModifiedMSecs() const { return mLastModified; }
 
     inline bool operator !=(const FileProperty &fileInfo) const {
         return !operator==(fileInfo);
@@ -81,14 +88,19 @@ public:
     }
 
 private:
+    static inline qint64 toMSecs(const QDateTime &dateTime) {
+        return dateTime.isValid() ? dateTime.toMSecsSinceEpoch() : std::numeric_limits<qint64>::min();
+    }
+    static inline QDateTime fromMSecs(qint64 msecs) {
+        return msecs != std::numeric_limits<qint64>::min() ? QDateTime::fromMSecsSinceEpoch(msecs) : QDateTime();
+    }
+
     QString mFileName;
-    QString mFilePath;
-    QString mBaseName;
-    QString mSuffix;
+    QString mDirectoryPrefix;
     qint64 mSize;
+    qint64 mLastModified;
+    qint64 mLastRead;
     bool mIsDir;
     bool mIsFile;
-    QDateTime mLastModified;
-    QDateTime mLastRead;
 };
 #endif // FILEPROPERTY_P_H
@@ -48,6 +48,9 @@
 
 QT_BEGIN_NAMESPACE
 
+// Changes spread over more places than this are applied as a model reset.
+#define FOLDERLISTMODEL_MAX_CHANGE_RUNS 64
+
 class QQuickFolderListModelPrivate
 {
     Q_DECLARE_PUBLIC(QQuickFolderListModel)
@@ -57,7 +60,7 @@ public:
         : q_ptr(q),
           sortField(QQuickFolderListModel::Name), sortReversed(false), showFiles(true),
           showDirs(true), showDirsFirst(false), showDotAndDotDot(false), showOnlyReadable(false),
-          showHidden(false)
+          showHidden(false), insertingList(0), insertBoundary(0), insertShift(0)
     {
         nameFilters << QLatin1String("*");
     }
@@ -79,13 +82,26 @@ public:
     bool showOnlyReadable;
     bool showHidden;
 
+    // While insertRows() runs, rows before insertBoundary are taken from the
+    // new list, and the rest from data, shifted by insertShift.
+    const QList<FileProperty> *insertingList;
+    int insertBoundary;
+    int insertShift;
+
     ~QQuickFolderListModelPrivate() {}
     void init();
     void updateSorting();
+    int count() const { return data.count() + insertShift; }
+    const FileProperty &fileAt(int row) const;
+    void insertRows(const QList<FileProperty> &list, const QList<int> &inserted);
+    void applyChanges(const QList<FileProperty> &list, const QList<int> &removed,
+                      const QList<int> &inserted, const QList<int> &changed);
 
     // private slots
     void _q_directoryChanged(const QString &directory, const QList<FileProperty> &list);
-    void _q_directoryUpdated(const QString &directory, const QList<FileProperty> &list, int fromIndex, int toIndex);
+    void _q_filesInserted(const QString &directory, const QList<FileProperty> &list, const QList<int> &inserted);
+    void _q_directoryUpdated(const QString &directory, const QList<FileProperty> &list,
+                             const QList<int> &removed, const QList<int> &inserted, const QList<int> &changed);
     void _q_sortFinished(const QList<FileProperty> &list);
 
     static QString resolvePath(const QUrl &path);
@@ -96,10 +112,13 @@ void QQuickFolderListModelPrivate::init()
 {
     Q_Q(QQuickFolderListModel);
     qRegisterMetaType<QList<FileProperty> >("QList<FileProperty>");
+    qRegisterMetaType<QList<int> >("QList<int>");
     q->connect(&fileInfoThread, SIGNAL(directoryChanged(QString, QList<FileProperty>)),
                q, SLOT(_q_directoryChanged(QString, QList<FileProperty>)));
-    q->connect(&fileInfoThread, SIGNAL(directoryUpdated(QString, QList<FileProperty>, int, int)),
-               q, SLOT(_q_directoryUpdated(QString, QList<FileProperty>, int, int)));
+    q->connect(&fileInfoThread, SIGNAL(filesInserted(QString, QList<FileProperty>, QList<int>)),
+               q, SLOT(_q_filesInserted(QString, QList<FileProperty>, QList<int>)));
+    q->connect(&fileInfoThread, SIGNAL(directoryUpdated(QString, QList<FileProperty>, QList<int>, QList<int>, QList<int>)),
+               q, SLOT(_q_directoryUpdated(QString, QList<FileProperty>, QList<int>, QList<int>, QList<int>)));
     q->connect(&fileInfoThread, SIGNAL(sortFinished(QList<FileProperty>)),
                q, SLOT(_q_sortFinished(QList<FileProperty>)));
     q->connect(q, SIGNAL(rowCountChanged()), q, SIGNAL(countChanged()));
@@ -143,7 +162,11 @@ void QQuickFolderListModelPrivate::updateSorting()
 void QQuickFolderListModelPrivate::_q_directoryChanged(const QString &directory, const QList<FileProperty> &list)
 {
     Q_Q(QQuickFolderListModel);
-    Q_UNUSED(directory);
+
+    // The reset started by setFolder() is completed by the listing of the
+    // folder that is current now, not by one that was superseded.
+    if (directory != resolvePath(currentDir))
+        return;
 
     data = list;
     q->endResetModel();
@@ -152,42 +175,135 @@ void QQuickFolderListModelPrivate::_q_directoryChanged(const QString &directory,
 }
 
 
-void QQuickFolderListModelPrivate::_q_directoryUpdated(const QString &directory, const QList<FileProperty> &list, int fromIndex, int toIndex)
+static int countRuns(const QList<int> &indexes)
+{
+    int runs = 0;
+    for (int i = 0; i < indexes.count(); ++i) {
+        if (i == 0 || indexes.at(i) != indexes.at(i - 1) + 1)
+            ++runs;
+    }
+    return runs;
+}
+
+const FileProperty &QQuickFolderListModelPrivate::fileAt(int row) const
+{
+    if (insertingList && row < insertBoundary)
+        return insertingList->at(row);
+    return data.at(row - insertShift);
+}
+
+/*
+    Inserts the rows of \a list at the ascending indexes \a inserted, the
+    other rows of which are those already in data, and makes list the new data.
+    Each run of rows is announced separately, but none of them is copied into
+    data on its own: the model reads the rows from both lists until the end.
+    When the runs are too fragmented, the rows from the first inserted one on
+    are replaced instead, with one removal and one insertion.
+*/
+void QQuickFolderListModelPrivate::insertRows(const QList<FileProperty> &list, const QList<int> &inserted)
 {
     Q_Q(QQuickFolderListModel);
-    Q_UNUSED(directory);
 
     QModelIndex parent;
-    if (data.size() > list.size()) {
-        //File(s) removed. Since I do not know how many
-        //or where I need to update the whole list from the first item.
-        data = list;
-        q->beginRemoveRows(parent, fromIndex, toIndex);
+    if (countRuns(inserted) > FOLDERLISTMODEL_MAX_CHANGE_RUNS) {
+        const int first = inserted.first();
+        q->beginRemoveRows(parent, first, data.count() - 1);
+        data.erase(data.begin() + first, data.end());
         q->endRemoveRows();
-        if (list.size() > 0) {
-            q->beginInsertRows(parent, fromIndex, list.size()-1);
-            q->endInsertRows();
-        }
-        emit q->rowCountChanged();
-    } else if (data.size() < list.size()) {
-        //qDebug() << "File added. FromIndex: " << fromIndex << " toIndex: " << toIndex << " list size: " << list.size();
-        //File(s) added. Calculate how many and insert
-        //from the first changed one.
-        toIndex = fromIndex + (list.size() - data.size()-1);
+        q->beginInsertRows(parent, first, list.count() - 1);
+        data = list;
+        q->endInsertRows();
+        return;
+    }
+
+    insertingList = &list;
+    for (int start = 0; start < inserted.count();) {
+        int end = start + 1;
+        while (end < inserted.count() && inserted.at(end) == inserted.at(end - 1) + 1)
+            ++end;
+        const int fromIndex = inserted.at(start);
+        const int toIndex = inserted.at(end - 1);
         q->beginInsertRows(parent, fromIndex, toIndex);
+        insertBoundary = toIndex + 1;
+        insertShift += toIndex - fromIndex + 1;
         q->endInsertRows();
+        start = end;
+    }
+
+    data = list;
+    insertingList = 0;
+    insertBoundary = 0;
+    insertShift = 0;
+}
+
+/*
+    Applies the differences between data and list. \a removed holds ascending
+    indexes into data, \a inserted and \a changed hold ascending indexes into
+    \a list.
+*/
+void QQuickFolderListModelPrivate::applyChanges(const QList<FileProperty> &list, const QList<int> &removed,
+                                                const QList<int> &inserted, const QList<int> &changed)
+{
+    Q_Q(QQuickFolderListModel);
+
+    if (countRuns(removed) + countRuns(inserted) > FOLDERLISTMODEL_MAX_CHANGE_RUNS) {
+        q->beginResetModel();
         data = list;
+        q->endResetModel();
         emit q->rowCountChanged();
-        QModelIndex modelIndexFrom = q->createIndex(fromIndex, 0);
-        QModelIndex modelIndexTo = q->createIndex(toIndex, 0);
-        emit q->dataChanged(modelIndexFrom, modelIndexTo);
-    } else {
-        //qDebug() << "File has been updated";
-        QModelIndex modelIndexFrom = q->createIndex(fromIndex, 0);
-        QModelIndex modelIndexTo = q->createIndex(toIndex, 0);
-        data = list;
-        emit q->dataChanged(modelIndexFrom, modelIndexTo);
+        return;
     }
+
+    QModelIndex parent;
+    for (int end = removed.count(); end > 0;) {
+        int start = end - 1;
+        while (start > 0 && removed.at(start - 1) == removed.at(start) - 1)
+            --start;
+        const int fromIndex = removed.at(start);
+        const int toIndex = removed.at(end - 1);
+        q->beginRemoveRows(parent, fromIndex, toIndex);
+        data.erase(data.begin() + fromIndex, data.begin() + toIndex + 1);
+        q->endRemoveRows();
+        end = start;
+    }
+
+    insertRows(list, inserted);
+
+    for (int start = 0; start < changed.count();) {
+        int end = start + 1;
+        while (end < changed.count() && changed.at(end) == changed.at(end - 1) + 1)
+            ++end;
+        emit q->dataChanged(q->createIndex(changed.at(start), 0), q->createIndex(changed.at(end - 1), 0));
+        start = end;
+    }
+
+    if (!removed.isEmpty() || !inserted.isEmpty())
+        emit q->rowCountChanged();
+}
+
+void QQuickFolderListModelPrivate::_q_filesInserted(const QString &directory, const QList<FileProperty> &list, const QList<int> &inserted)
+{
+    Q_Q(QQuickFolderListModel);
+
+    // Drop the rest of a listing that was superseded by a new folder.
+    if (directory != resolvePath(currentDir))
+        return;
+
+    // Never reset the model while it is being listed, which would lose the
+    // current index and position of the views.
+    insertRows(list, inserted);
+    if (!inserted.isEmpty())
+        emit q->rowCountChanged();
+}
+
+void QQuickFolderListModelPrivate::_q_directoryUpdated(const QString &directory, const QList<FileProperty> &list,
+                                                       const QList<int> &removed, const QList<int> &inserted,
+                                                       const QList<int> &changed)
+{
+    if (directory != resolvePath(currentDir))
+        return;
+
+    applyChanges(list, removed, inserted, changed);
 }
 
 void QQuickFolderListModelPrivate::_q_sortFinished(const QList<FileProperty> &list)
@@ -265,6 +381,10 @@ QString QQuickFolderListModelPrivate::resolvePath(const QUrl &path)
     Additionally a file entry can be differentiated from a folder entry via the
     isFolder() method.
 
+    The folder is read in a separate thread. Entries are added to the model in
+    sorted order while the folder is still being read, and later changes to
+    the folder are applied as individual insertions, removals and updates.
+
     \section1 Filtering
 
     Various properties can be set to filter the number of files and directories
@@ -345,37 +465,39 @@ QVariant QQuickFolderListModel::data(const QModelIndex &index, int role) const
     Q_D(const QQuickFolderListModel);
     QVariant rv;
 
-    if (index.row() >= d->data.size())
+    if (index.row() >= d->count())
         return rv;
 
+    const FileProperty &file = d->fileAt(index.row());
+
     switch (role)
     {
         case FileNameRole:
-            rv = d->data.at(index.row()).fileName();
+            rv = file.fileName();
             break;
         case FilePathRole:
-            rv = d->data.at(index.row()).filePath();
+            rv = file.filePath();
             break;
         case FileBaseNameRole:
-            rv = d->data.at(index.row()).baseName();
+            rv = file.baseName();
             break;
         case FileSuffixRole:
-            rv = d->data.at(index.row()).suffix();
+            rv = file.suffix();
             break;
         case FileSizeRole:
-            rv = d->data.at(index.row()).size();
+            rv = file.size();
             break;
         case FileLastModifiedRole:
-            rv = d->data.at(index.row()).lastModified();
+            rv = file.lastModified();
             break;
         case FileLastReadRole:
-            rv = d->data.at(index.row()).lastRead();
+            rv = file.lastRead();
             break;
         case FileIsDirRole:
-            rv = d->data.at(index.row()).isDir();
+            rv = file.isDir();
             break;
         case FileUrlRole:
-            rv = QUrl::fromLocalFile(d->data.at(index.row()).filePath());
+            rv = QUrl::fromLocalFile(file.filePath());
             break;
         default:
             break;
@@ -399,7 +521,7 @@ int QQuickFolderListModel::rowCount(const QModelIndex &parent) const
 {
     Q_D(const QQuickFolderListModel);
     Q_UNUSED(parent);
-    return d->data.size();
+    return d->count();
 }
 
 QModelIndex QQuickFolderListModel::index(int row, int , const QModelIndex &) const
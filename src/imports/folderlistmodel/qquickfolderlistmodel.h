@@ -164,7 +164,8 @@ private:
     QScopedPointer<QQuickFolderListModelPrivate> d_ptr;
 
     Q_PRIVATE_SLOT(d_func(), void _q_directoryChanged(const QString &directory, const QList<FileProperty> &list))
-    Q_PRIVATE_SLOT(d_func(), void _q_directoryUpdated(const QString &directory, const QList<FileProperty> &list, int fromIndex, int toIndex))
+    Q_PRIVATE_SLOT(d_func(), void _q_filesInserted(const QString &directory, const QList<FileProperty> &list, const QList<int> &inserted))
+    Q_PRIVATE_SLOT(d_func(), void _q_directoryUpdated(const QString &directory, const QList<FileProperty> &list, const QList<int> &removed, const QList<int> &inserted, const QList<int> &changed))
     Q_PRIVATE_SLOT(d_func(), void _q_sortFinished(const QList<FileProperty> &list))
 };
 //![class end]
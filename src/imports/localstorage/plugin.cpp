@@ -54,6 +54,9 @@
 #include <QtCore/qcryptographichash.h>
 #include <QtCore/qsettings.h>
 #include <QtCore/qdir.h>
+#include <QtCore/qcache.h>
+#include <QtCore/qthread.h>
+#include <QtCore/qcoreapplication.h>
 #include <private/qv4sqlerrors_p.h>
 #include <private/qv4engine_p.h>
 #include <private/qv4object_p.h>
@@ -86,19 +89,100 @@ using namespace QV4;
 }
 
 
+#define LOCALSTORAGE_STATEMENT_CACHE_SIZE 32
+// How long, in milliseconds, a statement on the GUI thread waits for a lock
+// that another connection, such as the database thread's, holds
+#define LOCALSTORAGE_GUI_BUSY_TIMEOUT 100
+
+struct QQmlSqlStatement
+{
+    QQmlSqlStatement() : executed(false), ok(false), rowsAffected(0) {}
+
+    QString sql;
+    QMap<int, QVariant> values;     // positional parameters
+    QVariantMap namedValues;        // named parameters
+    QList<QVariantList> batch;      // positional parameters, one list per execution
+
+    bool executed;
+    bool ok;
+    QSqlError error;
+    int rowsAffected;
+    QVariant insertId;
+    QList<QSqlRecord> records;      // only filled on the database thread
+};
+
+// Prepared statements of the connections used by one thread, keyed by their
+// SQL text.  A statement is taken out of the cache while it is executing.
+class QQmlSqlStatementCache
+{
+public:
+    QQmlSqlStatementCache() { m_statements.setMaxCost(LOCALSTORAGE_STATEMENT_CACHE_SIZE); }
+
+    QSqlQuery *take(const QSqlDatabase &db, const QString &sql, QSqlError *error);
+    void give(const QSqlDatabase &db, const QString &sql, QSqlQuery *query);
+    void clear(const QString &connectionName);
+
+private:
+    typedef QPair<QString, QString> Key;
+    QCache<Key, QSqlQuery> m_statements;
+};
+
+QSqlQuery *QQmlSqlStatementCache::take(const QSqlDatabase &db, const QString &sql, QSqlError *error)
+{
+    QSqlQuery *query = m_statements.take(Key(db.connectionName(), sql));
+    if (query && query->driver() == db.driver())
+        return query;
+    // The connection was removed and added again since the statement was prepared
+    delete query;
+
+    query = new QSqlQuery(db);
+    if (!query->prepare(sql)) {
+        *error = query->lastError();
+        delete query;
+        return 0;
+    }
+    return query;
+}
+
+void QQmlSqlStatementCache::give(const QSqlDatabase &db, const QString &sql, QSqlQuery *query)
+{
+    query->finish();
+    m_statements.insert(Key(db.connectionName(), sql), query);
+}
+
+void QQmlSqlStatementCache::clear(const QString &connectionName)
+{
+    foreach (const Key &key, m_statements.keys()) {
+        if (key.first == connectionName)
+            m_statements.remove(key);
+    }
+}
+
+class QQmlSqlDatabaseExecutor;
 class QQmlSqlDatabaseData : public QV8Engine::Deletable
 {
 public:
     QQmlSqlDatabaseData(QV8Engine *engine);
     ~QQmlSqlDatabaseData();
 
+    QQmlSqlDatabaseExecutor *executor();
+
     PersistentValue databaseProto;
+    PersistentValue asyncDatabaseProto;
     PersistentValue queryProto;
     PersistentValue rowsProto;
+
+    QQmlSqlStatementCache statements;
+
+private:
+    QV8Engine *m_engine;
+    QQmlSqlDatabaseExecutor *m_executor;
 };
 
 V8_DEFINE_EXTENSION(QQmlSqlDatabaseData, databaseData)
 
+class QQmlSqlAsyncTransaction;
+
 class QQmlSqlDatabaseWrapper : public Object
 {
     Q_MANAGED
@@ -106,7 +190,8 @@ class QQmlSqlDatabaseWrapper : public Object
 public:
     enum Type { Database, Query, Rows };
     QQmlSqlDatabaseWrapper(QV8Engine *e)
-        : Object(QV8Engine::getV4(e)), type(Database), inTransaction(false), readonly(false), forwardOnly(false)
+        : Object(QV8Engine::getV4(e)), type(Database), inTransaction(false), readonly(false)
+        , transaction(0), forwardOnly(false), materialized(false)
     {
         setVTable(&static_vtbl);
     }
@@ -126,9 +211,12 @@ public:
 
     bool inTransaction; // type == Query
     bool readonly;   // type == Query
+    QQmlSqlAsyncTransaction *transaction; // type == Query, for asynchronous transactions
 
     QSqlQuery sqlQuery; // type == Rows
     bool forwardOnly; // type == Rows
+    bool materialized; // type == Rows, read on the database thread into records
+    QList<QSqlRecord> records; // type == Rows
 };
 
 DEFINE_MANAGED_VTABLE(QQmlSqlDatabaseWrapper);
@@ -150,6 +238,9 @@ static ReturnedValue qmlsqldatabase_rows_length(CallContext *ctx)
     if (!r || r->type != QQmlSqlDatabaseWrapper::Rows)
         V4THROW_REFERENCE("Not a SQLDatabase::Rows object");
 
+    if (r->materialized)
+        return Encode(r->records.count());
+
     int s = r->sqlQuery.size();
     if (s < 0) {
         // Inefficient
@@ -168,6 +259,8 @@ static ReturnedValue qmlsqldatabase_rows_forwardOnly(CallContext *ctx)
     QV4::Scoped<QQmlSqlDatabaseWrapper> r(scope, ctx->callData->thisObject.as<QQmlSqlDatabaseWrapper>());
     if (!r || r->type != QQmlSqlDatabaseWrapper::Rows)
         V4THROW_REFERENCE("Not a SQLDatabase::Rows object");
+    if (r->materialized)
+        return Encode(false);
     return Encode(r->sqlQuery.isForwardOnly());
 }
 
@@ -180,12 +273,14 @@ static ReturnedValue qmlsqldatabase_rows_setForwardOnly(CallContext *ctx)
     if (ctx->callData->argc < 1)
         return ctx->throwTypeError();
 
-    r->sqlQuery.setForwardOnly(ctx->callData->args[0].toBoolean());
+    if (!r->materialized)
+        r->sqlQuery.setForwardOnly(ctx->callData->args[0].toBoolean());
     return Encode::undefined();
 }
 
 QQmlSqlDatabaseData::~QQmlSqlDatabaseData()
 {
+    delete m_executor;
 }
 
 static QString qmlsqldatabase_databasesPath(QV8Engine *engine)
@@ -206,24 +301,29 @@ static QString qmlsqldatabase_databaseFile(const QString& connectionName, QV8Eng
     return qmlsqldatabase_databasesPath(engine) + QDir::separator() + connectionName;
 }
 
-static ReturnedValue qmlsqldatabase_rows_index(QV4::Referenced<QQmlSqlDatabaseWrapper> r, ExecutionEngine *v4, quint32 index, bool *hasProperty = 0)
+static ReturnedValue qmlsqldatabase_rows_record(ExecutionEngine *v4, const QSqlRecord &record)
 {
     Scope scope(v4);
     QV8Engine *v8 = v4->v8Engine;
 
-    if (r->sqlQuery.at() == (int)index || r->sqlQuery.seek(index)) {
-        QSqlRecord record = r->sqlQuery.record();
-        // XXX optimize
-        Scoped<Object> row(scope, v4->newObject());
-        for (int ii = 0; ii < record.count(); ++ii) {
-            QVariant v = record.value(ii);
-            ScopedString s(scope, v4->newIdentifier(record.fieldName(ii)));
-            ScopedValue val(scope, v.isNull() ? Encode::null() : v8->fromVariant(v));
-            row->put(s, val);
-        }
+    // XXX optimize
+    Scoped<Object> row(scope, v4->newObject());
+    for (int ii = 0; ii < record.count(); ++ii) {
+        QVariant v = record.value(ii);
+        ScopedString s(scope, v4->newIdentifier(record.fieldName(ii)));
+        ScopedValue val(scope, v.isNull() ? Encode::null() : v8->fromVariant(v));
+        row->put(s, val);
+    }
+    return row.asReturnedValue();
+}
+
+static ReturnedValue qmlsqldatabase_rows_index(QV4::Referenced<QQmlSqlDatabaseWrapper> r, ExecutionEngine *v4, quint32 index, bool *hasProperty = 0)
+{
+    if (r->materialized ? index < (quint32)r->records.count()
+                        : r->sqlQuery.at() == (int)index || r->sqlQuery.seek(index)) {
         if (hasProperty)
             *hasProperty = true;
-        return row.asReturnedValue();
+        return qmlsqldatabase_rows_record(v4, r->materialized ? r->records.at(index) : r->sqlQuery.record());
     } else {
         if (hasProperty)
             *hasProperty = false;
@@ -251,6 +351,119 @@ static ReturnedValue qmlsqldatabase_rows_item(CallContext *ctx)
     return qmlsqldatabase_rows_index(r, ctx->engine, ctx->callData->argc ? ctx->callData->args[0].toUInt32() : 0);
 }
 
+static void qmlsqldatabase_readValues(QV8Engine *engine, const ValueRef values, QQmlSqlStatement *statement)
+{
+    Scope scope(QV8Engine::getV4(engine));
+
+    if (values->asArrayObject()) {
+        ScopedArrayObject array(scope, values);
+        quint32 size = array->arrayLength();
+        QV4::ScopedValue v(scope);
+
+        // An array of arrays executes the statement once for each of them
+        bool batch = size > 0;
+        for (quint32 ii = 0; batch && ii < size; ++ii)
+            batch = (v = array->getIndexed(ii))->asArrayObject() != 0;
+
+        ScopedArrayObject row(scope);
+        QV4::ScopedValue rv(scope);
+        for (quint32 ii = 0; ii < size; ++ii) {
+            v = array->getIndexed(ii);
+            if (batch) {
+                row = v.asReturnedValue();
+                QVariantList rowValues;
+                quint32 rowSize = row->arrayLength();
+                for (quint32 jj = 0; jj < rowSize; ++jj)
+                    rowValues.append(engine->toVariant((rv = row->getIndexed(jj)), -1));
+                statement->batch.append(rowValues);
+            } else {
+                statement->values.insert(ii, engine->toVariant(v, -1));
+            }
+        }
+    } else if (values->asObject()) {
+        ScopedObject object(scope, values);
+        ObjectIterator it(scope, object, ObjectIterator::WithProtoChain|ObjectIterator::EnumerableOnly);
+        ScopedValue key(scope);
+        QV4::ScopedValue val(scope);
+        while (1) {
+            key = it.nextPropertyName(val);
+            if (key->isNull())
+                break;
+            QVariant v = engine->toVariant(val, -1);
+            if (key->isString()) {
+                statement->namedValues.insert(key->stringValue()->toQString(), v);
+            } else {
+                assert(key->isInteger());
+                statement->values.insert(key->integerValue(), v);
+            }
+        }
+    } else {
+        statement->values.insert(0, engine->toVariant(values, -1));
+    }
+}
+
+static void qmlsqldatabase_bind(QSqlQuery *query, const QMap<int, QVariant> &values, const QVariantMap &namedValues)
+{
+    // Clear whatever a previous execution of a cached statement left bound
+    for (int ii = query->boundValues().count() - 1; ii >= 0; --ii)
+        query->bindValue(ii, QVariant());
+
+    for (QMap<int, QVariant>::const_iterator it = values.constBegin(); it != values.constEnd(); ++it)
+        query->bindValue(it.key(), it.value());
+    for (QVariantMap::const_iterator it = namedValues.constBegin(); it != namedValues.constEnd(); ++it)
+        query->bindValue(it.key(), it.value());
+}
+
+static bool qmlsqldatabase_execute(QSqlQuery *query, QQmlSqlStatement *statement)
+{
+    statement->executed = true;
+    statement->rowsAffected = 0;
+
+    if (statement->batch.isEmpty()) {
+        qmlsqldatabase_bind(query, statement->values, statement->namedValues);
+        statement->ok = query->exec();
+        if (statement->ok)
+            statement->rowsAffected = query->numRowsAffected();
+    } else {
+        statement->ok = true;
+        QMap<int, QVariant> values;
+        for (int ii = 0; statement->ok && ii < statement->batch.count(); ++ii) {
+            const QVariantList &row = statement->batch.at(ii);
+            values.clear();
+            for (int jj = 0; jj < row.count(); ++jj)
+                values.insert(jj, row.at(jj));
+            qmlsqldatabase_bind(query, values, QVariantMap());
+            statement->ok = query->exec();
+            if (statement->ok)
+                statement->rowsAffected += query->numRowsAffected();
+        }
+    }
+
+    if (statement->ok)
+        statement->insertId = query->lastInsertId();
+    else
+        statement->error = query->lastError();
+    return statement->ok;
+}
+
+static ReturnedValue qmlsqldatabase_resultSet(QV8Engine *engine, const QQmlSqlStatement &statement, const ValueRef rows)
+{
+    ExecutionEngine *v4 = QV8Engine::getV4(engine);
+    Scope scope(v4);
+
+    Scoped<Object> resultObject(scope, v4->newObject());
+    // XXX optimize
+    ScopedString s(scope);
+    ScopedValue v(scope);
+    resultObject->put((s = v4->newIdentifier("rowsAffected")), (v = Primitive::fromInt32(statement.rowsAffected)));
+    resultObject->put((s = v4->newIdentifier("insertId")), (v = engine->toString(statement.insertId.toString())));
+    resultObject->put((s = v4->newIdentifier("rows")), rows);
+    return resultObject.asReturnedValue();
+}
+
+static ReturnedValue qmlsqldatabase_enqueue(QQmlSqlAsyncTransaction *transaction, const QQmlSqlStatement &statement,
+                                            const ValueRef callback, const ValueRef errorCallback);
+
 static ReturnedValue qmlsqldatabase_executeSql(CallContext *ctx)
 {
     QV4::Scope scope(ctx);
@@ -271,67 +484,43 @@ static ReturnedValue qmlsqldatabase_executeSql(CallContext *ctx)
         V4THROW_SQL(SQLEXCEPTION_SYNTAX_ERR, QQmlEngine::tr("Read-only Transaction"));
     }
 
-    QSqlQuery query(db);
-    bool err = false;
-
-    ScopedValue result(scope, Primitive::undefinedValue());
-
-    if (query.prepare(sql)) {
-        if (ctx->callData->argc > 1) {
-            ScopedValue values(scope, ctx->callData->args[1]);
-            if (values->asArrayObject()) {
-                ScopedArrayObject array(scope, values);
-                quint32 size = array->arrayLength();
-                QV4::ScopedValue v(scope);
-                for (quint32 ii = 0; ii < size; ++ii)
-                    query.bindValue(ii, engine->toVariant((v = array->getIndexed(ii)), -1));
-            } else if (values->asObject()) {
-                ScopedObject object(scope, values);
-                ObjectIterator it(scope, object, ObjectIterator::WithProtoChain|ObjectIterator::EnumerableOnly);
-                ScopedValue key(scope);
-                QV4::ScopedValue val(scope);
-                while (1) {
-                    key = it.nextPropertyName(val);
-                    if (key->isNull())
-                        break;
-                    QVariant v = engine->toVariant(val, -1);
-                    if (key->isString()) {
-                        query.bindValue(key->stringValue()->toQString(), v);
-                    } else {
-                        assert(key->isInteger());
-                        query.bindValue(key->integerValue(), v);
-                    }
-                }
-            } else {
-                query.bindValue(0, engine->toVariant(values, -1));
-            }
-        }
-        if (query.exec()) {
-            QV4::Scoped<QQmlSqlDatabaseWrapper> rows(scope, new (ctx->engine->memoryManager) QQmlSqlDatabaseWrapper(engine));
-            QV4::ScopedObject p(scope, databaseData(engine)->rowsProto.value());
-            rows->setPrototype(p.getPointer());
-            rows->type = QQmlSqlDatabaseWrapper::Rows;
-            rows->database = db;
-            rows->sqlQuery = query;
-
-            Scoped<Object> resultObject(scope, ctx->engine->newObject());
-            result = resultObject.asReturnedValue();
-            // XXX optimize
-            ScopedString s(scope);
-            ScopedValue v(scope);
-            resultObject->put((s = ctx->engine->newIdentifier("rowsAffected")), (v = Primitive::fromInt32(query.numRowsAffected())));
-            resultObject->put((s = ctx->engine->newIdentifier("insertId")), (v = engine->toString(query.lastInsertId().toString())));
-            resultObject->put((s = ctx->engine->newIdentifier("rows")), rows);
-        } else {
-            err = true;
-        }
+    QQmlSqlStatement statement;
+    statement.sql = sql;
+    if (ctx->callData->argc > 1) {
+        ScopedValue values(scope, ctx->callData->args[1]);
+        qmlsqldatabase_readValues(engine, values, &statement);
+    }
+
+    if (r->transaction) {
+        ScopedValue callback(scope, ctx->argument(2));
+        ScopedValue errorCallback(scope, ctx->argument(3));
+        return qmlsqldatabase_enqueue(r->transaction, statement, callback, errorCallback);
+    }
+
+    QQmlSqlStatementCache &statements = databaseData(engine)->statements;
+    QSqlQuery *query = statements.take(db, sql, &statement.error);
+    if (!query)
+        V4THROW_SQL(SQLEXCEPTION_DATABASE_ERR,statement.error.text());
+
+    if (!qmlsqldatabase_execute(query, &statement)) {
+        statements.give(db, sql, query);
+        V4THROW_SQL(SQLEXCEPTION_DATABASE_ERR,statement.error.text());
+    }
+
+    QV4::Scoped<QQmlSqlDatabaseWrapper> rows(scope, new (ctx->engine->memoryManager) QQmlSqlDatabaseWrapper(engine));
+    QV4::ScopedObject p(scope, databaseData(engine)->rowsProto.value());
+    rows->setPrototype(p.getPointer());
+    rows->type = QQmlSqlDatabaseWrapper::Rows;
+    rows->database = db;
+    if (query->isSelect()) {
+        // The rows are read lazily, so the query can't be reused
+        rows->sqlQuery = *query;
+        delete query;
     } else {
-        err = true;
+        statements.give(db, sql, query);
     }
-    if (err)
-        V4THROW_SQL(SQLEXCEPTION_DATABASE_ERR,query.lastError().text());
 
-    return result.asReturnedValue();
+    return qmlsqldatabase_resultSet(engine, statement, rows);
 }
 
 struct TransactionRollback {
@@ -471,7 +660,518 @@ static ReturnedValue qmlsqldatabase_read_transaction(CallContext *ctx)
     return qmlsqldatabase_transaction_shared(ctx, true);
 }
 
+struct QQmlSqlStatementCallbacks
+{
+    PersistentValue callback;
+    PersistentValue errorCallback;
+};
+
+class QQmlSqlAsyncTransaction
+{
+public:
+    enum Step { Execute, Commit, Rollback };
+
+    QQmlSqlAsyncTransaction() : step(Execute), begun(false), errorCode(0) {}
+
+    // Handed over to the database thread for each step
+    QString connectionName;
+    QString databaseFile;
+    Step step;
+    bool begun;
+    QList<QQmlSqlStatement> statements;
+    QSqlError error;
+
+    // Only used on the GUI thread
+    QList<QQmlSqlStatementCallbacks> callbacks;
+    QList<QQmlSqlStatement> queue;
+    QList<QQmlSqlStatementCallbacks> queueCallbacks;
+    PersistentValue tx;
+    PersistentValue callback;
+    PersistentValue errorCallback;
+    PersistentValue successCallback;
+    int errorCode;
+    QString errorMessage;
+};
+
+class QQmlSqlTransactionEvent : public QEvent
+{
+public:
+    enum Type { Start = QEvent::User, Execute, Executed, Close };
+
+    QQmlSqlTransactionEvent(Type type, QQmlSqlAsyncTransaction *transaction)
+        : QEvent(QEvent::Type(type)), transaction(transaction) {}
+
+    QQmlSqlAsyncTransaction *transaction;
+};
+
+// Lives on the database thread, which opens its own connection to each database
+class QQmlSqlDatabaseWorker : public QObject
+{
+public:
+    QQmlSqlDatabaseWorker(QObject *executor) : m_executor(executor) {}
+
+protected:
+    bool event(QEvent *);
+
+private:
+    QSqlDatabase database(const QString &connectionName, const QString &databaseFile);
+    void run(QQmlSqlAsyncTransaction *);
+    void close();
+
+    QObject *m_executor;
+    QQmlSqlStatementCache m_statements;
+    QStringList m_connections;
+};
+
+bool QQmlSqlDatabaseWorker::event(QEvent *e)
+{
+    switch (int(e->type())) {
+    case QQmlSqlTransactionEvent::Execute: {
+        QQmlSqlAsyncTransaction *transaction = static_cast<QQmlSqlTransactionEvent *>(e)->transaction;
+        run(transaction);
+        QCoreApplication::postEvent(m_executor, new QQmlSqlTransactionEvent(QQmlSqlTransactionEvent::Executed, transaction));
+        return true;
+    }
+    case QQmlSqlTransactionEvent::Close:
+        close();
+        thread()->quit();
+        return true;
+    default:
+        break;
+    }
+    return QObject::event(e);
+}
+
+// Connections must be removed on the thread that used them
+void QQmlSqlDatabaseWorker::close()
+{
+    foreach (const QString &name, m_connections) {
+        m_statements.clear(name);
+        QSqlDatabase::removeDatabase(name);
+    }
+    m_connections.clear();
+}
+
+QSqlDatabase QQmlSqlDatabaseWorker::database(const QString &connectionName, const QString &databaseFile)
+{
+    QString name = connectionName + QLatin1String("-async");
+    if (!QSqlDatabase::contains(name)) {
+        m_statements.clear(name);
+        QSqlDatabase db = QSqlDatabase::addDatabase(QLatin1String("QSQLITE"), name);
+        db.setDatabaseName(databaseFile);
+        if (!m_connections.contains(name))
+            m_connections.append(name);
+    }
+    return QSqlDatabase::database(name);
+}
+
+void QQmlSqlDatabaseWorker::run(QQmlSqlAsyncTransaction *transaction)
+{
+    QSqlDatabase db = database(transaction->connectionName, transaction->databaseFile);
+    transaction->error = QSqlError();
+
+    switch (transaction->step) {
+    case QQmlSqlAsyncTransaction::Execute:
+        if (!transaction->begun) {
+            if (!db.transaction()) {
+                transaction->error = db.lastError();
+                break;
+            }
+            transaction->begun = true;
+        }
+        for (int ii = 0; ii < transaction->statements.count(); ++ii) {
+            QQmlSqlStatement &statement = transaction->statements[ii];
+            QSqlQuery *query = m_statements.take(db, statement.sql, &statement.error);
+            if (!query) {
+                statement.executed = true;
+                break;
+            }
+            query->setForwardOnly(true);
+            if (qmlsqldatabase_execute(query, &statement) && query->isSelect()) {
+                while (query->next())
+                    statement.records.append(query->record());
+            }
+            m_statements.give(db, statement.sql, query);
+            if (!statement.ok)
+                break;
+        }
+        break;
+    case QQmlSqlAsyncTransaction::Commit:
+        if (transaction->begun && !db.commit()) {
+            transaction->error = db.lastError();
+            db.rollback();
+        }
+        break;
+    case QQmlSqlAsyncTransaction::Rollback:
+        if (transaction->begun)
+            db.rollback();
+        break;
+    }
+}
+
+// Runs the asynchronous transactions of an engine.  Their callbacks are called
+// on the GUI thread, while the statements they queue are executed in batches
+// on the database thread.
+class QQmlSqlDatabaseExecutor : public QObject
+{
+public:
+    QQmlSqlDatabaseExecutor(QV8Engine *engine);
+    ~QQmlSqlDatabaseExecutor();
+
+    void start(QQmlSqlAsyncTransaction *);
+
+protected:
+    bool event(QEvent *);
+
+private:
+    void begin(QQmlSqlAsyncTransaction *);
+    void flush(QQmlSqlAsyncTransaction *);
+    void executed(QQmlSqlAsyncTransaction *);
+    void fail(QQmlSqlAsyncTransaction *, int code, const QString &message);
+    void reportError(QQmlSqlAsyncTransaction *);
+    void finish(QQmlSqlAsyncTransaction *);
+    void post(QQmlSqlAsyncTransaction *);
+    void postStart(QQmlSqlAsyncTransaction *);
+
+    bool call(const PersistentValue &function, int argc, const ValueRef arg0, const ValueRef arg1,
+              ValueRef result, QQmlError *exception);
+    ReturnedValue errorObject(int code, const QString &message);
+
+    QV8Engine *m_engine;
+    QThread m_thread;
+    QQmlSqlDatabaseWorker *m_worker;
+    QList<QQmlSqlAsyncTransaction *> m_transactions;
+    // Transactions waiting for each database, the running one first
+    QHash<QString, QList<QQmlSqlAsyncTransaction *> > m_queues;
+};
+
+QQmlSqlDatabaseExecutor::QQmlSqlDatabaseExecutor(QV8Engine *engine)
+    : m_engine(engine), m_worker(new QQmlSqlDatabaseWorker(this))
+{
+    m_thread.setObjectName(QStringLiteral("LocalStorage"));
+    m_worker->moveToThread(&m_thread);
+    m_thread.start();
+}
+
+QQmlSqlDatabaseExecutor::~QQmlSqlDatabaseExecutor()
+{
+    // The worker removes its connections on its own thread, and then stops it
+    QCoreApplication::postEvent(m_worker, new QQmlSqlTransactionEvent(QQmlSqlTransactionEvent::Close, 0));
+    m_thread.wait();
+    delete m_worker;
+    qDeleteAll(m_transactions);
+}
+
+void QQmlSqlDatabaseExecutor::start(QQmlSqlAsyncTransaction *transaction)
+{
+    m_transactions.append(transaction);
+
+    // Transactions on one database share the worker's connection to it, so
+    // the next one only begins once the previous one has finished
+    QList<QQmlSqlAsyncTransaction *> &queue = m_queues[transaction->connectionName];
+    queue.append(transaction);
+    if (queue.count() == 1)
+        postStart(transaction);
+}
+
+void QQmlSqlDatabaseExecutor::postStart(QQmlSqlAsyncTransaction *transaction)
+{
+    // As in the HTML5 API, the transaction callback is not called synchronously
+    QCoreApplication::postEvent(this, new QQmlSqlTransactionEvent(QQmlSqlTransactionEvent::Start, transaction));
+}
+
+bool QQmlSqlDatabaseExecutor::event(QEvent *e)
+{
+    switch (int(e->type())) {
+    case QQmlSqlTransactionEvent::Start:
+        begin(static_cast<QQmlSqlTransactionEvent *>(e)->transaction);
+        return true;
+    case QQmlSqlTransactionEvent::Executed:
+        executed(static_cast<QQmlSqlTransactionEvent *>(e)->transaction);
+        return true;
+    default:
+        break;
+    }
+    return QObject::event(e);
+}
+
+void QQmlSqlDatabaseExecutor::begin(QQmlSqlAsyncTransaction *transaction)
+{
+    Scope scope(QV8Engine::getV4(m_engine));
+    Scoped<QQmlSqlDatabaseWrapper> tx(scope, transaction->tx.value());
+    tx->inTransaction = true;
+
+    ScopedValue txValue(scope, tx.asReturnedValue());
+    ScopedValue result(scope);
+    QQmlError exception;
+    if (!call(transaction->callback, 1, txValue, txValue, result, &exception)) {
+        fail(transaction, SQLEXCEPTION_UNKNOWN_ERR, exception.description());
+        return;
+    }
+    flush(transaction);
+}
+
+void QQmlSqlDatabaseExecutor::flush(QQmlSqlAsyncTransaction *transaction)
+{
+    if (transaction->queue.isEmpty()) {
+        Scope scope(QV8Engine::getV4(m_engine));
+        Scoped<QQmlSqlDatabaseWrapper> tx(scope, transaction->tx.value());
+        tx->inTransaction = false;
+        transaction->step = QQmlSqlAsyncTransaction::Commit;
+    } else {
+        transaction->step = QQmlSqlAsyncTransaction::Execute;
+        transaction->statements.swap(transaction->queue);
+        transaction->callbacks.swap(transaction->queueCallbacks);
+        transaction->queue.clear();
+        transaction->queueCallbacks.clear();
+    }
+    post(transaction);
+}
+
+void QQmlSqlDatabaseExecutor::executed(QQmlSqlAsyncTransaction *transaction)
+{
+    ExecutionEngine *v4 = QV8Engine::getV4(m_engine);
+    Scope scope(v4);
+
+    switch (transaction->step) {
+    case QQmlSqlAsyncTransaction::Execute: {
+        if (transaction->error.isValid()) {
+            fail(transaction, SQLEXCEPTION_DATABASE_ERR, transaction->error.text());
+            return;
+        }
+
+        QList<QQmlSqlStatement> statements;
+        QList<QQmlSqlStatementCallbacks> callbacks;
+        statements.swap(transaction->statements);
+        callbacks.swap(transaction->callbacks);
+
+        // Statements after a failed one go back to the front of the queue
+        while (!statements.isEmpty() && !statements.last().executed) {
+            transaction->queue.prepend(statements.takeLast());
+            transaction->queueCallbacks.prepend(callbacks.takeLast());
+        }
+
+        ScopedValue txValue(scope, transaction->tx.value());
+        ScopedValue argument(scope);
+        ScopedValue result(scope);
+        Scoped<QQmlSqlDatabaseWrapper> rows(scope);
+        ScopedObject p(scope, databaseData(m_engine)->rowsProto.value());
+        QQmlError exception;
+        for (int ii = 0; ii < statements.count(); ++ii) {
+            const QQmlSqlStatement &statement = statements.at(ii);
+            if (statement.ok) {
+                if (callbacks.at(ii).callback.isUndefined())
+                    continue;
+                rows = new (v4->memoryManager) QQmlSqlDatabaseWrapper(m_engine);
+                rows->setPrototype(p.getPointer());
+                rows->type = QQmlSqlDatabaseWrapper::Rows;
+                rows->materialized = true;
+                rows->records = statement.records;
+                argument = qmlsqldatabase_resultSet(m_engine, statement, rows);
+                if (!call(callbacks.at(ii).callback, 2, txValue, argument, result, &exception)) {
+                    fail(transaction, SQLEXCEPTION_UNKNOWN_ERR, exception.description());
+                    return;
+                }
+            } else {
+                argument = errorObject(SQLEXCEPTION_DATABASE_ERR, statement.error.text());
+                if (!call(callbacks.at(ii).errorCallback, 2, txValue, argument, result, &exception)) {
+                    fail(transaction, SQLEXCEPTION_UNKNOWN_ERR, exception.description());
+                    return;
+                }
+                // Only an error callback returning false lets the transaction go on
+                if (!result->isBoolean() || result->booleanValue()) {
+                    fail(transaction, SQLEXCEPTION_DATABASE_ERR, statement.error.text());
+                    return;
+                }
+            }
+        }
+        flush(transaction);
+        break;
+    }
+    case QQmlSqlAsyncTransaction::Commit:
+        if (transaction->error.isValid()) {
+            transaction->errorCode = SQLEXCEPTION_DATABASE_ERR;
+            transaction->errorMessage = transaction->error.text();
+            reportError(transaction);
+        } else {
+            ScopedValue result(scope);
+            QQmlError exception;
+            if (!call(transaction->successCallback, 0, result, result, result, &exception))
+                QQmlEnginePrivate::warning(QQmlEnginePrivate::get(m_engine->engine()), exception);
+            finish(transaction);
+        }
+        break;
+    case QQmlSqlAsyncTransaction::Rollback:
+        reportError(transaction);
+        break;
+    }
+}
+
+void QQmlSqlDatabaseExecutor::fail(QQmlSqlAsyncTransaction *transaction, int code, const QString &message)
+{
+    Scope scope(QV8Engine::getV4(m_engine));
+    Scoped<QQmlSqlDatabaseWrapper> tx(scope, transaction->tx.value());
+    tx->inTransaction = false;
+
+    transaction->errorCode = code;
+    transaction->errorMessage = message;
+    transaction->queue.clear();
+    transaction->queueCallbacks.clear();
+
+    if (transaction->begun) {
+        transaction->step = QQmlSqlAsyncTransaction::Rollback;
+        post(transaction);
+    } else {
+        reportError(transaction);
+    }
+}
+
+void QQmlSqlDatabaseExecutor::reportError(QQmlSqlAsyncTransaction *transaction)
+{
+    Scope scope(QV8Engine::getV4(m_engine));
+    ScopedValue error(scope, errorObject(transaction->errorCode, transaction->errorMessage));
+    ScopedValue result(scope);
+    QQmlError exception;
+    if (!call(transaction->errorCallback, 1, error, error, result, &exception))
+        QQmlEnginePrivate::warning(QQmlEnginePrivate::get(m_engine->engine()), exception);
+    finish(transaction);
+}
+
+void QQmlSqlDatabaseExecutor::finish(QQmlSqlAsyncTransaction *transaction)
+{
+    Scope scope(QV8Engine::getV4(m_engine));
+    Scoped<QQmlSqlDatabaseWrapper> tx(scope, transaction->tx.value());
+    tx->inTransaction = false;
+    tx->transaction = 0;
+
+    m_transactions.removeOne(transaction);
+
+    QHash<QString, QList<QQmlSqlAsyncTransaction *> >::iterator it = m_queues.find(transaction->connectionName);
+    Q_ASSERT(it != m_queues.end() && it->first() == transaction);
+    it->removeFirst();
+    if (it->isEmpty())
+        m_queues.erase(it);
+    else
+        postStart(it->first());
+
+    delete transaction;
+}
+
+void QQmlSqlDatabaseExecutor::post(QQmlSqlAsyncTransaction *transaction)
+{
+    QCoreApplication::postEvent(m_worker, new QQmlSqlTransactionEvent(QQmlSqlTransactionEvent::Execute, transaction));
+}
+
+// Returns false, with the error in \a exception, if the function threw
+bool QQmlSqlDatabaseExecutor::call(const PersistentValue &function, int argc, const ValueRef arg0, const ValueRef arg1,
+                                   ValueRef result, QQmlError *exception)
+{
+    ExecutionEngine *v4 = QV8Engine::getV4(m_engine);
+    Scope scope(v4);
+
+    result = Primitive::undefinedValue();
+    Scoped<FunctionObject> f(scope, function.value());
+    if (!f)
+        return true;
+
+    ExecutionContext *ctx = v4->currentContext();
+    ScopedCallData callData(scope, argc);
+    callData->thisObject = m_engine->global();
+    if (argc > 0)
+        callData->args[0] = arg0;
+    if (argc > 1)
+        callData->args[1] = arg1;
+    result = f->call(callData);
+    if (v4->hasException) {
+        *exception = ExecutionEngine::catchExceptionAsQmlError(ctx);
+        return false;
+    }
+    return true;
+}
+
+ReturnedValue QQmlSqlDatabaseExecutor::errorObject(int code, const QString &message)
+{
+    ExecutionEngine *v4 = QV8Engine::getV4(m_engine);
+    Scope scope(v4);
+
+    Scoped<Object> error(scope, v4->newObject());
+    ScopedString s(scope);
+    ScopedValue v(scope);
+    error->put((s = v4->newIdentifier(QStringLiteral("code"))), (v = Primitive::fromInt32(code)));
+    error->put((s = v4->newIdentifier(QStringLiteral("message"))), (v = m_engine->toString(message)));
+    return error.asReturnedValue();
+}
+
+static ReturnedValue qmlsqldatabase_enqueue(QQmlSqlAsyncTransaction *transaction, const QQmlSqlStatement &statement,
+                                            const ValueRef callback, const ValueRef errorCallback)
+{
+    QQmlSqlStatementCallbacks callbacks;
+    if (callback->asFunctionObject())
+        callbacks.callback = callback;
+    if (errorCallback->asFunctionObject())
+        callbacks.errorCallback = errorCallback;
+
+    transaction->queue.append(statement);
+    transaction->queueCallbacks.append(callbacks);
+    return Encode::undefined();
+}
+
+static ReturnedValue qmlsqldatabase_transaction_async_shared(CallContext *ctx, bool readOnly)
+{
+    QV4::Scope scope(ctx);
+    QV4::Scoped<QQmlSqlDatabaseWrapper> r(scope, ctx->callData->thisObject.as<QQmlSqlDatabaseWrapper>());
+    if (!r || r->type != QQmlSqlDatabaseWrapper::Database)
+        V4THROW_REFERENCE("Not a SQLDatabase object");
+
+    QV8Engine *engine = ctx->engine->v8Engine;
+
+    ScopedValue callback(scope, ctx->argument(0));
+    if (!callback->asFunctionObject())
+        V4THROW_SQL(SQLEXCEPTION_UNKNOWN_ERR, QQmlEngine::tr("transaction: missing callback"));
+
+    Scoped<QQmlSqlDatabaseWrapper> w(scope, new (ctx->engine->memoryManager) QQmlSqlDatabaseWrapper(engine));
+    QV4::ScopedObject p(scope, databaseData(engine)->queryProto.value());
+    w->setPrototype(p.getPointer());
+    w->type = QQmlSqlDatabaseWrapper::Query;
+    w->database = r->database;
+    w->version = r->version;
+    w->readonly = readOnly;
+
+    QQmlSqlAsyncTransaction *transaction = new QQmlSqlAsyncTransaction;
+    transaction->connectionName = r->database.connectionName();
+    transaction->databaseFile = r->database.databaseName();
+    transaction->tx = w;
+    transaction->callback = callback;
+    ScopedValue v(scope);
+    if ((v = ctx->argument(1))->asFunctionObject())
+        transaction->errorCallback = v;
+    if ((v = ctx->argument(2))->asFunctionObject())
+        transaction->successCallback = v;
+    w->transaction = transaction;
+
+    databaseData(engine)->executor()->start(transaction);
+    return Encode::undefined();
+}
+
+static ReturnedValue qmlsqldatabase_transaction_async(CallContext *ctx)
+{
+    return qmlsqldatabase_transaction_async_shared(ctx, false);
+}
+
+static ReturnedValue qmlsqldatabase_read_transaction_async(CallContext *ctx)
+{
+    return qmlsqldatabase_transaction_async_shared(ctx, true);
+}
+
+QQmlSqlDatabaseExecutor *QQmlSqlDatabaseData::executor()
+{
+    if (!m_executor)
+        m_executor = new QQmlSqlDatabaseExecutor(m_engine);
+    return m_executor;
+}
+
 QQmlSqlDatabaseData::QQmlSqlDatabaseData(QV8Engine *engine)
+    : m_engine(engine), m_executor(0)
 {
     ExecutionEngine *v4 = QV8Engine::getV4(engine);
     Scope scope(v4);
@@ -484,6 +1184,15 @@ QQmlSqlDatabaseData::QQmlSqlDatabaseData(QV8Engine *engine)
         databaseProto = proto;
     }
 
+    {
+        Scoped<Object> proto(scope, v4->newObject());
+        proto->defineDefaultProperty(QStringLiteral("transaction"), qmlsqldatabase_transaction_async);
+        proto->defineDefaultProperty(QStringLiteral("readTransaction"), qmlsqldatabase_read_transaction_async);
+        proto->defineAccessorProperty(QStringLiteral("version"), qmlsqldatabase_version, 0);
+        proto->defineDefaultProperty(QStringLiteral("changeVersion"), qmlsqldatabase_changeVersion);
+        asyncDatabaseProto = proto;
+    }
+
     {
         Scoped<Object> proto(scope, v4->newObject());
         proto->defineDefaultProperty(QStringLiteral("executeSql"), qmlsqldatabase_executeSql);
@@ -520,6 +1229,7 @@ through the data.
 
     \list
     \li object \b{\l{#openDatabaseSync}{openDatabaseSync}}(string name, string version, string description, int estimated_size, jsobject callback(db))
+    \li object \b{\l{#openDatabase}{openDatabase}}(string name, string version, string description, int estimated_size, jsobject callback(db))
     \endlist
 
 
@@ -621,6 +1331,56 @@ It returns a results object, with the following properties:
 
 May throw exception with code property SQLException.DATABASE_ERR, SQLException.SYNTAX_ERR, or SQLException.UNKNOWN_ERR.
 
+If \e values is an array of arrays, the statement is executed once for each of them, which is
+much faster than calling \e executeSql repeatedly for bulk inserts. In that case \c rowsAffected
+is the total for all executions, and \c insertId is the id of the last row inserted.
+
+Prepared statements are cached by their SQL text, so executing the same statement again
+does not prepare it again.
+
+\section3 Asynchronous transactions
+
+Databases opened with \l{#openDatabase}{openDatabase()} conform to the Asynchronous API of the
+HTML5 Web Database API instead. Their statements are executed on a separate database thread,
+so that large writes do not block the user interface.
+
+\code
+db.transaction(function(tx) {
+    tx.executeSql('INSERT INTO Greeting VALUES(?, ?)', [ 'hello', 'world' ]);
+    tx.executeSql('SELECT * FROM Greeting', [], function(tx, results) {
+        console.log(results.rows.length);
+    });
+}, function(error) {
+    console.log("Transaction failed: " + error.message);
+}, function() {
+    console.log("Transaction committed");
+});
+\endcode
+
+\e {db.transaction(callback(tx), errorCallback(error), successCallback())} and
+\e {db.readTransaction(...)} return immediately, and \e callback is called later from the
+event loop. \e {tx.executeSql(statement, values, callback(tx, results), errorCallback(tx, error))}
+queues the statement and returns nothing; its \e callback receives the results once the statement
+has been executed, and may queue more statements. Once no statements are left, the transaction is
+committed and \e successCallback is called.
+
+If a statement fails, its \e errorCallback is called, and the transaction goes on only if it
+returns \c false. Otherwise, or if a callback throws an exception, the transaction is rolled back
+and \e errorCallback of the transaction is called with an object with \c code and \c message
+properties.
+
+Transactions on the same database run one after another, in the order they were requested. The
+callback of a transaction is not called before the previous one has been committed or rolled back.
+
+\e {db.changeVersion()} remains synchronous and uses the connection of the GUI thread, while the
+database thread has a second connection of its own. The same holds for the transactions of a
+database opened with \l{#openDatabaseSync}{openDatabaseSync()}. SQLite lets only one connection
+write at a time, so a synchronous transaction that writes while an asynchronous transaction on the
+same database is running would have to wait for it to finish, blocking the user interface. Instead,
+statements on the GUI thread wait at most 100 milliseconds for the lock and then fail with
+"database is locked", which throws an exception with code \c SQLException.DATABASE_ERR. Reading
+is not affected. Call \e changeVersion() and synchronous writes from the success or error callback
+of the asynchronous transactions to avoid this.
 
 \section1 Method Documentation
 
@@ -641,6 +1401,14 @@ Opens or creates a local storage sql database by the given parameters.
 
 Returns the created database object.
 
+\target openDatabase
+\code
+object openDatabase(string name, string version, string description, int estimated_size, jsobject callback(db))
+\endcode
+
+Opens or creates a local storage sql database, like \l{#openDatabaseSync}{openDatabaseSync()}, but
+returns a database object whose transactions are asynchronous.
+
 */
 class QQuickLocalStorage : public QObject
 {
@@ -653,9 +1421,23 @@ public:
     }
 
    Q_INVOKABLE void openDatabaseSync(QQmlV4Function* args);
+   Q_INVOKABLE void openDatabase(QQmlV4Function* args);
+
+private:
+   void open(QQmlV4Function *args, bool async);
 };
 
 void QQuickLocalStorage::openDatabaseSync(QQmlV4Function *args)
+{
+    open(args, false);
+}
+
+void QQuickLocalStorage::openDatabase(QQmlV4Function *args)
+{
+    open(args, true);
+}
+
+void QQuickLocalStorage::open(QQmlV4Function *args, bool async)
 {
 #ifndef QT_NO_SETTINGS
     QV8Engine *engine = args->engine();
@@ -710,13 +1492,17 @@ void QQuickLocalStorage::openDatabaseSync(QQmlV4Function *args)
                 version = ini.value(QLatin1String("Version")).toString();
             }
             database.setDatabaseName(basename+QLatin1String(".sqlite"));
+            // Don't block the GUI thread for SQLite's default of five seconds
+            // while an asynchronous transaction holds the write lock
+            database.setConnectOptions(QStringLiteral("QSQLITE_BUSY_TIMEOUT=%1").arg(LOCALSTORAGE_GUI_BUSY_TIMEOUT));
         }
         if (!database.isOpen())
             database.open();
     }
 
     QV4::Scoped<QQmlSqlDatabaseWrapper> db(scope, new (ctx->engine->memoryManager) QQmlSqlDatabaseWrapper(engine));
-    QV4::ScopedObject p(scope, databaseData(engine)->databaseProto.value());
+    QV4::ScopedObject p(scope, async ? databaseData(engine)->asyncDatabaseProto.value()
+                                     : databaseData(engine)->databaseProto.value());
     db->setPrototype(p.getPointer());
     db->database = database;
     db->version = version;
@@ -55,11 +55,15 @@
 #include <QXmlQuery>
 #include <QXmlResultItems>
 #include <QXmlNodeModelIndex>
+#include <QXmlStreamReader>
+#include <QRegExp>
 #include <QBuffer>
 #include <QNetworkRequest>
 #include <QNetworkReply>
 #include <QTimer>
 #include <QMutex>
+#include <QElapsedTimer>
+#include <qnumeric.h>
 
 #include <private/qabstractitemmodel_p.h>
 
@@ -73,6 +77,9 @@ typedef QPair<int, int> QQuickXmlListRange;
 
 #define XMLLISTMODEL_CLEAR_ID 0
 
+// how often rows parsed by the streaming query are handed to the model, in ms
+#define XMLLISTMODEL_STREAM_INTERVAL 100
+
 /*!
     \qmlmodule QtQuick.XmlListModel 2
     \title Qt Quick XmlListModel QML Types
@@ -165,6 +172,605 @@ struct XmlQueryJob
     QString prefix;
 };
 
+/*
+    QQuickXmlStreamQuery evaluates the common subset of XPath used with
+    XmlListModel in a single pass over the document using QXmlStreamReader,
+    rather than running a count query plus one QXmlQuery per role over an
+    in-memory copy of the results.
+
+    The base query is a sequence of '/' and '//' element steps.  Role queries
+    are relative child steps, optionally followed by an @attribute step, and
+    must end in string() or number().  Each element step is a name test or
+    '*', followed by any number of [@attr] or [@attr='value'] predicates and
+    an optional final [n] predicate.  Namespace declarations may only declare
+    prefixes and the default element namespace.
+
+    compile() returns false for anything outside of this subset, in which case
+    the job is run through QXmlQuery as before.
+*/
+struct QQuickXmlStreamAttributeTest
+{
+    QQuickXmlStreamAttributeTest() : hasValue(false) {}
+
+    bool matches(const QXmlStreamAttributes &attributes) const
+    {
+        if (!attributes.hasAttribute(namespaceUri, name))
+            return false;
+        return !hasValue || attributes.value(namespaceUri, name) == value;
+    }
+
+    QString namespaceUri;
+    QString name;
+    QString value;
+    bool hasValue;
+};
+
+struct QQuickXmlStreamStep
+{
+    QQuickXmlStreamStep() : descendant(false), anyName(false), position(0) {}
+
+    bool matches(const QXmlStreamReader &reader) const
+    {
+        if (!anyName && (reader.name() != name || reader.namespaceUri() != namespaceUri))
+            return false;
+        if (!attributeTests.isEmpty()) {
+            const QXmlStreamAttributes attributes = reader.attributes();
+            for (int i = 0; i < attributeTests.count(); ++i) {
+                if (!attributeTests.at(i).matches(attributes))
+                    return false;
+            }
+        }
+        return true;
+    }
+
+    bool descendant;
+    bool anyName;
+    QString namespaceUri;
+    QString name;
+    QList<QQuickXmlStreamAttributeTest> attributeTests;
+    int position;
+};
+
+struct QQuickXmlStreamRole
+{
+    enum Type { Invalid, String, Number };
+
+    QQuickXmlStreamRole() : type(Invalid), hasAttribute(false) {}
+
+    QList<QQuickXmlStreamStep> steps;
+    QString attributeNamespaceUri;
+    QString attributeName;
+    Type type;
+    bool hasAttribute;
+};
+
+// A row whose element has been opened but not yet closed.
+struct QQuickXmlStreamRow
+{
+    int index;
+    int depth;
+    quint64 found;              // roles which have a value
+    quint64 collecting;         // roles collecting the text of an open element
+    QVector<quint64> matched;   // per relative depth, roles whose steps matched so far
+    QVector<int> positions;     // per relative depth and role, for [n] predicates
+    QVector<int> collectDepth;
+    QVector<QString> text;
+};
+
+class QQuickXmlStreamQuery
+{
+public:
+    QQuickXmlStreamQuery();
+
+    bool compile(const XmlQueryJob &job);
+
+    bool readNext(QXmlStreamReader *reader);
+
+    int completedRowCount() const { return m_completedRows; }
+    void takeRows(int from, int to, QList<QList<QVariant> > *data);
+    QStringList keyRoleResults() const { return m_keys; }
+    QString errorString() const { return m_errorString; }
+
+private:
+    struct Level
+    {
+        quint64 done;       // bit 0 is the document, bit j + 1 step j of the base query
+        quint64 ancestors;  // done of this level and all of its ancestors
+    };
+
+    bool parseNamespaces(const QString &declarations);
+    bool parseBaseQuery(const QString &query);
+    bool parseRoleQuery(const QString &query, QQuickXmlStreamRole *role) const;
+    bool parseStep(const QString &query, int *pos, QQuickXmlStreamStep *step) const;
+    bool resolvePrefix(const QString &prefix, bool element, QString *namespaceUri) const;
+
+    void startElement(const QXmlStreamReader &reader);
+    void endElement();
+    void characters(const QStringRef &text);
+    void startRow(const QXmlStreamReader &reader, int depth);
+    void matchRoles(QQuickXmlStreamRow *row, const QXmlStreamReader &reader, int depth);
+    void resolveRole(QQuickXmlStreamRow *row, int role, const QXmlStreamReader &reader, int depth);
+    void finishRow(const QQuickXmlStreamRow &row);
+
+    QList<QQuickXmlStreamStep> m_steps;
+    QList<QQuickXmlStreamRole> m_roles;
+    QList<int> m_keyRoles;
+    QHash<QString, QString> m_namespaces;
+    QString m_defaultNamespace;
+    quint64 m_validRoles;
+    bool m_stepPositions;
+    bool m_rolePositions;
+
+    QVector<Level> m_levels;
+    QVector<int> m_positions;
+    QVector<QQuickXmlStreamRow> m_activeRows;
+    QVector<QVector<QVariant> > m_rows;
+    QStringList m_keys;
+    QString m_errorString;
+    int m_completedRows;
+};
+
+static inline void skipSpaces(const QString &s, int *pos)
+{
+    while (*pos < s.length() && s.at(*pos).isSpace())
+        ++*pos;
+}
+
+static inline bool isNameStartChar(QChar c)
+{
+    return c.isLetter() || c == QLatin1Char('_');
+}
+
+static inline bool isNameChar(QChar c)
+{
+    return c.isLetterOrNumber() || c == QLatin1Char('_') || c == QLatin1Char('-') || c == QLatin1Char('.');
+}
+
+static bool parseName(const QString &s, int *pos, QString *prefix, QString *localName)
+{
+    if (*pos >= s.length() || !isNameStartChar(s.at(*pos)))
+        return false;
+    int start = *pos;
+    while (++*pos < s.length() && isNameChar(s.at(*pos))) {}
+    *localName = s.mid(start, *pos - start);
+    prefix->clear();
+
+    // an axis such as parent:: is left for the caller to reject
+    if (*pos + 1 < s.length() && s.at(*pos) == QLatin1Char(':') && isNameStartChar(s.at(*pos + 1))) {
+        *prefix = *localName;
+        start = ++*pos;
+        while (++*pos < s.length() && isNameChar(s.at(*pos))) {}
+        *localName = s.mid(start, *pos - start);
+    }
+    return true;
+}
+
+static bool parseLiteral(const QString &s, int *pos, QString *value)
+{
+    if (*pos >= s.length() || (s.at(*pos) != QLatin1Char('\'') && s.at(*pos) != QLatin1Char('"')))
+        return false;
+    const int end = s.indexOf(s.at(*pos), *pos + 1);
+    if (end == -1)
+        return false;
+    *value = s.mid(*pos + 1, end - *pos - 1);
+    *pos = end + 1;
+    return true;
+}
+
+static bool parseResultType(const QString &s, int pos, QQuickXmlStreamRole::Type *type)
+{
+    const QString rest = s.mid(pos).trimmed();
+    if (rest == QLatin1String("string()"))
+        *type = QQuickXmlStreamRole::String;
+    else if (rest == QLatin1String("number()"))
+        *type = QQuickXmlStreamRole::Number;
+    else
+        return false;
+    return true;
+}
+
+QQuickXmlStreamQuery::QQuickXmlStreamQuery()
+    : m_validRoles(0), m_stepPositions(false), m_rolePositions(false), m_completedRows(0)
+{
+    Level document;
+    document.done = 1;
+    document.ancestors = 1;
+    m_levels.append(document);
+}
+
+bool QQuickXmlStreamQuery::compile(const XmlQueryJob &job)
+{
+    if (!parseNamespaces(job.namespaces) || !parseBaseQuery(job.query))
+        return false;
+
+    // roles are tracked in 64 bit masks
+    if (job.roleQueries.count() > 64)
+        return false;
+
+    for (int i = 0; i < job.roleQueries.count(); ++i) {
+        QQuickXmlStreamRole role;
+        if (!job.roleQueries.at(i).isEmpty()) {
+            if (!parseRoleQuery(job.roleQueries.at(i), &role))
+                return false;
+            m_validRoles |= Q_UINT64_C(1) << i;
+            for (int j = 0; j < role.steps.count(); ++j)
+                m_rolePositions |= role.steps.at(j).position > 0;
+        }
+        m_roles.append(role);
+    }
+
+    for (int i = 0; i < job.keyRoleQueries.count(); ++i)
+        m_keyRoles.append(job.roleQueries.indexOf(job.keyRoleQueries.at(i)));
+
+    return true;
+}
+
+bool QQuickXmlStreamQuery::parseNamespaces(const QString &declarations)
+{
+    QRegExp defaultNamespace(QLatin1String("\\s*declare\\s+default\\s+element\\s+namespace\\s+(?:'([^']*)'|\"([^\"]*)\")\\s*;"));
+    QRegExp prefixNamespace(QLatin1String("\\s*declare\\s+namespace\\s+([A-Za-z_][A-Za-z0-9_.-]*)\\s*=\\s*(?:'([^']*)'|\"([^\"]*)\")\\s*;"));
+
+    int pos = 0;
+    while (true) {
+        skipSpaces(declarations, &pos);
+        if (pos >= declarations.length())
+            return true;
+
+        if (defaultNamespace.indexIn(declarations, pos, QRegExp::CaretAtOffset) == pos) {
+            m_defaultNamespace = defaultNamespace.cap(1) + defaultNamespace.cap(2);
+            pos += defaultNamespace.matchedLength();
+        } else if (prefixNamespace.indexIn(declarations, pos, QRegExp::CaretAtOffset) == pos) {
+            m_namespaces.insert(prefixNamespace.cap(1), prefixNamespace.cap(2) + prefixNamespace.cap(3));
+            pos += prefixNamespace.matchedLength();
+        } else {
+            return false;
+        }
+    }
+}
+
+bool QQuickXmlStreamQuery::resolvePrefix(const QString &prefix, bool element, QString *namespaceUri) const
+{
+    if (prefix.isEmpty()) {
+        *namespaceUri = element ? m_defaultNamespace : QString();
+        return true;
+    }
+    if (prefix == QLatin1String("xml")) {
+        *namespaceUri = QLatin1String("http://www.w3.org/XML/1998/namespace");
+        return true;
+    }
+    QHash<QString, QString>::const_iterator it = m_namespaces.constFind(prefix);
+    if (it == m_namespaces.constEnd())
+        return false;
+    *namespaceUri = *it;
+    return true;
+}
+
+bool QQuickXmlStreamQuery::parseStep(const QString &query, int *pos, QQuickXmlStreamStep *step) const
+{
+    skipSpaces(query, pos);
+    if (*pos < query.length() && query.at(*pos) == QLatin1Char('*')) {
+        step->anyName = true;
+        ++*pos;
+    } else {
+        QString prefix;
+        if (!parseName(query, pos, &prefix, &step->name) || !resolvePrefix(prefix, true, &step->namespaceUri))
+            return false;
+    }
+    skipSpaces(query, pos);
+
+    while (*pos < query.length() && query.at(*pos) == QLatin1Char('[')) {
+        // a predicate following [n] would filter a different sequence
+        if (step->position > 0)
+            return false;
+
+        ++*pos;
+        skipSpaces(query, pos);
+        if (*pos < query.length() && query.at(*pos).isDigit()) {
+            const int start = *pos;
+            while (*pos < query.length() && query.at(*pos).isDigit())
+                ++*pos;
+            step->position = query.mid(start, *pos - start).toInt();
+            if (step->position <= 0)
+                return false;
+        } else if (*pos < query.length() && query.at(*pos) == QLatin1Char('@')) {
+            ++*pos;
+            QQuickXmlStreamAttributeTest test;
+            QString prefix;
+            if (!parseName(query, pos, &prefix, &test.name) || !resolvePrefix(prefix, false, &test.namespaceUri))
+                return false;
+            skipSpaces(query, pos);
+            if (*pos < query.length() && query.at(*pos) == QLatin1Char('=')) {
+                ++*pos;
+                skipSpaces(query, pos);
+                if (!parseLiteral(query, pos, &test.value))
+                    return false;
+                test.hasValue = true;
+                skipSpaces(query, pos);
+            }
+            step->attributeTests.append(test);
+        } else {
+            return false;
+        }
+
+        if (*pos >= query.length() || query.at(*pos) != QLatin1Char(']'))
+            return false;
+        ++*pos;
+        skipSpaces(query, pos);
+    }
+    return true;
+}
+
+bool QQuickXmlStreamQuery::parseBaseQuery(const QString &query)
+{
+    int pos = 0;
+    skipSpaces(query, &pos);
+    while (pos < query.length()) {
+        if (query.at(pos) != QLatin1Char('/'))
+            return false;
+        QQuickXmlStreamStep step;
+        if (++pos < query.length() && query.at(pos) == QLatin1Char('/')) {
+            step.descendant = true;
+            ++pos;
+        }
+        if (!parseStep(query, &pos, &step))
+            return false;
+        m_stepPositions |= step.position > 0;
+        m_steps.append(step);
+    }
+
+    // steps are tracked in 64 bit masks, with bit 0 taken by the document
+    return !m_steps.isEmpty() && m_steps.count() < 64;
+}
+
+bool QQuickXmlStreamQuery::parseRoleQuery(const QString &query, QQuickXmlStreamRole *role) const
+{
+    int pos = 0;
+    while (true) {
+        skipSpaces(query, &pos);
+        if (parseResultType(query, pos, &role->type))
+            return true;
+
+        if (pos < query.length() && query.at(pos) == QLatin1Char('@')) {
+            ++pos;
+            QString prefix;
+            if (!parseName(query, &pos, &prefix, &role->attributeName)
+                    || !resolvePrefix(prefix, false, &role->attributeNamespaceUri)) {
+                return false;
+            }
+            role->hasAttribute = true;
+            skipSpaces(query, &pos);
+            if (pos >= query.length() || query.at(pos) != QLatin1Char('/'))
+                return false;
+            return parseResultType(query, pos + 1, &role->type);
+        }
+
+        QQuickXmlStreamStep step;
+        if (!parseStep(query, &pos, &step))
+            return false;
+        role->steps.append(step);
+        if (pos >= query.length() || query.at(pos) != QLatin1Char('/'))
+            return false;
+        if (++pos < query.length() && query.at(pos) == QLatin1Char('/'))
+            return false;
+    }
+}
+
+bool QQuickXmlStreamQuery::readNext(QXmlStreamReader *reader)
+{
+    switch (reader->readNext()) {
+    case QXmlStreamReader::StartElement:
+        startElement(*reader);
+        break;
+    case QXmlStreamReader::EndElement:
+        endElement();
+        break;
+    case QXmlStreamReader::Characters:
+        if (!m_activeRows.isEmpty())
+            characters(reader->text());
+        break;
+    case QXmlStreamReader::EndDocument:
+        return false;
+    case QXmlStreamReader::Invalid:
+        // keep the rows read before the document turned out to be malformed,
+        // but report the document as a whole as an error
+        m_errorString = reader->errorString();
+        m_rows.resize(m_completedRows);
+        while (m_keys.count() > m_completedRows)
+            m_keys.removeLast();
+        m_activeRows.clear();
+        return false;
+    default:
+        break;
+    }
+    return true;
+}
+
+void QQuickXmlStreamQuery::startElement(const QXmlStreamReader &reader)
+{
+    const int depth = m_levels.count();
+    const int stepCount = m_steps.count();
+    const Level parent = m_levels.last();
+
+    if (m_stepPositions) {
+        m_positions.resize((depth + 1) * stepCount);
+        for (int j = 0; j < stepCount; ++j)
+            m_positions[depth * stepCount + j] = 0;
+    }
+
+    Level level;
+    level.done = 0;
+    for (int j = 0; j < stepCount; ++j) {
+        const QQuickXmlStreamStep &step = m_steps.at(j);
+        const quint64 context = step.descendant ? parent.ancestors : parent.done;
+        if (!(context & (Q_UINT64_C(1) << j)) || !step.matches(reader))
+            continue;
+        if (step.position > 0 && ++m_positions[(depth - 1) * stepCount + j] != step.position)
+            continue;
+        level.done |= Q_UINT64_C(1) << (j + 1);
+    }
+    level.ancestors = parent.ancestors | level.done;
+    m_levels.append(level);
+
+    for (int i = 0; i < m_activeRows.count(); ++i)
+        matchRoles(&m_activeRows[i], reader, depth);
+
+    if (level.done & (Q_UINT64_C(1) << stepCount))
+        startRow(reader, depth);
+}
+
+void QQuickXmlStreamQuery::endElement()
+{
+    const int depth = m_levels.count() - 1;
+
+    for (int i = m_activeRows.count() - 1; i >= 0; --i) {
+        QQuickXmlStreamRow &row = m_activeRows[i];
+        if (row.collecting) {
+            for (int r = 0; r < m_roles.count(); ++r) {
+                if (row.collectDepth.at(r) == depth)
+                    row.collecting &= ~(Q_UINT64_C(1) << r);
+            }
+        }
+        if (row.depth == depth) {
+            finishRow(row);
+            m_activeRows.remove(i);
+        } else {
+            row.matched.removeLast();
+        }
+    }
+
+    m_completedRows = m_activeRows.isEmpty() ? m_rows.count() : m_activeRows.first().index;
+    m_levels.removeLast();
+}
+
+void QQuickXmlStreamQuery::characters(const QStringRef &text)
+{
+    for (int i = 0; i < m_activeRows.count(); ++i) {
+        QQuickXmlStreamRow &row = m_activeRows[i];
+        for (int r = 0; r < m_roles.count() && (row.collecting >> r); ++r) {
+            if (row.collecting & (Q_UINT64_C(1) << r))
+                row.text[r].append(text);
+        }
+    }
+}
+
+void QQuickXmlStreamQuery::startRow(const QXmlStreamReader &reader, int depth)
+{
+    const int roleCount = m_roles.count();
+
+    QQuickXmlStreamRow row;
+    row.index = m_rows.count();
+    row.depth = depth;
+    row.found = 0;
+    row.collecting = 0;
+    row.matched.append(m_validRoles);
+    if (m_rolePositions)
+        row.positions.fill(0, roleCount);
+    row.collectDepth.fill(-1, roleCount);
+    row.text.resize(roleCount);
+
+    for (int r = 0; r < roleCount; ++r) {
+        if ((m_validRoles & (Q_UINT64_C(1) << r)) && m_roles.at(r).steps.isEmpty())
+            resolveRole(&row, r, reader, depth);
+    }
+
+    m_rows.append(QVector<QVariant>());
+    if (!m_keyRoles.isEmpty())
+        m_keys.append(QString());
+    m_activeRows.append(row);
+}
+
+void QQuickXmlStreamQuery::matchRoles(QQuickXmlStreamRow *row, const QXmlStreamReader &reader, int depth)
+{
+    const int roleCount = m_roles.count();
+    const int relativeDepth = depth - row->depth;
+    const quint64 context = row->matched.last() & ~row->found;
+
+    if (m_rolePositions) {
+        row->positions.resize((relativeDepth + 1) * roleCount);
+        for (int r = 0; r < roleCount; ++r)
+            row->positions[relativeDepth * roleCount + r] = 0;
+    }
+
+    quint64 matched = 0;
+    for (int r = 0; r < roleCount && (context >> r); ++r) {
+        if (!(context & (Q_UINT64_C(1) << r)))
+            continue;
+        const QQuickXmlStreamRole &role = m_roles.at(r);
+        if (role.steps.count() < relativeDepth)
+            continue;
+        const QQuickXmlStreamStep &step = role.steps.at(relativeDepth - 1);
+        if (!step.matches(reader))
+            continue;
+        if (step.position > 0 && ++row->positions[(relativeDepth - 1) * roleCount + r] != step.position)
+            continue;
+        matched |= Q_UINT64_C(1) << r;
+        if (role.steps.count() == relativeDepth)
+            resolveRole(row, r, reader, depth);
+    }
+    row->matched.append(matched);
+}
+
+void QQuickXmlStreamQuery::resolveRole(QQuickXmlStreamRow *row, int r, const QXmlStreamReader &reader, int depth)
+{
+    const QQuickXmlStreamRole &role = m_roles.at(r);
+    if (role.hasAttribute) {
+        // keep looking at later matches if this element lacks the attribute
+        const QXmlStreamAttributes attributes = reader.attributes();
+        if (!attributes.hasAttribute(role.attributeNamespaceUri, role.attributeName))
+            return;
+        row->text[r] = attributes.value(role.attributeNamespaceUri, role.attributeName).toString();
+        row->found |= Q_UINT64_C(1) << r;
+    } else {
+        row->found |= Q_UINT64_C(1) << r;
+        row->collecting |= Q_UINT64_C(1) << r;
+        row->collectDepth[r] = depth;
+    }
+}
+
+void QQuickXmlStreamQuery::finishRow(const QQuickXmlStreamRow &row)
+{
+    QVector<QVariant> values(m_roles.count());
+    for (int r = 0; r < m_roles.count(); ++r) {
+        const QQuickXmlStreamRole &role = m_roles.at(r);
+        if (role.type == QQuickXmlStreamRole::Invalid)
+            continue;
+        if (!(row.found & (Q_UINT64_C(1) << r))) {
+            // matches the empty string QXmlQuery returns for an empty sequence
+            values[r] = QString();
+        } else if (role.type == QQuickXmlStreamRole::Number) {
+            // an element that is present but empty gives NaN, like number() on ""
+            bool ok = false;
+            const double number = row.text.at(r).trimmed().toDouble(&ok);
+            values[r] = ok ? number : qQNaN();
+        } else {
+            values[r] = row.text.at(r);
+        }
+    }
+
+    if (!m_keyRoles.isEmpty()) {
+        QString key;
+        for (int i = 0; i < m_keyRoles.count(); ++i)
+            key += values.value(m_keyRoles.at(i)).toString();
+        m_keys[row.index] = key;
+    }
+    m_rows[row.index] = values;
+}
+
+void QQuickXmlStreamQuery::takeRows(int from, int to, QList<QList<QVariant> > *data)
+{
+    for (int r = 0; r < m_roles.count(); ++r) {
+        QList<QVariant> column;
+        column.reserve(to - from);
+        for (int i = from; i < to; ++i)
+            column.append(m_rows.at(i).value(r));
+        data->append(column);
+    }
+
+    // the model keeps its own copy from here on
+    for (int i = from; i < to; ++i)
+        m_rows[i].clear();
+}
+
 
 class QQuickXmlQueryEngine;
 class QQuickXmlQueryThreadObject : public QObject
@@ -197,6 +803,7 @@ public:
 
 signals:
     void queryCompleted(const QQuickXmlQueryResult &);
+    void queryRowsParsed(const QQuickXmlQueryResult &);
     void error(void*, const QString&);
 
 protected:
@@ -204,9 +811,11 @@ protected:
 
 private:
     void processQuery(XmlQueryJob *job);
+    bool doStreamQueryJob(XmlQueryJob *job, QQuickXmlStreamQuery *query, QQuickXmlQueryResult *currentResult);
     void doQueryJob(XmlQueryJob *job, QQuickXmlQueryResult *currentResult);
     void doSubQueryJob(XmlQueryJob *job, QQuickXmlQueryResult *currentResult);
     void getValuesOfKeyRoles(const XmlQueryJob& currentJob, QStringList *values, QXmlQuery *query) const;
+    void diffKeyRoleResults(const XmlQueryJob &currentJob, const QStringList &keyRoleResults, QQuickXmlQueryResult *currentResult) const;
     void addIndexToRangeList(QList<QQuickXmlListRange> *ranges, int index) const;
 
     QMutex m_mutex;
@@ -279,7 +888,7 @@ int QQuickXmlQueryEngine::doQuery(QString query, QString namespaces, QByteArray
     XmlQueryJob job;
     job.queryId = m_queryIds.load();
     job.data = data;
-    job.query = QLatin1String("doc($src)") + query;
+    job.query = query;
     job.namespaces = namespaces;
     job.keyRoleResultsCache = keyRoleResultsCache;
 
@@ -362,8 +971,15 @@ void QQuickXmlQueryEngine::processQuery(XmlQueryJob *job)
 {
     QQuickXmlQueryResult result;
     result.queryId = job->queryId;
-    doQueryJob(job, &result);
-    doSubQueryJob(job, &result);
+
+    QQuickXmlStreamQuery streamQuery;
+    if (streamQuery.compile(*job)) {
+        if (!doStreamQueryJob(job, &streamQuery, &result))
+            return;
+    } else {
+        doQueryJob(job, &result);
+        doSubQueryJob(job, &result);
+    }
 
     {
         QMutexLocker ml(&m_mutex);
@@ -375,6 +991,45 @@ void QQuickXmlQueryEngine::processQuery(XmlQueryJob *job)
     }
 }
 
+bool QQuickXmlQueryEngine::doStreamQueryJob(XmlQueryJob *currentJob, QQuickXmlStreamQuery *query, QQuickXmlQueryResult *currentResult)
+{
+    Q_ASSERT(currentJob->queryId != -1);
+
+    // Without key roles the model is rebuilt from scratch anyway, so rows can
+    // be handed over while the rest of the document is still being parsed.
+    const bool incremental = currentJob->keyRoleQueries.isEmpty();
+    int deliveredRows = 0;
+
+    QXmlStreamReader reader(currentJob->data);
+    QElapsedTimer timer;
+    timer.start();
+
+    while (query->readNext(&reader)) {
+        if (timer.elapsed() < XMLLISTMODEL_STREAM_INTERVAL)
+            continue;
+        timer.restart();
+
+        QMutexLocker ml(&m_mutex);
+        if (m_cancelledJobs.remove(currentJob->queryId))
+            return false;
+        if (incremental && query->completedRowCount() > deliveredRows) {
+            QQuickXmlQueryResult rows;
+            rows.queryId = currentJob->queryId;
+            rows.size = query->completedRowCount() - deliveredRows;
+            query->takeRows(deliveredRows, query->completedRowCount(), &rows.data);
+            deliveredRows = query->completedRowCount();
+            emit queryRowsParsed(rows);
+        }
+    }
+
+    // Once rows have been delivered the result only holds the remaining ones.
+    currentResult->size = query->completedRowCount() - deliveredRows;
+    query->takeRows(deliveredRows, query->completedRowCount(), &currentResult->data);
+    diffKeyRoleResults(*currentJob, query->keyRoleResults(), currentResult);
+    currentResult->errorString = query->errorString();
+    return true;
+}
+
 void QQuickXmlQueryEngine::doQueryJob(XmlQueryJob *currentJob, QQuickXmlQueryResult *currentResult)
 {
     Q_ASSERT(currentJob->queryId != -1);
@@ -384,7 +1039,7 @@ void QQuickXmlQueryEngine::doQueryJob(XmlQueryJob *currentJob, QQuickXmlQueryRes
     QBuffer buffer(&currentJob->data);
     buffer.open(QIODevice::ReadOnly);
     query.bindVariable(QLatin1String("src"), &buffer);
-    query.setQuery(currentJob->namespaces + currentJob->query);
+    query.setQuery(currentJob->namespaces + QLatin1String("doc($src)") + currentJob->query);
     query.evaluateTo(&r);
 
     //always need a single root element
@@ -443,31 +1098,20 @@ void QQuickXmlQueryEngine::addIndexToRangeList(QList<QQuickXmlListRange> *ranges
         ranges->append(qMakePair(index, 1));
 }
 
-void QQuickXmlQueryEngine::doSubQueryJob(XmlQueryJob *currentJob, QQuickXmlQueryResult *currentResult)
+void QQuickXmlQueryEngine::diffKeyRoleResults(const XmlQueryJob &currentJob, const QStringList &keyRoleResults, QQuickXmlQueryResult *currentResult) const
 {
-    Q_ASSERT(currentJob->queryId != -1);
-
-    QBuffer b(&currentJob->data);
-    b.open(QIODevice::ReadOnly);
-
-    QXmlQuery subquery;
-    subquery.bindVariable(QLatin1String("inputDocument"), &b);
-
-    QStringList keyRoleResults;
-    getValuesOfKeyRoles(*currentJob, &keyRoleResults, &subquery);
-
     // See if any values of key roles have been inserted or removed.
 
-    if (currentJob->keyRoleResultsCache.isEmpty()) {
+    if (currentJob.keyRoleResultsCache.isEmpty()) {
         currentResult->inserted << qMakePair(0, currentResult->size);
     } else {
-        if (keyRoleResults != currentJob->keyRoleResultsCache) {
+        if (keyRoleResults != currentJob.keyRoleResultsCache) {
             QStringList temp;
-            for (int i=0; i<currentJob->keyRoleResultsCache.count(); i++) {
-                if (!keyRoleResults.contains(currentJob->keyRoleResultsCache[i]))
+            for (int i=0; i<currentJob.keyRoleResultsCache.count(); i++) {
+                if (!keyRoleResults.contains(currentJob.keyRoleResultsCache[i]))
                     addIndexToRangeList(&currentResult->removed, i);
                 else
-                    temp << currentJob->keyRoleResultsCache[i];
+                    temp << currentJob.keyRoleResultsCache[i];
             }
             for (int i=0; i<keyRoleResults.count(); i++) {
                 if (temp.count() == i || keyRoleResults[i] != temp[i]) {
@@ -478,6 +1122,21 @@ void QQuickXmlQueryEngine::doSubQueryJob(XmlQueryJob *currentJob, QQuickXmlQuery
         }
     }
     currentResult->keyRoleResultsCache = keyRoleResults;
+}
+
+void QQuickXmlQueryEngine::doSubQueryJob(XmlQueryJob *currentJob, QQuickXmlQueryResult *currentResult)
+{
+    Q_ASSERT(currentJob->queryId != -1);
+
+    QBuffer b(&currentJob->data);
+    b.open(QIODevice::ReadOnly);
+
+    QXmlQuery subquery;
+    subquery.bindVariable(QLatin1String("inputDocument"), &b);
+
+    QStringList keyRoleResults;
+    getValuesOfKeyRoles(*currentJob, &keyRoleResults, &subquery);
+    diffKeyRoleResults(*currentJob, keyRoleResults, currentResult);
 
     // Get the new values for each role.
     //### we might be able to condense even further (query for everything in one go)
@@ -541,7 +1200,7 @@ public:
     QQuickXmlListModelPrivate()
         : isComponentComplete(true), size(-1), highestRole(Qt::UserRole)
         , reply(0), status(QQuickXmlListModel::Null), progress(0.0)
-        , queryId(-1), roleObjects(), redirectCount(0) {}
+        , queryId(-1), receivingRows(false), roleObjects(), redirectCount(0) {}
 
 
     void notifyQueryStarted(bool remoteSource) {
@@ -562,6 +1221,22 @@ public:
         }
     }
 
+    bool appendRows(const QQuickXmlQueryResult &result) {
+        Q_Q(QQuickXmlListModel);
+        if (result.size <= 0)
+            return false;
+        q->beginInsertRows(QModelIndex(), size, size + result.size - 1);
+        if (data.isEmpty()) {
+            data = result.data;
+        } else {
+            for (int i = 0; i < data.count() && i < result.data.count(); ++i)
+                data[i] += result.data.at(i);
+        }
+        size += result.size;
+        q->endInsertRows();
+        return true;
+    }
+
     bool isComponentComplete;
     QUrl src;
     QString xml;
@@ -577,6 +1252,7 @@ public:
     QString errorString;
     qreal progress;
     int queryId;
+    bool receivingRows;
     QStringList keyRoleResultsCache;
     QList<QQuickXmlListModelRole *> roleObjects;
 
@@ -687,8 +1363,34 @@ void QQuickXmlListModelPrivate::clear_role(QQmlListProperty<QQuickXmlListModelRo
 
     The XmlListModel data is loaded asynchronously, and \l status
     is set to \c XmlListModel.Ready when loading is complete.
-    Note this means when XmlListModel is used for a view, the view is not
-    populated until the model is loaded.
+    Unless the queries fall outside of the subset described in
+    \l {Streaming queries}, items are added to the model while the XML data
+    is still being parsed, so a view can start showing items before the
+    status becomes \c XmlListModel.Ready.
+
+
+    \section2 Streaming queries
+
+    Queries that only use the following parts of XPath are evaluated in a
+    single pass over the XML data, without building a model of the whole
+    document:
+
+    \list
+    \li A \l query made of \c / and \c // steps, such as \c "/rss/channel/item"
+       or \c "//entry".
+    \li Role queries made of child steps, optionally followed by an
+       attribute, ending in \c string() or \c number(), such as
+       \c "title/string()", \c "@id/string()" or
+       \c "link[@rel='enclosure']/@href/string()".
+    \li Element steps with a name or \c *, and \c [@attribute],
+       \c [@attribute='value'] and \c [n] predicates.
+    \li \l namespaceDeclarations that only declare namespace prefixes and the
+       default element namespace.
+    \endlist
+
+    A role query only takes the first matching node into account. Queries
+    using any other XPath or XQuery features are evaluated with the full
+    XQuery engine, and the model is populated once evaluation has finished.
 
 
     \section2 Using key XML roles
@@ -996,6 +1698,8 @@ void QQuickXmlListModel::classBegin()
     QQuickXmlQueryEngine *queryEngine = QQuickXmlQueryEngine::instance(qmlEngine(this));
     connect(queryEngine, SIGNAL(queryCompleted(QQuickXmlQueryResult)),
             SLOT(queryCompleted(QQuickXmlQueryResult)));
+    connect(queryEngine, SIGNAL(queryRowsParsed(QQuickXmlQueryResult)),
+            SLOT(queryRowsParsed(QQuickXmlQueryResult)));
     connect(queryEngine, SIGNAL(error(void*,QString)),
             SLOT(queryError(void*,QString)));
 }
@@ -1029,6 +1733,7 @@ void QQuickXmlListModel::reload()
 
     QQuickXmlQueryEngine::instance(qmlEngine(this))->abort(d->queryId);
     d->queryId = -1;
+    d->receivingRows = false;
 
     if (d->size < 0)
         d->size = 0;
@@ -1139,12 +1844,46 @@ void QQuickXmlListModel::queryError(void* object, const QString& error)
     qmlInfo(this) << QQuickXmlListModel::tr("invalid query: \"%1\"").arg(error);
 }
 
+void QQuickXmlListModel::queryRowsParsed(const QQuickXmlQueryResult &result)
+{
+    Q_D(QQuickXmlListModel);
+    if (result.queryId != d->queryId)
+        return;
+
+    // The first rows of a streamed query replace the previous contents.
+    if (!d->receivingRows) {
+        d->receivingRows = true;
+        if (d->size > 0) {
+            beginRemoveRows(QModelIndex(), 0, d->size - 1);
+            d->data.clear();
+            d->size = 0;
+            endRemoveRows();
+        }
+    }
+
+    if (d->appendRows(result))
+        emit countChanged();
+}
+
 void QQuickXmlListModel::queryCompleted(const QQuickXmlQueryResult &result)
 {
     Q_D(QQuickXmlListModel);
     if (result.queryId != d->queryId)
         return;
 
+    if (d->receivingRows) {
+        // The result only holds the rows left over after queryRowsParsed().
+        d->receivingRows = false;
+        d->keyRoleResultsCache = result.keyRoleResultsCache;
+        d->status = result.errorString.isEmpty() ? Ready : Error;
+        d->errorString = result.errorString;
+        d->queryId = -1;
+        if (d->appendRows(result))
+            emit countChanged();
+        emit statusChanged(d->status);
+        return;
+    }
+
     int origCount = d->size;
     bool sizeChanged = result.size != d->size;
 
@@ -1153,9 +1892,11 @@ void QQuickXmlListModel::queryCompleted(const QQuickXmlQueryResult &result)
     d->keyRoleResultsCache = result.keyRoleResultsCache;
     if (d->src.isEmpty() && d->xml.isEmpty())
         d->status = Null;
+    else if (!result.errorString.isEmpty())
+        d->status = Error;
     else
         d->status = Ready;
-    d->errorString.clear();
+    d->errorString = result.errorString;
     d->queryId = -1;
 
     bool hasKeys = false;
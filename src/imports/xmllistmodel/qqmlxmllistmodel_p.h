@@ -64,6 +64,7 @@ struct QQuickXmlQueryResult {
     QList<QPair<int, int> > inserted;
     QList<QPair<int, int> > removed;
     QStringList keyRoleResultsCache;
+    QString errorString;
 };
 
 class QQuickXmlListModel : public QAbstractListModel, public QQmlParserStatus
@@ -139,6 +140,7 @@ private Q_SLOTS:
     void requestProgress(qint64,qint64);
     void dataCleared();
     void queryCompleted(const QQuickXmlQueryResult &);
+    void queryRowsParsed(const QQuickXmlQueryResult &);
     void queryError(void* object, const QString& error);
 
 private:
@@ -68,6 +68,9 @@ using namespace QV4;
 //    + Date
 //    + RegExp
 // <quint8 type><quint24 size><data>
+//
+// Strings of at least SharedStringLength characters are not copied; the buffer
+// only holds their index in the message's string table.
 
 enum Type {
     WorkerUndefined,
@@ -84,9 +87,12 @@ enum Type {
     WorkerDate,
     WorkerRegexp,
     WorkerListModel,
-    WorkerSequence
+    WorkerSequence,
+    WorkerSharedString
 };
 
+enum { SharedStringLength = 256 };
+
 static inline quint32 valueheader(Type type, quint32 size = 0)
 {
     return quint8(type) << 24 | (size & 0xFFFFFF);
@@ -117,9 +123,13 @@ static inline void push(QByteArray &data, void *ptr)
     data.append((const char *)&ptr, sizeof(void *));
 }
 
+// QByteArray::reserve() allocates exactly what it is asked for, so growing by
+// the size of every value would copy the buffer over and over.
 static inline void reserve(QByteArray &data, int extra)
 {
-    data.reserve(data.size() + extra);
+    const int required = data.size() + extra;
+    if (required > data.capacity())
+        data.reserve(qMax(required, 2 * data.capacity()));
 }
 
 static inline quint32 popUint32(const char *&data)
@@ -147,8 +157,10 @@ static inline void *popPtr(const char *&data)
 // serialization/deserialization failures
 
 #define ALIGN(size) (((size) + 3) & ~3)
-void Serialize::serialize(QByteArray &data, const QV4::ValueRef v, QV8Engine *engine)
+void Serialize::serialize(Message &message, const QV4::ValueRef v, QV8Engine *engine)
 {
+    QByteArray &data = message.data;
+
     QV4::ExecutionEngine *v4 = QV8Engine::getV4(engine);
     QV4::Scope scope(v4);
 
@@ -163,8 +175,11 @@ void Serialize::serialize(QByteArray &data, const QV4::ValueRef v, QV8Engine *en
     } else if (v->isString()) {
         const QString &qstr = v->toQString();
         int length = qstr.length();
-        if (length > 0xFFFFFF) {
-            push(data, valueheader(WorkerUndefined));
+        if (length >= SharedStringLength) {
+            reserve(data, 2 * sizeof(quint32));
+            push(data, valueheader(WorkerSharedString));
+            push(data, (quint32)message.strings.count());
+            message.strings.append(qstr);
             return;
         }
         int utf16size = ALIGN(length * sizeof(uint16_t));
@@ -192,7 +207,7 @@ void Serialize::serialize(QByteArray &data, const QV4::ValueRef v, QV8Engine *en
         push(data, valueheader(WorkerArray, length));
         ScopedValue val(scope);
         for (uint32_t ii = 0; ii < length; ++ii)
-            serialize(data, (val = array->getIndexed(ii)), engine);
+            serialize(message, (val = array->getIndexed(ii)), engine);
     } else if (v->isInteger()) {
         reserve(data, 2 * sizeof(quint32));
         push(data, valueheader(WorkerInt32));
@@ -255,10 +270,10 @@ void Serialize::serialize(QByteArray &data, const QV4::ValueRef v, QV8Engine *en
             }
             reserve(data, sizeof(quint32) + length * sizeof(quint32));
             push(data, valueheader(WorkerSequence, length));
-            serialize(data, QV4::Primitive::fromInt32(QV4::SequencePrototype::metaTypeForSequence(o)), engine); // sequence type
+            serialize(message, QV4::Primitive::fromInt32(QV4::SequencePrototype::metaTypeForSequence(o)), engine); // sequence type
             ScopedValue val(scope);
             for (uint32_t ii = 0; ii < seqLength; ++ii)
-                serialize(data, (val = o->getIndexed(ii)), engine); // sequence elements
+                serialize(message, (val = o->getIndexed(ii)), engine); // sequence elements
 
             return;
         }
@@ -271,13 +286,14 @@ void Serialize::serialize(QByteArray &data, const QV4::ValueRef v, QV8Engine *en
             push(data, valueheader(WorkerUndefined));
             return;
         }
+        reserve(data, sizeof(quint32) + 2 * length * sizeof(quint32));
         push(data, valueheader(WorkerObject, length));
 
         QV4::ScopedValue s(scope);
         QV4::ScopedString str(scope);
         for (quint32 ii = 0; ii < length; ++ii) {
             s = properties->getIndexed(ii);
-            serialize(data, s, engine);
+            serialize(message, s, engine);
 
             QV4::ExecutionContext *ctx = v4->currentContext();
             str = s;
@@ -285,7 +301,7 @@ void Serialize::serialize(QByteArray &data, const QV4::ValueRef v, QV8Engine *en
             if (scope.hasException())
                 ctx->catchException();
 
-            serialize(data, val, engine);
+            serialize(message, val, engine);
         }
         return;
     } else {
@@ -293,7 +309,7 @@ void Serialize::serialize(QByteArray &data, const QV4::ValueRef v, QV8Engine *en
     }
 }
 
-ReturnedValue Serialize::deserialize(const char *&data, QV8Engine *engine)
+ReturnedValue Serialize::deserialize(const char *&data, const Message &message, QV8Engine *engine)
 {
     quint32 header = popUint32(data);
     Type type = headertype(header);
@@ -317,6 +333,8 @@ ReturnedValue Serialize::deserialize(const char *&data, QV8Engine *engine)
         data += ALIGN(size * sizeof(uint16_t));
         return QV4::Encode(v4->newString(qstr));
     }
+    case WorkerSharedString:
+        return QV4::Encode(v4->newString(message.strings.at(popUint32(data))));
     case WorkerFunction:
         Q_ASSERT(!"Unreachable");
         break;
@@ -324,9 +342,10 @@ ReturnedValue Serialize::deserialize(const char *&data, QV8Engine *engine)
     {
         quint32 size = headersize(header);
         Scoped<ArrayObject> a(scope, v4->newArrayObject());
+        a->arrayReserve(size);
         ScopedValue v(scope);
         for (quint32 ii = 0; ii < size; ++ii) {
-            v = deserialize(data, engine);
+            v = deserialize(data, message, engine);
             a->putIndexed(ii, v);
         }
         return a.asReturnedValue();
@@ -339,8 +358,8 @@ ReturnedValue Serialize::deserialize(const char *&data, QV8Engine *engine)
         ScopedString n(scope);
         ScopedValue value(scope);
         for (quint32 ii = 0; ii < size; ++ii) {
-            name = deserialize(data, engine);
-            value = deserialize(data, engine);
+            name = deserialize(data, message, engine);
+            value = deserialize(data, message, engine);
             n = name.asReturnedValue();
             o->put(n, value);
         }
@@ -366,6 +385,11 @@ ReturnedValue Serialize::deserialize(const char *&data, QV8Engine *engine)
     {
         void *ptr = popPtr(data);
         QQmlListModelWorkerAgent *agent = (QQmlListModelWorkerAgent *)ptr;
+        if (!agent->setV8Engine(engine)) {
+            qWarning("WorkerScript: a ListModel can only be shared by WorkerScripts running on the same thread");
+            agent->release();
+            return QV4::Encode::undefined();
+        }
         QV4::ScopedValue rv(scope, QV4::QObjectWrapper::wrap(v4, agent));
         // ### Find a better solution then the ugly property
         QQmlListModelWorkerAgent::VariantRef ref(agent);
@@ -375,7 +399,6 @@ ReturnedValue Serialize::deserialize(const char *&data, QV8Engine *engine)
         rv->asObject()->defineReadonlyProperty(s, v);
 
         agent->release();
-        agent->setV8Engine(engine);
         return rv.asReturnedValue();
     }
     case WorkerSequence:
@@ -384,12 +407,12 @@ ReturnedValue Serialize::deserialize(const char *&data, QV8Engine *engine)
         bool succeeded = false;
         quint32 length = headersize(header);
         quint32 seqLength = length - 1;
-        value = deserialize(data, engine);
+        value = deserialize(data, message, engine);
         int sequenceType = value->integerValue();
         Scoped<ArrayObject> array(scope, v4->newArrayObject());
         array->arrayReserve(seqLength);
         for (quint32 ii = 0; ii < seqLength; ++ii) {
-            value = deserialize(data, engine);
+            value = deserialize(data, message, engine);
             array->arrayData[ii].value = value.asReturnedValue();
             array->arrayDataLen = ii + 1;
         }
@@ -402,17 +425,18 @@ ReturnedValue Serialize::deserialize(const char *&data, QV8Engine *engine)
     return QV4::Encode::undefined();
 }
 
-QByteArray Serialize::serialize(const QV4::ValueRef value, QV8Engine *engine)
+Serialize::Message Serialize::serialize(const QV4::ValueRef value, QV8Engine *engine)
 {
-    QByteArray rv;
+    Message rv;
+    rv.data.reserve(256);
     serialize(rv, value, engine);
     return rv;
 }
 
-ReturnedValue Serialize::deserialize(const QByteArray &data, QV8Engine *engine)
+ReturnedValue Serialize::deserialize(const Message &message, QV8Engine *engine)
 {
-    const char *stream = data.constData();
-    return deserialize(stream, engine);
+    const char *stream = message.data.constData();
+    return deserialize(stream, message, engine);
 }
 
 QT_END_NAMESPACE
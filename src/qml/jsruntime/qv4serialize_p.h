@@ -54,6 +54,8 @@
 //
 
 #include <QtCore/qbytearray.h>
+#include <QtCore/qstring.h>
+#include <QtCore/qvector.h>
 #include <private/qv4value_p.h>
 
 QT_BEGIN_NAMESPACE
@@ -64,13 +66,20 @@ namespace QV4 {
 
 class Serialize {
 public:
+    // A serialized value.  Long strings are not copied into the buffer but
+    // shared with the sending thread.
+    struct Message
+    {
+        QByteArray data;
+        QVector<QString> strings;
+    };
 
-    static QByteArray serialize(const ValueRef, QV8Engine *);
-    static ReturnedValue deserialize(const QByteArray &, QV8Engine *);
+    static Message serialize(const ValueRef, QV8Engine *);
+    static ReturnedValue deserialize(const Message &, QV8Engine *);
 
 private:
-    static void serialize(QByteArray &, const ValueRef, QV8Engine *);
-    static ReturnedValue deserialize(const char *&, QV8Engine *);
+    static void serialize(Message &, const ValueRef, QV8Engine *);
+    static ReturnedValue deserialize(const char *&, const Message &, QV8Engine *);
 };
 
 }
@@ -49,6 +49,7 @@ SOURCES += \
     $$PWD/qqmlmemoryprofiler.cpp \
     $$PWD/qqmlplatform.cpp \
     $$PWD/qqmlbinding.cpp \
+    $$PWD/qqmltypedbinding.cpp \
     $$PWD/qqmlabstracturlinterceptor.cpp \
     $$PWD/qqmlapplicationengine.cpp \
     $$PWD/qqmllistwrapper.cpp \
@@ -125,6 +126,7 @@ HEADERS += \
     $$PWD/qqmlmemoryprofiler_p.h \
     $$PWD/qqmlplatform_p.h \
     $$PWD/qqmlbinding_p.h \
+    $$PWD/qqmltypedbinding_p.h \
     $$PWD/qqmlextensionplugin_p.h \
     $$PWD/qqmlabstracturlinterceptor.h \
     $$PWD/qqmlapplicationengine_p.h \
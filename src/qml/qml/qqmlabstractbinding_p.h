@@ -93,7 +93,7 @@ public:
 
     typedef QWeakPointer<QQmlAbstractBinding> Pointer;
 
-    enum BindingType { Binding = 0, ValueTypeProxy = 1 };
+    enum BindingType { Binding = 0, ValueTypeProxy = 1, Typed = 2 };
     inline BindingType bindingType() const;
 
     // Destroy the binding.  Use this instead of calling delete.
@@ -152,6 +152,7 @@ private:
     friend class QQmlVME;
     friend class QtSharedPointer::ExternalRefCount<QQmlAbstractBinding>;
     friend class QV4Bindings;
+    friend class QQmlTypedBinding;
     friend class QmlObjectCreator;
 
     typedef QSharedPointer<QQmlAbstractBinding> SharedPointer;
@@ -132,6 +132,17 @@ QQmlCompiledData::~QQmlCompiledData()
     for (int ii = 0; ii < scripts.count(); ++ii)
         scripts.at(ii)->release();
 
+    for (int ii = 0; ii < typedBindingPrograms.count(); ++ii)
+        typedBindingPrograms.at(ii)->release();
+
+    for (int ii = 0; ii < instantiationPlan.count(); ++ii) {
+        const QVector<InstantiationStep> &steps = instantiationPlan.at(ii);
+        for (int jj = 0; jj < steps.count(); ++jj) {
+            if (steps.at(jj).propertyCache)
+                steps.at(jj).propertyCache->release();
+        }
+    }
+
     if (importCache)
         importCache->release();
 
@@ -61,6 +61,7 @@
 #include "qqmlscriptstring.h"
 #include "qqmlglobal_p.h"
 #include "qqmlbinding_p.h"
+#include "qqmltypedbinding_p.h"
 #include "qqmlabstracturlinterceptor.h"
 
 #include <QDebug>
@@ -82,6 +83,7 @@ QT_BEGIN_NAMESPACE
 
 DEFINE_BOOL_CONFIG_OPTION(compilerDump, QML_COMPILER_DUMP);
 DEFINE_BOOL_CONFIG_OPTION(compilerStatDump, QML_COMPILER_STATS);
+DEFINE_BOOL_CONFIG_OPTION(disableTypedBindings, QML_DISABLE_TYPED_BINDINGS);
 
 using namespace QQmlJS;
 using namespace QQmlScript;
@@ -3632,6 +3634,18 @@ void QQmlCompiler::genBindingAssignment(QQmlScript::Value *binding,
             store.property = prop->core;
         }
 
+        output->addInstruction(store);
+    } else if (ref.dataType == BindingReference::Typed) {
+        const JSBindingReference &js = static_cast<const JSBindingReference &>(ref);
+        Q_ASSERT(js.bindingContext.owner == 0 && !valueTypeProperty);
+
+        Instruction::StoreTypedBinding store;
+        store.property = prop->core;
+        store.programIndex = js.compiledIndex;
+        store.context = js.bindingContext.stack;
+        store.isRoot = (compileState->root == obj);
+        store.line = binding->location.start.line;
+        store.column = binding->location.start.column;
         output->addInstruction(store);
     } else {
         Q_ASSERT(!"Unhandled BindingReference::DataType type");
@@ -3674,12 +3688,49 @@ bool QQmlCompiler::completeComponentBuild()
     QQmlJS::Engine *jsEngine = parser.jsEngine();
     QQmlJS::MemoryPool *pool = jsEngine->pool();
 
+    JSCodeGen::ObjectIdMapping idMapping;
+    if (compileState->ids.count() > 0) {
+        idMapping.reserve(compileState->ids.count());
+        for (Object *o = compileState->ids.first(); o; o = compileState->ids.next(o)) {
+            JSCodeGen::IdMapping m;
+            m.name = o->id;
+            m.idIndex = o->idIndex;
+            if (output->types[o->type].isFullyDynamicType)
+                m.type = 0;
+            else
+                m.type = o->metatype;
+            idMapping << m;
+        }
+    }
+
+    const bool useTypedBindings = !disableTypedBindings();
+    QQmlTypedBindingCompiler typedCompiler(enginePrivate, output->importCache);
+    typedCompiler.beginContextScope(idMapping, compileState->root->metatype);
+
     for (JSBindingReference *b = compileState->bindings.first(); b; b = b->nextReference) {
 
         JSBindingReference &binding = *b;
         binding.dataType = BindingReference::QtScript;
 
         QQmlJS::AST::Node *node = binding.expression.asAST();
+
+        // Expressions that only read typed properties don't need the JavaScript engine
+        if (useTypedBindings && binding.value && !binding.disableLookupAcceleration
+            && binding.bindingContext.owner == 0 && !binding.property->isAlias
+            && !binding.property->isValueTypeSubProperty
+            && output->typedBindingPrograms.count() < 0x7FFF) {
+            if (QQmlTypedBindingProgram *program = typedCompiler.compile(node, binding.bindingContext.object->metatype,
+                                                                         binding.property->core)) {
+                binding.dataType = BindingReference::Typed;
+                binding.compiledIndex = output->typedBindingPrograms.count();
+                output->typedBindingPrograms.append(program);
+
+                if (componentStats)
+                    componentStats->componentStat.typedBindings.append(binding.value->location);
+                continue;
+            }
+        }
+
         // Always wrap this in an ExpressionStatement, to make sure that
         // property var foo: function() { ... } results in a closure initialization.
         if (!node->statementCast()) {
@@ -3705,21 +3756,6 @@ bool QQmlCompiler::completeComponentBuild()
 
         JSCodeGen jsCodeGen(unit->finalUrlString(), sourceCode, jsModule.data(), jsEngine, qmlRoot, output->importCache);
 
-        JSCodeGen::ObjectIdMapping idMapping;
-        if (compileState->ids.count() > 0) {
-            idMapping.reserve(compileState->ids.count());
-            for (Object *o = compileState->ids.first(); o; o = compileState->ids.next(o)) {
-                JSCodeGen::IdMapping m;
-                m.name = o->id;
-                m.idIndex = o->idIndex;
-                if (output->types[o->type].isFullyDynamicType)
-                    m.type = 0;
-                else
-                    m.type = o->metatype;
-                idMapping << m;
-            }
-        }
-
         jsCodeGen.beginContextScope(idMapping, compileState->root->metatype);
 
         for (QHash<QQmlScript::Object *, ComponentCompileState::PerObjectCompileData>::Iterator it = compileState->jsCompileData.begin();
@@ -3746,6 +3782,8 @@ bool QQmlCompiler::completeComponentBuild()
 
         for (JSBindingReference *b = compileState->bindings.first(); b; b = b->nextReference) {
             JSBindingReference &binding = *b;
+            if (binding.dataType == BindingReference::Typed)
+                continue;
             binding.compiledIndex = compileState->jsCompileData[binding.bindingContext.object].runtimeFunctionIndices[binding.compiledIndex];
             if (!binding.value) { // Must be a binding requested from custom parser
                 Q_ASSERT(binding.customParserBindingsIndex >= 0 && binding.customParserBindingsIndex < output->customParserBindings.count());
@@ -3791,6 +3829,25 @@ void QQmlCompiler::dumpStats()
         if (!output.isEmpty())
             qWarning().nospace() << output.constData();
         }
+
+        qWarning().nospace() << "        Typed Bindings:     " << stat.typedBindings.count();
+        {
+        QByteArray output;
+        for (int ii = 0; ii < stat.typedBindings.count(); ++ii) {
+            if (0 == (ii % 10)) {
+                if (ii) output.append('\n');
+                output.append("            ");
+            }
+
+            output.append('(');
+            output.append(QByteArray::number(stat.typedBindings.at(ii).start.line));
+            output.append(':');
+            output.append(QByteArray::number(stat.typedBindings.at(ii).start.column));
+            output.append(") ");
+        }
+        if (!output.isEmpty())
+            qWarning().nospace() << output.constData();
+        }
     }
 }
 
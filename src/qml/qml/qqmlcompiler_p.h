@@ -65,6 +65,7 @@
 #include <private/qqmlcodegenerator_p.h>
 #include "private/qv4identifier_p.h"
 #include <private/qqmljsastfwd_p.h>
+#include <private/qqmltypedbinding_p.h>
 
 #include <QtCore/qbytearray.h>
 #include <QtCore/qset.h>
@@ -150,6 +151,7 @@ public:
     QList<QVector<QQmlContextData::ObjectIdMapping> > contextCaches;
     QList<QQmlScriptData *> scripts;
     QList<QUrl> urls;
+    QList<QQmlTypedBindingProgram *> typedBindingPrograms;
 
     // --- new compiler
     QV4::CompiledData::CompilationUnit *compilationUnit;
@@ -158,6 +160,22 @@ public:
     QHash<int, QHash<int, int> > objectIndexToIdPerComponent;
     QHash<int, int> objectIndexToIdForRoot;
     QVector<int> customParserBindings; // index is binding identifier, value is compiled function index.
+    // Number of binding slots one instance needs, per component index (-1 for the root)
+    QHash<int, int> bindingSlotsPerComponent;
+
+    // What the first instantiation found out about a binding of the unit, so that
+    // later instantiations can skip the property name lookup and the conversion of
+    // string literals. Filled lazily by QmlObjectCreator.
+    struct InstantiationStep {
+        InstantiationStep() : propertyCache(0), property(0), isDefaultProperty(false), convertedType(QMetaType::UnknownType) {}
+        QQmlPropertyCache *propertyCache; // The cache property was resolved in; 0 if not resolved yet
+        QQmlPropertyData *property;
+        bool isDefaultProperty;
+        int convertedType;
+        QVariant convertedValue; // The string literal converted to convertedType
+    };
+    // Outer index is the object index, inner index the binding index within that object
+    QVector<QVector<InstantiationStep> > instantiationPlan;
 
     bool isComponent(int objectIndex) const { return objectIndexToIdPerComponent.contains(objectIndex); }
     bool isCompositeType() const { return !datas.at(qmlUnit->indexOfRootObject).isEmpty(); }
@@ -224,7 +242,7 @@ namespace QQmlCompilerTypes {
 
     struct BindingReference
     {
-        enum DataType { QtScript,
+        enum DataType { QtScript, Typed,
                         Tr, TrId };
         DataType dataType;
     };
@@ -496,6 +514,7 @@ private:
 
         int ids;
         QList<QQmlScript::LocationSpan> scriptBindings;
+        QList<QQmlScript::LocationSpan> typedBindings;
         int objects;
     };
     struct ComponentStats : public QQmlPool::Class
@@ -109,6 +109,7 @@ public:
 
     void destroyed(QObject *);
     void parentChanged(QObject *, QObject *);
+    void releaseBindingsAndSignalHandlers(QObject *);
 
     void setImplicitDestructible() {
         if (!explicitIndestructibleSet) indestructible = false;
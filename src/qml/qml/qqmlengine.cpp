@@ -200,9 +200,12 @@ void QQmlEnginePrivate::registerQtQuick2Types(const char *uri, int versionMajor,
     qmlRegisterType<QQmlListElement>(uri, versionMajor, versionMinor, "ListElement"); // Now in QtQml.Models, here for compatibility
     qmlRegisterCustomType<QQmlListModel>(uri, versionMajor, versionMinor, "ListModel", new QQmlListModelParser); // Now in QtQml.Models, here for compatibility
     qmlRegisterType<QQuickWorkerScript>(uri, versionMajor, versionMinor, "WorkerScript");
+    qmlRegisterType<QQuickWorkerScript, 1>(uri, versionMajor, (versionMinor < 2 ? 2 : versionMinor), "WorkerScript"); //Only available in >=2.2
     qmlRegisterType<QQuickPackage>(uri, versionMajor, versionMinor, "Package");
     qmlRegisterType<QQmlDelegateModel>(uri, versionMajor, versionMinor, "VisualDataModel");
+    qmlRegisterType<QQmlDelegateModel, 1>(uri, versionMajor, (versionMinor < 2 ? 2 : versionMinor), "VisualDataModel"); //Only available in >=2.2
     qmlRegisterType<QQmlDelegateModelGroup>(uri, versionMajor, versionMinor, "VisualDataGroup");
+    qmlRegisterType<QQmlDelegateModelGroup, 1>(uri, versionMajor, (versionMinor < 2 ? 2 : versionMinor), "VisualDataGroup"); //Only available in >=2.2
     qmlRegisterType<QQmlObjectModel>(uri, versionMajor, versionMinor, "VisualItemModel");
 }
 
@@ -556,7 +559,7 @@ QQmlEnginePrivate::QQmlEnginePrivate(QQmlEngine *e)
 : propertyCapture(0), rootContext(0), isDebugging(false),
   outputWarningsToStdErr(true),
   cleanup(0), erroredBindings(0), inProgressCreations(0),
-  workerScriptEngine(0), activeVME(0),
+  activeVME(0),
   activeObjectCreator(0),
   networkAccessManager(0), networkAccessManagerFactory(0), urlInterceptor(0),
   scarceResourcesRefCount(0), importDatabase(e), typeLoader(e), uniqueId(1),
@@ -821,12 +824,55 @@ void QQmlEnginePrivate::init()
     }
 }
 
-QQuickWorkerScriptEngine *QQmlEnginePrivate::getWorkerScriptEngine()
+static int workerScriptPoolSize()
+{
+    static int size = qMax(1, qgetenv("QML_WORKERSCRIPT_THREADS").toInt());
+    return size;
+}
+
+/*
+    Returns the thread to run a WorkerScript on.  Scripts asking for a particular
+    \a thread share it.  Otherwise the least loaded thread of the pool is used,
+    and a new thread is only started while every running one has scripts on it.
+    The pool never grows beyond QML_WORKERSCRIPT_THREADS threads.
+*/
+QQuickWorkerScriptEngine *QQmlEnginePrivate::getWorkerScriptEngine(int thread)
 {
     Q_Q(QQmlEngine);
-    if (!workerScriptEngine)
-        workerScriptEngine = new QQuickWorkerScriptEngine(q);
-    return workerScriptEngine;
+    const int poolSize = workerScriptPoolSize();
+    if (workerScriptEngines.isEmpty())
+        workerScriptEngines.resize(poolSize);
+
+    if (thread >= poolSize) {
+        qWarning("WorkerScript: workerThread %d is out of range, QML_WORKERSCRIPT_THREADS allows %d thread(s)",
+                 thread, poolSize);
+        thread = -1;
+    }
+
+    if (thread < 0) {
+        QQuickWorkerScriptEngine *best = 0;
+        int bestIndex = -1;
+        int freeIndex = -1;
+        for (int ii = 0; ii < poolSize; ++ii) {
+            QQuickWorkerScriptEngine *engine = workerScriptEngines.at(ii);
+            if (!engine) {
+                if (freeIndex == -1)
+                    freeIndex = ii;
+            } else if (!best
+                       || engine->workerScriptCount() < best->workerScriptCount()
+                       || (engine->workerScriptCount() == best->workerScriptCount()
+                           && engine->pendingMessageCount() < best->pendingMessageCount())) {
+                best = engine;
+                bestIndex = ii;
+            }
+        }
+        thread = (best && (freeIndex == -1 || best->workerScriptCount() == 0)) ? bestIndex : freeIndex;
+    }
+
+    QQuickWorkerScriptEngine *&engine = workerScriptEngines[thread];
+    if (!engine)
+        engine = new QQuickWorkerScriptEngine(q);
+    return engine;
 }
 
 /*!
@@ -900,6 +946,10 @@ QQmlEngine::~QQmlEngine()
         QV4DebugService::instance()->removeEngine(this);
     }
 
+    // Object trees still waiting for deferred destruction go first, while
+    // everything they may refer to is still around.
+    d->flushDeferredDestructions();
+
     // Emit onDestruction signals for the root context before
     // we destroy the contexts, engine, Singleton Types etc. that
     // may be required to handle the destruction signal.
@@ -1662,6 +1712,50 @@ void QQmlData::destroyed(QObject *object)
         delete this;
 }
 
+/*
+Releases the bindings and signal handlers of an object queued for deletion ahead of
+its destruction, so that destroyed() has less left to do. Nothing is released while
+one of the object's signal handlers is being evaluated; destroyed() reports that case.
+*/
+void QQmlData::releaseBindingsAndSignalHandlers(QObject *object)
+{
+    Q_ASSERT(isQueuedForDeletion);
+    Q_UNUSED(object);
+
+    for (QQmlAbstractBoundSignal *signalHandler = signalHandlers; signalHandler; signalHandler = signalHandler->m_nextSignal) {
+        if (signalHandler->isEvaluating())
+            return;
+    }
+
+    QQmlAbstractBinding *binding = bindings;
+    bindings = 0;
+    while (binding) {
+        QQmlAbstractBinding *next = binding->nextBinding();
+        binding->setAddedToObject(false);
+        binding->setNextBinding(0);
+        binding->destroy();
+        binding = next;
+    }
+
+    if (bindingBits) {
+        free(bindingBits);
+        bindingBits = 0;
+        bindingBitsSize = 0;
+    }
+
+    QQmlAbstractBoundSignal *signalHandler = signalHandlers;
+    signalHandlers = 0;
+    while (signalHandler) {
+        QQmlAbstractBoundSignal *next = signalHandler->m_nextSignal;
+        signalHandler->m_prevSignal = 0;
+        signalHandler->m_nextSignal = 0;
+        delete signalHandler;
+        signalHandler = next;
+    }
+
+    disconnectNotifiers();
+}
+
 DEFINE_BOOL_CONFIG_OPTION(parentTest, QML_PARENT_TEST);
 
 void QQmlData::parentChanged(QObject *object, QObject *parent)
@@ -72,10 +72,12 @@
 
 #include <QtCore/qlist.h>
 #include <QtCore/qpair.h>
+#include <QtCore/qpointer.h>
 #include <QtCore/qstack.h>
 #include <QtCore/qmutex.h>
 #include <QtCore/qstring.h>
 #include <QtCore/qthread.h>
+#include <QtCore/qvector.h>
 
 #include <private/qobject_p.h>
 
@@ -159,8 +161,8 @@ public:
     QV8Engine *v8engine() const { return q_func()->handle(); }
     QV4::ExecutionEngine *v4engine() const { return QV8Engine::getV4(q_func()->handle()); }
 
-    QQuickWorkerScriptEngine *getWorkerScriptEngine();
-    QQuickWorkerScriptEngine *workerScriptEngine;
+    QQuickWorkerScriptEngine *getWorkerScriptEngine(int thread = -1);
+    QVector<QQuickWorkerScriptEngine *> workerScriptEngines;
 
     QUrl baseUrl;
 
@@ -208,6 +210,21 @@ public:
     QQmlIncubationController *incubationController;
     void incubate(QQmlIncubator &, QQmlContextData *);
 
+    // Object trees whose destruction is spread over the incubation controller's time
+    // slices. The bindings and signal handlers of the tree are released first, a few
+    // objects at a time, then its objects are deleted bottom up and the root last.
+    struct DeferredDestruction {
+        DeferredDestruction() : started(false) {}
+        QPointer<QObject> root;
+        QVector<QPointer<QObject> > pending;
+        bool started;
+    };
+    QList<DeferredDestruction> deferredDestructions;
+    void deferDestruction(QObject *);
+    inline static void deferDestruction(QQmlEngine *, QObject *);
+    void flushDeferredDestructions();
+    inline int incubatingObjectCount() const;
+
     // These methods may be called from any thread
     inline bool isEngineThread() const;
     inline static bool isEngineThread(const QQmlEngine *);
@@ -411,6 +428,27 @@ void QQmlEnginePrivate::deleteInEngineThread(QQmlEngine *engine, T *value)
     QQmlEnginePrivate::get(engine)->deleteInEngineThread<T>(value);
 }
 
+/*!
+Defer the destruction of \a object to the incubation controller of \a engine.  If
+\a engine is 0, \a object is deleted later from the event loop.
+*/
+void QQmlEnginePrivate::deferDestruction(QQmlEngine *engine, QObject *object)
+{
+    if (engine)
+        QQmlEnginePrivate::get(engine)->deferDestruction(object);
+    else if (object)
+        object->deleteLater();
+}
+
+/*!
+Returns the number of objects the incubation controller has work for: the objects
+being incubated and the object trees waiting for deferred destruction.
+*/
+int QQmlEnginePrivate::incubatingObjectCount() const
+{
+    return incubatorCount + deferredDestructions.count();
+}
+
 /*!
 Returns a QQmlPropertyCache for \a obj if one is available.
 
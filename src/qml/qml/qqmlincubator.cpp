@@ -44,6 +44,7 @@
 #include "qqmlincubator_p.h"
 
 #include "qqmlcompiler_p.h"
+#include "qqmldata_p.h"
 #include "qqmlexpression_p.h"
 #include "qqmlmemoryprofiler_p.h"
 
@@ -101,10 +102,110 @@ void QQmlEnginePrivate::incubate(QQmlIncubator &i, QQmlContextData *forContext)
         p->changeStatus(QQmlIncubator::Loading);
 
         if (incubationController)
-             incubationController->incubatingObjectCountChanged(incubatorCount);
+             incubationController->incubatingObjectCountChanged(incubatingObjectCount());
     }
 }
 
+/*!
+Queues the destruction of \a object and its children, to be torn down in the time slices
+given by the incubation controller, after any pending incubation.  Without an incubation
+controller the object is deleted later from the event loop.
+
+Until the controller gets to the tree, its objects stay alive and their bindings are still
+evaluated, as with QObject::deleteLater().  Component.onDestruction is only emitted, and
+the tree marked as deleted so that it no longer resolves in bindings, once the controller
+starts on it.
+
+Callers are expected to detach the object from whatever displays it first.
+*/
+void QQmlEnginePrivate::deferDestruction(QObject *object)
+{
+    if (!object)
+        return;
+
+    if (!incubationController) {
+        object->deleteLater();
+        return;
+    }
+
+    DeferredDestruction destruction;
+    destruction.root = object;
+    deferredDestructions.append(destruction);
+
+    incubationController->incubatingObjectCountChanged(incubatingObjectCount());
+}
+
+/*!
+Destroys all object trees queued with deferDestruction() immediately.
+*/
+void QQmlEnginePrivate::flushDeferredDestructions()
+{
+    if (deferredDestructions.isEmpty())
+        return;
+
+    while (!deferredDestructions.isEmpty()) {
+        QObject *root = deferredDestructions.takeFirst().root;
+        delete root;
+    }
+
+    if (incubationController)
+        incubationController->incubatingObjectCountChanged(incubatingObjectCount());
+}
+
+static void destroyDeferred(QQmlEnginePrivate *enginePriv, QQmlVME::Interrupt &i)
+{
+    QList<QQmlEnginePrivate::DeferredDestruction> &queue = enginePriv->deferredDestructions;
+    const int count = queue.count();
+
+    while (!queue.isEmpty()) {
+        QQmlEnginePrivate::DeferredDestruction &destruction = queue.first();
+        if (destruction.root.isNull()) {
+            queue.removeFirst();
+            continue;
+        }
+
+        if (!destruction.started) {
+            QQmlData::markAsDeleted(destruction.root);
+            destruction.pending.append(destruction.root);
+            destruction.started = true;
+        }
+
+        // Release the bindings top down, so that nothing is re-evaluated
+        // while the tree is taken apart.
+        while (!destruction.pending.isEmpty()) {
+            QObject *object = destruction.pending.last();
+            destruction.pending.removeLast();
+            if (!object)
+                continue;
+
+            const QObjectList &children = object->children();
+            for (int ii = children.count() - 1; ii >= 0; --ii)
+                destruction.pending.append(children.at(ii));
+
+            QQmlData *ddata = QQmlData::get(object);
+            if (ddata && ddata->isQueuedForDeletion)
+                ddata->releaseBindingsAndSignalHandlers(object);
+
+            if (i.shouldInterrupt())
+                break;
+        }
+
+        // The tree itself goes in one piece.  Types may hold plain pointers to their
+        // declared children, so those must be destroyed by their parent's destructor.
+        if (destruction.pending.isEmpty()) {
+            QObject *root = destruction.root;
+            queue.removeFirst();
+            delete root;
+        }
+
+        if (i.shouldInterrupt())
+            break;
+    }
+
+    if (queue.count() != count && enginePriv->incubationController)
+        enginePriv->incubationController->incubatingObjectCountChanged(enginePriv->incubatingObjectCount());
+}
+
 /*!
 Sets the engine's incubation \a controller.  The engine can only have one active controller 
 and it does not take ownership of it.
@@ -118,6 +219,7 @@ void QQmlEngine::setIncubationController(QQmlIncubationController *controller)
         d->incubationController->d = 0;
     d->incubationController = controller;
     if (controller) controller->d = d;
+    else d->flushDeferredDestructions();
 }
 
 /*!
@@ -153,7 +255,7 @@ void QQmlIncubatorPrivate::clear()
         enginePriv->incubatorCount--;
         QQmlIncubationController *controller = enginePriv->incubationController;
         if (controller)
-             controller->incubatingObjectCountChanged(enginePriv->incubatorCount);
+             controller->incubatingObjectCountChanged(enginePriv->incubatingObjectCount());
     } else if (compiledData) {
         compiledData->release();
         compiledData = 0;
@@ -246,10 +348,13 @@ QQmlEngine *QQmlIncubationController::engine() const
 
 /*!
 Return the number of objects currently incubating.
+
+Object trees whose destruction has been deferred to the incubation controller
+are included in the count.
 */
 int QQmlIncubationController::incubatingObjectCount() const
 {
-    return d ? d->incubatorCount : 0;
+    return d ? d->incubatingObjectCount() : 0;
 }
 
 /*!
@@ -383,17 +488,25 @@ finishIncubate:
 
 /*!
 Incubate objects for \a msecs, or until there are no more objects to incubate.
+
+Time left once all objects have been incubated is spent destroying object trees
+whose destruction has been deferred to the controller.
 */
 void QQmlIncubationController::incubateFor(int msecs)
 {
-    if (!d || !d->incubatorCount)
+    if (!d || !d->incubatingObjectCount())
         return;
 
     QQmlVME::Interrupt i(msecs * 1000000);
     i.reset();
-    do {
+    while (d && d->incubatorCount != 0) {
         static_cast<QQmlIncubatorPrivate*>(d->incubatorList.first())->incubate(i);
-    } while (d && d->incubatorCount != 0 && !i.shouldInterrupt());
+        if (i.shouldInterrupt())
+            return;
+    }
+
+    if (d)
+        destroyDeferred(d, i);
 }
 
 /*!
@@ -405,14 +518,19 @@ the bool pointed to by \a flag to false when it wants incubation to be interrupt
 */
 void QQmlIncubationController::incubateWhile(volatile bool *flag, int msecs)
 {
-    if (!d || !d->incubatorCount)
+    if (!d || !d->incubatingObjectCount())
         return;
 
     QQmlVME::Interrupt i(flag, msecs * 1000000);
     i.reset();
-    do {
+    while (d && d->incubatorCount != 0) {
         static_cast<QQmlIncubatorPrivate*>(d->incubatorList.first())->incubate(i);
-    } while (d && d->incubatorCount != 0 && !i.shouldInterrupt());
+        if (i.shouldInterrupt())
+            return;
+    }
+
+    if (d)
+        destroyDeferred(d, i);
 }
 
 /*!
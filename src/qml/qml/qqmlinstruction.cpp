@@ -224,6 +224,9 @@ void QQmlCompiledData::dump(QQmlInstruction *instr, int idx)
     case QQmlInstruction::StoreBinding:
         qWarning().nospace() << idx << "\t\t" << "STORE_BINDING\t" << instr->assignBinding.property.coreIndex << "\t" << instr->assignBinding.functionIndex << "\t" << instr->assignBinding.context;
         break;
+    case QQmlInstruction::StoreTypedBinding:
+        qWarning().nospace() << idx << "\t\t" << "STORE_TYPED_BINDING\t" << instr->assignTypedBinding.property.coreIndex << "\t" << instr->assignTypedBinding.programIndex << "\t" << instr->assignTypedBinding.context;
+        break;
     case QQmlInstruction::StoreValueSource:
         qWarning().nospace() << idx << "\t\t" << "STORE_VALUE_SOURCE\t" << instr->assignValueSource.property.coreIndex << "\t" << instr->assignValueSource.castValue;
         break;
@@ -117,6 +117,7 @@ QT_BEGIN_NAMESPACE
     F(StoreScriptString, storeScriptString) \
     F(BeginObject, begin) \
     F(StoreBinding, assignBinding) \
+    F(StoreTypedBinding, assignTypedBinding) \
     F(StoreValueSource, assignValueSource) \
     F(StoreValueInterceptor, assignValueInterceptor) \
     F(StoreObjectQList, common) \
@@ -249,6 +250,15 @@ union QQmlInstruction
         ushort line;
         ushort column;
     };
+    struct instr_assignTypedBinding {
+        QML_INSTR_HEADER
+        QQmlPropertyRawData property;
+        int programIndex; // index in QQmlCompiledData::typedBindingPrograms
+        short context;
+        bool isRoot;
+        ushort line;
+        ushort column;
+    };
     struct instr_fetch {
         QML_INSTR_HEADER
         int property;
@@ -489,6 +499,7 @@ union QQmlInstruction
     instr_assignValueSource assignValueSource;
     instr_assignValueInterceptor assignValueInterceptor;
     instr_assignBinding assignBinding;
+    instr_assignTypedBinding assignTypedBinding;
     instr_fetch fetch;
     instr_fetchValue fetchValue;
     instr_fetchQmlList fetchQmlList;
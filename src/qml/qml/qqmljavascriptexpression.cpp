@@ -149,7 +149,11 @@ QV4::ReturnedValue QQmlJavaScriptExpression::evaluate(QQmlContextData *context,
     ep->propertyCapture = notifyOnValueChanged()?&capture:0;
 
 
-    if (notifyOnValueChanged())
+    // Permanent guards stay connected and are only compared against the properties
+    // read during this evaluation, instead of being moved through the capture list.
+    if (hasPermanentGuards())
+        capture.verifying = true;
+    else if (notifyOnValueChanged())
         capture.guards.copyAndClearPrepend(activeGuards);
 
     QV4::ExecutionEngine *v4 = QV8Engine::getV4(ep->v8engine());
@@ -186,6 +190,15 @@ QV4::ReturnedValue QQmlJavaScriptExpression::evaluate(QQmlContextData *context,
         capture.errorString = 0;
     }
 
+    if (!watcher.wasDeleted() && notifyOnValueChanged()) {
+        // A permanent guard that was not read this time means the dependencies changed
+        if (capture.verifying && capture.nextToVerify())
+            capture.stopVerifying();
+
+        if (!capture.verifying)
+            updateStableEvaluations(capture.changed || !capture.guards.isEmpty());
+    }
+
     while (Guard *g = capture.guards.takeFirst())
         g->Delete();
 
@@ -194,15 +207,92 @@ QV4::ReturnedValue QQmlJavaScriptExpression::evaluate(QQmlContextData *context,
     return result.asReturnedValue();
 }
 
+void QQmlJavaScriptExpression::updateStableEvaluations(bool changed)
+{
+    if (changed) {
+        setStableEvaluations(0);
+        return;
+    }
+
+    int count = stableEvaluations() + 1;
+    if (count < PermanentGuardThreshold) {
+        setStableEvaluations(count);
+        return;
+    }
+
+    // Reverse the guards into capture order, so that the next evaluations can
+    // verify them in a single pass.
+    QForwardFieldList<Guard, &Guard::next> ordered;
+    while (Guard *g = activeGuards.takeFirst())
+        ordered.prepend(g);
+    ordered.setFlagValue(activeGuards.flag());
+    activeGuards = ordered;
+
+    setStableEvaluations(0);
+    setPermanentGuards(true);
+}
+
+QQmlJavaScriptExpressionGuard *QQmlJavaScriptExpression::GuardCapture::nextToVerify() const
+{
+    return verified ? verified->next : expression->activeGuards.first();
+}
+
+void QQmlJavaScriptExpression::GuardCapture::verify(Guard *g)
+{
+    g->cancelNotify();
+    verified = g;
+}
+
+/*! \internal
+    Moves the permanent guards back into the regular capture state.  Guards that were
+    already verified become active again and the rest are recaptured as usual.
+*/
+void QQmlJavaScriptExpression::GuardCapture::stopVerifying()
+{
+    Q_ASSERT(verifying);
+    verifying = false;
+    changed = true;
+
+    QQmlJavaScriptExpression *e = expression;
+    e->setPermanentGuards(false);
+
+    QForwardFieldList<Guard, &Guard::next> ordered = e->activeGuards;
+    e->activeGuards = QForwardFieldList<Guard, &Guard::next>();
+    e->activeGuards.setFlagValue(ordered.flag());
+
+    bool isVerified = verified != 0;
+    while (Guard *g = ordered.takeFirst()) {
+        if (isVerified)
+            e->activeGuards.prepend(g);
+        else
+            guards.append(g);
+        if (g == verified)
+            isVerified = false;
+    }
+    verified = 0;
+}
+
 void QQmlJavaScriptExpression::GuardCapture::captureProperty(QQmlNotifier *n)
 {
     if (watcher->wasDeleted())
         return;
 
     Q_ASSERT(expression);
+
+    if (verifying) {
+        Guard *g = nextToVerify();
+        if (g && g->isConnected(n)) {
+            verify(g);
+            return;
+        }
+        stopVerifying();
+    }
+
     // Try and find a matching guard
-    while (!guards.isEmpty() && !guards.first()->isConnected(n))
+    while (!guards.isEmpty() && !guards.first()->isConnected(n)) {
         guards.takeFirst()->Delete();
+        changed = true;
+    }
 
     Guard *g = 0;
     if (!guards.isEmpty()) {
@@ -212,6 +302,7 @@ void QQmlJavaScriptExpression::GuardCapture::captureProperty(QQmlNotifier *n)
     } else {
         g = Guard::New(expression, engine);
         g->connect(n);
+        changed = true;
     }
 
     expression->activeGuards.prepend(g);
@@ -247,9 +338,20 @@ void QQmlJavaScriptExpression::GuardCapture::captureProperty(QObject *o, int c,
         errorString->append(error);
     } else {
 
+        if (verifying) {
+            Guard *g = nextToVerify();
+            if (g && g->isConnected(o, n)) {
+                verify(g);
+                return;
+            }
+            stopVerifying();
+        }
+
         // Try and find a matching guard
-        while (!guards.isEmpty() && !guards.first()->isConnected(o, n))
+        while (!guards.isEmpty() && !guards.first()->isConnected(o, n)) {
             guards.takeFirst()->Delete();
+            changed = true;
+        }
 
         Guard *g = 0;
         if (!guards.isEmpty()) {
@@ -259,6 +361,7 @@ void QQmlJavaScriptExpression::GuardCapture::captureProperty(QObject *o, int c,
         } else {
             g = Guard::New(expression, engine);
             g->connect(o, n, engine);
+            changed = true;
         }
 
         expression->activeGuards.prepend(g);
@@ -362,6 +465,8 @@ void QQmlJavaScriptExpression::clearGuards()
 {
     while (Guard *g = activeGuards.takeFirst())
         g->Delete();
+    setPermanentGuards(false);
+    setStableEvaluations(0);
 }
 
 void QQmlJavaScriptExpressionGuard_callback(QQmlNotifierEndpoint *e, void **)
@@ -162,7 +162,8 @@ private:
 
     struct GuardCapture : public QQmlEnginePrivate::PropertyCapture {
         GuardCapture(QQmlEngine *engine, QQmlJavaScriptExpression *e, DeleteWatcher *w)
-        : engine(engine), expression(e), watcher(w), errorString(0) { }
+        : engine(engine), expression(e), watcher(w), errorString(0),
+          changed(false), verifying(false), verified(0) { }
 
         ~GuardCapture()  {
             Q_ASSERT(guards.isEmpty());
@@ -172,18 +173,41 @@ private:
         virtual void captureProperty(QQmlNotifier *);
         virtual void captureProperty(QObject *, int, int);
 
+        Guard *nextToVerify() const;
+        void verify(Guard *g);
+        void stopVerifying();
+
         QQmlEngine *engine;
         QQmlJavaScriptExpression *expression;
         DeleteWatcher *watcher;
         QFieldList<Guard, &Guard::next> guards;
         QStringList *errorString;
+
+        // True if a guard had to be created or deleted
+        bool changed;
+        // While verifying, activeGuards are kept in capture order and only compared
+        // against the captured properties.  verified is the last guard that matched.
+        bool verifying;
+        Guard *verified;
     };
 
+    // Number of consecutive evaluations with an identical dependency set after which
+    // the guards become permanent.  The count is stored in two flag bits.
+    enum { PermanentGuardThreshold = 3 };
+
+    inline int stableEvaluations() const;
+    inline void setStableEvaluations(int);
+    inline bool hasPermanentGuards() const;
+    inline void setPermanentGuards(bool);
+    void updateStableEvaluations(bool changed);
+
     QPointerValuePair<VTable, QQmlDelayedError> m_vtable;
 
     // We store some flag bits in the following flag pointers.
+    //    m_vtable:flag       - stable evaluation count, high bit
+    //    m_scopeObject:flag  - stable evaluation count, low bit
     //    activeGuards:flag1  - notifyOnValueChanged
-    //    activeGuards:flag2  - useSharedContext
+    //    activeGuards:flag2  - permanent guards; activeGuards are in capture order
     QBiPointer<QObject, DeleteWatcher> m_scopeObject;
     QForwardFieldList<Guard, &Guard::next> activeGuards;
 };
@@ -230,6 +254,28 @@ void QQmlJavaScriptExpression::setScopeObject(QObject *v)
     else m_scopeObject.asT2()->_c = v;
 }
 
+int QQmlJavaScriptExpression::stableEvaluations() const
+{
+    return (m_vtable.flag() ? 2 : 0) | (m_scopeObject.flag() ? 1 : 0);
+}
+
+void QQmlJavaScriptExpression::setStableEvaluations(int count)
+{
+    Q_ASSERT(count >= 0 && count <= PermanentGuardThreshold);
+    m_vtable.setFlagValue(count & 2);
+    m_scopeObject.setFlagValue(count & 1);
+}
+
+bool QQmlJavaScriptExpression::hasPermanentGuards() const
+{
+    return activeGuards.flag2();
+}
+
+void QQmlJavaScriptExpression::setPermanentGuards(bool v)
+{
+    activeGuards.setFlag2Value(v);
+}
+
 bool QQmlJavaScriptExpression::hasError() const
 {
     return m_vtable.hasValue() && m_vtable.constValue()->isValid();
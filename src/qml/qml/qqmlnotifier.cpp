@@ -51,12 +51,14 @@ typedef void (*Callback)(QQmlNotifierEndpoint *, void **);
 void QQmlBoundSignal_callback(QQmlNotifierEndpoint *, void **);
 void QQmlJavaScriptExpressionGuard_callback(QQmlNotifierEndpoint *, void **);
 void QQmlVMEMetaObjectEndpoint_callback(QQmlNotifierEndpoint *, void **);
+void QQmlTypedBindingSubscription_callback(QQmlNotifierEndpoint *, void **);
 
 static Callback QQmlNotifier_callbacks[] = {
     0,
     QQmlBoundSignal_callback,
     QQmlJavaScriptExpressionGuard_callback,
-    QQmlVMEMetaObjectEndpoint_callback
+    QQmlVMEMetaObjectEndpoint_callback,
+    QQmlTypedBindingSubscription_callback
 };
 
 void QQmlNotifier::emitNotify(QQmlNotifierEndpoint *endpoint, void **a)
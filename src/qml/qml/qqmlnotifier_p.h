@@ -81,7 +81,7 @@ public:
         QQmlBoundSignal = 1,
         QQmlJavaScriptExpressionGuard = 2,
         QQmlVMEMetaObjectEndpoint = 3,
-        QV4BindingsSubscription = 4
+        QQmlTypedBindingSubscription = 4
     };
 
     inline void setCallback(Callback c) { callback = c; }
@@ -477,6 +477,7 @@ QmlObjectCreator::QmlObjectCreator(QQmlContextData *parentContext, QQmlCompiledD
     , resolvedTypes(compiledData->resolvedTypes)
     , propertyCaches(compiledData->propertyCaches)
     , vmeMetaObjectData(compiledData->datas)
+    , allCreatedBindings(&createdBindingsStorage)
     , compiledData(compiledData)
     , _qobject(0)
     , _qobjectForBindings(0)
@@ -485,10 +486,14 @@ QmlObjectCreator::QmlObjectCreator(QQmlContextData *parentContext, QQmlCompiledD
     , _ddata(0)
     , _propertyCache(0)
     , _vmeMetaObject(0)
+    , _createdBindings(0)
+    , _instantiationSteps(0)
     , _qmlContext(0)
 {
     if (!compiledData->isInitialized())
         compiledData->initialize(engine);
+    if (compiledData->instantiationPlan.isEmpty())
+        compiledData->instantiationPlan.resize(qmlUnit->nObjects);
 }
 
 QObject *QmlObjectCreator::create(int subComponentIndex, QObject *parent)
@@ -504,6 +509,10 @@ QObject *QmlObjectCreator::create(int subComponentIndex, QObject *parent)
         objectToCreate = compObj->bindingTable()->value.objectIndex;
     }
 
+    // Creators of composite types share the binding slots of the creator of the outer instance
+    if (allCreatedBindings == &createdBindingsStorage)
+        createdBindingsStorage.allocate(bindingSlotsForComponent(compiledData, subComponentIndex));
+
     context = new QQmlContextData;
     context->isInternal = true;
     context->url = compiledData->url;
@@ -549,13 +558,29 @@ QObject *QmlObjectCreator::create(int subComponentIndex, QObject *parent)
     return instance;
 }
 
-void QmlObjectCreator::setPropertyValue(QQmlPropertyData *property, const QV4::CompiledData::Binding *binding)
+static inline void rememberConversion(QQmlCompiledData::InstantiationStep *step, int type, const void *value)
+{
+    if (!step)
+        return;
+    step->convertedValue = QVariant(type, value);
+    step->convertedType = type;
+}
+
+void QmlObjectCreator::setPropertyValue(QQmlPropertyData *property, const QV4::CompiledData::Binding *binding,
+                                        QQmlCompiledData::InstantiationStep *step)
 {
     QQmlPropertyPrivate::WriteFlags propertyWriteFlags = QQmlPropertyPrivate::BypassInterceptor |
                                                                QQmlPropertyPrivate::RemoveBindingOnAliasWrite;
     int propertyWriteStatus = -1;
     void *argv[] = { 0, 0, &propertyWriteStatus, &propertyWriteFlags };
 
+    // A string literal converted by an earlier instantiation is written as is
+    if (step && step->convertedType != QMetaType::UnknownType && step->convertedType == property->propType) {
+        argv[0] = const_cast<void *>(step->convertedValue.constData());
+        QMetaObject::metacall(_qobject, QMetaObject::WriteProperty, property->coreIndex, argv);
+        return;
+    }
+
     QV4::ExecutionEngine *v4 = QV8Engine::getV4(engine);
     QV4::Scope scope(v4);
     // ### enums
@@ -702,6 +727,7 @@ void QmlObjectCreator::setPropertyValue(QQmlPropertyData *property, const QV4::C
         if (ok) {
             struct { void *data[4]; } buffer;
             if (QQml_valueTypeProvider()->storeValueType(property->propType, &colorValue, &buffer, sizeof(buffer))) {
+                rememberConversion(step, property->propType, &buffer);
                 argv[0] = reinterpret_cast<void *>(&buffer);
                 QMetaObject::metacall(_qobject, QMetaObject::WriteProperty, property->coreIndex, argv);
             }
@@ -715,6 +741,7 @@ void QmlObjectCreator::setPropertyValue(QQmlPropertyData *property, const QV4::C
         bool ok = false;
         QDate value = QQmlStringConverters::dateFromString(binding->valueAsString(&qmlUnit->header), &ok);
         if (ok) {
+            rememberConversion(step, property->propType, &value);
             argv[0] = &value;
             QMetaObject::metacall(_qobject, QMetaObject::WriteProperty, property->coreIndex, argv);
         } else {
@@ -726,6 +753,7 @@ void QmlObjectCreator::setPropertyValue(QQmlPropertyData *property, const QV4::C
         bool ok = false;
         QTime value = QQmlStringConverters::timeFromString(binding->valueAsString(&qmlUnit->header), &ok);
         if (ok) {
+            rememberConversion(step, property->propType, &value);
             argv[0] = &value;
             QMetaObject::metacall(_qobject, QMetaObject::WriteProperty, property->coreIndex, argv);
         } else {
@@ -737,6 +765,7 @@ void QmlObjectCreator::setPropertyValue(QQmlPropertyData *property, const QV4::C
         bool ok = false;
         QDateTime value = QQmlStringConverters::dateTimeFromString(binding->valueAsString(&qmlUnit->header), &ok);
         if (ok) {
+            rememberConversion(step, property->propType, &value);
             argv[0] = &value;
             QMetaObject::metacall(_qobject, QMetaObject::WriteProperty, property->coreIndex, argv);
         } else {
@@ -749,6 +778,7 @@ void QmlObjectCreator::setPropertyValue(QQmlPropertyData *property, const QV4::C
         bool ok = false;
         QPoint value = QQmlStringConverters::pointFFromString(binding->valueAsString(&qmlUnit->header), &ok).toPoint();
         if (ok) {
+            rememberConversion(step, property->propType, &value);
             argv[0] = &value;
             QMetaObject::metacall(_qobject, QMetaObject::WriteProperty, property->coreIndex, argv);
         } else {
@@ -760,6 +790,7 @@ void QmlObjectCreator::setPropertyValue(QQmlPropertyData *property, const QV4::C
         bool ok = false;
         QPointF value = QQmlStringConverters::pointFFromString(binding->valueAsString(&qmlUnit->header), &ok);
         if (ok) {
+            rememberConversion(step, property->propType, &value);
             argv[0] = &value;
             QMetaObject::metacall(_qobject, QMetaObject::WriteProperty, property->coreIndex, argv);
         } else {
@@ -771,6 +802,7 @@ void QmlObjectCreator::setPropertyValue(QQmlPropertyData *property, const QV4::C
         bool ok = false;
         QSize value = QQmlStringConverters::sizeFFromString(binding->valueAsString(&qmlUnit->header), &ok).toSize();
         if (ok) {
+            rememberConversion(step, property->propType, &value);
             argv[0] = &value;
             QMetaObject::metacall(_qobject, QMetaObject::WriteProperty, property->coreIndex, argv);
         } else {
@@ -782,6 +814,7 @@ void QmlObjectCreator::setPropertyValue(QQmlPropertyData *property, const QV4::C
         bool ok = false;
         QSizeF value = QQmlStringConverters::sizeFFromString(binding->valueAsString(&qmlUnit->header), &ok);
         if (ok) {
+            rememberConversion(step, property->propType, &value);
             argv[0] = &value;
             QMetaObject::metacall(_qobject, QMetaObject::WriteProperty, property->coreIndex, argv);
         } else {
@@ -793,6 +826,7 @@ void QmlObjectCreator::setPropertyValue(QQmlPropertyData *property, const QV4::C
         bool ok = false;
         QRect value = QQmlStringConverters::rectFFromString(binding->valueAsString(&qmlUnit->header), &ok).toRect();
         if (ok) {
+            rememberConversion(step, property->propType, &value);
             argv[0] = &value;
             QMetaObject::metacall(_qobject, QMetaObject::WriteProperty, property->coreIndex, argv);
         } else {
@@ -804,6 +838,7 @@ void QmlObjectCreator::setPropertyValue(QQmlPropertyData *property, const QV4::C
         bool ok = false;
         QRectF value = QQmlStringConverters::rectFFromString(binding->valueAsString(&qmlUnit->header), &ok);
         if (ok) {
+            rememberConversion(step, property->propType, &value);
             argv[0] = &value;
             QMetaObject::metacall(_qobject, QMetaObject::WriteProperty, property->coreIndex, argv);
         } else {
@@ -828,6 +863,7 @@ void QmlObjectCreator::setPropertyValue(QQmlPropertyData *property, const QV4::C
             float zy;
         } vec;
         if (QQmlStringConverters::createFromString(QMetaType::QVector3D, binding->valueAsString(&qmlUnit->header), &vec, sizeof(vec))) {
+            rememberConversion(step, property->propType, &vec);
             argv[0] = reinterpret_cast<void *>(&vec);
             QMetaObject::metacall(_qobject, QMetaObject::WriteProperty, property->coreIndex, argv);
         } else {
@@ -843,6 +879,7 @@ void QmlObjectCreator::setPropertyValue(QQmlPropertyData *property, const QV4::C
             float wp;
         } vec;
         if (QQmlStringConverters::createFromString(QMetaType::QVector4D, binding->valueAsString(&qmlUnit->header), &vec, sizeof(vec))) {
+            rememberConversion(step, property->propType, &vec);
             argv[0] = reinterpret_cast<void *>(&vec);
             QMetaObject::metacall(_qobject, QMetaObject::WriteProperty, property->coreIndex, argv);
         } else {
@@ -941,6 +978,7 @@ void QmlObjectCreator::setPropertyValue(QQmlPropertyData *property, const QV4::C
                 break;
             }
 
+            rememberConversion(step, property->propType, value.constData());
             argv[0] = value.data();
             QMetaObject::metacall(_qobject, QMetaObject::WriteProperty, property->coreIndex, argv);
         } else {
@@ -970,19 +1008,30 @@ void QmlObjectCreator::setupBindings()
             idBinding.type = QV4::CompiledData::Binding::Type_String;
             idBinding.stringIndex = _compiledObject->idIndex;
             idBinding.location = _compiledObject->location; // ###
-            setPropertyValue(idProperty, &idBinding);
+            setPropertyValue(idProperty, &idBinding, /*step*/0);
         }
     }
 
-    const QV4::CompiledData::Binding *binding = _compiledObject->bindingTable();
-    for (quint32 i = 0; i < _compiledObject->nBindings; ++i, ++binding) {
+    // The lookup result only depends on the property cache unless the object carries a
+    // VME meta-object, where the context may select between overriding properties.
+    const bool canRememberLookups = !_ddata->hasVMEMetaObject;
 
-        QString name = stringAt(binding->propertyNameIndex);
-        if (name.isEmpty())
+    const QV4::CompiledData::Binding *binding = _compiledObject->bindingTable();
+    QQmlCompiledData::InstantiationStep *step = _instantiationSteps;
+    for (quint32 i = 0; i < _compiledObject->nBindings; ++i, ++binding, ++step) {
+
+        const bool resolved = step->propertyCache && step->propertyCache == _propertyCache.data();
+        QString name;
+        if (!resolved)
+            name = stringAt(binding->propertyNameIndex);
+        const bool isDefaultProperty = resolved ? step->isDefaultProperty : name.isEmpty();
+        if (isDefaultProperty)
             property = 0;
 
         if (!property || (i > 0 && (binding - 1)->propertyNameIndex != binding->propertyNameIndex)) {
-            if (!name.isEmpty())
+            if (resolved)
+                property = step->property;
+            else if (!isDefaultProperty)
                 property = _propertyCache->property(name, _qobject, context);
             else {
                 if (!defaultPropertyQueried) {
@@ -1000,6 +1049,15 @@ void QmlObjectCreator::setupBindings()
 
         }
 
+        if (!resolved && canRememberLookups) {
+            if (step->propertyCache)
+                step->propertyCache->release();
+            step->propertyCache = _propertyCache.data();
+            step->propertyCache->addref();
+            step->property = property;
+            step->isDefaultProperty = isDefaultProperty;
+        }
+
         if (!setPropertyValue(property, i, binding))
             return;
     }
@@ -1195,7 +1253,7 @@ bool QmlObjectCreator::setPropertyValue(QQmlPropertyData *property, int bindingI
         return false;
     }
 
-    setPropertyValue(property, binding);
+    setPropertyValue(property, binding, &_instantiationSteps[bindingIndex]);
     return true;
 }
 
@@ -1219,6 +1277,49 @@ void QmlObjectCreator::setupFunctions()
     }
 }
 
+/*!
+    Returns the number of binding slots needed to populate the object at \a index and
+    the objects it creates, including the instances of composite types.  Objects inside
+    of nested components are created separately and are not included.
+*/
+int QmlObjectCreator::bindingSlotsForObject(QQmlCompiledData *compiledData, int index)
+{
+    const QV4::CompiledData::Object *obj = compiledData->qmlUnit->objectAt(index);
+    int slots = obj->nBindings;
+
+    const QQmlCompiledData::TypeReference typeRef = compiledData->resolvedTypes.value(obj->inheritedTypeNameIndex);
+    if (!typeRef.type && typeRef.component)
+        slots += bindingSlotsForComponent(typeRef.component, -1);
+
+    const QV4::CompiledData::Binding *binding = obj->bindingTable();
+    for (quint32 i = 0; i < obj->nBindings; ++i, ++binding) {
+        if (binding->type < QV4::CompiledData::Binding::Type_Object)
+            continue;
+        if (!compiledData->isComponent(binding->value.objectIndex))
+            slots += bindingSlotsForObject(compiledData, binding->value.objectIndex);
+    }
+
+    return slots;
+}
+
+int QmlObjectCreator::bindingSlotsForComponent(QQmlCompiledData *compiledData, int subComponentIndex)
+{
+    QHash<int, int>::ConstIterator cached = compiledData->bindingSlotsPerComponent.find(subComponentIndex);
+    if (cached != compiledData->bindingSlotsPerComponent.constEnd())
+        return cached.value();
+
+    const QV4::CompiledData::QmlUnit *unit = compiledData->qmlUnit;
+    int objectIndex;
+    if (subComponentIndex == -1)
+        objectIndex = unit->indexOfRootObject;
+    else
+        objectIndex = unit->objectAt(subComponentIndex)->bindingTable()->value.objectIndex;
+
+    const int slots = bindingSlotsForObject(compiledData, objectIndex);
+    compiledData->bindingSlotsPerComponent.insert(subComponentIndex, slots);
+    return slots;
+}
+
 QObject *QmlObjectCreator::createInstance(int index, QObject *parent)
 {
     ActiveOCRestorer ocRestorer(this, QQmlEnginePrivate::get(engine));
@@ -1237,11 +1338,17 @@ QObject *QmlObjectCreator::createInstance(int index, QObject *parent)
         QQmlCompiledData::TypeReference typeRef = resolvedTypes.value(obj->inheritedTypeNameIndex);
         QQmlType *type = typeRef.type;
         if (type) {
-            instance = type->create();
+            // Allocate the QQmlData together with the object, like QQmlVME does
+            void *ddataMemory = 0;
+            type->create(&instance, &ddataMemory, sizeof(QQmlData));
             if (!instance) {
                 recordError(obj->location, tr("Unable to create object of type %1").arg(stringAt(obj->inheritedTypeNameIndex)));
                 return 0;
             }
+
+            QQmlData *ddata = new (ddataMemory) QQmlData;
+            ddata->ownMemory = false;
+            QObjectPrivate::get(instance)->declarativeData = ddata;
         } else {
             Q_ASSERT(typeRef.component);
             if (typeRef.component->qmlUnit->isSingleton())
@@ -1250,6 +1357,7 @@ QObject *QmlObjectCreator::createInstance(int index, QObject *parent)
                 return 0;
             }
             QmlObjectCreator subCreator(context, typeRef.component);
+            subCreator.allCreatedBindings = allCreatedBindings;
             instance = subCreator.create();
             if (!instance) {
                 errors += subCreator.errors;
@@ -1257,7 +1365,6 @@ QObject *QmlObjectCreator::createInstance(int index, QObject *parent)
             }
             if (subCreator.componentAttached)
                 subCreator.componentAttached->add(&componentAttached);
-            allCreatedBindings << subCreator.allCreatedBindings;
         }
         // ### use no-event variant
         if (parent)
@@ -1302,23 +1409,20 @@ void QmlObjectCreator::finalize()
     QQmlTrace trace("VME Binding Enable");
     trace.event("begin binding eval");
 
-    Q_ASSERT(allCreatedBindings.isEmpty() || allCreatedBindings.isDetached());
+    Q_ASSERT(allCreatedBindings == &createdBindingsStorage);
 
-    for (QLinkedList<QVector<QQmlAbstractBinding*> >::Iterator it = allCreatedBindings.begin(), end = allCreatedBindings.end();
-         it != end; ++it) {
-        const QVector<QQmlAbstractBinding *> &bindings = *it;
-        for (int i = 0; i < bindings.count(); ++i) {
-            QQmlAbstractBinding *b = bindings.at(i);
-            if (!b)
-                continue;
-            b->m_mePtr = 0;
-            QQmlData *data = QQmlData::get(b->object());
-            Q_ASSERT(data);
-            data->clearPendingBindingBit(b->propertyIndex());
-            b->setEnabled(true, QQmlPropertyPrivate::BypassInterceptor |
-                          QQmlPropertyPrivate::DontRemoveBinding);
-        }
+    for (int i = 0; i < createdBindingsStorage.count(); ++i) {
+        QQmlAbstractBinding *b = createdBindingsStorage.at(i);
+        if (!b)
+            continue;
+        b->m_mePtr = 0;
+        QQmlData *data = QQmlData::get(b->object());
+        Q_ASSERT(data);
+        data->clearPendingBindingBit(b->propertyIndex());
+        b->setEnabled(true, QQmlPropertyPrivate::BypassInterceptor |
+                      QQmlPropertyPrivate::DontRemoveBinding);
     }
+    createdBindingsStorage.deallocate();
     }
 
     {
@@ -1348,6 +1452,13 @@ bool QmlObjectCreator::populateInstance(int index, QObject *instance, QQmlRefPoi
 
     Q_ASSERT(scopeObjectForBindings);
 
+    // The binding slots of the whole instance were reserved up front from the compiled
+    // object tree.  Never write past them, even if the count turns out to be wrong.
+    if (allCreatedBindings->count() + int(obj->nBindings) > allCreatedBindings->capacity()) {
+        recordError(obj->location, tr("Internal error: more bindings than binding slots reserved for the component"));
+        return false;
+    }
+
     QQmlData *declarativeData = QQmlData::get(instance, /*create*/true);
 
     qSwap(_propertyCache, cache);
@@ -1375,9 +1486,25 @@ bool QmlObjectCreator::populateInstance(int index, QObject *instance, QQmlRefPoi
 
     qSwap(_vmeMetaObject, vmeMetaObject);
 
-    QVector<QQmlAbstractBinding*> createdBindings(_compiledObject->nBindings, 0);
+    // Reserve one slot per binding of this object in the preallocated block
+    QQmlAbstractBinding **createdBindings = 0;
+    if (_compiledObject->nBindings) {
+        const int firstSlot = allCreatedBindings->count();
+        for (quint32 i = 0; i < _compiledObject->nBindings; ++i)
+            allCreatedBindings->push(0);
+        createdBindings = &(*allCreatedBindings)[firstSlot];
+    }
     qSwap(_createdBindings, createdBindings);
 
+    QQmlCompiledData::InstantiationStep *instantiationSteps = 0;
+    if (_compiledObject->nBindings) {
+        QVector<QQmlCompiledData::InstantiationStep> &steps = compiledData->instantiationPlan[index];
+        if (steps.isEmpty())
+            steps.resize(_compiledObject->nBindings);
+        instantiationSteps = steps.data();
+    }
+    qSwap(_instantiationSteps, instantiationSteps);
+
     QV4::ExecutionEngine *v4 = QV8Engine::getV4(engine);
     QV4::Scope valueScope(v4);
     QV4::ScopedObject scopeObject(valueScope, QV4::QmlContextWrapper::qmlScope(QV8Engine::get(engine), context, _qobjectForBindings));
@@ -1389,10 +1516,9 @@ bool QmlObjectCreator::populateInstance(int index, QObject *instance, QQmlRefPoi
     setupBindings();
     setupFunctions();
 
-    allCreatedBindings.append(_createdBindings);
-
     qSwap(_qmlContext, qmlContext);
 
+    qSwap(_instantiationSteps, instantiationSteps);
     qSwap(_createdBindings, createdBindings);
     qSwap(_vmeMetaObject, vmeMetaObject);
     qSwap(_propertyCache, cache);
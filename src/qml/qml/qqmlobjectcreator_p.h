@@ -45,7 +45,7 @@
 #include <private/qqmltypenamecache_p.h>
 #include <private/qv4compileddata_p.h>
 #include <private/qqmlcompiler_p.h>
-#include <QLinkedList>
+#include <private/qfinitestack_p.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -149,6 +149,9 @@ public:
     QList<QQmlEnginePrivate::FinalizeCallback> finalizeCallbacks;
 
 private:
+    static int bindingSlotsForObject(QQmlCompiledData *compiledData, int index);
+    static int bindingSlotsForComponent(QQmlCompiledData *compiledData, int subComponentIndex);
+
     QObject *createInstance(int index, QObject *parent = 0);
 
     bool populateInstance(int index, QObject *instance, QQmlRefPointer<QQmlPropertyCache> cache,
@@ -156,7 +159,8 @@ private:
 
     void setupBindings();
     bool setPropertyValue(QQmlPropertyData *property, int index, const QV4::CompiledData::Binding *binding);
-    void setPropertyValue(QQmlPropertyData *property, const QV4::CompiledData::Binding *binding);
+    void setPropertyValue(QQmlPropertyData *property, const QV4::CompiledData::Binding *binding,
+                          QQmlCompiledData::InstantiationStep *step);
     void setupFunctions();
 
     QQmlEngine *engine;
@@ -167,7 +171,10 @@ private:
     const QList<QQmlPropertyCache *> propertyCaches;
     const QList<QByteArray> vmeMetaObjectData;
     QHash<int, int> objectIndexToId;
-    QLinkedList<QVector<QQmlAbstractBinding*> > allCreatedBindings;
+    // Binding slots for the whole instance, including the objects created by the
+    // creators of composite types, allocated in one block from QQmlCompiledData statistics.
+    QFiniteStack<QQmlAbstractBinding*> createdBindingsStorage;
+    QFiniteStack<QQmlAbstractBinding*> *allCreatedBindings;
     QQmlCompiledData *compiledData;
 
     QObject *_qobject;
@@ -177,7 +184,8 @@ private:
     QQmlData *_ddata;
     QQmlRefPointer<QQmlPropertyCache> _propertyCache;
     QQmlVMEMetaObject *_vmeMetaObject;
-    QVector<QQmlAbstractBinding*> _createdBindings;
+    QQmlAbstractBinding **_createdBindings;
+    QQmlCompiledData::InstantiationStep *_instantiationSteps;
     QQmlListProperty<void> _currentList;
     QV4::ExecutionContext *_qmlContext;
 };
@@ -0,0 +1,779 @@
+/****************************************************************************
+**
+** Copyright (C) 2013 Digia Plc and/or its subsidiary(-ies).
+** Contact: http://www.qt-project.org/legal
+**
+** This file is part of the QtQml module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Digia.  For licensing terms and
+** conditions see http://qt.digia.com/licensing.  For further information
+** use the contact form at http://qt.digia.com/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU Lesser General Public License version 2.1 requirements
+** will be met: http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Digia gives you certain additional
+** rights.  These rights are described in the Digia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met: http://www.gnu.org/copyleft/gpl.html.
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qqmltypedbinding_p.h"
+
+#include <private/qqmlengine_p.h>
+#include <private/qqmlcontext_p.h>
+#include <private/qqmldata_p.h>
+#include <private/qqmlproperty_p.h>
+#include <private/qqmltypenamecache_p.h>
+#include <private/qqmlprofilerservice_p.h>
+#include <private/qqmljsast_p.h>
+#include <private/qv4value_def_p.h>
+
+#include <QtCore/qvarlengtharray.h>
+
+#include <math.h>
+
+QT_BEGIN_NAMESPACE
+
+using namespace QQmlJS;
+
+// Register indices are stored as quint8
+static const int MaxRegisters = 255;
+
+QQmlTypedBindingProgram::QQmlTypedBindingProgram()
+: registerCount(1), subscriptionCount(0), resultType(Invalid)
+{
+}
+
+bool QQmlTypedBindingProgram::canStore(const QQmlPropertyData &core, Type type)
+{
+    if (core.isVarProperty() || core.isAlias() || core.isValueTypeVirtual() || core.isFunction())
+        return false;
+
+    switch (core.propType) {
+    case QMetaType::Int:
+    case QMetaType::Double:
+    case QMetaType::Float:
+        return type == Number;
+    case QMetaType::Bool:
+        return type == Bool;
+    case QMetaType::QString:
+    case QMetaType::QColor:
+        return type == String;
+    default:
+        return false;
+    }
+}
+
+QQmlTypedBindingCompiler::QQmlTypedBindingCompiler(QQmlEnginePrivate *engine, QQmlTypeNameCache *imports)
+: engine(engine), imports(imports), contextObject(0), scopeObject(0), program(0)
+{
+}
+
+void QQmlTypedBindingCompiler::beginContextScope(const QtQml::JSCodeGen::ObjectIdMapping &objectIds,
+                                                 QQmlPropertyCache *contextObject)
+{
+    this->idObjects = objectIds;
+    this->contextObject = contextObject;
+}
+
+QQmlTypedBindingProgram *QQmlTypedBindingCompiler::compile(AST::Node *node, QQmlPropertyCache *scopeObject,
+                                                           const QQmlPropertyData &target)
+{
+    AST::ExpressionNode *expression = 0;
+    if (AST::ExpressionStatement *statement = AST::cast<AST::ExpressionStatement *>(node))
+        expression = statement->expression;
+    else
+        expression = node->expressionCast();
+
+    if (!expression)
+        return 0;
+
+    this->scopeObject = scopeObject;
+    program = new Program;
+
+    Operand result;
+    if (!compileExpression(expression, 0, &result) || !Program::canStore(target, result.type)) {
+        program->release();
+        program = 0;
+        return 0;
+    }
+
+    program->resultType = result.type;
+    program->code.squeeze();
+
+    Program *rv = program;
+    program = 0;
+    return rv;
+}
+
+bool QQmlTypedBindingCompiler::compileExpression(AST::ExpressionNode *node, int dest, Operand *result)
+{
+    switch (node->kind) {
+    case AST::Node::Kind_NestedExpression:
+        return compileExpression(static_cast<AST::NestedExpression *>(node)->expression, dest, result);
+
+    case AST::Node::Kind_TrueLiteral:
+    case AST::Node::Kind_FalseLiteral:
+        emit(Program::LoadBool, dest, 0, 0, node->kind == AST::Node::Kind_TrueLiteral);
+        result->type = Program::Bool;
+        return true;
+
+    case AST::Node::Kind_NumericLiteral:
+        program->numbers.append(static_cast<AST::NumericLiteral *>(node)->value);
+        emit(Program::LoadNumber, dest, 0, 0, program->numbers.count() - 1);
+        result->type = Program::Number;
+        return true;
+
+    case AST::Node::Kind_StringLiteral:
+        program->strings.append(static_cast<AST::StringLiteral *>(node)->value.toString());
+        emit(Program::LoadString, dest, 0, 0, program->strings.count() - 1);
+        result->type = Program::String;
+        return true;
+
+    case AST::Node::Kind_IdentifierExpression:
+        return compileName(static_cast<AST::IdentifierExpression *>(node)->name.toString(), dest, result);
+
+    case AST::Node::Kind_FieldMemberExpression: {
+        AST::FieldMemberExpression *member = static_cast<AST::FieldMemberExpression *>(node);
+        Operand base;
+        if (!compileExpression(member->base, dest, &base) || base.type != Program::Object)
+            return false;
+
+        const QString name = member->name.toString();
+        QQmlPropertyData *property = base.objectType->property(name, /*object*/0, /*context*/0);
+        return property && compileProperty(base, property, name, dest, dest, result);
+    }
+
+    case AST::Node::Kind_UnaryMinusExpression:
+        if (!compileExpression(static_cast<AST::UnaryMinusExpression *>(node)->expression, dest, result)
+            || result->type != Program::Number)
+            return false;
+        emit(Program::Negate, dest, dest);
+        return true;
+
+    case AST::Node::Kind_UnaryPlusExpression:
+        return compileExpression(static_cast<AST::UnaryPlusExpression *>(node)->expression, dest, result)
+               && result->type == Program::Number;
+
+    case AST::Node::Kind_NotExpression:
+        if (!compileExpression(static_cast<AST::NotExpression *>(node)->expression, dest, result)
+            || result->type != Program::Bool)
+            return false;
+        emit(Program::Not, dest, dest);
+        return true;
+
+    case AST::Node::Kind_BinaryExpression:
+        return compileBinary(static_cast<AST::BinaryExpression *>(node), dest, result);
+
+    case AST::Node::Kind_ConditionalExpression:
+        return compileConditional(static_cast<AST::ConditionalExpression *>(node), dest, result);
+
+    default:
+        return false;
+    }
+}
+
+// Mirrors the lookup order of JSCodeGen::fallbackNameLookup(), so that a typed binding
+// always resolves a name to the same object as the JavaScript version would.
+bool QQmlTypedBindingCompiler::compileName(const QString &name, int dest, Operand *result)
+{
+    foreach (const QtQml::JSCodeGen::IdMapping &mapping, idObjects) {
+        if (mapping.name != name)
+            continue;
+        if (!mapping.type)
+            return false;
+
+        emit(Program::LoadIdObject, dest, 0, 0, mapping.idIndex, program->subscriptionCount++);
+        result->type = Program::Object;
+        result->objectType = mapping.type;
+        result->isDynamic = false;
+        return true;
+    }
+
+    // Types, singletons and namespaces need the JavaScript engine
+    if (imports) {
+        QQmlTypeNameCache::Result r = imports->query(name);
+        if (r.isValid())
+            return false;
+    }
+
+    if (scopeObject) {
+        if (QQmlPropertyData *property = scopeObject->property(name, /*object*/0, /*context*/0)) {
+            Operand base;
+            base.type = Program::Object;
+            base.objectType = scopeObject;
+            emit(Program::LoadScopeObject, dest);
+            return compileProperty(base, property, name, dest, dest, result);
+        }
+    }
+
+    if (contextObject) {
+        if (QQmlPropertyData *property = contextObject->property(name, /*object*/0, /*context*/0)) {
+            Operand base;
+            base.type = Program::Object;
+            base.objectType = contextObject;
+            emit(Program::LoadContextObject, dest);
+            return compileProperty(base, property, name, dest, dest, result);
+        }
+    }
+
+    return false;
+}
+
+bool QQmlTypedBindingCompiler::compileProperty(const Operand &base, QQmlPropertyData *property,
+                                               const QString &name, int src, int dest, Operand *result)
+{
+    if (property->isFunction() || !base.objectType->isAllowedInRevision(property))
+        return false;
+
+    QQmlPropertyCache *objectType = 0;
+    Program::Type type = typeForProperty(*property, &objectType);
+    if (type == Program::Invalid)
+        return false;
+
+    // Without a notifier the binding could never be updated
+    const bool hasNotifier = property->notifyIndex != -1
+                             || (property->hasAccessors() && property->accessors->notifier);
+    if (!property->isConstant() && !hasNotifier)
+        return false;
+
+    Program::Property p;
+    p.core = *property;
+    p.name = name;
+    p.dynamicBase = base.isDynamic;
+    program->properties.append(p);
+
+    emit(Program::LoadProperty, dest, src, 0, program->properties.count() - 1,
+         property->isConstant() ? -1 : program->subscriptionCount++);
+
+    result->type = type;
+    result->objectType = objectType;
+    result->isDynamic = true;
+    return true;
+}
+
+bool QQmlTypedBindingCompiler::compileBinary(AST::BinaryExpression *node, int dest, Operand *result)
+{
+    if (node->op == QSOperator::And || node->op == QSOperator::Or) {
+        Operand left;
+        if (!compileExpression(node->left, dest, &left) || left.type != Program::Bool)
+            return false;
+
+        int jump = emit(node->op == QSOperator::And ? Program::JumpIfFalse : Program::JumpIfTrue,
+                        dest, dest);
+
+        if (!compileExpression(node->right, dest, result) || result->type != Program::Bool)
+            return false;
+
+        patchJump(jump);
+        return true;
+    }
+
+    Operand left;
+    Operand right;
+    if (!useRegister(dest + 1)
+        || !compileExpression(node->left, dest, &left)
+        || !compileExpression(node->right, dest + 1, &right)
+        || left.type != right.type)
+        return false;
+
+    Program::Operation operation;
+    Program::Type type = left.type;
+
+    switch (node->op) {
+    case QSOperator::Add:
+        if (type == Program::String)
+            operation = Program::Concat;
+        else if (type == Program::Number)
+            operation = Program::Add;
+        else
+            return false;
+        break;
+    case QSOperator::Sub: operation = Program::Sub; break;
+    case QSOperator::Mul: operation = Program::Mul; break;
+    case QSOperator::Div: operation = Program::Div; break;
+    case QSOperator::Mod: operation = Program::Mod; break;
+    case QSOperator::Lt: operation = Program::LessThan; type = Program::Bool; break;
+    case QSOperator::Gt: operation = Program::GreaterThan; type = Program::Bool; break;
+    case QSOperator::Le: operation = Program::LessEqual; type = Program::Bool; break;
+    case QSOperator::Ge: operation = Program::GreaterEqual; type = Program::Bool; break;
+    case QSOperator::Equal:
+    case QSOperator::StrictEqual:
+    case QSOperator::NotEqual:
+    case QSOperator::StrictNotEqual: {
+        const bool equal = node->op == QSOperator::Equal || node->op == QSOperator::StrictEqual;
+        if (type == Program::Number)
+            operation = equal ? Program::NumberEqual : Program::NumberNotEqual;
+        else if (type == Program::Bool)
+            operation = equal ? Program::BoolEqual : Program::BoolNotEqual;
+        else if (type == Program::String)
+            operation = equal ? Program::StringEqual : Program::StringNotEqual;
+        else
+            return false;
+        result->type = Program::Bool;
+        emit(operation, dest, dest, dest + 1);
+        return true;
+    }
+    default:
+        return false;
+    }
+
+    // The remaining operators are only defined for numbers
+    if (operation != Program::Concat && left.type != Program::Number)
+        return false;
+
+    result->type = type;
+    emit(operation, dest, dest, dest + 1);
+    return true;
+}
+
+bool QQmlTypedBindingCompiler::compileConditional(AST::ConditionalExpression *node, int dest, Operand *result)
+{
+    Operand condition;
+    if (!compileExpression(node->expression, dest, &condition) || condition.type != Program::Bool)
+        return false;
+
+    int jumpToFalse = emit(Program::JumpIfFalse, dest, dest);
+
+    Operand ok;
+    if (!compileExpression(node->ok, dest, &ok))
+        return false;
+
+    int jumpToEnd = emit(Program::Jump, dest);
+    patchJump(jumpToFalse);
+
+    Operand ko;
+    if (!compileExpression(node->ko, dest, &ko))
+        return false;
+
+    patchJump(jumpToEnd);
+
+    if (ok.type != ko.type || (ok.type == Program::Object && ok.objectType != ko.objectType))
+        return false;
+
+    result->type = ok.type;
+    result->objectType = ok.objectType;
+    result->isDynamic = ok.isDynamic || ko.isDynamic;
+    return true;
+}
+
+QQmlTypedBindingProgram::Type QQmlTypedBindingCompiler::typeForProperty(const QQmlPropertyData &property,
+                                                                        QQmlPropertyCache **objectType)
+{
+    if (property.isVarProperty() || property.isQList())
+        return Program::Invalid;
+
+    if (property.isQObject()) {
+        *objectType = engine->propertyCacheForType(property.propType);
+        return *objectType ? Program::Object : Program::Invalid;
+    }
+
+    if (property.isEnum())
+        return Program::Number;
+
+    switch (property.propType) {
+    case QMetaType::Int:
+    case QMetaType::UInt:
+    case QMetaType::Double:
+    case QMetaType::Float:
+        return Program::Number;
+    case QMetaType::Bool:
+        return Program::Bool;
+    case QMetaType::QString:
+        return Program::String;
+    default:
+        return Program::Invalid;
+    }
+}
+
+int QQmlTypedBindingCompiler::emit(Program::Operation operation, int dest, int src1, int src2, int index,
+                                   int subscription)
+{
+    Program::Instruction instruction;
+    instruction.operation = operation;
+    instruction.dest = dest;
+    instruction.src1 = src1;
+    instruction.src2 = src2;
+    instruction.index = index;
+    instruction.subscription = subscription;
+    program->code.append(instruction);
+    return program->code.count() - 1;
+}
+
+bool QQmlTypedBindingCompiler::useRegister(int reg)
+{
+    if (reg >= MaxRegisters)
+        return false;
+    program->registerCount = qMax(program->registerCount, reg + 1);
+    return true;
+}
+
+QQmlAbstractBinding::VTable QQmlTypedBinding_vtable = {
+    QQmlAbstractBinding::default_destroy<QQmlTypedBinding>,
+    QQmlAbstractBinding::default_expression,
+    QQmlTypedBinding::propertyIndex,
+    QQmlTypedBinding::object,
+    QQmlTypedBinding::setEnabled,
+    QQmlTypedBinding::update,
+    QQmlAbstractBinding::default_retargetBinding
+};
+
+QQmlTypedBinding::QQmlTypedBinding(QQmlTypedBindingProgram *program, QObject *scope, QQmlContextData *ctxt,
+                                   const QString &url, quint16 lineNumber, quint16 columnNumber)
+: QQmlAbstractBinding(Typed), m_program(program), m_scope(scope), m_target(0), m_subscriptions(0),
+  m_url(url), m_lineNumber(lineNumber), m_columnNumber(columnNumber), m_enabled(false), m_updating(false)
+{
+    QQmlAbstractExpression::setContext(ctxt);
+
+    if (program->subscriptionCount) {
+        m_subscriptions = new Subscription[program->subscriptionCount];
+        for (int ii = 0; ii < program->subscriptionCount; ++ii)
+            m_subscriptions[ii].binding = this;
+    }
+}
+
+QQmlTypedBinding::~QQmlTypedBinding()
+{
+    delete [] m_subscriptions;
+}
+
+void QQmlTypedBinding::setTarget(QObject *object, const QQmlPropertyData &core)
+{
+    m_target = object;
+    m_core = core;
+}
+
+void QQmlTypedBinding::refresh()
+{
+    update();
+}
+
+int QQmlTypedBinding::propertyIndex(const QQmlAbstractBinding *This)
+{
+    return static_cast<const QQmlTypedBinding *>(This)->m_core.encodedIndex();
+}
+
+QObject *QQmlTypedBinding::object(const QQmlAbstractBinding *This)
+{
+    return static_cast<const QQmlTypedBinding *>(This)->m_target;
+}
+
+void QQmlTypedBinding::setEnabled(QQmlAbstractBinding *This, bool e, QQmlPropertyPrivate::WriteFlags f)
+{
+    static_cast<QQmlTypedBinding *>(This)->setEnabled(e, f);
+}
+
+void QQmlTypedBinding::update(QQmlAbstractBinding *This, QQmlPropertyPrivate::WriteFlags f)
+{
+    static_cast<QQmlTypedBinding *>(This)->update(f);
+}
+
+void QQmlTypedBinding::setEnabled(bool e, QQmlPropertyPrivate::WriteFlags flags)
+{
+    m_enabled = e;
+
+    if (e)
+        update(flags);
+    else
+        disconnectSubscriptions();
+}
+
+void QQmlTypedBinding::update(QQmlPropertyPrivate::WriteFlags flags)
+{
+    if (!m_enabled || !context() || !context()->isValid())
+        return;
+
+    // Check that the target has not been deleted
+    if (QQmlData::wasDeleted(m_target))
+        return;
+
+    if (m_updating) {
+        QQmlProperty p = QQmlPropertyPrivate::restore(m_target, m_core, context());
+        QQmlAbstractBinding::printBindingLoopError(p);
+        return;
+    }
+
+    QQmlBindingProfiler prof(m_url, qmlSourceCoordinate(m_lineNumber), qmlSourceCoordinate(m_columnNumber),
+                             QQmlProfilerService::QmlBinding);
+    m_updating = true;
+
+    QQmlAbstractExpression::DeleteWatcher watcher(this);
+
+    for (int ii = 0; ii < m_program->subscriptionCount; ++ii)
+        m_subscriptions[ii].used = false;
+
+    QVarLengthArray<Register, 8> registers(m_program->registerCount);
+    const bool ok = run(registers.data(), watcher);
+    if (!watcher.wasDeleted()) {
+        // Like the captured properties of a QQmlBinding, dependencies read by a branch
+        // that was not taken this time must not trigger further updates.
+        disconnectUnusedSubscriptions();
+        if (ok)
+            write(registers[0], flags);
+    }
+
+    if (!watcher.wasDeleted())
+        m_updating = false;
+}
+
+bool QQmlTypedBinding::run(Register *registers, QQmlAbstractExpression::DeleteWatcher &watcher)
+{
+    typedef QQmlTypedBindingProgram Program;
+
+    const Program *program = m_program.data();
+    const Program::Instruction *code = program->code.constData();
+    const int count = program->code.count();
+
+    for (int pc = 0; pc < count;) {
+        const Program::Instruction &instr = code[pc++];
+        Register &dest = registers[instr.dest];
+        const Register &src1 = registers[instr.src1];
+        const Register &src2 = registers[instr.src2];
+
+        switch (instr.operation) {
+        case Program::LoadBool: dest.boolean = instr.index; break;
+        case Program::LoadNumber: dest.number = program->numbers.at(instr.index); break;
+        case Program::LoadString: dest.string = program->strings.at(instr.index); break;
+        case Program::LoadScopeObject: dest.object = m_scope; break;
+        case Program::LoadContextObject: dest.object = context()->contextObject; break;
+        case Program::LoadIdObject: {
+            Q_ASSERT(instr.index < context()->idValueCount);
+            QQmlContextData::ContextGuard &id = context()->idValues[instr.index];
+            subscribe(instr.subscription, &id.bindings);
+            dest.object = id.data();
+            break;
+        }
+        case Program::LoadProperty: {
+            const Program::Property &property = program->properties.at(instr.index);
+            QObject *object = src1.object;
+            if (!object) {
+                reportError(QString(QLatin1String("TypeError: Cannot read property '%1' of null")).arg(property.name));
+                return false;
+            }
+            if (!loadProperty(property, object, instr.subscription, &dest) || watcher.wasDeleted())
+                return false;
+            break;
+        }
+        case Program::Negate: dest.number = -src1.number; break;
+        case Program::Not: dest.boolean = !src1.boolean; break;
+        case Program::Add: dest.number = src1.number + src2.number; break;
+        case Program::Sub: dest.number = src1.number - src2.number; break;
+        case Program::Mul: dest.number = src1.number * src2.number; break;
+        case Program::Div: dest.number = src1.number / src2.number; break;
+        case Program::Mod: dest.number = ::fmod(src1.number, src2.number); break;
+        case Program::Concat: dest.string = src1.string + src2.string; break;
+        case Program::LessThan: dest.boolean = src1.number < src2.number; break;
+        case Program::GreaterThan: dest.boolean = src1.number > src2.number; break;
+        case Program::LessEqual: dest.boolean = src1.number <= src2.number; break;
+        case Program::GreaterEqual: dest.boolean = src1.number >= src2.number; break;
+        case Program::NumberEqual: dest.boolean = src1.number == src2.number; break;
+        case Program::NumberNotEqual: dest.boolean = src1.number != src2.number; break;
+        case Program::BoolEqual: dest.boolean = src1.boolean == src2.boolean; break;
+        case Program::BoolNotEqual: dest.boolean = src1.boolean != src2.boolean; break;
+        case Program::StringEqual: dest.boolean = src1.string == src2.string; break;
+        case Program::StringNotEqual: dest.boolean = src1.string != src2.string; break;
+        case Program::Jump: pc = instr.index; break;
+        case Program::JumpIfFalse: if (!src1.boolean) pc = instr.index; break;
+        case Program::JumpIfTrue: if (src1.boolean) pc = instr.index; break;
+        default:
+            Q_UNREACHABLE();
+        }
+    }
+
+    return true;
+}
+
+bool QQmlTypedBinding::loadProperty(const QQmlTypedBindingProgram::Property &property, QObject *object,
+                                    int subscription, Register *result)
+{
+    const QQmlPropertyData *core = &property.core;
+
+    // The object was only known by its static type at compile time.  A QML subclass may
+    // declare a property of the same name, which is the one JavaScript would see.
+    if (property.dynamicBase) {
+        QQmlData *ddata = QQmlData::get(object, false);
+        if (ddata && ddata->hasVMEMetaObject && ddata->propertyCache) {
+            QQmlPropertyData *local = ddata->propertyCache->property(property.name, object, context());
+            if (!local || local->isFunction() || local->propType != core->propType) {
+                reportError(QString(QLatin1String("Unable to read property '%1' of %2"))
+                            .arg(property.name).arg(QString::fromUtf8(object->metaObject()->className())));
+                return false;
+            }
+            core = local;
+        }
+    }
+
+    QQmlData::flushPendingBinding(object, core->coreIndex);
+
+    int intValue = 0;
+    uint uintValue = 0;
+    float floatValue = 0;
+    void *output = 0;
+
+    if (core->isQObject() || core->isEnum()) {
+        output = core->isQObject() ? static_cast<void *>(&result->object) : static_cast<void *>(&intValue);
+    } else {
+        switch (core->propType) {
+        case QMetaType::Int: output = &intValue; break;
+        case QMetaType::UInt: output = &uintValue; break;
+        case QMetaType::Double: output = &result->number; break;
+        case QMetaType::Float: output = &floatValue; break;
+        case QMetaType::Bool: output = &result->boolean; break;
+        case QMetaType::QString: output = &result->string; break;
+        default:
+            Q_UNREACHABLE();
+            return false;
+        }
+    }
+
+    if (core->hasAccessors()) {
+        core->accessors->read(object, core->accessorData, output);
+    } else {
+        void *args[] = { output, 0 };
+        if (core->isDirect())
+            object->qt_metacall(QMetaObject::ReadProperty, core->coreIndex, args);
+        else
+            QMetaObject::metacall(object, QMetaObject::ReadProperty, core->coreIndex, args);
+    }
+
+    if (subscription != -1) {
+        if (core->hasAccessors() && core->accessors->notifier) {
+            QQmlNotifier *notifier = 0;
+            core->accessors->notifier(object, core->accessorData, &notifier);
+            if (notifier)
+                subscribe(subscription, notifier);
+        } else {
+            subscribe(subscription, object, core->notifyIndex);
+        }
+    }
+
+    if (output == &intValue)
+        result->number = intValue;
+    else if (output == &uintValue)
+        result->number = uintValue;
+    else if (output == &floatValue)
+        result->number = floatValue;
+
+    return true;
+}
+
+void QQmlTypedBinding::subscribe(int index, QObject *object, int notifyIndex)
+{
+    Q_ASSERT(index >= 0 && index < m_program->subscriptionCount);
+    Subscription &s = m_subscriptions[index];
+    s.used = true;
+    if (notifyIndex == -1) {
+        s.disconnect();
+    } else if (!s.isConnected(object, notifyIndex)) {
+        s.connect(object, notifyIndex, context()->engine);
+    }
+}
+
+void QQmlTypedBinding::subscribe(int index, QQmlNotifier *notifier)
+{
+    Q_ASSERT(index >= 0 && index < m_program->subscriptionCount);
+    Subscription &s = m_subscriptions[index];
+    s.used = true;
+    if (!s.isConnected(notifier))
+        s.connect(notifier);
+}
+
+void QQmlTypedBinding::disconnectSubscriptions()
+{
+    for (int ii = 0; ii < m_program->subscriptionCount; ++ii)
+        m_subscriptions[ii].disconnect();
+}
+
+void QQmlTypedBinding::disconnectUnusedSubscriptions()
+{
+    for (int ii = 0; ii < m_program->subscriptionCount; ++ii) {
+        if (!m_subscriptions[ii].used)
+            m_subscriptions[ii].disconnect();
+    }
+}
+
+void QQmlTypedBinding::write(const Register &result, QQmlPropertyPrivate::WriteFlags flags)
+{
+    if (m_core.propType == QMetaType::QColor) {
+        QQmlPropertyPrivate::write(m_target, m_core, QVariant(result.string), context(), flags);
+        return;
+    }
+
+    int status = -1;
+    void *a[] = { 0, 0, &status, &flags };
+
+    switch (m_core.propType) {
+    case QMetaType::Int: {
+        int value = QV4::Primitive::toInt32(result.number);
+        a[0] = &value;
+        QMetaObject::metacall(m_target, QMetaObject::WriteProperty, m_core.coreIndex, a);
+        break;
+    }
+    case QMetaType::Double: {
+        double value = result.number;
+        a[0] = &value;
+        QMetaObject::metacall(m_target, QMetaObject::WriteProperty, m_core.coreIndex, a);
+        break;
+    }
+    case QMetaType::Float: {
+        float value = result.number;
+        a[0] = &value;
+        QMetaObject::metacall(m_target, QMetaObject::WriteProperty, m_core.coreIndex, a);
+        break;
+    }
+    case QMetaType::Bool: {
+        bool value = result.boolean;
+        a[0] = &value;
+        QMetaObject::metacall(m_target, QMetaObject::WriteProperty, m_core.coreIndex, a);
+        break;
+    }
+    case QMetaType::QString: {
+        QString value = result.string;
+        a[0] = &value;
+        QMetaObject::metacall(m_target, QMetaObject::WriteProperty, m_core.coreIndex, a);
+        break;
+    }
+    default:
+        Q_UNREACHABLE();
+    }
+}
+
+void QQmlTypedBinding::reportError(const QString &description)
+{
+    QQmlError error;
+    error.setUrl(QUrl(m_url));
+    error.setLine(qmlSourceCoordinate(m_lineNumber));
+    error.setColumn(qmlSourceCoordinate(m_columnNumber));
+    error.setDescription(description);
+    QQmlEnginePrivate::warning(QQmlEnginePrivate::get(context()->engine), error);
+}
+
+void QQmlTypedBindingSubscription_callback(QQmlNotifierEndpoint *e, void **)
+{
+    QQmlTypedBinding *binding = static_cast<QQmlTypedBinding::Subscription *>(e)->binding;
+    binding->update();
+}
+
+QT_END_NAMESPACE
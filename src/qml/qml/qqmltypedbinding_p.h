@@ -0,0 +1,253 @@
+/****************************************************************************
+**
+** Copyright (C) 2013 Digia Plc and/or its subsidiary(-ies).
+** Contact: http://www.qt-project.org/legal
+**
+** This file is part of the QtQml module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Digia.  For licensing terms and
+** conditions see http://qt.digia.com/licensing.  For further information
+** use the contact form at http://qt.digia.com/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU Lesser General Public License version 2.1 requirements
+** will be met: http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Digia gives you certain additional
+** rights.  These rights are described in the Digia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met: http://www.gnu.org/copyleft/gpl.html.
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QQMLTYPEDBINDING_P_H
+#define QQMLTYPEDBINDING_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <private/qqmlabstractbinding_p.h>
+#include <private/qqmlabstractexpression_p.h>
+#include <private/qqmlpropertycache_p.h>
+#include <private/qqmlnotifier_p.h>
+#include <private/qqmlrefcount_p.h>
+#include <private/qqmlcodegenerator_p.h>
+#include <private/qqmljsastfwd_p.h>
+
+#include <QtCore/qvector.h>
+#include <QtCore/qstringlist.h>
+
+QT_BEGIN_NAMESPACE
+
+class QQmlEnginePrivate;
+class QQmlTypeNameCache;
+
+// A typed binding program is a small register based bytecode for binding expressions
+// whose operand types are fully known at compile time, such as "parent.width - 10" or
+// "root.active ? 'red' : 'blue'".  It reads properties through QQmlAccessors or the
+// meta-object system and subscribes to their notifiers directly, without entering the
+// JavaScript engine.
+class QQmlTypedBindingProgram : public QQmlRefCount
+{
+public:
+    enum Type { Invalid, Bool, Number, String, Object };
+
+    enum Operation {
+        LoadBool,           // r[dest].boolean = index
+        LoadNumber,         // r[dest].number = numbers[index]
+        LoadString,         // r[dest].string = strings[index]
+        LoadScopeObject,    // r[dest].object = scope object
+        LoadContextObject,  // r[dest].object = context object
+        LoadIdObject,       // r[dest].object = id object index, subscribes to the id
+        LoadProperty,       // r[dest] = r[src1].object->properties[index]
+        Negate,             // r[dest].number = -r[src1].number
+        Not,                // r[dest].boolean = !r[src1].boolean
+        Add,
+        Sub,
+        Mul,
+        Div,
+        Mod,
+        Concat,
+        LessThan,
+        GreaterThan,
+        LessEqual,
+        GreaterEqual,
+        NumberEqual,
+        NumberNotEqual,
+        BoolEqual,
+        BoolNotEqual,
+        StringEqual,
+        StringNotEqual,
+        Jump,               // pc = index
+        JumpIfFalse,        // if (!r[src1].boolean) pc = index
+        JumpIfTrue          // if (r[src1].boolean) pc = index
+    };
+
+    struct Instruction {
+        quint8 operation;
+        quint8 dest;
+        quint8 src1;
+        quint8 src2;
+        int index;
+        int subscription;   // -1 for loads that need no notification
+    };
+
+    struct Property {
+        QQmlPropertyData core;
+        QString name;
+        // True if the object the property is read from is only known by its static
+        // type, in which case QML declared properties are resolved again by name.
+        bool dynamicBase;
+    };
+
+    QQmlTypedBindingProgram();
+
+    QVector<Instruction> code;
+    QVector<double> numbers;
+    QStringList strings;
+    QVector<Property> properties;
+    int registerCount;
+    int subscriptionCount;
+    Type resultType;
+
+    static bool canStore(const QQmlPropertyData &core, Type type);
+};
+
+class QQmlTypedBindingCompiler
+{
+public:
+    QQmlTypedBindingCompiler(QQmlEnginePrivate *engine, QQmlTypeNameCache *imports);
+
+    void beginContextScope(const QtQml::JSCodeGen::ObjectIdMapping &objectIds,
+                           QQmlPropertyCache *contextObject);
+
+    // Returns 0 if the expression is not suitable for a typed binding to \a target
+    QQmlTypedBindingProgram *compile(QQmlJS::AST::Node *node, QQmlPropertyCache *scopeObject,
+                                     const QQmlPropertyData &target);
+
+private:
+    typedef QQmlTypedBindingProgram Program;
+
+    struct Operand {
+        Operand() : type(Program::Invalid), objectType(0), isDynamic(false) {}
+        Program::Type type;
+        QQmlPropertyCache *objectType;
+        bool isDynamic;
+    };
+
+    bool compileExpression(QQmlJS::AST::ExpressionNode *node, int dest, Operand *result);
+    bool compileName(const QString &name, int dest, Operand *result);
+    bool compileProperty(const Operand &base, QQmlPropertyData *property, const QString &name,
+                         int src, int dest, Operand *result);
+    bool compileBinary(QQmlJS::AST::BinaryExpression *node, int dest, Operand *result);
+    bool compileConditional(QQmlJS::AST::ConditionalExpression *node, int dest, Operand *result);
+
+    Program::Type typeForProperty(const QQmlPropertyData &property, QQmlPropertyCache **objectType);
+    int emit(Program::Operation operation, int dest, int src1 = 0, int src2 = 0, int index = 0,
+             int subscription = -1);
+    void patchJump(int instruction) { program->code[instruction].index = program->code.count(); }
+    bool useRegister(int reg);
+
+    QQmlEnginePrivate *engine;
+    QQmlTypeNameCache *imports;
+    QtQml::JSCodeGen::ObjectIdMapping idObjects;
+    QQmlPropertyCache *contextObject;
+    QQmlPropertyCache *scopeObject;
+    Program *program;
+};
+
+class QQmlTypedBinding : public QQmlAbstractExpression,
+                         public QQmlAbstractBinding
+{
+public:
+    QQmlTypedBinding(QQmlTypedBindingProgram *program, QObject *scope, QQmlContextData *ctxt,
+                     const QString &url, quint16 lineNumber, quint16 columnNumber);
+
+    void setTarget(QObject *, const QQmlPropertyData &);
+
+    // Inherited from QQmlAbstractExpression
+    virtual void refresh();
+
+    // "Inherited" from QQmlAbstractBinding
+    static int propertyIndex(const QQmlAbstractBinding *);
+    static QObject *object(const QQmlAbstractBinding *);
+    static void setEnabled(QQmlAbstractBinding *, bool, QQmlPropertyPrivate::WriteFlags);
+    static void update(QQmlAbstractBinding *, QQmlPropertyPrivate::WriteFlags);
+
+    void setEnabled(bool, QQmlPropertyPrivate::WriteFlags flags);
+    void update(QQmlPropertyPrivate::WriteFlags flags);
+    void update() { update(QQmlPropertyPrivate::DontRemoveBinding); }
+
+    struct Subscription : public QQmlNotifierEndpoint
+    {
+        Subscription() : binding(0), used(false) { setCallback(QQmlNotifierEndpoint::QQmlTypedBindingSubscription); }
+        QQmlTypedBinding *binding;
+        bool used; // Touched by the current evaluation
+    };
+
+protected:
+    friend class QQmlAbstractBinding;
+    ~QQmlTypedBinding();
+
+private:
+    struct Register {
+        Register() : number(0), boolean(false), object(0) {}
+        double number;
+        bool boolean;
+        QObject *object;
+        QString string;
+    };
+
+    bool run(Register *registers, QQmlAbstractExpression::DeleteWatcher &watcher);
+    bool loadProperty(const QQmlTypedBindingProgram::Property &property, QObject *object,
+                      int subscription, Register *result);
+    void subscribe(int index, QObject *object, int notifyIndex);
+    void subscribe(int index, QQmlNotifier *notifier);
+    void write(const Register &result, QQmlPropertyPrivate::WriteFlags flags);
+    void reportError(const QString &description);
+    void disconnectSubscriptions();
+    void disconnectUnusedSubscriptions();
+
+    QQmlRefPointer<QQmlTypedBindingProgram> m_program;
+    QObject *m_scope;
+    QObject *m_target;
+    QQmlPropertyData m_core;
+    Subscription *m_subscriptions;
+
+    QString m_url;
+    quint16 m_lineNumber;
+    quint16 m_columnNumber;
+    bool m_enabled:1;
+    bool m_updating:1;
+};
+
+QT_END_NAMESPACE
+
+#endif // QQMLTYPEDBINDING_P_H
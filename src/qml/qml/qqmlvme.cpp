@@ -54,6 +54,7 @@
 #include "qqmlcomponent.h"
 #include "qqmlcomponentattached_p.h"
 #include "qqmlbinding_p.h"
+#include "qqmltypedbinding_p.h"
 #include "qqmlengine_p.h"
 #include "qqmlcomponent_p.h"
 #include "qqmlvmemetaobject_p.h"
@@ -890,6 +891,32 @@ QObject *QQmlVME::run(QList<QQmlError> *errors,
             }
         QML_END_INSTR(StoreBinding)
 
+        QML_BEGIN_INSTR(StoreTypedBinding)
+            QObject *target = objects.top();
+            QObject *scope =
+                objects.at(objects.count() - 1 - instr.context);
+
+            if (instr.isRoot && BINDINGSKIPLIST.testBit(instr.property.coreIndex))
+                QML_NEXT_INSTR(StoreTypedBinding);
+
+            QQmlTypedBinding *bind = new QQmlTypedBinding(COMP->typedBindingPrograms.at(instr.programIndex),
+                                                          scope, CTXT, COMP->name, instr.line, instr.column);
+            bindValues.push(bind);
+            bind->m_mePtr = &bindValues.top();
+            bind->setTarget(target, instr.property);
+
+            typedef QQmlPropertyPrivate QDPP;
+            Q_ASSERT(bind->propertyIndex() == QDPP::bindingIndex(instr.property));
+
+            CLEAN_PROPERTY(target, QDPP::bindingIndex(instr.property));
+
+            bind->addToObject();
+
+            QQmlData *data = QQmlData::get(target);
+            Q_ASSERT(data);
+            data->setPendingBindingBit(target, instr.property.coreIndex);
+        QML_END_INSTR(StoreTypedBinding)
+
         QML_BEGIN_INSTR(StoreValueSource)
             QObject *obj = objects.pop();
             QQmlPropertyValueSource *vs = reinterpret_cast<QQmlPropertyValueSource *>(reinterpret_cast<char *>(obj) + instr.castValue);
@@ -62,10 +62,18 @@
 #include <QtCore/qtextcodec.h>
 #include <QtCore/qxmlstream.h>
 #include <QtCore/qstack.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qrunnable.h>
+#include <QtCore/qthreadpool.h>
+#include <QtCore/qcoreapplication.h>
+#include <QtCore/qjsondocument.h>
+#include <QtCore/qjsonarray.h>
+#include <QtCore/qjsonobject.h>
 #include <QtCore/qdebug.h>
 
 #include <private/qv4objectproto_p.h>
 #include <private/qv4scopedvalue_p.h>
+#include <private/qv4jsonobject_p.h>
 
 using namespace QV4;
 
@@ -402,7 +410,8 @@ public:
 
     // C++ API
     static ReturnedValue prototype(ExecutionEngine *);
-    static ReturnedValue load(QV8Engine *engine, const QByteArray &data);
+    static DocumentImpl *parse(const QByteArray &data);
+    static ReturnedValue wrap(QV8Engine *engine, DocumentImpl *document);
 };
 
 }
@@ -799,12 +808,10 @@ ReturnedValue Document::prototype(ExecutionEngine *v4)
     return d->documentPrototype.value();
 }
 
-ReturnedValue Document::load(QV8Engine *engine, const QByteArray &data)
+// Builds the document tree without touching the engine, so that it can be
+// run on a worker thread.  The caller owns the returned reference.
+DocumentImpl *Document::parse(const QByteArray &data)
 {
-    Q_ASSERT(engine);
-    ExecutionEngine *v4 = QV8Engine::getV4(engine);
-    Scope scope(v4);
-
     DocumentImpl *document = 0;
     QStack<NodeImpl *> nodeStack;
 
@@ -880,9 +887,21 @@ ReturnedValue Document::load(QV8Engine *engine, const QByteArray &data)
     if (!document || reader.hasError()) {
         if (document)
             document->release();
-        return Encode::null();
+        return 0;
     }
 
+    return document;
+}
+
+ReturnedValue Document::wrap(QV8Engine *engine, DocumentImpl *document)
+{
+    Q_ASSERT(engine);
+    ExecutionEngine *v4 = QV8Engine::getV4(engine);
+    Scope scope(v4);
+
+    if (!document)
+        return Encode::null();
+
     ScopedObject instance(scope, new (v4->memoryManager) Node(v4, document));
     ScopedObject p(scope);
     instance->setPrototype((p = Document::prototype(v4)).getPointer());
@@ -1041,6 +1060,34 @@ ReturnedValue Document::method_xmlEncoding(CallContext *ctx)
     return engine->toString(static_cast<DocumentImpl *>(r->d)->encoding);
 }
 
+#ifndef QT_NO_TEXTCODEC
+static QTextCodec *findTextCodec(const QByteArray &body, const QByteArray &mime,
+                                 const QByteArray &charset, bool gotXml)
+{
+    QTextCodec *codec = 0;
+
+    if (!charset.isEmpty())
+        codec = QTextCodec::codecForName(charset);
+
+    if (!codec && gotXml) {
+        QXmlStreamReader reader(body);
+        reader.readNext();
+        codec = QTextCodec::codecForName(reader.documentEncoding().toString().toUtf8());
+    }
+
+    if (!codec && mime == "text/html")
+        codec = QTextCodec::codecForHtml(body, 0);
+
+    if (!codec)
+        codec = QTextCodec::codecForUtfText(body, 0);
+
+    if (!codec)
+        codec = QTextCodec::codecForName("UTF-8");
+    return codec;
+}
+#endif
+
+class QQmlXMLHttpRequestResponseJob;
 class QQmlXMLHttpRequest : public QObject
 {
     Q_OBJECT
@@ -1049,6 +1096,9 @@ public:
                  Opened = 1, HeadersReceived = 2,
                  Loading = 3, Done = 4 };
 
+    enum ResponseType { DefaultResponse, TextResponse,
+                        JsonResponse, DocumentResponse };
+
     QQmlXMLHttpRequest(QV8Engine *engine, QNetworkAccessManager *manager);
     virtual ~QQmlXMLHttpRequest();
 
@@ -1070,6 +1120,15 @@ public:
     QString responseBody();
     const QByteArray & rawResponseBody() const;
     bool receivedXml() const;
+
+    ResponseType responseType() const;
+    void setResponseType(ResponseType);
+    ReturnedValue responseXml();
+    ReturnedValue responseJson();
+
+protected:
+    bool event(QEvent *);
+
 private slots:
     void readyRead();
     void error(QNetworkReply::NetworkError);
@@ -1097,10 +1156,20 @@ private:
     QByteArray m_mime;
     QByteArray m_charset;
     QTextCodec *m_textCodec;
-#ifndef QT_NO_TEXTCODEC
-    QTextCodec* findTextCodec() const;
-#endif
     void readEncoding();
+    void readResponseData();
+
+    ResponseType m_responseType;
+    QQmlXMLHttpRequestResponseJob *m_responseJob;
+    bool m_responseProcessed;
+    QString m_responseText;
+    bool m_responseTextValid;
+    QJsonValue m_responseJson;
+    DocumentImpl *m_responseDocument;
+    PersistentValue m_response;
+    void processResponse();
+    void responseProcessed();
+    void clearResponse();
 
     ReturnedValue getMe() const;
     void setMe(const ValueRef me);
@@ -1120,16 +1189,125 @@ private:
     QNetworkAccessManager *networkAccessManager() { return m_nam; }
 };
 
+static QEvent::Type responseProcessedEventType()
+{
+    static const int type = QEvent::registerEventType();
+    return QEvent::Type(type);
+}
+
+// Decodes the text, parses JSON and builds the document tree of a finished
+// response on a worker thread.  Only the results are handed back to the GUI
+// thread, where they are wrapped for JavaScript on first access.
+class QQmlXMLHttpRequestResponseJob : public QRunnable, public QQmlRefCount
+{
+public:
+    QQmlXMLHttpRequestResponseJob(QQmlXMLHttpRequest *request, const QByteArray &body,
+                                  const QByteArray &mime, const QByteArray &charset,
+                                  bool gotXml, QQmlXMLHttpRequest::ResponseType type)
+        : body(body), mime(mime), charset(charset), gotXml(gotXml), type(type)
+        , hasText(false), document(0), request(request)
+    {
+        setAutoDelete(false);
+    }
+    ~QQmlXMLHttpRequestResponseJob()
+    {
+        if (document)
+            document->release();
+    }
+
+    void run();
+    void cancel();
+
+    // The body is shared with the request rather than copied; neither side
+    // modifies it while the job is running.
+    const QByteArray body;
+    const QByteArray mime;
+    const QByteArray charset;
+    const bool gotXml;
+    const QQmlXMLHttpRequest::ResponseType type;
+
+    bool hasText;
+    QString text;
+    QJsonValue json;
+    DocumentImpl *document;
+
+private:
+    bool isCancelled();
+
+    QMutex mutex;
+    QQmlXMLHttpRequest *request;
+};
+
+void QQmlXMLHttpRequestResponseJob::run()
+{
+    if (type == QQmlXMLHttpRequest::DefaultResponse
+            || type == QQmlXMLHttpRequest::TextResponse) {
+#ifndef QT_NO_TEXTCODEC
+        QTextCodec *codec = findTextCodec(body, mime, charset, gotXml);
+        text = codec ? codec->toUnicode(body) : QString::fromUtf8(body);
+#else
+        text = QString::fromUtf8(body);
+#endif
+        hasText = true;
+    }
+
+    if ((type == QQmlXMLHttpRequest::DefaultResponse
+            || type == QQmlXMLHttpRequest::DocumentResponse)
+            && gotXml && !isCancelled()) {
+        document = Document::parse(body);
+    }
+
+    if (type == QQmlXMLHttpRequest::JsonResponse && !isCancelled()) {
+        QJsonParseError error;
+        QJsonDocument doc = QJsonDocument::fromJson(body, &error);
+        if (doc.isObject()) {
+            json = doc.object();
+        } else if (doc.isArray()) {
+            json = doc.array();
+        } else {
+            // QJsonDocument only accepts objects and arrays at the top level
+            doc = QJsonDocument::fromJson('[' + body + ']', &error);
+            if (doc.isArray() && doc.array().count() == 1)
+                json = doc.array().at(0);
+            else
+                json = QJsonValue(QJsonValue::Undefined);
+        }
+    }
+
+    QMutexLocker locker(&mutex);
+    if (request)
+        QCoreApplication::postEvent(request, new QEvent(responseProcessedEventType()));
+    locker.unlock();
+
+    release();
+}
+
+void QQmlXMLHttpRequestResponseJob::cancel()
+{
+    QMutexLocker locker(&mutex);
+    request = 0;
+}
+
+bool QQmlXMLHttpRequestResponseJob::isCancelled()
+{
+    QMutexLocker locker(&mutex);
+    return !request;
+}
+
 QQmlXMLHttpRequest::QQmlXMLHttpRequest(QV8Engine *engine, QNetworkAccessManager *manager)
     : v4(QV8Engine::getV4(engine))
     , m_state(Unsent), m_errorFlag(false), m_sendFlag(false)
-    , m_redirectCount(0), m_gotXml(false), m_textCodec(0), m_network(0), m_nam(manager)
+    , m_redirectCount(0), m_gotXml(false), m_textCodec(0), m_responseType(DefaultResponse)
+    , m_responseJob(0), m_responseProcessed(false), m_responseTextValid(false)
+    , m_responseDocument(0)
+    , m_network(0), m_nam(manager)
 {
 }
 
 QQmlXMLHttpRequest::~QQmlXMLHttpRequest()
 {
     destroyNetwork();
+    clearResponse();
 }
 
 bool QQmlXMLHttpRequest::sendFlag() const
@@ -1160,6 +1338,7 @@ QString QQmlXMLHttpRequest::replyStatusText() const
 ReturnedValue QQmlXMLHttpRequest::open(const ValueRef me, const QString &method, const QUrl &url)
 {
     destroyNetwork();
+    clearResponse();
     m_sendFlag = false;
     m_errorFlag = false;
     m_responseEntityBody = QByteArray();
@@ -1299,6 +1478,7 @@ ReturnedValue QQmlXMLHttpRequest::send(const ValueRef me, const QByteArray &data
 ReturnedValue QQmlXMLHttpRequest::abort(const ValueRef me)
 {
     destroyNetwork();
+    clearResponse();
     m_responseEntityBody = QByteArray();
     m_errorFlag = true;
     m_request = QNetworkRequest();
@@ -1345,13 +1525,34 @@ void QQmlXMLHttpRequest::readyRead()
     }
 
     bool wasEmpty = m_responseEntityBody.isEmpty();
-    m_responseEntityBody.append(m_network->readAll());
+    readResponseData();
     if (wasEmpty && !m_responseEntityBody.isEmpty())
         m_state = Loading;
 
     dispatchCallback(me);
 }
 
+#define XMLHTTPREQUEST_MAXIMUM_RESERVE (16 * 1024 * 1024)
+void QQmlXMLHttpRequest::readResponseData()
+{
+    if (m_responseEntityBody.isEmpty()) {
+        // Size the body once up front instead of growing it chunk by chunk
+        bool ok = false;
+        qint64 length = m_network->header(QNetworkRequest::ContentLengthHeader).toLongLong(&ok);
+        if (ok && length > 0)
+            m_responseEntityBody.reserve(int(qMin<qint64>(length, XMLHTTPREQUEST_MAXIMUM_RESERVE)));
+    }
+
+    qint64 available = m_network->bytesAvailable();
+    if (available <= 0)
+        return;
+
+    int size = m_responseEntityBody.size();
+    m_responseEntityBody.resize(size + int(available));
+    qint64 read = m_network->read(m_responseEntityBody.data() + size, available);
+    m_responseEntityBody.resize(size + int(qMax<qint64>(read, 0)));
+}
+
 static const char *errorToString(QNetworkReply::NetworkError error)
 {
     int idx = QNetworkReply::staticMetaObject.indexOfEnumerator("NetworkError");
@@ -1371,6 +1572,30 @@ void QQmlXMLHttpRequest::error(QNetworkReply::NetworkError error)
     m_statusText =
         QString::fromUtf8(m_network->attribute(QNetworkRequest::HttpReasonPhraseAttribute).toByteArray());
 
+    // HTTP errors still carry a response, e.g. a JSON body describing a 404
+    const bool hasResponse = error == QNetworkReply::ContentAccessDenied ||
+        error == QNetworkReply::ContentOperationNotPermittedError ||
+        error == QNetworkReply::ContentNotFoundError ||
+        error == QNetworkReply::AuthenticationRequiredError ||
+        error == QNetworkReply::ContentReSendError ||
+        error == QNetworkReply::UnknownContentError;
+
+    Scope scope(v4);
+    ScopedValue me(scope, m_me.value());
+
+    if (hasResponse) {
+        if (m_state < HeadersReceived) {
+            m_state = HeadersReceived;
+            fillHeadersList ();
+            dispatchCallback(me);
+            // the callback may have called abort() or open()
+            if (m_state != HeadersReceived)
+                return;
+        }
+        readResponseData();
+        readEncoding();
+    }
+
     m_request = QNetworkRequest();
     m_data.clear();
     destroyNetwork();
@@ -1380,22 +1605,19 @@ void QQmlXMLHttpRequest::error(QNetworkReply::NetworkError error)
         qWarning().nospace() << "    " << error << ' ' << errorToString(error) << ' ' << m_statusText;
     }
 
-    Scope scope(v4);
-    ScopedValue me(scope, m_me.value());
-
-    if (error == QNetworkReply::ContentAccessDenied ||
-        error == QNetworkReply::ContentOperationNotPermittedError ||
-        error == QNetworkReply::ContentNotFoundError ||
-        error == QNetworkReply::AuthenticationRequiredError ||
-        error == QNetworkReply::ContentReSendError ||
-        error == QNetworkReply::UnknownContentError) {
+    if (hasResponse) {
         m_state = Loading;
         dispatchCallback(me);
-    } else {
-        m_errorFlag = true;
-        m_responseEntityBody = QByteArray();
-    } 
+        if (m_state != Loading)
+            return;
+
+        // As for a successful reply, the request moves to Done once the body has been processed
+        processResponse();
+        return;
+    }
 
+    m_errorFlag = true;
+    m_responseEntityBody = QByteArray();
     m_state = Done;
 
     dispatchCallback(me);
@@ -1431,8 +1653,11 @@ void QQmlXMLHttpRequest::finished()
         m_state = HeadersReceived;
         fillHeadersList ();
         dispatchCallback(m_me);
+        // the callback may have called abort() or open()
+        if (m_state != HeadersReceived)
+            return;
     }
-    m_responseEntityBody.append(m_network->readAll());
+    readResponseData();
     readEncoding();
 
     if (xhrDump()) {
@@ -1448,7 +1673,42 @@ void QQmlXMLHttpRequest::finished()
     if (m_state < Loading) {
         m_state = Loading;
         dispatchCallback(m_me);
+        if (m_state != Loading)
+            return;
+    }
+
+    // The request moves to Done once the body has been processed
+    processResponse();
+}
+
+void QQmlXMLHttpRequest::processResponse()
+{
+    Q_ASSERT(!m_responseJob);
+    m_responseJob = new QQmlXMLHttpRequestResponseJob(this, m_responseEntityBody,
+                                                      m_mime, m_charset, m_gotXml,
+                                                      m_responseType);
+    // One reference for the worker, released at the end of run()
+    m_responseJob->addref();
+    QThreadPool::globalInstance()->start(m_responseJob);
+}
+
+void QQmlXMLHttpRequest::responseProcessed()
+{
+    QQmlXMLHttpRequestResponseJob *job = m_responseJob;
+    m_responseJob = 0;
+    if (!job)
+        return;
+
+    if (job->hasText) {
+        m_responseText = job->text;
+        m_responseTextValid = true;
     }
+    m_responseJson = job->json;
+    m_responseDocument = job->document;
+    job->document = 0;
+    job->release();
+    m_responseProcessed = true;
+
     m_state = Done;
 
     dispatchCallback(m_me);
@@ -1458,6 +1718,39 @@ void QQmlXMLHttpRequest::finished()
     setMe(v);
 }
 
+void QQmlXMLHttpRequest::clearResponse()
+{
+    if (m_responseJob) {
+        m_responseJob->cancel();
+        m_responseJob->release();
+        m_responseJob = 0;
+        QCoreApplication::removePostedEvents(this, responseProcessedEventType());
+    }
+
+    m_responseProcessed = false;
+    m_responseText = QString();
+    m_responseTextValid = false;
+    m_responseJson = QJsonValue();
+    if (m_responseDocument) {
+        m_responseDocument->release();
+        m_responseDocument = 0;
+    }
+    m_response.clear();
+    m_textCodec = 0;
+    m_gotXml = false;
+    m_mime.clear();
+    m_charset.clear();
+}
+
+bool QQmlXMLHttpRequest::event(QEvent *e)
+{
+    if (e->type() == responseProcessedEventType()) {
+        responseProcessed();
+        return true;
+    }
+    return QObject::event(e);
+}
+
 
 void QQmlXMLHttpRequest::readEncoding()
 {
@@ -1489,38 +1782,16 @@ bool QQmlXMLHttpRequest::receivedXml() const
 }
 
 
-#ifndef QT_NO_TEXTCODEC
-QTextCodec* QQmlXMLHttpRequest::findTextCodec() const
-{
-    QTextCodec *codec = 0;
-
-    if (!m_charset.isEmpty()) 
-        codec = QTextCodec::codecForName(m_charset);
-
-    if (!codec && m_gotXml) {
-        QXmlStreamReader reader(m_responseEntityBody);
-        reader.readNext();
-        codec = QTextCodec::codecForName(reader.documentEncoding().toString().toUtf8());
-    }
-
-    if (!codec && m_mime == "text/html") 
-        codec = QTextCodec::codecForHtml(m_responseEntityBody, 0);
-
-    if (!codec)
-        codec = QTextCodec::codecForUtfText(m_responseEntityBody, 0);
-
-    if (!codec)
-        codec = QTextCodec::codecForName("UTF-8");
-    return codec;
-}
-#endif
 
 
 QString QQmlXMLHttpRequest::responseBody()
 {
+    if (m_responseTextValid)
+        return m_responseText;
+
 #ifndef QT_NO_TEXTCODEC
     if (!m_textCodec)
-        m_textCodec = findTextCodec();
+        m_textCodec = findTextCodec(m_responseEntityBody, m_mime, m_charset, m_gotXml);
     if (m_textCodec)
         return m_textCodec->toUnicode(m_responseEntityBody);
 #endif
@@ -1533,6 +1804,43 @@ const QByteArray &QQmlXMLHttpRequest::rawResponseBody() const
     return m_responseEntityBody;
 }
 
+QQmlXMLHttpRequest::ResponseType QQmlXMLHttpRequest::responseType() const
+{
+    return m_responseType;
+}
+
+void QQmlXMLHttpRequest::setResponseType(ResponseType type)
+{
+    m_responseType = type;
+}
+
+ReturnedValue QQmlXMLHttpRequest::responseXml()
+{
+    if (m_responseProcessed) {
+        if (m_response.isUndefined())
+            m_response = Document::wrap(v4->v8Engine, m_responseDocument);
+        return m_response.value();
+    }
+
+    // The response is still arriving, or failed; parse what there is so far
+    Scope scope(v4);
+    DocumentImpl *document = Document::parse(m_responseEntityBody);
+    ScopedValue result(scope, Document::wrap(v4->v8Engine, document));
+    if (document)
+        document->release();
+    return result.asReturnedValue();
+}
+
+ReturnedValue QQmlXMLHttpRequest::responseJson()
+{
+    if (!m_responseProcessed || m_responseJson.isUndefined())
+        return Encode::null();
+
+    if (m_response.isUndefined())
+        m_response = JsonObject::fromJsonValue(v4, m_responseJson);
+    return m_response.value();
+}
+
 void QQmlXMLHttpRequest::dispatchCallbackImpl(const ValueRef me)
 {
     ExecutionContext *ctx = v4->currentContext();
@@ -1684,6 +1992,9 @@ struct QQmlXMLHttpRequestCtor : public FunctionObject
     static ReturnedValue method_get_statusText(CallContext *ctx);
     static ReturnedValue method_get_responseText(CallContext *ctx);
     static ReturnedValue method_get_responseXML(CallContext *ctx);
+    static ReturnedValue method_get_response(CallContext *ctx);
+    static ReturnedValue method_get_responseType(CallContext *ctx);
+    static ReturnedValue method_set_responseType(CallContext *ctx);
 
 
     Object *proto;
@@ -1712,6 +2023,10 @@ void QQmlXMLHttpRequestCtor::setupProto()
     proto->defineAccessorProperty(QStringLiteral("statusText"),method_get_statusText, 0);
     proto->defineAccessorProperty(QStringLiteral("responseText"),method_get_responseText, 0);
     proto->defineAccessorProperty(QStringLiteral("responseXML"),method_get_responseXML, 0);
+    proto->defineAccessorProperty(QStringLiteral("response"),method_get_response, 0);
+
+    // Read-write properties
+    proto->defineAccessorProperty(QStringLiteral("responseType"),method_get_responseType, method_set_responseType);
 
     // State values
     proto->defineReadonlyProperty(QStringLiteral("UNSENT"), Primitive::fromInt32(0));
@@ -1956,6 +2271,10 @@ ReturnedValue QQmlXMLHttpRequestCtor::method_get_responseText(CallContext *ctx)
 
     QV8Engine *engine = ctx->engine->v8Engine;
 
+    if (r->responseType() != QQmlXMLHttpRequest::DefaultResponse &&
+        r->responseType() != QQmlXMLHttpRequest::TextResponse)
+        V4THROW_DOM(DOMEXCEPTION_INVALID_STATE_ERR, "Invalid state");
+
     if (r->readyState() != QQmlXMLHttpRequest::Loading &&
         r->readyState() != QQmlXMLHttpRequest::Done)
         return engine->toString(QString());
@@ -1971,13 +2290,101 @@ ReturnedValue QQmlXMLHttpRequestCtor::method_get_responseXML(CallContext *ctx)
         V4THROW_REFERENCE("Not an XMLHttpRequest object");
     QQmlXMLHttpRequest *r = w->request;
 
+    if (r->responseType() != QQmlXMLHttpRequest::DefaultResponse &&
+        r->responseType() != QQmlXMLHttpRequest::DocumentResponse)
+        V4THROW_DOM(DOMEXCEPTION_INVALID_STATE_ERR, "Invalid state");
+
     if (!r->receivedXml() ||
         (r->readyState() != QQmlXMLHttpRequest::Loading &&
          r->readyState() != QQmlXMLHttpRequest::Done)) {
         return Encode::null();
     } else {
-        return Document::load(ctx->engine->v8Engine, r->rawResponseBody());
+        return r->responseXml();
+    }
+}
+
+ReturnedValue QQmlXMLHttpRequestCtor::method_get_response(CallContext *ctx)
+{
+    Scope scope(ctx);
+    Scoped<QQmlXMLHttpRequestWrapper> w(scope, ctx->callData->thisObject.as<QQmlXMLHttpRequestWrapper>());
+    if (!w)
+        V4THROW_REFERENCE("Not an XMLHttpRequest object");
+    QQmlXMLHttpRequest *r = w->request;
+
+    QV8Engine *engine = ctx->engine->v8Engine;
+
+    switch (r->responseType()) {
+    case QQmlXMLHttpRequest::DefaultResponse:
+    case QQmlXMLHttpRequest::TextResponse:
+        if (r->readyState() != QQmlXMLHttpRequest::Loading &&
+            r->readyState() != QQmlXMLHttpRequest::Done)
+            return engine->toString(QString());
+        return engine->toString(r->responseBody());
+    case QQmlXMLHttpRequest::JsonResponse:
+        if (r->readyState() != QQmlXMLHttpRequest::Done || r->errorFlag())
+            return Encode::null();
+        return r->responseJson();
+    case QQmlXMLHttpRequest::DocumentResponse:
+        if (!r->receivedXml() || r->readyState() != QQmlXMLHttpRequest::Done || r->errorFlag())
+            return Encode::null();
+        return r->responseXml();
+    }
+
+    return Encode::null();
+}
+
+ReturnedValue QQmlXMLHttpRequestCtor::method_get_responseType(CallContext *ctx)
+{
+    Scope scope(ctx);
+    Scoped<QQmlXMLHttpRequestWrapper> w(scope, ctx->callData->thisObject.as<QQmlXMLHttpRequestWrapper>());
+    if (!w)
+        V4THROW_REFERENCE("Not an XMLHttpRequest object");
+    QQmlXMLHttpRequest *r = w->request;
+
+    QV8Engine *engine = ctx->engine->v8Engine;
+
+    switch (r->responseType()) {
+    case QQmlXMLHttpRequest::TextResponse:
+        return engine->toString(QStringLiteral("text"));
+    case QQmlXMLHttpRequest::JsonResponse:
+        return engine->toString(QStringLiteral("json"));
+    case QQmlXMLHttpRequest::DocumentResponse:
+        return engine->toString(QStringLiteral("document"));
+    default:
+        break;
     }
+
+    return engine->toString(QString());
+}
+
+ReturnedValue QQmlXMLHttpRequestCtor::method_set_responseType(CallContext *ctx)
+{
+    Scope scope(ctx);
+    Scoped<QQmlXMLHttpRequestWrapper> w(scope, ctx->callData->thisObject.as<QQmlXMLHttpRequestWrapper>());
+    if (!w)
+        V4THROW_REFERENCE("Not an XMLHttpRequest object");
+    QQmlXMLHttpRequest *r = w->request;
+
+    if (ctx->callData->argc != 1)
+        V4THROW_DOM(DOMEXCEPTION_SYNTAX_ERR, "Incorrect argument count");
+
+    if (r->readyState() == QQmlXMLHttpRequest::Loading ||
+        r->readyState() == QQmlXMLHttpRequest::Done)
+        V4THROW_DOM(DOMEXCEPTION_INVALID_STATE_ERR, "Invalid state");
+
+    // Unknown types are ignored, as in the XMLHttpRequest specification.
+    // "arraybuffer" is one of them, as the engine has no ArrayBuffer type.
+    QString type = ctx->callData->args[0].toQStringNoThrow();
+    if (type.isEmpty())
+        r->setResponseType(QQmlXMLHttpRequest::DefaultResponse);
+    else if (type == QLatin1String("text"))
+        r->setResponseType(QQmlXMLHttpRequest::TextResponse);
+    else if (type == QLatin1String("json"))
+        r->setResponseType(QQmlXMLHttpRequest::JsonResponse);
+    else if (type == QLatin1String("document"))
+        r->setResponseType(QQmlXMLHttpRequest::DocumentResponse);
+
+    return Encode::undefined();
 }
 
 void qt_rem_qmlxmlhttprequest(QV8Engine * /* engine */, void *d)
@@ -55,8 +55,21 @@
 #include <private/qv4value_p.h>
 #include <private/qv4functionobject_p.h>
 
+#include <QtCore/qdatetime.h>
+#include <QtCore/qregexp.h>
+
+#include <algorithm>
+
 QT_BEGIN_NAMESPACE
 
+static const int MaximumReusableItems = 64;
+
+static QEvent::Type flushChangesEventType()
+{
+    static const int type = QEvent::registerEventType();
+    return QEvent::Type(type);
+}
+
 class QQmlDelegateModelItem;
 
 struct DelegateModelGroupFunction: QV4::FunctionObject
@@ -188,6 +201,10 @@ QQmlDelegateModelPrivate::QQmlDelegateModelPrivate(QQmlContext *ctxt)
     , m_reset(false)
     , m_transaction(false)
     , m_incubatorCleanupScheduled(false)
+    , m_coalesceChanges(false)
+    , m_flushScheduled(false)
+    , m_flushAfterTransaction(false)
+    , m_reuseItems(false)
     , m_cacheItems(0)
     , m_items(0)
     , m_persistedItems(0)
@@ -247,6 +264,16 @@ QQmlDelegateModel::~QQmlDelegateModel()
         else if (cacheItem->incubationTask)
             cacheItem->incubationTask->vdm = 0;
     }
+    foreach (QQmlDelegateModelItem *cacheItem, d->m_reusableItems) {
+        delete cacheItem->object;
+
+        cacheItem->object = 0;
+        cacheItem->contextData->destroy();
+        cacheItem->contextData = 0;
+        cacheItem->scriptRef -= 1;
+        if (!cacheItem->isReferenced())
+            delete cacheItem;
+    }
 }
 
 
@@ -343,6 +370,9 @@ void QQmlDelegateModel::setModel(const QVariant &model)
     if (d->m_complete)
         _q_itemsRemoved(0, d->m_count);
 
+    // Pooled items are bound to the data type of the previous model.
+    d->drainReusableItems();
+
     d->m_adaptorModel.setModel(model, this, d->m_context->engine());
     d->m_adaptorModel.replaceWatchedRoles(QList<QByteArray>(), d->m_watchedRoles);
     for (int i = 0; d->m_parts && i < d->m_parts->models.count(); ++i) {
@@ -380,6 +410,7 @@ void QQmlDelegateModel::setDelegate(QQmlComponent *delegate)
     bool wasValid = d->m_delegate != 0;
     d->m_delegate = delegate;
     d->m_delegateValidated = false;
+    d->drainReusableItems();
     if (wasValid && d->m_complete) {
         for (int i = 1; i < d->m_groupCount; ++i) {
             QQmlDelegateModelGroupPrivate::get(d->m_groups[i])->changeSet.remove(
@@ -455,6 +486,97 @@ void QQmlDelegateModel::setRootIndex(const QVariant &root)
     }
 }
 
+/*!
+    \qmlproperty bool QtQml.Models::DelegateModel::coalesceChanges
+    \since QtQml.Models 2.2
+
+    This property holds whether change notifications to QML are merged and delivered once per
+    event loop iteration.
+
+    Views are always informed of changes to the model as they happen, and already lay out their
+    delegates once per frame.  When a model changes many times in quick succession, for example
+    when it is fed from a live data source, most of the remaining cost is in notifying QML.  With
+    this property set to true, the \l {QtQml.Models::DelegateModelGroup::onChanged()}{changed} and count change
+    signals of the groups, and the changes to the \l DelegateModel attached properties of
+    delegates, are deferred and the \e removed and \e inserted lists passed to onChanged
+    describe all changes made since the previous notification.
+
+    The default value is false.
+*/
+
+bool QQmlDelegateModel::coalesceChanges() const
+{
+    Q_D(const QQmlDelegateModel);
+    return d->m_coalesceChanges;
+}
+
+void QQmlDelegateModel::setCoalesceChanges(bool coalesce)
+{
+    Q_D(QQmlDelegateModel);
+    if (d->m_coalesceChanges == coalesce)
+        return;
+
+    d->m_coalesceChanges = coalesce;
+    if (!coalesce) {
+        QCoreApplication::removePostedEvents(this, flushChangesEventType());
+        d->m_flushScheduled = false;
+        d->flushChanges();
+    }
+    emit coalesceChangesChanged();
+}
+
+/*!
+    \qmlproperty bool QtQml.Models::DelegateModel::reuseItems
+    \since QtQml.Models 2.2
+
+    This property holds whether delegate instances released by a view are kept for reuse.
+
+    Normally a delegate instance is destroyed as soon as the view no longer needs it, and a new
+    one is created for every item that scrolls into view.  With this property set to true a
+    released instance is instead hidden and placed in a pool, and the next
+    item the view requests is bound to a pooled instance by updating its \c index and model
+    roles rather than creating a new one.
+
+    The \l {DelegateModel::pooled}{DelegateModel.pooled} and
+    \l {DelegateModel::reused}{DelegateModel.reused} attached signals are emitted when an
+    instance is moved into and out of the pool, and can be used to reset any state that is
+    not derived from the model.  Instances which are referenced from JavaScript, which are
+    \l Package delegates, or which are created for a list of objects are never pooled.
+
+    Pooled instances are destroyed when the model or the delegate changes, or when this
+    property is set back to false.
+
+    The default value is false.
+*/
+
+bool QQmlDelegateModel::reuseItems() const
+{
+    Q_D(const QQmlDelegateModel);
+    return d->m_reuseItems;
+}
+
+void QQmlDelegateModel::setReuseItems(bool reuse)
+{
+    Q_D(QQmlDelegateModel);
+    if (d->m_reuseItems == reuse)
+        return;
+
+    d->m_reuseItems = reuse;
+    if (!reuse)
+        d->drainReusableItems();
+    emit reuseItemsChanged();
+}
+
+/*
+    Destroys the pooled delegate instances.  A view calls this when it stops using a model it
+    does not own, as the pooled instances are still children of the view.
+*/
+void QQmlDelegateModel::drainReusableItems()
+{
+    Q_D(QQmlDelegateModel);
+    d->drainReusableItems();
+}
+
 /*!
     \qmlmethod QModelIndex QtQml.Models::DelegateModel::modelIndex(int index)
 
@@ -511,6 +633,8 @@ QQmlDelegateModel::ReleaseFlags QQmlDelegateModelPrivate::release(QObject *objec
 
     if (QQmlDelegateModelItem *cacheItem = QQmlDelegateModelItem::dataForObject(object)) {
         if (cacheItem->releaseObject()) {
+            if (poolItem(cacheItem))
+                return QQmlInstanceModel::Pooled;
             cacheItem->destroyObject();
             emitDestroyingItem(object);
             if (cacheItem->incubationTask) {
@@ -840,6 +964,78 @@ void QQmlDelegateModelPrivate::removeCacheItem(QQmlDelegateModelItem *cacheItem)
     Q_ASSERT(m_cache.count() == m_compositor.count(Compositor::Cache));
 }
 
+/*
+    Moves a released item into the reuse pool instead of destroying it.  The item is taken out
+    of the cache so it no longer receives change notifications, but the object and its context
+    are kept so reuseItem() can bind them to another model index.  release() returns Pooled
+    rather than Destroyed, and the view keeps the object as a hidden child, so bindings to its
+    parent stay valid while it waits.  Only instances of the current delegate which are still
+    part of the model are pooled, so the pool never holds objects created from a previous
+    delegate or model.
+*/
+bool QQmlDelegateModelPrivate::poolItem(QQmlDelegateModelItem *cacheItem)
+{
+    if (!m_reuseItems
+            || !cacheItem->isReusable()
+            || cacheItem->delegate != m_delegate
+            || !(cacheItem->groups & Compositor::GroupMask)
+            || cacheItem->incubationTask
+            || cacheItem->scriptRef != 1
+            || (cacheItem->groups & Compositor::UnresolvedFlag)
+            || !cacheItem->object
+            || qmlobject_cast<QQuickPackage *>(cacheItem->object)
+            || m_reusableItems.count() >= MaximumReusableItems) {
+        return false;
+    }
+
+    removeCacheItem(cacheItem);
+    cacheItem->groups = 0;
+    m_reusableItems.append(cacheItem);
+
+    if (QQmlDelegateModelAttached *attached = cacheItem->attached) {
+        // A pooled item has no index in any group until it is reused.
+        for (int i = 1; i < m_groupCount; ++i)
+            attached->m_currentIndex[i] = -1;
+        attached->emitPooled();
+    }
+    return true;
+}
+
+QQmlDelegateModelItem *QQmlDelegateModelPrivate::reuseItem(Compositor::iterator &it)
+{
+    if (m_reusableItems.isEmpty())
+        return 0;
+
+    QQmlDelegateModelItem *cacheItem = m_reusableItems.takeLast();
+    cacheItem->groups = it->flags;
+
+    m_cache.insert(it.cacheIndex, cacheItem);
+    m_compositor.setFlags(it, 1, Compositor::CacheFlag);
+    Q_ASSERT(m_cache.count() == m_compositor.count(Compositor::Cache));
+
+    cacheItem->rebindIndex(m_adaptorModel, it.modelIndex());
+
+    if (QQmlDelegateModelAttached *attached = cacheItem->attached) {
+        for (int i = 1; i < m_groupCount; ++i)
+            attached->m_currentIndex[i] = it.index[i];
+        attached->emitChanges();
+        attached->emitReused();
+    }
+    return cacheItem;
+}
+
+void QQmlDelegateModelPrivate::drainReusableItems()
+{
+    while (!m_reusableItems.isEmpty()) {
+        QQmlDelegateModelItem *cacheItem = m_reusableItems.takeLast();
+        QObject *object = cacheItem->object;
+        cacheItem->destroyObject();
+        // the view still holds pooled objects as hidden children
+        emitDestroyingItem(object);
+        cacheItem->Dispose();
+    }
+}
+
 void QQmlDelegateModelPrivate::incubatorStatusChanged(QQDMIncubationTask *incubationTask, QQmlIncubator::Status status)
 {
     Q_Q(QQmlDelegateModel);
@@ -911,6 +1107,9 @@ QObject *QQmlDelegateModelPrivate::object(Compositor::Group group, int index, bo
 
     QQmlDelegateModelItem *cacheItem = it->inCache() ? m_cache.at(it.cacheIndex) : 0;
 
+    if (!cacheItem && m_reuseItems)
+        cacheItem = reuseItem(it);
+
     if (!cacheItem) {
         cacheItem = m_adaptorModel.createItem(m_cacheMetaType, m_context->engine(), it.modelIndex());
         if (!cacheItem)
@@ -938,6 +1137,7 @@ QObject *QQmlDelegateModelPrivate::object(Compositor::Group group, int index, bo
 
         cacheItem->scriptRef += 1;
 
+        cacheItem->delegate = m_delegate;
         cacheItem->incubationTask = new QQDMIncubationTask(this, asynchronous ? QQmlIncubator::Asynchronous : QQmlIncubator::AsynchronousIfNested);
         cacheItem->incubationTask->incubating = cacheItem;
         cacheItem->incubationTask->clear();
@@ -1008,7 +1208,11 @@ QObject *QQmlDelegateModel::object(int index, bool asynchronous)
 
 QString QQmlDelegateModelPrivate::stringValue(Compositor::Group group, int index, const QString &name)
 {
-    Compositor::iterator it = m_compositor.find(group, index);
+    return roleValue(m_compositor.find(group, index), name).toString();
+}
+
+QVariant QQmlDelegateModelPrivate::roleValue(const Compositor::iterator &it, const QString &name)
+{
     if (QQmlAdaptorModel *model = it.list<QQmlAdaptorModel>()) {
         QString role = name;
         int dot = name.indexOf(QLatin1Char('.'));
@@ -1018,14 +1222,14 @@ QString QQmlDelegateModelPrivate::stringValue(Compositor::Group group, int index
         while (dot > 0) {
             QObject *obj = qvariant_cast<QObject*>(value);
             if (!obj)
-                return QString();
+                return QVariant();
             int from = dot+1;
             dot = name.indexOf(QLatin1Char('.'), from);
             value = obj->property(name.mid(from, dot-from).toUtf8());
         }
-        return value.toString();
+        return value;
     }
-    return QString();
+    return QVariant();
 }
 
 QString QQmlDelegateModel::stringValue(int index, const QString &name)
@@ -1092,6 +1296,9 @@ bool QQmlDelegateModel::event(QEvent *e)
         d->m_incubatorCleanupScheduled = false;
         qDeleteAll(d->m_finishedIncubating);
         d->m_finishedIncubating.clear();
+    } else if (e->type() == flushChangesEventType()) {
+        d->m_flushScheduled = false;
+        d->flushChanges();
     }
     return QQmlInstanceModel::event(e);
 }
@@ -1407,15 +1614,48 @@ void QQmlDelegateModelPrivate::emitModelUpdated(const QQmlChangeSet &changeSet,
         emit q->countChanged();
 }
 
+void QQmlDelegateModelPrivate::updateSortAndFilter()
+{
+    // Filters take their items from the items group, so they must be applied before that group
+    // is itself re-sorted, and groups are only sorted once their membership is up to date.
+    const QQmlChangeSet &itemChanges = QQmlDelegateModelGroupPrivate::get(m_items)->changeSet;
+    for (int i = Compositor::MinimumGroupCount; i < m_groupCount; ++i) {
+        QQmlDelegateModelGroupPrivate *group = QQmlDelegateModelGroupPrivate::get(m_groups[i]);
+        if (group->isFiltered())
+            group->filter(itemChanges);
+    }
+    for (int i = 1; i < m_groupCount; ++i) {
+        QQmlDelegateModelGroupPrivate *group = QQmlDelegateModelGroupPrivate::get(m_groups[i]);
+        if (group->isSorted())
+            group->sort();
+    }
+}
+
 void QQmlDelegateModelPrivate::emitChanges()
 {
     if (m_transaction || !m_complete || !m_context->isValid())
         return;
 
     m_transaction = true;
-    QV8Engine *engine = QQmlEnginePrivate::getV8Engine(m_context->engine());
-    for (int i = 1; i < m_groupCount; ++i)
-        QQmlDelegateModelGroupPrivate::get(m_groups[i])->emitChanges(engine);
+    updateSortAndFilter();
+    if (m_coalesceChanges) {
+        // Views are still updated immediately so their indexes stay in sync with the compositor,
+        // but notifying QML is deferred and the changes merged until the next flush.
+        for (int i = 1; i < m_groupCount; ++i) {
+            QQmlDelegateModelGroupPrivate *group = QQmlDelegateModelGroupPrivate::get(m_groups[i]);
+            group->pendingChangeSet.apply(group->changeSet);
+        }
+        if (!m_flushScheduled) {
+            m_flushScheduled = true;
+            QCoreApplication::postEvent(q_func(), new QEvent(flushChangesEventType()));
+        }
+    } else {
+        QV8Engine *engine = QQmlEnginePrivate::getV8Engine(m_context->engine());
+        for (int i = 1; i < m_groupCount; ++i) {
+            QQmlDelegateModelGroupPrivate *group = QQmlDelegateModelGroupPrivate::get(m_groups[i]);
+            group->emitChanges(engine, group->changeSet);
+        }
+    }
     m_transaction = false;
 
     const bool reset = m_reset;
@@ -1423,10 +1663,46 @@ void QQmlDelegateModelPrivate::emitChanges()
     for (int i = 1; i < m_groupCount; ++i)
         QQmlDelegateModelGroupPrivate::get(m_groups[i])->emitModelUpdated(reset);
 
+    if (!m_coalesceChanges) {
+        foreach (QQmlDelegateModelItem *cacheItem, m_cache) {
+            if (cacheItem->attached)
+                cacheItem->attached->emitChanges();
+        }
+    }
+
+    if (m_flushAfterTransaction)
+        flushChanges();
+}
+
+void QQmlDelegateModelPrivate::flushChanges()
+{
+    if (!m_complete || !m_context->isValid())
+        return;
+    if (m_transaction) {
+        // Changes are being emitted already, for example by a handler that spun an event
+        // loop.  Deliver the pending ones once that has finished rather than dropping them.
+        m_flushAfterTransaction = true;
+        return;
+    }
+    m_flushAfterTransaction = false;
+
+    m_transaction = true;
+    QV8Engine *engine = QQmlEnginePrivate::getV8Engine(m_context->engine());
+    for (int i = 1; i < m_groupCount; ++i) {
+        QQmlDelegateModelGroupPrivate *group = QQmlDelegateModelGroupPrivate::get(m_groups[i]);
+        QQmlChangeSet changes = group->pendingChangeSet;
+        group->pendingChangeSet.clear();
+        group->emitChanges(engine, changes);
+    }
+    m_transaction = false;
+
     foreach (QQmlDelegateModelItem *cacheItem, m_cache) {
         if (cacheItem->attached)
             cacheItem->attached->emitChanges();
     }
+
+    if (m_flushAfterTransaction)
+        flushChanges();
 }
 
 void QQmlDelegateModel::_q_modelReset()
@@ -1802,6 +2078,8 @@ QV4::ReturnedValue QQmlDelegateModelItem::set_groups(QV4::CallContext *ctx)
 
     const int groupFlags = model->m_cacheMetaType->parseGroups(ctx->callData->args[0]);
     const int cacheIndex = model->m_cache.indexOf(o->item);
+    if (cacheIndex == -1)   // The item is waiting in the reuse pool.
+        return QV4::Encode::undefined();
     Compositor::iterator it = model->m_compositor.find(Compositor::Cache, cacheIndex);
     model->setGroups(it, 1, Compositor::Cache, groupFlags);
     return QV4::Encode::undefined();
@@ -1825,6 +2103,8 @@ QV4::ReturnedValue QQmlDelegateModelItem::set_member(QQmlDelegateModelItem *cach
         return QV4::Encode::undefined();
 
     const int cacheIndex = model->m_cache.indexOf(cacheItem);
+    if (cacheIndex == -1)   // The item is waiting in the reuse pool.
+        return QV4::Encode::undefined();
     Compositor::iterator it = model->m_compositor.find(Compositor::Cache, cacheIndex);
     if (member)
         model->addGroups(it, 1, Compositor::Cache, groupFlag);
@@ -1861,6 +2141,7 @@ QQmlDelegateModelItem::QQmlDelegateModelItem(
     , metaType(metaType)
     , contextData(0)
     , object(0)
+    , delegate(0)
     , attached(0)
     , incubationTask(0)
     , objectRef(0)
@@ -1969,7 +2250,9 @@ int QQmlDelegateModelItem::groupIndex(Compositor::Group group)
     if (QQmlDelegateModelPrivate * const model = metaType->model
             ? QQmlDelegateModelPrivate::get(metaType->model)
             : 0) {
-        return model->m_compositor.find(Compositor::Cache, model->m_cache.indexOf(this)).index[group];
+        const int cacheIndex = model->m_cache.indexOf(this);
+        if (cacheIndex != -1)   // Not waiting in the reuse pool.
+            return model->m_compositor.find(Compositor::Cache, cacheIndex).index[group];
     }
     return -1;
 }
@@ -2017,6 +2300,8 @@ int QQmlDelegateModelAttachedMetaObject::metaCall(QObject *object, QMetaObject::
             if (!metaType->model)
                 return -1;
             QQmlDelegateModelPrivate *model = QQmlDelegateModelPrivate::get(metaType->model);
+            if (!model->m_cache.contains(attached->m_cacheItem))   // The item is waiting in the reuse pool.
+                return -1;
             Compositor::Group group = Compositor::Group(_id - memberPropertyOffset + 1);
             const int groupFlag = 1 << group;
             const bool member = attached->m_cacheItem->groups & groupFlag;
@@ -2114,6 +2399,8 @@ void QQmlDelegateModelAttached::setGroups(const QStringList &groups)
 
     const int groupFlags = model->m_cacheMetaType->parseGroups(groups);
     const int cacheIndex = model->m_cache.indexOf(m_cacheItem);
+    if (cacheIndex == -1)   // The item is waiting in the reuse pool.
+        return;
     Compositor::iterator it = model->m_compositor.find(Compositor::Cache, cacheIndex);
     model->setGroups(it, 1, Compositor::Cache, groupFlags);
 }
@@ -2138,6 +2425,28 @@ bool QQmlDelegateModelAttached::isUnresolved() const
     return m_cacheItem->groups & Compositor::UnresolvedFlag;
 }
 
+/*!
+    \qmlattachedsignal QtQml.Models::DelegateModel::pooled()
+    \since QtQml.Models 2.2
+
+    This attached signal is emitted when a view no longer needs the delegate instance and it is
+    kept for reuse because \l reuseItems is true.  The instance stays a child of the view but
+    is hidden, and its \c index and model roles are not updated while it is in the pool.
+
+    It is attached to each instance of the delegate.
+*/
+
+/*!
+    \qmlattachedsignal QtQml.Models::DelegateModel::reused()
+    \since QtQml.Models 2.2
+
+    This attached signal is emitted when a pooled delegate instance is taken out of the pool and
+    bound to a new model item, after its \c index and model roles have been updated.  Use it to
+    reset any state the delegate keeps which is not derived from the model.
+
+    It is attached to each instance of the delegate.
+*/
+
 /*!
     \qmlattachedproperty int QtQml.Models::DelegateModel::inItems
 
@@ -2219,16 +2528,16 @@ bool QQmlDelegateModelGroupPrivate::isChangedConnected()
     IS_SIGNAL_CONNECTED(q, QQmlDelegateModelGroup, changed, (const QQmlV4Handle &,const QQmlV4Handle &));
 }
 
-void QQmlDelegateModelGroupPrivate::emitChanges(QV8Engine *engine)
+void QQmlDelegateModelGroupPrivate::emitChanges(QV8Engine *engine, const QQmlChangeSet &changes)
 {
     Q_Q(QQmlDelegateModelGroup);
-    if (isChangedConnected() && !changeSet.isEmpty()) {
+    if (isChangedConnected() && !changes.isEmpty()) {
         QV4::Scope scope(QV8Engine::getV4(engine));
-        QV4::ScopedValue removed(scope, engineData(engine)->array(engine, changeSet.removes()));
-        QV4::ScopedValue inserted(scope, engineData(engine)->array(engine, changeSet.inserts()));
+        QV4::ScopedValue removed(scope, engineData(engine)->array(engine, changes.removes()));
+        QV4::ScopedValue inserted(scope, engineData(engine)->array(engine, changes.inserts()));
         emit q->changed(QQmlV4Handle(removed), QQmlV4Handle(inserted));
     }
-    if (changeSet.difference() != 0)
+    if (changes.difference() != 0)
         emit q->countChanged();
 }
 
@@ -2239,6 +2548,235 @@ void QQmlDelegateModelGroupPrivate::emitModelUpdated(bool reset)
     changeSet.clear();
 }
 
+bool QQmlDelegateModelGroupPrivate::filterAccepts(const QVariant &value) const
+{
+    if (filterValue.userType() == QMetaType::QRegExp)
+        return value.isValid() && filterValue.toRegExp().indexIn(value.toString()) != -1;
+    return value == filterValue;
+}
+
+void QQmlDelegateModelGroupPrivate::invalidate()
+{
+    if (model)
+        QQmlDelegateModelPrivate::get(model)->emitChanges();
+}
+
+void QQmlDelegateModelGroupPrivate::filter(const QQmlChangeSet &itemChanges)
+{
+    QQmlDelegateModelPrivate *d = QQmlDelegateModelPrivate::get(model);
+
+    // Without a delegate no change sets are recorded, so there is nothing to narrow the
+    // evaluation down to.
+    if (filterDirty || !d->m_delegate) {
+        filterDirty = false;
+        filter(0, d->m_compositor.count(Compositor::Default));
+        return;
+    }
+
+    foreach (const QQmlChangeSet::Insert &insert, itemChanges.inserts()) {
+        if (!insert.isMove())
+            filter(insert.index, insert.count);
+    }
+    foreach (const QQmlChangeSet::Change &change, itemChanges.changes())
+        filter(change.index, change.count);
+}
+
+void QQmlDelegateModelGroupPrivate::filter(int index, int count)
+{
+    QQmlDelegateModelPrivate *d = QQmlDelegateModelPrivate::get(model);
+
+    const int end = qMin(index + count, d->m_compositor.count(Compositor::Default));
+    if (index >= end)
+        return;
+
+    // Collect runs of consecutive items whose membership disagrees with the filter in the same
+    // direction and add or remove each run with a single compositor operation.  Changing the
+    // flags of a group doesn't affect the indexes of the items group, so the iterator only needs
+    // to be found again after a run has been applied.
+    Compositor::iterator it = d->m_compositor.find(Compositor::Default, index);
+    int runStart = -1;
+    bool runInsert = false;
+    for (int i = index; i <= end; ++i) {
+        int action = 0;
+        if (i < end) {
+            const bool member = it->inGroup(group);
+            if (filterAccepts(d->roleValue(it, filterRole)) != member)
+                action = member ? -1 : 1;
+            it += 1;
+        }
+
+        if (runStart >= 0 && action != (runInsert ? 1 : -1)) {
+            Compositor::iterator from = d->m_compositor.find(Compositor::Default, runStart);
+            if (runInsert) {
+                QVector<Compositor::Insert> inserts;
+                d->m_compositor.setFlags(from, i - runStart, Compositor::Default, 1 << group, &inserts);
+                d->itemsInserted(inserts);
+            } else {
+                QVector<Compositor::Remove> removes;
+                d->m_compositor.clearFlags(from, i - runStart, Compositor::Default, 1 << group, &removes);
+                d->itemsRemoved(removes);
+            }
+            runStart = -1;
+            if (i + 1 < end)
+                it = d->m_compositor.find(Compositor::Default, i + 1);
+        }
+        if (action != 0 && runStart < 0) {
+            runStart = i;
+            runInsert = action > 0;
+        }
+    }
+}
+
+static bool isNumeric(int type)
+{
+    switch (type) {
+    case QMetaType::Bool:
+    case QMetaType::Int:
+    case QMetaType::UInt:
+    case QMetaType::LongLong:
+    case QMetaType::ULongLong:
+    case QMetaType::Float:
+    case QMetaType::Double:
+        return true;
+    default:
+        return false;
+    }
+}
+
+static bool variantLessThan(const QVariant &left, const QVariant &right)
+{
+    if (!left.isValid() || !right.isValid())
+        return !left.isValid() && right.isValid();
+
+    const int leftType = left.userType();
+    const int rightType = right.userType();
+    if (isNumeric(leftType) && isNumeric(rightType))
+        return left.toDouble() < right.toDouble();
+    else if (leftType == QMetaType::QDateTime && rightType == QMetaType::QDateTime)
+        return left.toDateTime() < right.toDateTime();
+    else if (leftType == QMetaType::QDate && rightType == QMetaType::QDate)
+        return left.toDate() < right.toDate();
+    return left.toString() < right.toString();
+}
+
+struct SortKeyLessThan
+{
+    SortKeyLessThan(const QVector<QVariant> &keys, Qt::SortOrder order) : keys(keys), order(order) {}
+
+    bool operator ()(int left, int right) const {
+        return order == Qt::AscendingOrder
+                ? variantLessThan(keys.at(left), keys.at(right))
+                : variantLessThan(keys.at(right), keys.at(left));
+    }
+
+    const QVector<QVariant> &keys;
+    const Qt::SortOrder order;
+};
+
+void QQmlDelegateModelGroupPrivate::sort()
+{
+    QQmlDelegateModelPrivate *d = QQmlDelegateModelPrivate::get(model);
+
+    // Unless the sort criteria changed, only inserted or changed items can be out of order.
+    if (!sortDirty && d->m_delegate && changeSet.inserts().isEmpty() && changeSet.changes().isEmpty())
+        return;
+    sortDirty = false;
+
+    const int count = d->m_compositor.count(group);
+    if (count < 2)
+        return;
+
+    QVector<QVariant> keys(count);
+    Compositor::iterator it = d->m_compositor.find(group, 0);
+    for (int i = 0; i < count; ++i, it += 1)
+        keys[i] = d->roleValue(it, sortRole);
+
+    QVector<int> order(count);
+    for (int i = 0; i < count; ++i)
+        order[i] = i;
+    std::stable_sort(order.begin(), order.end(), SortKeyLessThan(keys, sortOrder));
+
+    // ranks holds the sorted position of the item at each current index.
+    QVector<int> ranks(count);
+    for (int i = 0; i < count; ++i)
+        ranks[order.at(i)] = i;
+
+    // Items on the longest increasing run of ranks are already in order relative to each other
+    // and stay where they are, every other item is moved once.  This keeps the number of moves
+    // reported to views minimal when only a few items are out of place.
+    QVector<int> tails;
+    QVector<int> previous(count, -1);
+    for (int i = 0; i < count; ++i) {
+        int lower = 0;
+        int upper = tails.count();
+        while (lower < upper) {
+            const int middle = (lower + upper) / 2;
+            if (ranks.at(tails.at(middle)) < ranks.at(i))
+                lower = middle + 1;
+            else
+                upper = middle;
+        }
+        if (lower > 0)
+            previous[i] = tails.at(lower - 1);
+        if (lower == tails.count())
+            tails.append(i);
+        else
+            tails[lower] = i;
+    }
+
+    QVector<bool> settled(count, false);
+    for (int i = tails.isEmpty() ? -1 : tails.last(); i >= 0; i = previous.at(i))
+        settled[ranks.at(i)] = true;
+
+    // Place the remaining items in rank order directly after their predecessor.  Items
+    // placed that way form a run behind the nearest settled item of lower rank, or at the
+    // start of the group if there is none.  The current position of an item is then the
+    // number of items still at a lower original index, counting the runs behind them,
+    // which a Fenwick tree over the original indexes gives in O(log n).
+    QVector<int> weights(count + 1, 0);
+    for (int i = 1; i <= count; ++i) {
+        weights[i] += 1;
+        if (i + (i & -i) <= count)
+            weights[i + (i & -i)] += weights.at(i);
+    }
+    QVector<int> runLengths(count, 0);
+    int headLength = 0;
+    int anchor = -1;
+
+    for (int rank = 0; rank < count; ++rank) {
+        if (settled.at(rank)) {
+            anchor = order.at(rank);
+            continue;
+        }
+
+        const int index = order.at(rank);
+        int from = headLength;
+        for (int i = index; i > 0; i -= i & -i)
+            from += weights.at(i);
+        for (int i = index + 1; i <= count; i += i & -i)
+            weights[i] -= 1;
+
+        int to = headLength;
+        if (anchor >= 0) {
+            for (int i = anchor; i > 0; i -= i & -i)
+                to += weights.at(i);
+            to += 1 + runLengths.at(anchor);
+            ++runLengths[anchor];
+            for (int i = anchor + 1; i <= count; i += i & -i)
+                weights[i] += 1;
+        } else {
+            ++headLength;
+        }
+
+        if (from != to) {
+            QVector<Compositor::Remove> removes;
+            QVector<Compositor::Insert> inserts;
+            d->m_compositor.move(group, from, group, to, 1, group, &removes, &inserts);
+            d->itemsMoved(removes, inserts);
+        }
+    }
+}
+
 void QQmlDelegateModelGroupPrivate::createdPackage(int index, QQuickPackage *package)
 {
     for (QQmlDelegateModelGroupEmitterList::iterator it = emitters.begin(); it != emitters.end(); ++it)
@@ -2396,6 +2934,130 @@ void QQmlDelegateModelGroup::setDefaultInclude(bool include)
     }
 }
 
+/*!
+    \qmlproperty string QtQml.Models::DelegateModelGroup::sortRole
+    \since QtQml.Models 2.2
+
+    This property holds the name of the model role the items of the group are sorted by.
+
+    While set, the group keeps its items ordered by the value of the role, moving items as the
+    model inserts or changes them.  Numbers and dates are compared by value and any other data
+    by its string value; items without a value for the role sort first.  Items with the same
+    value keep their relative order.
+
+    Sorting repositions items in the same way as move(), so sorting a group other than
+    \l {QtQml.Models::DelegateModel::items}{items} also reorders its items in the other groups
+    they belong to.
+
+    By default this property is an empty string and the group isn't sorted.
+
+    \sa sortOrder
+*/
+
+QString QQmlDelegateModelGroup::sortRole() const
+{
+    Q_D(const QQmlDelegateModelGroup);
+    return d->sortRole;
+}
+
+void QQmlDelegateModelGroup::setSortRole(const QString &role)
+{
+    Q_D(QQmlDelegateModelGroup);
+    if (d->sortRole != role) {
+        d->sortRole = role;
+        d->sortDirty = true;
+        d->invalidate();
+        emit sortRoleChanged();
+    }
+}
+
+/*!
+    \qmlproperty enumeration QtQml.Models::DelegateModelGroup::sortOrder
+    \since QtQml.Models 2.2
+
+    This property holds the order items are sorted in when \l sortRole is set.
+
+    \list
+    \li Qt.AscendingOrder (default)
+    \li Qt.DescendingOrder
+    \endlist
+*/
+
+Qt::SortOrder QQmlDelegateModelGroup::sortOrder() const
+{
+    Q_D(const QQmlDelegateModelGroup);
+    return d->sortOrder;
+}
+
+void QQmlDelegateModelGroup::setSortOrder(Qt::SortOrder order)
+{
+    Q_D(QQmlDelegateModelGroup);
+    if (d->sortOrder != order) {
+        d->sortOrder = order;
+        d->sortDirty = true;
+        d->invalidate();
+        emit sortOrderChanged();
+    }
+}
+
+/*!
+    \qmlproperty string QtQml.Models::DelegateModelGroup::filterRole
+    \since QtQml.Models 2.2
+
+    This property holds the name of the model role compared against \l filterValue.
+
+    While both properties are set, the group contains exactly those items of the
+    \l {QtQml.Models::DelegateModel::items}{items} group that match the filter, and items are
+    added to or removed from it as the model changes.  The filter has no effect on the items
+    and persistedItems groups themselves.
+*/
+
+QString QQmlDelegateModelGroup::filterRole() const
+{
+    Q_D(const QQmlDelegateModelGroup);
+    return d->filterRole;
+}
+
+void QQmlDelegateModelGroup::setFilterRole(const QString &role)
+{
+    Q_D(QQmlDelegateModelGroup);
+    if (d->filterRole != role) {
+        d->filterRole = role;
+        d->filterDirty = true;
+        d->invalidate();
+        emit filterRoleChanged();
+    }
+}
+
+/*!
+    \qmlproperty var QtQml.Models::DelegateModelGroup::filterValue
+    \since QtQml.Models 2.2
+
+    This property holds the value an item's \l filterRole must have for the item to be included
+    in the group.
+
+    If the value is a regular expression an item matches if the expression matches part of the
+    string value of its role, otherwise the values must be equal.  By default the value is
+    undefined and the group isn't filtered.
+*/
+
+QVariant QQmlDelegateModelGroup::filterValue() const
+{
+    Q_D(const QQmlDelegateModelGroup);
+    return d->filterValue;
+}
+
+void QQmlDelegateModelGroup::setFilterValue(const QVariant &value)
+{
+    Q_D(QQmlDelegateModelGroup);
+    if (d->filterValue != value) {
+        d->filterValue = value;
+        d->filterDirty = true;
+        d->invalidate();
+        emit filterValueChanged();
+    }
+}
+
 /*!
     \qmlmethod object QtQml.Models::DelegateModelGroup::get(int index)
 
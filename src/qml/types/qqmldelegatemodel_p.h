@@ -78,6 +78,8 @@ class Q_QML_PRIVATE_EXPORT QQmlDelegateModel : public QQmlInstanceModel, public
     Q_PROPERTY(QQmlListProperty<QQmlDelegateModelGroup> groups READ groups CONSTANT)
     Q_PROPERTY(QObject *parts READ parts CONSTANT)
     Q_PROPERTY(QVariant rootIndex READ rootIndex WRITE setRootIndex NOTIFY rootIndexChanged)
+    Q_PROPERTY(bool coalesceChanges READ coalesceChanges WRITE setCoalesceChanges NOTIFY coalesceChangesChanged REVISION 1)
+    Q_PROPERTY(bool reuseItems READ reuseItems WRITE setReuseItems NOTIFY reuseItemsChanged REVISION 1)
     Q_CLASSINFO("DefaultProperty", "delegate")
     Q_INTERFACES(QQmlParserStatus)
 public:
@@ -97,6 +99,13 @@ public:
     QVariant rootIndex() const;
     void setRootIndex(const QVariant &root);
 
+    bool coalesceChanges() const;
+    void setCoalesceChanges(bool coalesce);
+
+    bool reuseItems() const;
+    void setReuseItems(bool reuse);
+    void drainReusableItems();
+
     Q_INVOKABLE QVariant modelIndex(int idx) const;
     Q_INVOKABLE QVariant parentModelIndex() const;
 
@@ -127,6 +136,8 @@ Q_SIGNALS:
     void filterGroupChanged();
     void defaultGroupsChanged();
     void rootIndexChanged();
+    Q_REVISION(1) void coalesceChangesChanged();
+    Q_REVISION(1) void reuseItemsChanged();
 
 private Q_SLOTS:
     void _q_itemsChanged(int index, int count, const QVector<int> &roles);
@@ -153,6 +164,10 @@ class Q_QML_PRIVATE_EXPORT QQmlDelegateModelGroup : public QObject
     Q_PROPERTY(int count READ count NOTIFY countChanged)
     Q_PROPERTY(QString name READ name WRITE setName NOTIFY nameChanged)
     Q_PROPERTY(bool includeByDefault READ defaultInclude WRITE setDefaultInclude NOTIFY defaultIncludeChanged)
+    Q_PROPERTY(QString sortRole READ sortRole WRITE setSortRole NOTIFY sortRoleChanged REVISION 1)
+    Q_PROPERTY(Qt::SortOrder sortOrder READ sortOrder WRITE setSortOrder NOTIFY sortOrderChanged REVISION 1)
+    Q_PROPERTY(QString filterRole READ filterRole WRITE setFilterRole NOTIFY filterRoleChanged REVISION 1)
+    Q_PROPERTY(QVariant filterValue READ filterValue WRITE setFilterValue NOTIFY filterValueChanged REVISION 1)
 public:
     QQmlDelegateModelGroup(QObject *parent = 0);
     QQmlDelegateModelGroup(const QString &name, QQmlDelegateModel *model, int compositorType, QObject *parent = 0);
@@ -166,6 +181,18 @@ public:
     bool defaultInclude() const;
     void setDefaultInclude(bool include);
 
+    QString sortRole() const;
+    void setSortRole(const QString &role);
+
+    Qt::SortOrder sortOrder() const;
+    void setSortOrder(Qt::SortOrder order);
+
+    QString filterRole() const;
+    void setFilterRole(const QString &role);
+
+    QVariant filterValue() const;
+    void setFilterValue(const QVariant &value);
+
     Q_INVOKABLE QQmlV4Handle get(int index);
 
 public Q_SLOTS:
@@ -182,6 +209,10 @@ Q_SIGNALS:
     void countChanged();
     void nameChanged();
     void defaultIncludeChanged();
+    Q_REVISION(1) void sortRoleChanged();
+    Q_REVISION(1) void sortOrderChanged();
+    Q_REVISION(1) void filterRoleChanged();
+    Q_REVISION(1) void filterValueChanged();
     void changed(const QQmlV4Handle &removed, const QQmlV4Handle &inserted);
 private:
     Q_DECLARE_PRIVATE(QQmlDelegateModelGroup)
@@ -212,10 +243,14 @@ public:
     void emitChanges();
 
     void emitUnresolvedChanged() { Q_EMIT unresolvedChanged(); }
+    void emitPooled() { Q_EMIT pooled(); }
+    void emitReused() { Q_EMIT reused(); }
 
 Q_SIGNALS:
     void groupsChanged();
     void unresolvedChanged();
+    void pooled();
+    void reused();
 
 public:
     QQmlDelegateModelItem *m_cacheItem;
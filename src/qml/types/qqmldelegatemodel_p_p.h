@@ -132,6 +132,8 @@ public:
 
     virtual void setValue(const QString &role, const QVariant &value) { Q_UNUSED(role); Q_UNUSED(value); }
     virtual bool resolveIndex(const QQmlAdaptorModel &, int) { return false; }
+    virtual bool isReusable() const { return false; }
+    virtual void rebindIndex(const QQmlAdaptorModel &, int idx) { setModelIndex(idx); }
 
     static QV4::ReturnedValue get_model(QV4::CallContext *ctx);
     static QV4::ReturnedValue get_groups(QV4::CallContext *ctx);
@@ -144,6 +146,7 @@ public:
     QQmlDelegateModelItemMetaType * const metaType;
     QQmlContextData *contextData;
     QObject *object;
+    QQmlComponent *delegate;
     QQmlDelegateModelAttached *attached;
     QQDMIncubationTask *incubationTask;
     int objectRef;
@@ -212,14 +215,20 @@ class QQmlDelegateModelGroupPrivate : public QObjectPrivate
 public:
     Q_DECLARE_PUBLIC(QQmlDelegateModelGroup)
 
-    QQmlDelegateModelGroupPrivate() : group(Compositor::Cache), defaultInclude(false) {}
+    QQmlDelegateModelGroupPrivate()
+        : group(Compositor::Cache)
+        , sortOrder(Qt::AscendingOrder)
+        , defaultInclude(false)
+        , sortDirty(true)
+        , filterDirty(true)
+    {}
 
     static QQmlDelegateModelGroupPrivate *get(QQmlDelegateModelGroup *group) {
         return static_cast<QQmlDelegateModelGroupPrivate *>(QObjectPrivate::get(group)); }
 
     void setModel(QQmlDelegateModel *model, Compositor::Group group);
     bool isChangedConnected();
-    void emitChanges(QV8Engine *engine);
+    void emitChanges(QV8Engine *engine, const QQmlChangeSet &changes);
     void emitModelUpdated(bool reset);
 
     void createdPackage(int index, QQuickPackage *package);
@@ -230,12 +239,28 @@ public:
     bool parseGroupArgs(
             QQmlV4Function *args, Compositor::Group *group, int *index, int *count, int *groups) const;
 
+    bool isSorted() const { return !sortRole.isEmpty(); }
+    bool isFiltered() const {
+        return group >= Compositor::MinimumGroupCount && !filterRole.isEmpty() && filterValue.isValid(); }
+    bool filterAccepts(const QVariant &value) const;
+    void invalidate();
+    void filter(const QQmlChangeSet &itemChanges);
+    void filter(int index, int count);
+    void sort();
+
     Compositor::Group group;
     QPointer<QQmlDelegateModel> model;
     QQmlDelegateModelGroupEmitterList emitters;
     QQmlChangeSet changeSet;
+    QQmlChangeSet pendingChangeSet;
     QString name;
+    QString sortRole;
+    QString filterRole;
+    QVariant filterValue;
+    Qt::SortOrder sortOrder;
     bool defaultInclude;
+    bool sortDirty;
+    bool filterDirty;
 };
 
 class QQmlDelegateModelParts;
@@ -257,6 +282,7 @@ public:
     QObject *object(Compositor::Group group, int index, bool asynchronous);
     QQmlDelegateModel::ReleaseFlags release(QObject *object);
     QString stringValue(Compositor::Group group, int index, const QString &name);
+    QVariant roleValue(const Compositor::iterator &it, const QString &name);
     void emitCreatedPackage(QQDMIncubationTask *incubationTask, QQuickPackage *package);
     void emitInitPackage(QQDMIncubationTask *incubationTask, QQuickPackage *package);
     void emitCreatedItem(QQDMIncubationTask *incubationTask, QObject *item) {
@@ -266,6 +292,9 @@ public:
     void emitDestroyingPackage(QQuickPackage *package);
     void emitDestroyingItem(QObject *item) { Q_EMIT q_func()->destroyingItem(item); }
     void removeCacheItem(QQmlDelegateModelItem *cacheItem);
+    bool poolItem(QQmlDelegateModelItem *cacheItem);
+    QQmlDelegateModelItem *reuseItem(Compositor::iterator &it);
+    void drainReusableItems();
 
     void updateFilterGroup();
 
@@ -286,7 +315,9 @@ public:
     void itemsMoved(
             const QVector<Compositor::Remove> &removes, const QVector<Compositor::Insert> &inserts);
     void itemsChanged(const QVector<Compositor::Change> &changes);
+    void updateSortAndFilter();
     void emitChanges();
+    void flushChanges();
     void emitModelUpdated(const QQmlChangeSet &changeSet, bool reset);
 
     bool insert(Compositor::insert_iterator &before, const QV4::ValueRef object, int groups);
@@ -308,6 +339,7 @@ public:
     QQmlDelegateModelGroupEmitterList m_pendingParts;
 
     QList<QQmlDelegateModelItem *> m_cache;
+    QList<QQmlDelegateModelItem *> m_reusableItems;
     QList<QQDMIncubationTask *> m_finishedIncubating;
     QList<QByteArray> m_watchedRoles;
 
@@ -322,6 +354,10 @@ public:
     bool m_reset : 1;
     bool m_transaction : 1;
     bool m_incubatorCleanupScheduled : 1;
+    bool m_coalesceChanges : 1;
+    bool m_flushScheduled : 1;
+    bool m_flushAfterTransaction : 1;
+    bool m_reuseItems : 1;
 
     union {
         struct {
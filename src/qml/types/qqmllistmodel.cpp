@@ -219,6 +219,7 @@ const ListLayout::Role *ListLayout::getRoleOrCreate(const QString &key, const QV
         case QVariant::Bool:        type = Role::Bool;        break;
         case QVariant::String:      type = Role::String;      break;
         case QVariant::Map:         type = Role::VariantMap;  break;
+        case QVariant::DateTime:    type = Role::DateTime;    break;
         default:                    type = Role::Invalid;     break;
     }
 
@@ -248,9 +249,216 @@ const ListLayout::Role *ListLayout::getExistingRole(const QV4::StringRef key)
     return r;
 }
 
+ListElement *ListElementTree::at(int index) const
+{
+    Q_ASSERT(index >= 0 && index < count());
+
+    if (m_cachedLeaf && index >= m_cachedLeafStart && index < m_cachedLeafStart + m_cachedLeaf->size)
+        return m_cachedLeaf->elements[index - m_cachedLeafStart];
+
+    const Node *node = m_root;
+    int start = 0;
+    while (!node->leaf) {
+        int i = 0;
+        while (index >= node->children[i]->count) {
+            index -= node->children[i]->count;
+            start += node->children[i]->count;
+            ++i;
+        }
+        node = node->children[i];
+    }
+
+    m_cachedLeaf = node;
+    m_cachedLeafStart = start;
+    return node->elements[index];
+}
+
+void ListElementTree::insert(int index, ListElement *element)
+{
+    Q_ASSERT(index >= 0 && index <= count());
+    m_cachedLeaf = 0;
+
+    if (!m_root)
+        m_root = new Node(true);
+
+    if (Node *sibling = insert(m_root, index, element)) {
+        Node *root = new Node(false);
+        root->children[0] = m_root;
+        root->children[1] = sibling;
+        root->size = 2;
+        root->count = m_root->count + sibling->count;
+        m_root = root;
+    }
+}
+
+// Inserts element at index below node.  Returns the new right half of node if node
+// had to be split, 0 otherwise.
+ListElementTree::Node *ListElementTree::insert(Node *node, int index, ListElement *element)
+{
+    ++node->count;
+
+    if (node->leaf) {
+        ::memmove(node->elements + index + 1, node->elements + index, (node->size - index) * sizeof(ListElement *));
+        node->elements[index] = element;
+        ++node->size;
+    } else {
+        int i = 0;
+        while (i < node->size - 1 && index > node->children[i]->count) {
+            index -= node->children[i]->count;
+            ++i;
+        }
+
+        Node *split = insert(node->children[i], index, element);
+        if (!split)
+            return 0;
+
+        ::memmove(node->children + i + 2, node->children + i + 1, (node->size - i - 1) * sizeof(Node *));
+        node->children[i + 1] = split;
+        ++node->size;
+    }
+
+    if (node->size < NodeSize)
+        return 0;
+
+    Node *sibling = new Node(node->leaf);
+    sibling->size = node->size - NodeSize / 2;
+    node->size = NodeSize / 2;
+
+    if (node->leaf) {
+        ::memcpy(sibling->elements, node->elements + node->size, sibling->size * sizeof(ListElement *));
+        sibling->count = sibling->size;
+    } else {
+        ::memcpy(sibling->children, node->children + node->size, sibling->size * sizeof(Node *));
+        for (int i = 0; i < sibling->size; ++i)
+            sibling->count += sibling->children[i]->count;
+    }
+    node->count -= sibling->count;
+
+    return sibling;
+}
+
+ListElement *ListElementTree::take(int index)
+{
+    Q_ASSERT(index >= 0 && index < count());
+    m_cachedLeaf = 0;
+
+    ListElement *element = take(m_root, index);
+
+    while (!m_root->leaf && m_root->size == 1) {
+        Node *child = m_root->children[0];
+        delete m_root;
+        m_root = child;
+    }
+
+    if (m_root->count == 0) {
+        destroy(m_root);
+        m_root = 0;
+    }
+
+    return element;
+}
+
+ListElement *ListElementTree::take(Node *node, int index)
+{
+    --node->count;
+
+    if (node->leaf) {
+        ListElement *element = node->elements[index];
+        --node->size;
+        ::memmove(node->elements + index, node->elements + index + 1, (node->size - index) * sizeof(ListElement *));
+        return element;
+    }
+
+    int i = 0;
+    while (index >= node->children[i]->count) {
+        index -= node->children[i]->count;
+        ++i;
+    }
+
+    ListElement *element = take(node->children[i], index);
+
+    rebalance(node, i);
+
+    return element;
+}
+
+// Restores the minimum fill of the child at i of node after a removal, by merging it
+// with a neighbour or, if both don't fit into one node, moving entries over from it.
+void ListElementTree::rebalance(Node *node, int i)
+{
+    if (node->children[i]->size >= MinSize || node->size < 2)
+        return;
+
+    const int left = (i + 1 < node->size) ? i : i - 1;
+    Node *leftNode = node->children[left];
+    Node *rightNode = node->children[left + 1];
+
+    // Elements and children share their storage, so both are moved through children
+    if (leftNode->size + rightNode->size < NodeSize) {
+        ::memcpy(leftNode->children + leftNode->size, rightNode->children, rightNode->size * sizeof(Node *));
+        leftNode->size += rightNode->size;
+        leftNode->count += rightNode->count;
+        delete rightNode;
+
+        --node->size;
+        ::memmove(node->children + left + 1, node->children + left + 2, (node->size - left - 1) * sizeof(Node *));
+        return;
+    }
+
+    const int leftSize = (leftNode->size + rightNode->size) / 2;
+    if (leftNode->size > leftSize) {
+        const int moved = leftNode->size - leftSize;
+        const int movedCount = countEntries(leftNode, leftSize, moved);
+        ::memmove(rightNode->children + moved, rightNode->children, rightNode->size * sizeof(Node *));
+        ::memcpy(rightNode->children, leftNode->children + leftSize, moved * sizeof(Node *));
+        leftNode->size -= moved;
+        leftNode->count -= movedCount;
+        rightNode->size += moved;
+        rightNode->count += movedCount;
+    } else {
+        const int moved = leftSize - leftNode->size;
+        const int movedCount = countEntries(rightNode, 0, moved);
+        ::memcpy(leftNode->children + leftNode->size, rightNode->children, moved * sizeof(Node *));
+        ::memmove(rightNode->children, rightNode->children + moved, (rightNode->size - moved) * sizeof(Node *));
+        leftNode->size += moved;
+        leftNode->count += movedCount;
+        rightNode->size -= moved;
+        rightNode->count -= movedCount;
+    }
+}
+
+// Returns the number of elements in the n entries of node starting at from.
+int ListElementTree::countEntries(const Node *node, int from, int n)
+{
+    if (node->leaf)
+        return n;
+
+    int count = 0;
+    for (int i = from; i < from + n; ++i)
+        count += node->children[i]->count;
+    return count;
+}
+
+void ListElementTree::clear()
+{
+    if (m_root)
+        destroy(m_root);
+    m_root = 0;
+    m_cachedLeaf = 0;
+}
+
+void ListElementTree::destroy(Node *node)
+{
+    if (!node->leaf) {
+        for (int i = 0; i < node->size; ++i)
+            destroy(node->children[i]);
+    }
+    delete node;
+}
+
 ModelObject *ListModel::getOrCreateModelObject(QQmlListModel *model, int elementIndex)
 {
-    ListElement *e = elements[elementIndex];
+    ListElement *e = elements.at(elementIndex);
     if (e->m_objectCache == 0) {
         e->m_objectCache = new ModelObject(model, elementIndex);
     }
@@ -295,8 +503,7 @@ void ListModel::sync(ListModel *src, ListModel *target, QHash<int, ListModel *>
         const ElementSync &s = it.value();
         if (s.src == 0) {
             s.target->destroy(target->m_layout);
-            target->elements.removeOne(s.target);
-            delete s.target;
+            ListLayout::releaseElement(s.target);
         }
         ++it;
     }
@@ -312,7 +519,7 @@ void ListModel::sync(ListModel *src, ListModel *target, QHash<int, ListModel *>
         const ElementSync &s = it.value();
         ListElement *targetElement = s.target;
         if (targetElement == 0) {
-            targetElement = new ListElement(srcElement->getUid());
+            targetElement = target->m_layout->allocateElement(srcElement->getUid());
         }
         ListElement::sync(srcElement, src->m_layout, targetElement, target->m_layout, targetModelHash);
         target->elements.append(targetElement);
@@ -322,13 +529,13 @@ void ListModel::sync(ListModel *src, ListModel *target, QHash<int, ListModel *>
 
     // Update values stored in target meta objects
     for (int i=0 ; i < target->elements.count() ; ++i) {
-        ListElement *e = target->elements[i];
+        ListElement *e = target->elements.at(i);
         if (e->m_objectCache)
             e->m_objectCache->updateValues();
     }
 }
 
-ListModel::ListModel(ListLayout *layout, QQmlListModel *modelCache, int uid) : m_layout(layout), m_modelCache(modelCache)
+ListModel::ListModel(ListLayout *layout, QQmlListModel *modelCache, int uid) : m_layout(layout), m_cacheIndicesDirty(false), m_modelCache(modelCache)
 {
     if (uid == -1)
         uid = uidCounter.fetchAndAddOrdered(1);
@@ -355,34 +562,24 @@ int ListModel::appendElement()
 void ListModel::insertElement(int index)
 {
     newElement(index);
-    updateCacheIndices();
+    m_cacheIndicesDirty = true;
 }
 
 void ListModel::move(int from, int to, int n)
 {
-    if (from > to) {
-        // Only move forwards - flip if backwards moving
-        int tfrom = from;
-        int tto = to;
-        from = tto;
-        to = tto+n;
-        n = tfrom-tto;
-    }
-
     QPODVector<ListElement *, 4> store;
-    for (int i=0 ; i < (to-from) ; ++i)
-        store.append(elements[from+n+i]);
+    store.reserve(n);
     for (int i=0 ; i < n ; ++i)
-        store.append(elements[from+i]);
-    for (int i=0 ; i < store.count() ; ++i)
-        elements[from+i] = store[i];
+        store.append(elements.take(from));
+    for (int i=0 ; i < n ; ++i)
+        elements.insert(to+i, store.at(i));
 
-    updateCacheIndices();
+    m_cacheIndicesDirty = true;
 }
 
 void ListModel::newElement(int index)
 {
-    ListElement *e = new ListElement;
+    ListElement *e = m_layout->allocateElement();
     elements.insert(index, e);
 }
 
@@ -394,24 +591,25 @@ void ListModel::updateCacheIndices()
             e->m_objectCache->m_elementIndex = i;
         }
     }
+    m_cacheIndicesDirty = false;
 }
 
 QVariant ListModel::getProperty(int elementIndex, int roleIndex, const QQmlListModel *owner, QV8Engine *eng)
 {
-    ListElement *e = elements[elementIndex];
+    ListElement *e = elements.at(elementIndex);
     const ListLayout::Role &r = m_layout->getExistingRole(roleIndex);
     return e->getProperty(r, owner, eng);
 }
 
 ListModel *ListModel::getListProperty(int elementIndex, const ListLayout::Role &role)
 {
-    ListElement *e = elements[elementIndex];
+    ListElement *e = elements.at(elementIndex);
     return e->getListProperty(role);
 }
 
 void ListModel::set(int elementIndex, QV4::ObjectRef object, QVector<int> *roles, QV8Engine *eng)
 {
-    ListElement *e = elements[elementIndex];
+    ListElement *e = elements.at(elementIndex);
 
     QV4::ExecutionEngine *v4 = object->engine();
     QV4::Scope scope(v4);
@@ -479,16 +677,44 @@ void ListModel::set(int elementIndex, QV4::ObjectRef object, QVector<int> *roles
     }
 
     if (e->m_objectCache) {
+        e->m_objectCache->m_elementIndex = elementIndex;
         e->m_objectCache->updateValues(*roles);
     }
 }
 
+const ListLayout::Role &ListModel::getRoleOrCreate(const QV4::StringRef name, ListLayout::Role::DataType type, RoleCache *roleCache)
+{
+    if (!roleCache)
+        return m_layout->getRoleOrCreate(name, type);
+
+    const QV4::Identifier *identifier = name->largestSubLength ? 0 : name->identifier;
+    if (identifier) {
+        for (int i=0 ; i < roleCache->entries.count() ; ++i) {
+            const RoleCache::Entry &entry = roleCache->entries.at(i);
+            if (entry.identifier == identifier && entry.type == type)
+                return *entry.role;
+        }
+    }
+
+    const ListLayout::Role &r = m_layout->getRoleOrCreate(name, type);
+    if (identifier && r.type == type) {
+        RoleCache::Entry entry = { identifier, type, &r };
+        roleCache->entries.append(entry);
+    }
+    return r;
+}
+
 void ListModel::set(int elementIndex, QV4::ObjectRef object, QV8Engine *eng)
+{
+    set(elementIndex, object, eng, 0);
+}
+
+void ListModel::set(int elementIndex, QV4::ObjectRef object, QV8Engine *eng, RoleCache *roleCache)
 {
     if (!object)
         return;
 
-    ListElement *e = elements[elementIndex];
+    ListElement *e = elements.at(elementIndex);
 
     QV4::ExecutionEngine *v4 = object->engine();
     QV4::Scope scope(v4);
@@ -506,17 +732,17 @@ void ListModel::set(int elementIndex, QV4::ObjectRef object, QV8Engine *eng)
 
         // Add the value now
         if (propertyValue->isString()) {
-            const ListLayout::Role &r = m_layout->getRoleOrCreate(propertyName, ListLayout::Role::String);
+            const ListLayout::Role &r = getRoleOrCreate(propertyName, ListLayout::Role::String, roleCache);
             if (r.type == ListLayout::Role::String)
                 e->setStringPropertyFast(r, propertyValue->stringValue()->toQString());
         } else if (propertyValue->isNumber()) {
-            const ListLayout::Role &r = m_layout->getRoleOrCreate(propertyName, ListLayout::Role::Number);
+            const ListLayout::Role &r = getRoleOrCreate(propertyName, ListLayout::Role::Number, roleCache);
             if (r.type == ListLayout::Role::Number) {
                 e->setDoublePropertyFast(r, propertyValue->asDouble());
             }
         } else if (propertyValue->asArrayObject()) {
             a = propertyValue;
-            const ListLayout::Role &r = m_layout->getRoleOrCreate(propertyName, ListLayout::Role::List);
+            const ListLayout::Role &r = getRoleOrCreate(propertyName, ListLayout::Role::List, roleCache);
             if (r.type == ListLayout::Role::List) {
                 ListModel *subModel = new ListModel(r.subLayout, 0, -1);
 
@@ -529,13 +755,13 @@ void ListModel::set(int elementIndex, QV4::ObjectRef object, QV8Engine *eng)
                 e->setListPropertyFast(r, subModel);
             }
         } else if (propertyValue->isBoolean()) {
-            const ListLayout::Role &r = m_layout->getRoleOrCreate(propertyName, ListLayout::Role::Bool);
+            const ListLayout::Role &r = getRoleOrCreate(propertyName, ListLayout::Role::Bool, roleCache);
             if (r.type == ListLayout::Role::Bool) {
                 e->setBoolPropertyFast(r, propertyValue->booleanValue());
             }
         } else if (propertyValue->asDateObject()) {
             date = propertyValue;
-            const ListLayout::Role &r = m_layout->getRoleOrCreate(propertyName, ListLayout::Role::DateTime);
+            const ListLayout::Role &r = getRoleOrCreate(propertyName, ListLayout::Role::DateTime, roleCache);
             if (r.type == ListLayout::Role::DateTime) {
                 QDateTime dt = date->toQDateTime();;
                 e->setDateTimePropertyFast(r, dt);
@@ -544,11 +770,11 @@ void ListModel::set(int elementIndex, QV4::ObjectRef object, QV8Engine *eng)
             o = propertyValue;
             if (QV4::QObjectWrapper *wrapper = o->as<QV4::QObjectWrapper>()) {
                 QObject *o = wrapper->object();
-                const ListLayout::Role &r = m_layout->getRoleOrCreate(propertyName, ListLayout::Role::QObject);
+                const ListLayout::Role &r = getRoleOrCreate(propertyName, ListLayout::Role::QObject, roleCache);
                 if (r.type == ListLayout::Role::QObject)
                     e->setQObjectPropertyFast(r, o);
             } else {
-                const ListLayout::Role &role = m_layout->getRoleOrCreate(propertyName, ListLayout::Role::VariantMap);
+                const ListLayout::Role &role = getRoleOrCreate(propertyName, ListLayout::Role::VariantMap, roleCache);
                 if (role.type == ListLayout::Role::VariantMap)
                     e->setVariantMapFast(role, o, eng);
             }
@@ -564,8 +790,9 @@ void ListModel::clear()
 {
     int elementCount = elements.count();
     for (int i=0 ; i < elementCount ; ++i) {
-        elements[i]->destroy(m_layout);
-        delete elements[i];
+        ListElement *e = elements.at(i);
+        e->destroy(m_layout);
+        ListLayout::releaseElement(e);
     }
     elements.clear();
 }
@@ -573,11 +800,11 @@ void ListModel::clear()
 void ListModel::remove(int index, int count)
 {
     for (int i=0 ; i < count ; ++i) {
-        elements[index+i]->destroy(m_layout);
-        delete elements[index+i];
+        ListElement *e = elements.take(index);
+        e->destroy(m_layout);
+        ListLayout::releaseElement(e);
     }
-    elements.remove(index, count);
-    updateCacheIndices();
+    m_cacheIndicesDirty = true;
 }
 
 void ListModel::insert(int elementIndex, QV4::ObjectRef object, QV8Engine *eng)
@@ -593,18 +820,86 @@ int ListModel::append(QV4::ObjectRef object, QV8Engine *eng)
     return elementIndex;
 }
 
+void ListModel::insertObjects(int elementIndex, QV4::ArrayObjectRef objects, QV8Engine *eng)
+{
+    QV4::Scope scope(objects->engine());
+    QV4::ScopedObject o(scope);
+    RoleCache roleCache;
+
+    int objectCount = objects->arrayLength();
+    for (int i=0 ; i < objectCount ; ++i) {
+        o = objects->getIndexed(i);
+        elements.insert(elementIndex + i, m_layout->allocateElement());
+        set(elementIndex + i, o, eng, &roleCache);
+    }
+
+    m_cacheIndicesDirty = true;
+}
+
+void ListModel::insertRows(int elementIndex, const QVector<QVariantMap> &rows)
+{
+    QHash<QString, const ListLayout::Role *> roleCache;
+
+    for (int i=0 ; i < rows.count() ; ++i) {
+        ListElement *e = m_layout->allocateElement();
+        elements.insert(elementIndex + i, e);
+
+        const QVariantMap &row = rows.at(i);
+        QVariantMap::const_iterator it = row.constBegin();
+        QVariantMap::const_iterator end = row.constEnd();
+        for (; it != end; ++it) {
+            const ListLayout::Role *r = roleCache.value(it.key());
+            if (!r) {
+                r = m_layout->getRoleOrCreate(it.key(), it.value());
+                if (!r)
+                    continue;
+                roleCache.insert(it.key(), r);
+            }
+            e->setVariantProperty(*r, it.value());
+        }
+    }
+
+    m_cacheIndicesDirty = true;
+}
+
+void ListModel::insertColumns(int elementIndex, const QStringList &roleNames, const QVector<QVariantList> &columns, int rowCount)
+{
+    for (int i=0 ; i < rowCount ; ++i)
+        elements.insert(elementIndex + i, m_layout->allocateElement());
+
+    for (int c=0 ; c < roleNames.count() ; ++c) {
+        const QVariantList &column = columns.at(c);
+        const ListLayout::Role *r = 0;
+
+        for (int i=0 ; i < rowCount ; ++i) {
+            const QVariant &value = column.at(i);
+            if (!value.isValid())
+                continue;
+            if (!r) {
+                r = m_layout->getRoleOrCreate(roleNames.at(c), value);
+                if (!r)
+                    break;
+            }
+            elements.at(elementIndex + i)->setVariantProperty(*r, value);
+        }
+    }
+
+    m_cacheIndicesDirty = true;
+}
+
 int ListModel::setOrCreateProperty(int elementIndex, const QString &key, const QVariant &data)
 {
     int roleIndex = -1;
 
     if (elementIndex >= 0 && elementIndex < elements.count()) {
-        ListElement *e = elements[elementIndex];
+        ListElement *e = elements.at(elementIndex);
 
         const ListLayout::Role *r = m_layout->getRoleOrCreate(key, data);
         if (r) {
             roleIndex = e->setVariantProperty(*r, data);
 
             if (roleIndex != -1 && e->m_objectCache) {
+                e->m_objectCache->m_elementIndex = elementIndex;
                 QVector<int> roles;
                 roles << roleIndex;
                 e->m_objectCache->updateValues(roles);
@@ -620,7 +915,7 @@ int ListModel::setExistingProperty(int elementIndex, const QString &key, const Q
     int roleIndex = -1;
 
     if (elementIndex >= 0 && elementIndex < elements.count()) {
-        ListElement *e = elements[elementIndex];
+        ListElement *e = elements.at(elementIndex);
         const ListLayout::Role *r = m_layout->getExistingRole(key);
         if (r)
             roleIndex = e->setJsProperty(*r, data, eng);
@@ -1252,6 +1547,12 @@ void ModelObject::updateValues(const QVector<int> &roles)
     }
 }
 
+int ModelObject::elementIndex() const
+{
+    m_model->m_listModel->ensureCacheIndices();
+    return m_elementIndex;
+}
+
 ModelNodeMetaObject::ModelNodeMetaObject(ModelObject *object)
 : QQmlOpenMetaObject(object), m_enabled(false), m_obj(object)
 {
@@ -1274,11 +1575,12 @@ void ModelNodeMetaObject::propertyWritten(int index)
     QV4::Scope scope(QV8Engine::getV4((eng)));
     QV4::ScopedValue v(scope, eng->fromVariant(value));
 
-    int roleIndex = m_obj->m_model->m_listModel->setExistingProperty(m_obj->m_elementIndex, propName, v, eng);
+    const int elementIndex = m_obj->elementIndex();
+    int roleIndex = m_obj->m_model->m_listModel->setExistingProperty(elementIndex, propName, v, eng);
     if (roleIndex != -1) {
         QVector<int> roles;
         roles << roleIndex;
-        m_obj->m_model->emitItemsChanged(m_obj->m_elementIndex, 1, roles);
+        m_obj->m_model->emitItemsChanged(elementIndex, 1, roles);
     }
 }
 
@@ -1693,9 +1995,13 @@ void QQmlListModel::emitItemsChanged(int index, int count, const QVector<int> &r
 
     if (m_mainThread) {
         emit dataChanged(createIndex(index, 0), createIndex(index + count - 1, 0), roles);;
+        if (m_agent)
+            m_agent->modelModified();
+    } else if (m_dynamicRoles) {
+        m_agent->data.changedChange(getUid(), index, count, roles, QVector<int>());
     } else {
-        int uid = m_dynamicRoles ? getUid() : m_listModel->getUid();
-        m_agent->data.changedChange(uid, index, count, roles);
+        m_agent->data.changedChange(m_listModel->getUid(), index, count, roles, m_listModel->getElementUids(index, count));
+        m_agent->copyElements(m_listModel, index, count);
     }
 }
 
@@ -1708,11 +2014,14 @@ void QQmlListModel::emitItemsRemoved(int index, int count)
             beginRemoveRows(QModelIndex(), index, index + count - 1);
             endRemoveRows();
             emit countChanged();
+            if (m_agent)
+                m_agent->modelModified();
     } else {
         int uid = m_dynamicRoles ? getUid() : m_listModel->getUid();
-        if (index == 0 && count == this->count())
-            m_agent->data.clearChange(uid);
-        m_agent->data.removeChange(uid, index, count);
+        if (index == 0 && this->count() == 0)
+            count -= m_agent->data.clearChange(uid);
+        if (count > 0)
+            m_agent->data.removeChange(uid, index, count);
     }
 }
 
@@ -1725,9 +2034,13 @@ void QQmlListModel::emitItemsInserted(int index, int count)
         beginInsertRows(QModelIndex(), index, index + count - 1);
         endInsertRows();
         emit countChanged();
+        if (m_agent)
+            m_agent->modelModified();
+    } else if (m_dynamicRoles) {
+        m_agent->data.insertChange(getUid(), index, count, QVector<int>());
     } else {
-        int uid = m_dynamicRoles ? getUid() : m_listModel->getUid();
-        m_agent->data.insertChange(uid, index, count);
+        m_agent->data.insertChange(m_listModel->getUid(), index, count, m_listModel->getElementUids(index, count));
+        m_agent->copyElements(m_listModel, index, count);
     }
 }
 
@@ -1739,6 +2052,8 @@ void QQmlListModel::emitItemsMoved(int from, int to, int n)
     if (m_mainThread) {
         beginMoveRows(QModelIndex(), from, from + n - 1, QModelIndex(), to > from ? to + n : to);
         endMoveRows();
+        if (m_agent)
+            m_agent->modelModified();
     } else {
         int uid = m_dynamicRoles ? getUid() : m_listModel->getUid();
         m_agent->data.moveChange(uid, from, n, to);
@@ -1954,17 +2269,16 @@ void QQmlListModel::insert(QQmlV4Function *args)
         QV4::ScopedObject argObject(scope, (*args)[1]);
         QV4::ScopedArrayObject objectArray(scope, (*args)[1]);
         if (objectArray) {
-            QV4::ScopedObject argObject(scope);
-
             int objectArrayLength = objectArray->arrayLength();
-            for (int i=0 ; i < objectArrayLength ; ++i) {
-                argObject = objectArray->getIndexed(i);
-
-                if (m_dynamicRoles) {
-                    m_modelObjects.insert(index+i, DynamicRoleModelNode::create(args->engine()->variantMapFromJS(argObject), this));
-                } else {
-                    m_listModel->insert(index+i, argObject, args->engine());
+            if (m_dynamicRoles) {
+                QV4::ScopedObject argObject(scope);
+                m_modelObjects.insert(index, objectArrayLength, 0);
+                for (int i=0 ; i < objectArrayLength ; ++i) {
+                    argObject = objectArray->getIndexed(i);
+                    m_modelObjects[index+i] = DynamicRoleModelNode::create(args->engine()->variantMapFromJS(argObject), this);
                 }
+            } else {
+                m_listModel->insertObjects(index, objectArray, args->engine());
             }
             emitItemsInserted(index, objectArrayLength);
         } else if (argObject) {
@@ -1983,6 +2297,88 @@ void QQmlListModel::insert(QQmlV4Function *args)
     }
 }
 
+/*!
+    Inserts \a rows into the model at \a index, each row given as a map from
+    role name to value.
+
+    Roles are resolved once for the whole batch and a single rowsInserted()
+    signal is emitted, which makes this considerably cheaper than appending
+    the rows one at a time when populating a large model from C++.
+
+    \internal
+*/
+void QQmlListModel::insertBulk(int index, const QVector<QVariantMap> &rows)
+{
+    if (index < 0 || index > count()) {
+        qmlInfo(this) << tr("insert: index %1 out of range").arg(index);
+        return;
+    }
+
+    if (rows.isEmpty())
+        return;
+
+    if (m_dynamicRoles) {
+        m_modelObjects.insert(index, rows.count(), 0);
+        for (int i=0 ; i < rows.count() ; ++i)
+            m_modelObjects[index+i] = DynamicRoleModelNode::create(rows.at(i), this);
+    } else {
+        m_listModel->insertRows(index, rows);
+    }
+
+    emitItemsInserted(index, rows.count());
+}
+
+/*!
+    Inserts rows into the model at \a index from column data.  \a columns
+    holds one list of values per entry in \a roleNames, and all columns must
+    have the same length.  Invalid values leave the role unset for that row.
+
+    \internal
+*/
+void QQmlListModel::insertBulk(int index, const QStringList &roleNames, const QVector<QVariantList> &columns)
+{
+    if (index < 0 || index > count()) {
+        qmlInfo(this) << tr("insert: index %1 out of range").arg(index);
+        return;
+    }
+
+    if (roleNames.count() != columns.count()) {
+        qmlInfo(this) << tr("insert: %1 role names given for %2 columns").arg(roleNames.count()).arg(columns.count());
+        return;
+    }
+
+    if (columns.isEmpty())
+        return;
+
+    int rowCount = columns.at(0).count();
+    for (int c=1 ; c < columns.count() ; ++c) {
+        if (columns.at(c).count() != rowCount) {
+            qmlInfo(this) << tr("insert: column '%1' has %2 values, expected %3").arg(roleNames.at(c)).arg(columns.at(c).count()).arg(rowCount);
+            return;
+        }
+    }
+
+    if (rowCount == 0)
+        return;
+
+    if (m_dynamicRoles) {
+        m_modelObjects.insert(index, rowCount, 0);
+        for (int i=0 ; i < rowCount ; ++i) {
+            QVariantMap row;
+            for (int c=0 ; c < roleNames.count() ; ++c) {
+                const QVariant &value = columns.at(c).at(i);
+                if (value.isValid())
+                    row.insert(roleNames.at(c), value);
+            }
+            m_modelObjects[index+i] = DynamicRoleModelNode::create(row, this);
+        }
+    } else {
+        m_listModel->insertColumns(index, roleNames, columns, rowCount);
+    }
+
+    emitItemsInserted(index, rowCount);
+}
+
 /*!
     \qmlmethod ListModel::move(int from, int to, int n)
 
@@ -2056,19 +2452,18 @@ void QQmlListModel::append(QQmlV4Function *args)
         QV4::ScopedArrayObject objectArray(scope, (*args)[0]);
 
         if (objectArray) {
-            QV4::Scoped<QV4::Object> argObject(scope);
-
             int objectArrayLength = objectArray->arrayLength();
 
             int index = count();
-            for (int i=0 ; i < objectArrayLength ; ++i) {
-                argObject = objectArray->getIndexed(i);
-
-                if (m_dynamicRoles) {
+            if (m_dynamicRoles) {
+                QV4::Scoped<QV4::Object> argObject(scope);
+                m_modelObjects.reserve(index + objectArrayLength);
+                for (int i=0 ; i < objectArrayLength ; ++i) {
+                    argObject = objectArray->getIndexed(i);
                     m_modelObjects.append(DynamicRoleModelNode::create(args->engine()->variantMapFromJS(argObject), this));
-                } else {
-                    m_listModel->append(argObject, args->engine());
                 }
+            } else {
+                m_listModel->insertObjects(index, objectArray, args->engine());
             }
 
             emitItemsInserted(index, objectArrayLength);
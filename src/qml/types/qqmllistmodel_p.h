@@ -90,6 +90,9 @@ public:
     Q_INVOKABLE void move(int from, int to, int count);
     Q_INVOKABLE void sync();
 
+    void insertBulk(int index, const QVector<QVariantMap> &rows);
+    void insertBulk(int index, const QStringList &roleNames, const QVector<QVariantList> &columns);
+
     QQmlListModelWorkerAgent *agent();
 
     bool dynamicRoles() const { return m_dynamicRoles; }
@@ -56,6 +56,7 @@
 #include "qqmllistmodel_p.h"
 #include <private/qqmlengine_p.h>
 #include <private/qqmlopenmetaobject_p.h>
+#include <private/qrecyclepool_p.h>
 #include <qqml.h>
 
 QT_BEGIN_NAMESPACE
@@ -162,13 +163,17 @@ public:
     void updateValues();
     void updateValues(const QVector<int> &roles);
 
+    int elementIndex() const;
+
     QQmlListModel *m_model;
-    int m_elementIndex;
+    int m_elementIndex; // Up to date after ListModel::ensureCacheIndices()
 
 private:
     ModelNodeMetaObject *m_meta;
 };
 
+class ListElement;
+
 class ListLayout
 {
 public:
@@ -220,6 +225,11 @@ public:
 
     static void sync(ListLayout *src, ListLayout *target);
 
+    // The first block of each element using this layout comes from the layout's pool
+    inline ListElement *allocateElement();
+    inline ListElement *allocateElement(int existingUid);
+    static inline void releaseElement(ListElement *element);
+
 private:
     const Role &createRole(const QString &key, Role::DataType type);
 
@@ -227,6 +237,7 @@ private:
     int currentBlockOffset;
     QVector<Role *> roles;
     QStringHash<Role *> roleHash;
+    QRecyclePool<ListElement, 64> elementPool;
 };
 
 /*!
@@ -293,6 +304,75 @@ private:
     ModelObject *m_objectCache;
 
     friend class ListModel;
+    friend class QQmlListModelWorkerAgent;
+};
+
+ListElement *ListLayout::allocateElement()
+{
+    return elementPool.New();
+}
+
+ListElement *ListLayout::allocateElement(int existingUid)
+{
+    return elementPool.New(existingUid);
+}
+
+void ListLayout::releaseElement(ListElement *element)
+{
+    QRecyclePool<ListElement, 64>::Delete(element);
+}
+
+/*!
+\internal
+
+Positional container for the elements of a ListModel.  It is a B+-tree keeping the
+number of elements below each node, so that elements are looked up, inserted and
+removed at any position in logarithmic time.
+*/
+class ListElementTree
+{
+public:
+    ListElementTree() : m_root(0), m_cachedLeaf(0), m_cachedLeafStart(0) {}
+    ~ListElementTree() { clear(); }
+
+    int count() const { return m_root ? m_root->count : 0; }
+
+    ListElement *at(int index) const;
+    void insert(int index, ListElement *element);
+    void append(ListElement *element) { insert(count(), element); }
+    ListElement *take(int index);
+    void clear();
+
+private:
+    Q_DISABLE_COPY(ListElementTree)
+
+    // Nodes other than the root hold at least MinSize entries, and split when full
+    enum { NodeSize = 64, MinSize = NodeSize / 4 };
+
+    struct Node
+    {
+        Node(bool isLeaf) : count(0), size(0), leaf(isLeaf) {}
+
+        int count; // Elements in this subtree
+        int size;  // Used entries
+        bool leaf;
+        union {
+            Node *children[NodeSize];
+            ListElement *elements[NodeSize];
+        };
+    };
+
+    static Node *insert(Node *node, int index, ListElement *element);
+    static ListElement *take(Node *node, int index);
+    static void rebalance(Node *node, int i);
+    static int countEntries(const Node *node, int from, int n);
+    static void destroy(Node *node);
+
+    Node *m_root;
+    // The leaf the last lookup ended in, so that iterating over the elements doesn't
+    // descend from the root for each of them
+    mutable const Node *m_cachedLeaf;
+    mutable int m_cachedLeafStart;
 };
 
 /*!
@@ -339,6 +419,10 @@ public:
     int append(QV4::ObjectRef object, QV8Engine *eng);
     void insert(int elementIndex, QV4::ObjectRef object, QV8Engine *eng);
 
+    void insertObjects(int elementIndex, QV4::ArrayObjectRef objects, QV8Engine *eng);
+    void insertRows(int elementIndex, const QVector<QVariantMap> &rows);
+    void insertColumns(int elementIndex, const QStringList &roleNames, const QVector<QVariantList> &columns, int rowCount);
+
     void clear();
     void remove(int index, int count);
 
@@ -349,14 +433,29 @@ public:
 
     int getUid() const { return m_uid; }
 
+    QVector<int> getElementUids(int index, int count) const
+    {
+        QVector<int> uids(count);
+        for (int i=0 ; i < count ; ++i)
+            uids[i] = elements.at(index + i)->getUid();
+        return uids;
+    }
+
     static void sync(ListModel *src, ListModel *target, QHash<int, ListModel *> *srcModelHash);
 
     ModelObject *getOrCreateModelObject(QQmlListModel *model, int elementIndex);
 
+    void ensureCacheIndices()
+    {
+        if (m_cacheIndicesDirty)
+            updateCacheIndices();
+    }
+
 private:
-    QPODVector<ListElement *, 4> elements;
+    ListElementTree elements;
     ListLayout *m_layout;
     int m_uid;
+    bool m_cacheIndicesDirty;
 
     QQmlListModel *m_modelCache;
 
@@ -368,6 +467,23 @@ private:
         ListElement *target;
     };
 
+    // Roles already resolved while setting many elements from JS objects.  Property
+    // names of plain objects are interned, so they are compared by identifier.
+    struct RoleCache
+    {
+        struct Entry
+        {
+            const QV4::Identifier *identifier;
+            ListLayout::Role::DataType type;
+            const ListLayout::Role *role;
+        };
+
+        QVarLengthArray<Entry, 16> entries;
+    };
+
+    const ListLayout::Role &getRoleOrCreate(const QV4::StringRef name, ListLayout::Role::DataType type, RoleCache *roleCache);
+    void set(int elementIndex, QV4::ObjectRef object, QV8Engine *eng, RoleCache *roleCache);
+
     void newElement(int index);
 
     void updateCacheIndices();
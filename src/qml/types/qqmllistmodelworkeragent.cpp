@@ -53,55 +53,120 @@
 QT_BEGIN_NAMESPACE
 
 
-void QQmlListModelWorkerAgent::Data::clearChange(int uid)
+/*
+    Drops the pending changes of the model \a uid and returns the number of rows
+    they added, so the caller can express the removal of every row against the
+    state of the previous sync.
+*/
+int QQmlListModelWorkerAgent::Data::clearChange(int uid)
 {
+    int added = 0;
     for (int i=0 ; i < changes.count() ; ++i) {
-        if (changes[i].modelUid == uid) {
+        const Change &change = changes.at(i);
+        if (change.modelUid == uid) {
+            if (change.type == Change::Inserted)
+                added += change.count;
+            else if (change.type == Change::Removed)
+                added -= change.count;
             changes.removeAt(i);
             --i;
         }
     }
+    return added;
 }
 
-void QQmlListModelWorkerAgent::Data::insertChange(int uid, int index, int count)
+void QQmlListModelWorkerAgent::Data::insertChange(int uid, int index, int count, const QVector<int> &uids)
 {
-    Change c = { uid, Change::Inserted, index, count, 0, QVector<int>() };
+    Change c = { uid, Change::Inserted, index, count, 0, QVector<int>(), uids };
     changes << c;
 }
 
 void QQmlListModelWorkerAgent::Data::removeChange(int uid, int index, int count)
 {
-    Change c = { uid, Change::Removed, index, count, 0, QVector<int>() };
+    Change c = { uid, Change::Removed, index, count, 0, QVector<int>(), QVector<int>() };
     changes << c;
 }
 
 void QQmlListModelWorkerAgent::Data::moveChange(int uid, int index, int count, int to)
 {
-    Change c = { uid, Change::Moved, index, count, to, QVector<int>() };
+    Change c = { uid, Change::Moved, index, count, to, QVector<int>(), QVector<int>() };
     changes << c;
 }
 
-void QQmlListModelWorkerAgent::Data::changedChange(int uid, int index, int count, const QVector<int> &roles)
+void QQmlListModelWorkerAgent::Data::changedChange(int uid, int index, int count, const QVector<int> &roles, const QVector<int> &uids)
 {
-    Change c = { uid, Change::Changed, index, count, 0, roles };
+    Change c = { uid, Change::Changed, index, count, 0, roles, uids };
     changes << c;
 }
 
+void QQmlListModelWorkerAgent::destroySnapshot(ListModel *snapshot)
+{
+    if (snapshot) {
+        ListLayout *layout = snapshot->m_layout;
+        snapshot->destroy();
+        delete snapshot;
+        delete layout;
+    }
+}
+
+QQmlListModelWorkerAgent::Sync::~Sync()
+{
+    destroySnapshot(snapshot);
+}
+
 QQmlListModelWorkerAgent::QQmlListModelWorkerAgent(QQmlListModel *model)
-: m_ref(1), m_orig(model), m_copy(new QQmlListModel(model, this))
+: m_ref(1), m_fullSyncRequested(0), m_workerEngine(0), m_orig(model), m_copy(new QQmlListModel(model, this)), m_pending(0)
 {
 }
 
 QQmlListModelWorkerAgent::~QQmlListModelWorkerAgent()
 {
+    destroySnapshot(m_pending);
+
     mutex.lock();
     syncDone.wakeAll();
     mutex.unlock();
 }
 
-void QQmlListModelWorkerAgent::setV8Engine(QV8Engine *eng)
+/*
+    Copies \a count rows of \a src starting at \a index into the snapshot the
+    next sync posts, replacing any earlier copy of the same rows.  Called on the
+    worker thread as inserted and changed rows are recorded, so a sync only
+    copies what the batch touched and never has to look rows up by uid.  Rows of
+    nested lists aren't copied; changing them forces a full sync.
+*/
+void QQmlListModelWorkerAgent::copyElements(ListModel *src, int index, int count)
 {
+    if (src != m_copy->m_listModel)
+        return;
+
+    if (!m_pending)
+        m_pending = new ListModel(new ListLayout(src->m_layout), 0, src->getUid());
+    else
+        ListLayout::sync(src->m_layout, m_pending->m_layout);
+
+    for (int i=0 ; i < count ; ++i) {
+        ListElement *e = src->elements.at(index + i);
+        ListElement *&copy = m_pendingElements[e->getUid()];
+        if (!copy) {
+            copy = m_pending->m_layout->allocateElement(e->getUid());
+            m_pending->elements.append(copy);
+        }
+        ListElement::sync(e, src->m_layout, copy, m_pending->m_layout, 0);
+    }
+}
+
+/*
+    Binds the worker's copy of the model to the worker engine \a eng.  The copy
+    isn't thread safe, so this fails if a worker on another thread already uses it.
+*/
+bool QQmlListModelWorkerAgent::setV8Engine(QV8Engine *eng)
+{
+    if (!m_workerEngine.testAndSetOrdered(0, eng) && m_workerEngine.load() != eng)
+        return false;
+
     m_copy->m_engine = eng;
+    return true;
 }
 
 void QQmlListModelWorkerAgent::addref()
@@ -122,6 +187,15 @@ void QQmlListModelWorkerAgent::modelDestroyed()
     m_orig = 0;
 }
 
+/*
+    Called when the original model is changed on the main thread.  The worker's
+    copy no longer matches it, so the next sync has to replace all rows.
+*/
+void QQmlListModelWorkerAgent::modelModified()
+{
+    m_fullSyncRequested.store(1);
+}
+
 int QQmlListModelWorkerAgent::count() const
 {
     return m_copy->count();
@@ -171,34 +245,180 @@ void QQmlListModelWorkerAgent::sync()
 {
     Sync *s = new Sync;
     s->data = data;
-    s->list = m_copy;
     data.changes.clear();
 
-    mutex.lock();
+    if (m_copy->m_dynamicRoles) {
+        s->list = m_copy;
+
+        mutex.lock();
+        QCoreApplication::postEvent(this, s);
+        syncDone.wait(&mutex);
+        mutex.unlock();
+        return;
+    }
+
+    // With static roles the rows are copied on the worker, so the main thread never
+    // reads the worker's model and the worker doesn't have to wait for the sync to
+    // be applied.  Only the rows touched since the last sync were copied, unless a
+    // nested list changed or the original model was modified behind our back.
+    ListModel *src = m_copy->m_listModel;
+    bool incremental = !m_fullSyncRequested.fetchAndStoreOrdered(0);
+
+    const QList<Change> &changes = s->data.changes;
+    for (int ii = 0; incremental && ii < changes.count(); ++ii) {
+        if (changes.at(ii).modelUid != src->getUid())
+            incremental = false;
+    }
+
+    ListModel *pending = m_pending;
+    m_pending = 0;
+    m_pendingElements.clear();
+
+    if (incremental) {
+        if (pending)
+            ListLayout::sync(src->m_layout, pending->m_layout);
+        else
+            pending = new ListModel(new ListLayout(src->m_layout), 0, src->getUid());
+        s->snapshot = pending;
+        s->incremental = true;
+    } else {
+        destroySnapshot(pending);
+        s->snapshot = new ListModel(new ListLayout, 0, src->getUid());
+        ListModel::sync(src, s->snapshot, 0);
+    }
+
     QCoreApplication::postEvent(this, s);
-    syncDone.wait(&mutex);
-    mutex.unlock();
+}
+
+/*
+    Replays the changes of an incremental sync on the original model, taking the
+    contents of inserted and changed rows from the snapshot.  Returns false
+    without touching the model if the changes don't fit it.
+*/
+bool QQmlListModelWorkerAgent::applyChanges(Sync *s)
+{
+    ListModel *target = m_orig->m_listModel;
+    ListModel *snapshot = s->snapshot;
+    const QList<Change> &changes = s->data.changes;
+
+    int count = target->elementCount();
+    for (int ii = 0; ii < changes.count(); ++ii) {
+        const Change &change = changes.at(ii);
+        int end = change.index + change.count;
+        switch (change.type) {
+        case Change::Inserted:
+            if (change.index < 0 || change.index > count || change.uids.count() != change.count)
+                return false;
+            count += change.count;
+            break;
+        case Change::Removed:
+            if (change.index < 0 || end > count)
+                return false;
+            count -= change.count;
+            break;
+        case Change::Moved:
+            if (change.index < 0 || end > count || change.to < 0 || change.to + change.count > count)
+                return false;
+            break;
+        case Change::Changed:
+            if (change.index < 0 || end > count)
+                return false;
+            break;
+        }
+    }
+    bool cc = count != target->elementCount();
+
+    ListLayout::sync(snapshot->m_layout, target->m_layout);
+
+    QHash<int, ListElement *> pending;
+    for (int i=0 ; i < snapshot->elements.count() ; ++i) {
+        ListElement *e = snapshot->elements.at(i);
+        pending.insert(e->getUid(), e);
+    }
+    QHash<int, ListModel *> targetModelHash;
+
+    for (int ii = 0; ii < changes.count(); ++ii) {
+        const Change &change = changes.at(ii);
+        switch (change.type) {
+        case Change::Inserted:
+            m_orig->beginInsertRows(QModelIndex(), change.index, change.index + change.count - 1);
+            for (int i=0 ; i < change.count ; ++i) {
+                int uid = change.uids.at(i);
+                ListElement *e = target->m_layout->allocateElement(uid);
+                if (ListElement *src = pending.take(uid))
+                    ListElement::sync(src, snapshot->m_layout, e, target->m_layout, &targetModelHash);
+                target->elements.insert(change.index + i, e);
+            }
+            target->m_cacheIndicesDirty = true;
+            m_orig->endInsertRows();
+            break;
+        case Change::Removed:
+            m_orig->beginRemoveRows(QModelIndex(), change.index, change.index + change.count - 1);
+            target->remove(change.index, change.count);
+            m_orig->endRemoveRows();
+            break;
+        case Change::Moved:
+            m_orig->beginMoveRows(
+                        QModelIndex(),
+                        change.index,
+                        change.index + change.count - 1,
+                        QModelIndex(),
+                        change.to > change.index ? change.to + change.count : change.to);
+            target->move(change.index, change.to, change.count);
+            m_orig->endMoveRows();
+            break;
+        case Change::Changed:
+            for (int i=change.index ; i < change.index + change.count ; ++i) {
+                ListElement *e = target->elements.at(i);
+                if (ListElement *src = pending.take(e->getUid())) {
+                    ListElement::sync(src, snapshot->m_layout, e, target->m_layout, &targetModelHash);
+                    if (e->m_objectCache) {
+                        e->m_objectCache->m_elementIndex = i;
+                        e->m_objectCache->updateValues();
+                    }
+                }
+            }
+            emit m_orig->dataChanged(
+                        m_orig->createIndex(change.index, 0),
+                        m_orig->createIndex(change.index + change.count - 1, 0),
+                        change.roles);
+            break;
+        }
+    }
+
+    if (cc)
+        emit m_orig->countChanged();
+    return true;
 }
 
 bool QQmlListModelWorkerAgent::event(QEvent *e)
 {
     if (e->type() == QEvent::User) {
+        Sync *s = static_cast<Sync *>(e);
+        if (s->incremental) {
+            // If the original model has drifted from the worker's copy, leave it
+            // alone and have the next sync replace all rows.
+            if (m_orig && !applyChanges(s))
+                m_fullSyncRequested.store(1);
+            return true;
+        }
+
         bool cc = false;
         QMutexLocker locker(&mutex);
         if (m_orig) {
-            Sync *s = static_cast<Sync *>(e);
             const QList<Change> &changes = s->data.changes;
 
-            cc = m_orig->count() != s->list->count();
-
             QHash<int, QQmlListModel *> targetModelDynamicHash;
             QHash<int, ListModel *> targetModelStaticHash;
 
-            Q_ASSERT(m_orig->m_dynamicRoles == s->list->m_dynamicRoles);
-            if (m_orig->m_dynamicRoles)
+            Q_ASSERT(m_orig->m_dynamicRoles == (s->list != 0));
+            if (m_orig->m_dynamicRoles) {
+                cc = m_orig->count() != s->list->count();
                 QQmlListModel::sync(s->list, m_orig, &targetModelDynamicHash);
-            else
-                ListModel::sync(s->list->m_listModel, m_orig->m_listModel, &targetModelStaticHash);
+            } else {
+                cc = m_orig->count() != s->snapshot->elementCount();
+                ListModel::sync(s->snapshot, m_orig->m_listModel, &targetModelStaticHash);
+            }
 
             for (int ii = 0; ii < changes.count(); ++ii) {
                 const Change &change = changes.at(ii);
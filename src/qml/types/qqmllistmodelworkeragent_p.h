@@ -55,6 +55,7 @@
 
 #include <qqml.h>
 
+#include <QHash>
 #include <QMutex>
 #include <QWaitCondition>
 
@@ -64,6 +65,8 @@ QT_BEGIN_NAMESPACE
 
 
 class QQmlListModel;
+class ListModel;
+class ListElement;
 
 class QQmlListModelWorkerAgent : public QObject
 {
@@ -73,7 +76,7 @@ class QQmlListModelWorkerAgent : public QObject
 public:
     QQmlListModelWorkerAgent(QQmlListModel *);
     ~QQmlListModelWorkerAgent();
-    void setV8Engine(QV8Engine *eng);
+    bool setV8Engine(QV8Engine *eng);
 
     void addref();
     void release();
@@ -107,6 +110,7 @@ public:
     };
 
     void modelDestroyed();
+    void modelModified();
 protected:
     virtual bool event(QEvent *);
 
@@ -122,29 +126,41 @@ private:
         int count; // Inserted/Removed/Moved/Changed
         int to;    // Moved
         QVector<int> roles;
+        QVector<int> uids; // Inserted/Changed, static roles only
     };
 
     struct Data
     {
         QList<Change> changes;
 
-        void clearChange(int uid);
-        void insertChange(int uid, int index, int count);
+        int clearChange(int uid);
+        void insertChange(int uid, int index, int count, const QVector<int> &uids);
         void removeChange(int uid, int index, int count);
         void moveChange(int uid, int index, int count, int to);
-        void changedChange(int uid, int index, int count, const QVector<int> &roles);
+        void changedChange(int uid, int index, int count, const QVector<int> &roles, const QVector<int> &uids);
     };
     Data data;
 
     struct Sync : public QEvent {
-        Sync() : QEvent(QEvent::User) {}
+        Sync() : QEvent(QEvent::User), list(0), snapshot(0), incremental(false) {}
+        ~Sync();
         Data data;
-        QQmlListModel *list;
+        QQmlListModel *list;    // dynamic roles: the worker's model, read while the worker waits
+        ListModel *snapshot;    // static roles: rows copied from the worker's model
+        bool incremental;       // snapshot only holds the rows inserted or changed by data
     };
 
+    static void destroySnapshot(ListModel *snapshot);
+    void copyElements(ListModel *src, int index, int count);
+    bool applyChanges(Sync *s);
+
     QAtomicInt m_ref;
+    QAtomicInt m_fullSyncRequested;
+    QAtomicPointer<QV8Engine> m_workerEngine;
     QQmlListModel *m_orig;
     QQmlListModel *m_copy;
+    ListModel *m_pending;                       // rows inserted or changed since the last sync
+    QHash<int, ListElement *> m_pendingElements;
     QMutex mutex;
     QWaitCondition syncDone;
 };
@@ -74,15 +74,15 @@ class WorkerDataEvent : public QEvent
 public:
     enum Type { WorkerData = QEvent::User };
 
-    WorkerDataEvent(int workerId, const QByteArray &data);
+    WorkerDataEvent(int workerId, const QV4::Serialize::Message &data);
     virtual ~WorkerDataEvent();
 
     int workerId() const;
-    QByteArray data() const;
+    const QV4::Serialize::Message &data() const;
 
 private:
     int m_id;
-    QByteArray m_data;
+    QV4::Serialize::Message m_data;
 };
 
 class WorkerLoadEvent : public QEvent
@@ -180,6 +180,8 @@ public:
     QV4::ReturnedValue getWorker(WorkerScript *);
 
     int m_nextId;
+    int m_scriptCount; // main thread only
+    QAtomicInt m_pendingMessages;
 
     static QV4::ReturnedValue method_sendMessage(QV4::CallContext *ctx);
 
@@ -190,7 +192,7 @@ protected:
     virtual bool event(QEvent *);
 
 private:
-    void processMessage(int, const QByteArray &);
+    void processMessage(int, const QV4::Serialize::Message &);
     void processLoad(int, const QUrl &);
     void reportScriptException(WorkerScript *, const QQmlError &error);
 };
@@ -277,7 +279,7 @@ QNetworkAccessManager *QQuickWorkerScriptEnginePrivate::WorkerEngine::networkAcc
 }
 
 QQuickWorkerScriptEnginePrivate::QQuickWorkerScriptEnginePrivate(QQmlEngine *engine)
-: workerEngine(0), qmlengine(engine), m_nextId(0)
+: workerEngine(0), qmlengine(engine), m_nextId(0), m_scriptCount(0), m_pendingMessages(0)
 {
 }
 
@@ -289,7 +291,7 @@ QV4::ReturnedValue QQuickWorkerScriptEnginePrivate::method_sendMessage(QV4::Call
 
     QV4::Scope scope(ctx);
     QV4::ScopedValue v(scope, ctx->callData->argument(2));
-    QByteArray data = QV4::Serialize::serialize(v, engine);
+    QV4::Serialize::Message data = QV4::Serialize::serialize(v, engine);
 
     QMutexLocker locker(&engine->p->m_lock);
     WorkerScript *script = engine->p->workers.value(id);
@@ -330,6 +332,7 @@ bool QQuickWorkerScriptEnginePrivate::event(QEvent *event)
     if (event->type() == (QEvent::Type)WorkerDataEvent::WorkerData) {
         WorkerDataEvent *workerEvent = static_cast<WorkerDataEvent *>(event);
         processMessage(workerEvent->workerId(), workerEvent->data());
+        m_pendingMessages.deref();
         return true;
     } else if (event->type() == (QEvent::Type)WorkerLoadEvent::WorkerLoad) {
         WorkerLoadEvent *workerEvent = static_cast<WorkerLoadEvent *>(event);
@@ -347,7 +350,7 @@ bool QQuickWorkerScriptEnginePrivate::event(QEvent *event)
     }
 }
 
-void QQuickWorkerScriptEnginePrivate::processMessage(int id, const QByteArray &data)
+void QQuickWorkerScriptEnginePrivate::processMessage(int id, const QV4::Serialize::Message &data)
 {
     WorkerScript *script = workers.value(id);
     if (!script)
@@ -421,7 +424,7 @@ void QQuickWorkerScriptEnginePrivate::reportScriptException(WorkerScript *script
         QCoreApplication::postEvent(script->owner, new WorkerErrorEvent(error));
 }
 
-WorkerDataEvent::WorkerDataEvent(int workerId, const QByteArray &data)
+WorkerDataEvent::WorkerDataEvent(int workerId, const QV4::Serialize::Message &data)
 : QEvent((QEvent::Type)WorkerData), m_id(workerId), m_data(data)
 {
 }
@@ -435,7 +438,7 @@ int WorkerDataEvent::workerId() const
     return m_id;
 }
 
-QByteArray WorkerDataEvent::data() const
+const QV4::Serialize::Message &WorkerDataEvent::data() const
 {
     return m_data;
 }
@@ -526,6 +529,8 @@ int QQuickWorkerScriptEngine::registerWorkerScript(QQuickWorkerScript *owner)
     d->workers.insert(script->id, script);
     d->m_lock.unlock();
 
+    ++d->m_scriptCount;
+
     return script->id;
 }
 
@@ -534,6 +539,7 @@ void QQuickWorkerScriptEngine::removeWorkerScript(int id)
     QQuickWorkerScriptEnginePrivate::WorkerScript* script = d->workers.value(id);
     if (script) {
         script->owner = 0;
+        --d->m_scriptCount;
         QCoreApplication::postEvent(d, new WorkerRemoveEvent(id));
     }
 }
@@ -543,11 +549,29 @@ void QQuickWorkerScriptEngine::executeUrl(int id, const QUrl &url)
     QCoreApplication::postEvent(d, new WorkerLoadEvent(id, url));
 }
 
-void QQuickWorkerScriptEngine::sendMessage(int id, const QByteArray &data)
+void QQuickWorkerScriptEngine::sendMessage(int id, const QV4::Serialize::Message &data)
 {
+    d->m_pendingMessages.ref();
     QCoreApplication::postEvent(d, new WorkerDataEvent(id, data));
 }
 
+/*
+    The number of WorkerScripts running on this thread.  Only valid on the
+    thread of the QML engine.
+*/
+int QQuickWorkerScriptEngine::workerScriptCount() const
+{
+    return d->m_scriptCount;
+}
+
+/*
+    The number of messages sent to this thread that it hasn't processed yet.
+*/
+int QQuickWorkerScriptEngine::pendingMessageCount() const
+{
+    return d->m_pendingMessages.load();
+}
+
 void QQuickWorkerScriptEngine::run()
 {
     d->m_lock.lock();
@@ -611,11 +635,21 @@ void QQuickWorkerScriptEngine::run()
 
     Worker script can not use \l {qtqml-javascript-imports.html}{.import} syntax.
 
+    \section3 Threads
+
+    By default all WorkerScripts of an engine share a single thread.  Setting the
+    \c QML_WORKERSCRIPT_THREADS environment variable to a larger number lets the
+    engine start up to that many threads, each with its own JavaScript engine, and
+    new WorkerScripts are put on the least busy one.  A WorkerScript can also be
+    placed on a particular thread with the \l workerThread property.
+
+    A ListModel can only be passed to WorkerScripts that run on the same thread.
+
     \sa {declarative/threading/workerscript}{WorkerScript example},
         {declarative/threading/threadedlistmodel}{Threaded ListModel example}
 */
 QQuickWorkerScript::QQuickWorkerScript(QObject *parent)
-: QObject(parent), m_engine(0), m_scriptId(-1), m_componentComplete(true)
+: QObject(parent), m_engine(0), m_scriptId(-1), m_workerThread(-1), m_componentComplete(true)
 {
 }
 
@@ -648,6 +682,44 @@ void QQuickWorkerScript::setSource(const QUrl &source)
     emit sourceChanged();
 }
 
+/*!
+    \qmlproperty int WorkerScript::workerThread
+    \since QtQuick 2.2
+
+    This holds the index of the thread the script runs on.  WorkerScripts with
+    the same index share a thread and its JavaScript engine.  Valid indices go
+    from 0 to one less than the value of \c QML_WORKERSCRIPT_THREADS.  Any other
+    index prints a warning and is treated like -1.
+
+    The default value of -1 lets the engine pick the least busy thread of its
+    pool.  Changing the value of a running WorkerScript moves it to the other
+    thread and loads \l source again there, so any state held by the script is
+    lost.
+*/
+int QQuickWorkerScript::workerThread() const
+{
+    return m_workerThread;
+}
+
+void QQuickWorkerScript::setWorkerThread(int thread)
+{
+    if (thread < 0)
+        thread = -1;
+    if (m_workerThread == thread)
+        return;
+
+    m_workerThread = thread;
+
+    if (m_engine) {
+        m_engine->removeWorkerScript(m_scriptId);
+        m_engine = 0;
+        m_scriptId = -1;
+        engine();
+    }
+
+    emit workerThreadChanged();
+}
+
 /*!
     \qmlmethod WorkerScript::sendMessage(jsobject message)
 
@@ -698,7 +770,7 @@ QQuickWorkerScriptEngine *QQuickWorkerScript::engine()
             return 0;
         }
 
-        m_engine = QQmlEnginePrivate::get(engine)->getWorkerScriptEngine();
+        m_engine = QQmlEnginePrivate::get(engine)->getWorkerScriptEngine(m_workerThread);
         m_scriptId = m_engine->registerWorkerScript(this);
 
         if (m_source.isValid())
@@ -59,6 +59,7 @@
 #include <QtCore/qthread.h>
 #include <QtQml/qjsvalue.h>
 #include <QtCore/qurl.h>
+#include <private/qv4serialize_p.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -75,7 +76,10 @@ public:
     int registerWorkerScript(QQuickWorkerScript *);
     void removeWorkerScript(int);
     void executeUrl(int, const QUrl &);
-    void sendMessage(int, const QByteArray &);
+    void sendMessage(int, const QV4::Serialize::Message &);
+
+    int workerScriptCount() const;
+    int pendingMessageCount() const;
 
 protected:
     virtual void run();
@@ -90,6 +94,7 @@ class Q_AUTOTEST_EXPORT QQuickWorkerScript : public QObject, public QQmlParserSt
 {
     Q_OBJECT
     Q_PROPERTY(QUrl source READ source WRITE setSource NOTIFY sourceChanged)
+    Q_PROPERTY(int workerThread READ workerThread WRITE setWorkerThread NOTIFY workerThreadChanged REVISION 1)
 
     Q_INTERFACES(QQmlParserStatus)
 public:
@@ -99,12 +104,16 @@ public:
     QUrl source() const;
     void setSource(const QUrl &);
 
+    int workerThread() const;
+    void setWorkerThread(int);
+
 public Q_SLOTS:
     void sendMessage(QQmlV4Function*);
 
 Q_SIGNALS:
     void sourceChanged();
     void message(const QQmlV4Handle &messageObject);
+    Q_REVISION(1) void workerThreadChanged();
 
 protected:
     virtual void classBegin();
@@ -115,6 +124,7 @@ private:
     QQuickWorkerScriptEngine *engine();
     QQuickWorkerScriptEngine *m_engine;
     int m_scriptId;
+    int m_workerThread;
     QUrl m_source;
     bool m_componentComplete;
 };
@@ -107,6 +107,8 @@ public:
 
     void setValue(const QString &role, const QVariant &value);
     bool resolveIndex(const QQmlAdaptorModel &model, int idx);
+    bool isReusable() const { return true; }
+    void rebindIndex(const QQmlAdaptorModel &model, int idx);
 
     static QV4::ReturnedValue get_property(QV4::CallContext *ctx, uint propertyId);
     static QV4::ReturnedValue set_property(QV4::CallContext *ctx, uint propertyId);
@@ -339,6 +341,17 @@ bool QQmlDMCachedModelData::resolveIndex(const QQmlAdaptorModel &, int idx)
     }
 }
 
+void QQmlDMCachedModelData::rebindIndex(const QQmlAdaptorModel &, int idx)
+{
+    index = idx;
+    cachedData.clear();
+    emit modelIndexChanged();
+    const QMetaObject *meta = metaObject();
+    const int propertyCount = type->propertyRoles.count();
+    for (int i = 0; i < propertyCount; ++i)
+        QMetaObject::activate(this, meta, i, 0);
+}
+
 QV4::ReturnedValue QQmlDMCachedModelData::get_property(QV4::CallContext *ctx, uint propertyId)
 {
     QV4::Scope scope(ctx);
@@ -391,7 +404,7 @@ QV4::ReturnedValue QQmlDMCachedModelData::set_property(QV4::CallContext *ctx, ui
 class QQmlDMAbstractItemModelData : public QQmlDMCachedModelData
 {
     Q_OBJECT
-    Q_PROPERTY(bool hasModelChildren READ hasModelChildren CONSTANT)
+    Q_PROPERTY(bool hasModelChildren READ hasModelChildren NOTIFY modelIndexChanged)
 public:
     QQmlDMAbstractItemModelData(
             QQmlDelegateModelItemMetaType *metaType,
@@ -634,6 +647,15 @@ public:
         }
     }
 
+    bool isReusable() const { return true; }
+
+    void rebindIndex(const QQmlAdaptorModel &model, int idx)
+    {
+        index = idx;
+        cachedData = model.list.at(idx);
+        emit modelIndexChanged();
+        emit modelDataChanged();
+    }
 
 Q_SIGNALS:
     void modelDataChanged();
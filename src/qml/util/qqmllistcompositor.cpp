@@ -289,6 +289,8 @@ QQmlListCompositor::insert_iterator &QQmlListCompositor::insert_iterator::operat
 QQmlListCompositor::QQmlListCompositor()
     : m_end(m_ranges.next, 0, Default, 2)
     , m_cacheIt(m_end)
+    , m_seekRoot(0)
+    , m_seekSeed(0x9e3779b9)
     , m_groupCount(2)
     , m_defaultFlags(PrependFlag | DefaultFlag)
     , m_removeFlags(AppendFlag | PrependFlag | GroupMask)
@@ -316,7 +318,9 @@ QQmlListCompositor::~QQmlListCompositor()
 inline QQmlListCompositor::Range *QQmlListCompositor::insert(
         Range *before, void *list, int index, int count, uint flags)
 {
-    return new Range(before, list, index, count, flags);
+    Range *range = new Range(before, list, index, count, flags);
+    linkSeekIndex(range);
+    return range;
 }
 
 /*!
@@ -328,6 +332,7 @@ inline QQmlListCompositor::Range *QQmlListCompositor::insert(
 inline QQmlListCompositor::Range *QQmlListCompositor::erase(
         Range *range)
 {
+    unlinkSeekIndex(range);
     Range *next = range->next;
     next->previous = range->previous;
     next->previous->next = range->next;
@@ -344,6 +349,231 @@ void QQmlListCompositor::setGroupCount(int count)
     m_groupCount = count;
     m_end = iterator(&m_ranges, 0, Default, m_groupCount);
     m_cacheIt = m_end;
+    rebuildSeekIndex();
+}
+
+/*!
+    \internal
+
+    The seek index is a treap with the ranges as its nodes, ordered as in the list, in which
+    every node holds the number of items in each group below it.  This allows the range that
+    holds an item to be found in O(log ranges) however fragmented the compositor is.
+
+    Ranges are linked into and unlinked from the treap as they are created and erased, which
+    only depends on their position in the list.  Modifying routines change the counts and
+    flags of ranges in place, so they bring the totals up to date with updateSeekIndex() for
+    the span of ranges they have touched before the index is next used.
+*/
+
+inline uint QQmlListCompositor::seekPriority()
+{
+    m_seekSeed ^= m_seekSeed << 13;
+    m_seekSeed ^= m_seekSeed >> 17;
+    m_seekSeed ^= m_seekSeed << 5;
+    return m_seekSeed;
+}
+
+inline void QQmlListCompositor::updateTotals(Range *range) const
+{
+    for (int i = 0; i < m_groupCount; ++i) {
+        range->totals[i] = (range->inGroup(i) ? range->count : 0)
+                + (range->left ? range->left->totals[i] : 0)
+                + (range->right ? range->right->totals[i] : 0);
+    }
+}
+
+/*!
+    Rotates \a range above its parent in the seek index.
+*/
+
+void QQmlListCompositor::rotateUp(Range *range)
+{
+    Range *parent = range->parent;
+    Range *grandParent = parent->parent;
+
+    if (parent->left == range) {
+        parent->left = range->right;
+        if (range->right)
+            range->right->parent = parent;
+        range->right = parent;
+    } else {
+        parent->right = range->left;
+        if (range->left)
+            range->left->parent = parent;
+        range->left = parent;
+    }
+    parent->parent = range;
+    range->parent = grandParent;
+
+    if (!grandParent)
+        m_seekRoot = range;
+    else if (grandParent->left == parent)
+        grandParent->left = range;
+    else
+        grandParent->right = range;
+
+    updateTotals(parent);
+    updateTotals(range);
+}
+
+/*!
+    Adds a \a range which has just been linked into the list to the seek index.
+*/
+
+void QQmlListCompositor::linkSeekIndex(Range *range)
+{
+    range->priority = seekPriority();
+    range->left = 0;
+    range->right = 0;
+
+    // The range goes directly in front of the one following it in the list.
+    Range *parent = 0;
+    if (range->next == &m_ranges) {
+        for (parent = m_seekRoot; parent && parent->right; parent = parent->right) {}
+        if (parent)
+            parent->right = range;
+    } else if (!range->next->left) {
+        parent = range->next;
+        parent->left = range;
+    } else {
+        for (parent = range->next->left; parent->right; parent = parent->right) {}
+        parent->right = range;
+    }
+    range->parent = parent;
+    if (!parent)
+        m_seekRoot = range;
+
+    for (Range *node = range; node; node = node->parent)
+        updateTotals(node);
+    while (range->parent && range->parent->priority < range->priority)
+        rotateUp(range);
+}
+
+/*!
+    Removes a \a range which is about to be erased from the seek index.
+*/
+
+void QQmlListCompositor::unlinkSeekIndex(Range *range)
+{
+    while (range->left && range->right)
+        rotateUp(range->left->priority > range->right->priority ? range->left : range->right);
+
+    Range *child = range->left ? range->left : range->right;
+    Range *parent = range->parent;
+    if (child)
+        child->parent = parent;
+    if (!parent)
+        m_seekRoot = child;
+    else if (parent->left == range)
+        parent->left = child;
+    else
+        parent->right = child;
+
+    for (; parent; parent = parent->parent)
+        updateTotals(parent);
+}
+
+/*!
+    Updates the seek index for changes to the counts and flags of the ranges from \a first to
+    \a last inclusive.  Either may be the list head, standing for the start or end of the list.
+*/
+
+void QQmlListCompositor::updateSeekIndex(Range *first, Range *last)
+{
+    for (Range *range = first == &m_ranges ? first->next : first; range != &m_ranges; range = range->next) {
+        for (Range *node = range; node; node = node->parent)
+            updateTotals(node);
+        if (range == last)
+            break;
+    }
+}
+
+/*!
+    Rebuilds the seek index from scratch in O(ranges), for modifications that touch ranges
+    throughout the list anyway.
+*/
+
+void QQmlListCompositor::rebuildSeekIndex()
+{
+    // Ranges on the right spine of the treap built so far; a range's subtree is complete
+    // once it drops off the spine.
+    QVarLengthArray<Range *, 32> spine;
+    for (Range *range = m_ranges.next; range != &m_ranges; range = range->next) {
+        range->priority = seekPriority();
+        range->parent = 0;
+        range->left = 0;
+        range->right = 0;
+
+        while (!spine.isEmpty() && spine.last()->priority < range->priority) {
+            range->left = spine.last();
+            spine.removeLast();
+            updateTotals(range->left);
+        }
+        if (range->left)
+            range->left->parent = range;
+        if (!spine.isEmpty()) {
+            spine.last()->right = range;
+            range->parent = spine.last();
+        }
+        spine.append(range);
+    }
+
+    m_seekRoot = spine.isEmpty() ? 0 : spine.first();
+    while (!spine.isEmpty()) {
+        updateTotals(spine.last());
+        spine.removeLast();
+    }
+}
+
+/*!
+    Returns an iterator representing the item at \a index in a \a group using the seek index.
+
+    The range containing the item is the last one whose first index in the group is not greater
+    than \a index; ranges that follow it in the group start after \a index, and ranges outside
+    the group that precede it can at most share its first index.
+*/
+
+QQmlListCompositor::iterator QQmlListCompositor::seek(Group group, int index) const
+{
+    Q_ASSERT(m_seekRoot);
+
+    int indexes[MaximumGroupCount];
+    int start[MaximumGroupCount];
+    for (int i = 0; i < m_groupCount; ++i)
+        indexes[i] = 0;
+
+    Range *found = 0;
+    for (Range *range = m_seekRoot; range;) {
+        const int leftCount = range->left ? range->left->totals[group] : 0;
+        if (indexes[group] + leftCount <= index) {
+            found = range;
+            for (int i = 0; i < m_groupCount; ++i) {
+                start[i] = indexes[i] + (range->left ? range->left->totals[i] : 0);
+                indexes[i] = start[i] + (range->inGroup(i) ? range->count : 0);
+            }
+            range = range->right;
+        } else {
+            range = range->left;
+        }
+    }
+    Q_ASSERT(found);
+
+    iterator it(found, index - start[group], group, m_groupCount);
+    for (int i = 0; i < m_groupCount; ++i)
+        it.index[i] = start[i];
+    it.incrementIndexes(it.offset);
+    return it;
+}
+
+/*!
+    Returns whether a seek to \a index in \a group should use the seek index rather than walk
+    the ranges from the last position found, which is cheaper for nearby indexes.
+*/
+
+bool QQmlListCompositor::useSeekIndex(Group group, int index) const
+{
+    const int distance = m_cacheIt == m_end ? index : qAbs(index - m_cacheIt.index[group]);
+    return m_seekRoot && distance > MaximumWalkDistance;
 }
 
 /*!
@@ -365,7 +595,9 @@ QQmlListCompositor::iterator QQmlListCompositor::find(Group group, int index)
 {
     QT_QML_TRACE_LISTCOMPOSITOR(<< group << index)
     Q_ASSERT(index >=0 && index < count(group));
-    if (m_cacheIt == m_end) {
+    if (useSeekIndex(group, index)) {
+        m_cacheIt = seek(group, index);
+    } else if (m_cacheIt == m_end) {
         m_cacheIt = iterator(m_ranges.next, 0, group, m_groupCount);
         m_cacheIt += index;
     } else {
@@ -407,7 +639,10 @@ QQmlListCompositor::insert_iterator QQmlListCompositor::findInsertPosition(Group
     QT_QML_TRACE_LISTCOMPOSITOR(<< group << index)
     Q_ASSERT(index >=0 && index <= count(group));
     insert_iterator it;
-    if (m_cacheIt == m_end) {
+    if (index > 0 && useSeekIndex(group, index - 1)) {
+        it = seek(group, index - 1);
+        it += 1;
+    } else if (m_cacheIt == m_end) {
         it = iterator(m_ranges.next, 0, group, m_groupCount);
         it += index;
     } else {
@@ -465,6 +700,7 @@ QQmlListCompositor::iterator QQmlListCompositor::insert(
     if (inserts) {
         inserts->append(Insert(before, count, flags & GroupMask));
     }
+    Range *first = before->previous;
     if (before.offset > 0) {
         // Inserting into the middle of a range.  Split it two and update the iterator so it's
         // positioned at the start of the second half.
@@ -501,6 +737,7 @@ QQmlListCompositor::iterator QQmlListCompositor::insert(
 
     m_end.incrementIndexes(count, flags);
     m_cacheIt = before;
+    updateSeekIndex(first, *before);
     QT_QML_VERIFY_LISTCOMPOSITOR
     return before;
 }
@@ -533,6 +770,7 @@ void QQmlListCompositor::setFlags(
     if (!flags || !count)
         return;
 
+    Range *first = from->previous;
     if (from != group) {
         // Skip to the next full range if the start one is not a member of the target group.
         from.incrementIndexes(from->count - from.offset);
@@ -612,6 +850,7 @@ void QQmlListCompositor::setFlags(
         *from = erase(*from)->previous;
     }
     m_cacheIt = from;
+    updateSeekIndex(first, *from);
     QT_QML_VERIFY_LISTCOMPOSITOR
 }
 
@@ -645,6 +884,7 @@ void QQmlListCompositor::clearFlags(
 
     const bool clearCache = flags & CacheFlag;
 
+    Range *first = from->previous;
     if (from != group) {
         // Skip to the next full range if the start one is not a member of the target group.
         from.incrementIndexes(from->count - from.offset);
@@ -727,6 +967,7 @@ void QQmlListCompositor::clearFlags(
         *from = erase(*from)->previous;
     }
     m_cacheIt = from;
+    updateSeekIndex(first, *from);
     QT_QML_VERIFY_LISTCOMPOSITOR
 }
 
@@ -782,6 +1023,7 @@ void QQmlListCompositor::move(
 
     // Find the position of the first item to move.
     iterator fromIt = find(fromGroup, from);
+    Range *first = fromIt->previous;
 
     if (fromIt != moveGroup) {
         // If the range at the from index doesn't contain items from the move group; skip
@@ -875,11 +1117,10 @@ void QQmlListCompositor::move(
     }
 
     // Find the destination position of the move.
-    insert_iterator toIt = fromIt;
-    toIt.setGroup(toGroup);
-
-    const int difference = to - toIt.index[toGroup];
-    toIt += difference;
+    updateSeekIndex(first, *fromIt);
+    m_cacheIt = fromIt;
+    insert_iterator toIt = findInsertPosition(toGroup, to);
+    first = toIt->previous;
 
     // If the insert position is part way through a range; split it and move the iterator to the
     // start of the second range.
@@ -932,6 +1173,7 @@ void QQmlListCompositor::move(
     }
 
     m_cacheIt = toIt;
+    updateSeekIndex(first, *toIt);
 
     QT_QML_VERIFY_LISTCOMPOSITOR
 }
@@ -1041,6 +1283,7 @@ void QQmlListCompositor::listItemsInserted(
         it.incrementIndexes(it->count);
     }
     m_cacheIt = m_end;
+    rebuildSeekIndex();
     QT_QML_VERIFY_LISTCOMPOSITOR
 }
 
@@ -1231,6 +1474,7 @@ void QQmlListCompositor::listItemsRemoved(
         }
     }
     m_cacheIt = m_end;
+    rebuildSeekIndex();
     QT_QML_VERIFY_LISTCOMPOSITOR
 }
 
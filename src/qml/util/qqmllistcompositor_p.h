@@ -89,9 +89,12 @@ public:
     class Range
     {
     public:
-        Range() : next(this), previous(this), list(0), index(0), count(0), flags(0) {}
+        Range()
+            : next(this), previous(this), list(0), index(0), count(0), flags(0)
+            , parent(0), left(0), right(0), priority(0) {}
         Range(Range *next, void *list, int index, int count, uint flags)
-            : next(next), previous(next->previous), list(list), index(index), count(count), flags(flags) {
+            : next(next), previous(next->previous), list(list), index(index), count(count), flags(flags)
+            , parent(0), left(0), right(0), priority(0) {
             next->previous = this; previous->next = this; }
 
         Range *next;
@@ -101,6 +104,13 @@ public:
         int count;
         uint flags;
 
+        // Node of the seek index, a treap over the ranges in list order.
+        Range *parent;
+        Range *left;
+        Range *right;
+        uint priority;
+        int totals[MaximumGroupCount]; // Items in each group in this subtree
+
         inline int start() const { return index; }
         inline int end() const { return index + count; }
 
@@ -267,9 +277,13 @@ public:
             QVector<QQmlChangeSet::Insert> *inserts);
 
 private:
+    enum { MaximumWalkDistance = 16 };
+
     Range m_ranges;
     iterator m_end;
     iterator m_cacheIt;
+    Range *m_seekRoot;
+    uint m_seekSeed;
     int m_groupCount;
     int m_defaultFlags;
     int m_removeFlags;
@@ -278,6 +292,16 @@ private:
     inline Range *insert(Range *before, void *list, int index, int count, uint flags);
     inline Range *erase(Range *range);
 
+    inline uint seekPriority();
+    inline void updateTotals(Range *range) const;
+    void rotateUp(Range *range);
+    void linkSeekIndex(Range *range);
+    void unlinkSeekIndex(Range *range);
+    void updateSeekIndex(Range *first, Range *last);
+    void rebuildSeekIndex();
+    iterator seek(Group group, int index) const;
+    bool useSeekIndex(Group group, int index) const;
+
     struct MovedFlags
     {
         MovedFlags() {}
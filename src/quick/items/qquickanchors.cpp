@@ -43,8 +43,12 @@
 
 #include "qquickitem.h"
 #include "qquickitem_p.h"
+#include "qquickwindow_p.h"
+
+#include <private/qsgrenderloop_p.h>
 
 #include <qqmlinfo.h>
+#include <QtCore/qvarlengtharray.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -155,6 +159,10 @@ QQuickAnchors::~QQuickAnchors()
 {
     Q_D(QQuickAnchors);
     d->inDestructor = true;
+    if (d->updateScheduled) {
+        if (QQuickWindow *window = QQuickItemPrivate::get(d->item)->window)
+            QQuickWindowPrivate::get(window)->itemsToAnchor.remove(d->item);
+    }
     d->remDepend(d->fill);
     d->remDepend(d->centerIn);
     d->remDepend(d->left.item);
@@ -446,14 +454,165 @@ void QQuickAnchorsPrivate::update()
 
 void QQuickAnchorsPrivate::itemGeometryChanged(QQuickItem *, const QRectF &newG, const QRectF &oldG)
 {
+    const bool horizontalChange = newG.x() != oldG.x() || newG.width() != oldG.width();
+    const bool verticalChange = newG.y() != oldG.y() || newG.height() != oldG.height();
+    if (scheduleUpdate(horizontalChange, verticalChange))
+        return;
+
+    fillChanged();
+    centerInChanged();
+    if ((usedAnchors & QQuickAnchorLine::Horizontal_Mask) && horizontalChange)
+        updateHorizontalAnchors();
+    if ((usedAnchors & QQuickAnchorLine::Vertical_Mask) && verticalChange)
+        updateVerticalAnchors();
+}
+
+/*
+    Queues the anchors to be resolved in the next polish pass of the item's
+    window, rather than updating them for every geometry change of a target.
+    Returns false if the window does not batch anchors, in which case the
+    caller must update immediately.
+*/
+bool QQuickAnchorsPrivate::scheduleUpdate(bool horizontal, bool vertical)
+{
+    if (!componentComplete || inDestructor)
+        return false;
+
+    QQuickWindow *window = QQuickItemPrivate::get(item)->window;
+    if (!window)
+        return false;
+    QQuickWindowPrivate *windowPrivate = QQuickWindowPrivate::get(window);
+    if (!windowPrivate->batchedAnchorsEnabled)
+        return false;
+
+    if (horizontal)
+        horizontalUpdatePending = true;
+    if (vertical)
+        verticalUpdatePending = true;
+
+    if (!updateScheduled) {
+        updateScheduled = true;
+        bool maybeUpdate = windowPrivate->itemsToAnchor.isEmpty() && windowPrivate->itemsToPolish.isEmpty();
+        windowPrivate->itemsToAnchor.insert(item);
+        if (maybeUpdate && windowPrivate->windowManager)
+            windowPrivate->windowManager->maybeUpdate(window);
+    }
+    return true;
+}
+
+void QQuickAnchorsPrivate::resolveScheduledUpdate()
+{
+    const bool horizontal = horizontalUpdatePending;
+    const bool vertical = verticalUpdatePending;
+    updateScheduled = false;
+    horizontalUpdatePending = false;
+    verticalUpdatePending = false;
+
     fillChanged();
     centerInChanged();
-    if ((usedAnchors & QQuickAnchorLine::Horizontal_Mask) && (newG.x() != oldG.x() || newG.width() != oldG.width()))
+    if (horizontal && (usedAnchors & QQuickAnchorLine::Horizontal_Mask))
         updateHorizontalAnchors();
-    if ((usedAnchors & QQuickAnchorLine::Vertical_Mask) && (newG.y() != oldG.y() || newG.height() != oldG.height()))
+    if (vertical && (usedAnchors & QQuickAnchorLine::Vertical_Mask))
         updateVerticalAnchors();
 }
 
+/*
+    Returns the \a index'th item \a d is anchored to, or 0 if that anchor is
+    not set.  Indexes run from 0 to anchorTargetCount - 1.
+*/
+static const int anchorTargetCount = 9;
+
+static QQuickItem *anchorTarget(QQuickAnchorsPrivate *d, int index)
+{
+    switch (index) {
+    case 0: return d->fill;
+    case 1: return d->centerIn;
+    case 2: return d->left.item;
+    case 3: return d->right.item;
+    case 4: return d->hCenter.item;
+    case 5: return d->top.item;
+    case 6: return d->bottom.item;
+    case 7: return d->vCenter.item;
+    case 8: return d->baseline.item;
+    default: return 0;
+    }
+}
+
+/*
+    Resolves the anchors of \a item after those of every anchored item it
+    depends on.  A target that is not scheduled yet is still visited, as
+    resolving its own targets may schedule it.  Items already visited in this
+    pass are skipped, which also stops at anchor loops.
+
+    The walk keeps its own stack rather than recursing, as a long chain of
+    items each anchored to the previous one would otherwise use a stack frame
+    per item.
+*/
+struct QQuickAnchorsResolveFrame
+{
+    QQuickAnchorsPrivate *anchors;
+    int nextTarget;
+};
+
+static void resolveInDependencyOrder(QQuickItem *item, QSet<QQuickItem *> &visited)
+{
+    typedef QQuickAnchorsResolveFrame Frame;
+
+    if (visited.contains(item))
+        return;
+    visited.insert(item);
+
+    QQuickAnchors *anchors = QQuickItemPrivate::get(item)->_anchors;
+    if (!anchors)
+        return;
+
+    QVarLengthArray<Frame, 16> stack;
+    Frame root = { QQuickAnchorsPrivate::get(anchors), 0 };
+    stack.append(root);
+
+    while (!stack.isEmpty()) {
+        Frame &frame = stack[stack.count() - 1];
+        QQuickAnchorsPrivate *d = frame.anchors;
+
+        QQuickItem *target = 0;
+        while (!target && frame.nextTarget < anchorTargetCount) {
+            target = anchorTarget(d, frame.nextTarget++);
+            if (target == d->item || visited.contains(target))
+                target = 0;
+        }
+
+        if (target) {
+            visited.insert(target);
+            if (QQuickAnchors *targetAnchors = QQuickItemPrivate::get(target)->_anchors) {
+                // appending may reallocate the stack, so frame isn't used after this
+                Frame next = { QQuickAnchorsPrivate::get(targetAnchors), 0 };
+                stack.append(next);
+            }
+            continue;
+        }
+
+        // every target has been resolved, so this item can be
+        stack.resize(stack.count() - 1);
+        if (d->updateScheduled)
+            d->resolveScheduledUpdate();
+    }
+}
+
+/*
+    Resolves the anchors queued by scheduleUpdate(), each once and after the
+    items they are anchored to.  Items whose targets move while this runs are
+    queued again in \a items for the caller's next pass.
+*/
+void QQuickAnchorsPrivate::resolveScheduledAnchors(QSet<QQuickItem *> &items)
+{
+    QSet<QQuickItem *> scheduled = items;
+    items.clear();
+
+    QSet<QQuickItem *> visited;
+    for (QSet<QQuickItem *>::const_iterator it = scheduled.constBegin(); it != scheduled.constEnd(); ++it)
+        resolveInDependencyOrder(*it, visited);
+}
+
 QQuickItem *QQuickAnchors::fill() const
 {
     Q_D(const QQuickAnchors);
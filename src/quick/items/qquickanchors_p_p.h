@@ -56,6 +56,7 @@
 #include "qquickanchors_p.h"
 #include "qquickitemchangelistener_p.h"
 #include <private/qobject_p.h>
+#include <QtCore/qset.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -94,7 +95,8 @@ public:
     QQuickAnchorsPrivate(QQuickItem *i)
       : componentComplete(true), updatingMe(false), inDestructor(false), centerAligned(true),
         leftMarginExplicit(false), rightMarginExplicit(false), topMarginExplicit(false),
-        bottomMarginExplicit(false), updatingHorizontalAnchor(0),
+        bottomMarginExplicit(false), updateScheduled(false), horizontalUpdatePending(false),
+        verticalUpdatePending(false), updatingHorizontalAnchor(0),
         updatingVerticalAnchor(0), updatingFill(0), updatingCenterIn(0), item(i), usedAnchors(0), fill(0),
         centerIn(0), leftMargin(0), rightMargin(0), topMargin(0), bottomMargin(0),
         margins(0), vCenterOffset(0), hCenterOffset(0), baselineOffset(0)
@@ -117,6 +119,9 @@ public:
     bool rightMarginExplicit : 1;
     bool topMarginExplicit : 1;
     bool bottomMarginExplicit : 1;
+    bool updateScheduled : 1;
+    bool horizontalUpdatePending : 1;
+    bool verticalUpdatePending : 1;
     uint updatingHorizontalAnchor:2;
     uint updatingVerticalAnchor:2;
     uint updatingFill:2;
@@ -133,6 +138,10 @@ public:
     void updateOnComplete();
     void updateMe();
 
+    bool scheduleUpdate(bool horizontal, bool vertical);
+    void resolveScheduledUpdate();
+    static void resolveScheduledAnchors(QSet<QQuickItem *> &items);
+
     // QQuickItemGeometryListener interface
     void itemGeometryChanged(QQuickItem *, const QRectF &, const QRectF &);
     QQuickAnchorsPrivate *anchorPrivate() { return this; }
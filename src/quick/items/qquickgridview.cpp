@@ -1563,6 +1563,25 @@ void QQuickGridView::setHighlightFollowsCurrentItem(bool autoHighlight)
     want to use the cacheBuffer property instead.
 */
 
+/*!
+    \qmlproperty bool QtQuick::GridView::reuseItems
+    \since QtQuick 2.2
+
+    This property holds whether delegate instances are reused rather than destroyed when they
+    move out of the visible area and the cacheBuffer.
+
+    When true, a delegate that is no longer needed is hidden and kept in a pool, and the next
+    delegate the view needs is taken from the pool and bound to its new model item instead of being created from scratch.  This avoids most of the cost of
+    instantiating delegates while flicking through long lists.  A reused delegate receives
+    new values for \c index and the model roles, so any other state it keeps should be reset
+    in the \l {DelegateModel::reused}{DelegateModel.onReused} handler.
+
+    This property only affects the model created by the view; when \l model is a
+    \l DelegateModel set its \l {DelegateModel::reuseItems}{reuseItems} property instead.
+
+    The default value is false.
+*/
+
 void QQuickGridView::setHighlightMoveDuration(int duration)
 {
     Q_D(QQuickGridView);
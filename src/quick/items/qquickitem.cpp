@@ -2540,6 +2540,8 @@ void QQuickItemPrivate::refWindow(QQuickWindow *c)
 
     if (polishScheduled)
         QQuickWindowPrivate::get(window)->itemsToPolish.insert(q);
+    if (_anchors && QQuickAnchorsPrivate::get(_anchors)->updateScheduled)
+        QQuickWindowPrivate::get(window)->itemsToAnchor.insert(q);
 
     if (!parentItem)
         QQuickWindowPrivate::get(window)->parentlessItems.insert(q);
@@ -2572,6 +2574,8 @@ void QQuickItemPrivate::derefWindow()
     QQuickWindowPrivate *c = QQuickWindowPrivate::get(window);
     if (polishScheduled)
         c->itemsToPolish.remove(q);
+    if (_anchors && QQuickAnchorsPrivate::get(_anchors)->updateScheduled)
+        c->itemsToAnchor.remove(q);
     QMutableHashIterator<int, QQuickItem *> itemTouchMapIt(c->itemForTouchPointId);
     while (itemTouchMapIt.hasNext()) {
         if (itemTouchMapIt.next().value() == q)
@@ -2586,6 +2590,7 @@ void QQuickItemPrivate::derefWindow()
     }
 #endif
     c->hoverItems.removeAll(q);
+    c->hitTestIndex.remove(q);
     if (itemNodeInstance)
         c->cleanup(itemNodeInstance);
     if (!parentItem)
@@ -4089,12 +4094,18 @@ QQuickItem *QQuickItem::nextItemInFocusChain(bool forward)
 */
 QQuickItem *QQuickItem::childAt(qreal x, qreal y) const
 {
-    const QList<QQuickItem *> children = childItems();
-    for (int i = children.count()-1; i >= 0; --i) {
-        QQuickItem *child = children.at(i);
+    // The window's hit-test index cannot answer this: it only covers items
+    // which accept mouse buttons or hover events, whereas childAt() returns
+    // any visible child. Only direct children are tested, so skip the hidden
+    // ones before paying for the mapping.
+    Q_D(const QQuickItem);
+    for (int i = d->childItems.count()-1; i >= 0; --i) {
+        QQuickItem *child = d->childItems.at(i);
+        if (!child->isVisible())
+            continue;
         // Map coordinates to the child element's coordinate space
         QPointF point = mapToItem(child, QPointF(x, y));
-        if (child->isVisible() && point.x() >= 0
+        if (point.x() >= 0
                 && child->width() >= point.x()
                 && point.y() >= 0
                 && child->height() >= point.y())
@@ -5345,6 +5356,9 @@ void QQuickItemPrivate::dirty(DirtyType type)
     if (type & (TransformOrigin | Transform | BasicTransform | Position | Size))
         transformChanged();
 
+    if (window && (type & HitTestBoundsMask))
+        QQuickWindowPrivate::get(window)->invalidateHitTestBounds(q);
+
     if (!(dirtyAttributes & type) || (window && !prevDirtyItem)) {
         dirtyAttributes |= type;
         if (window && componentComplete) {
@@ -6370,6 +6384,9 @@ void QQuickItem::setAcceptedMouseButtons(Qt::MouseButtons buttons)
     buttons &= ~Qt::LeftButton;
     if (buttons || d->extra.isAllocated())
         d->extra.value().acceptedMouseButtons = buttons;
+
+    if (d->window)
+        QQuickWindowPrivate::get(d->window)->invalidateHitTestBounds(this);
 }
 
 /*!
@@ -6436,6 +6453,9 @@ void QQuickItem::setAcceptHoverEvents(bool enabled)
 {
     Q_D(QQuickItem);
     d->hoverEnabled = enabled;
+
+    if (d->window)
+        QQuickWindowPrivate::get(d->window)->invalidateHitTestBounds(this);
 }
 
 void QQuickItemPrivate::incrementCursorCount(int delta)
@@ -452,7 +452,9 @@ public:
                                   Window,
         ComplexTransformUpdateMask     = Transform | Window,
         ContentUpdateMask       = Size | Content | Smooth | Window | Antialiasing,
-        ChildrenUpdateMask      = ChildrenChanged | ChildrenStackingChanged | EffectReference | Window
+        ChildrenUpdateMask      = ChildrenChanged | ChildrenStackingChanged | EffectReference | Window,
+        HitTestBoundsMask       = TransformOrigin | Transform | BasicTransform | Position | Size |
+                                  ChildrenChanged | ParentChanged | Clip | Visible | Window
     };
 
     quint32 dirtyAttributes;
@@ -266,8 +266,12 @@ static void qt_quickitems_defineModule(const char *uri, int major, int minor)
     qmlRegisterType<QQuickGridView, 1>(uri, 2, 1, "GridView");
     qmlRegisterType<QQuickTextEdit, 1>(uri, 2, 1, "TextEdit");
 
-    qmlRegisterType<QQuickText, 2>(uri, 2, 2, "Text");
-    qmlRegisterType<QQuickTextEdit, 2>(uri, 2, 2, "TextEdit");
+    qmlRegisterType<QQuickText, 3>(uri, 2, 2, "Text");
+    qmlRegisterType<QQuickTextEdit, 3>(uri, 2, 2, "TextEdit");
+    qmlRegisterUncreatableType<QQuickItemView, 2>(uri, 2, 2, "ItemView", QQuickItemView::tr("ItemView is an abstract base class"));
+    qmlRegisterType<QQuickListView, 2>(uri, 2, 2, "ListView");
+    qmlRegisterType<QQuickGridView, 2>(uri, 2, 2, "GridView");
+    qmlRegisterType<QQuickPathView, 1>(uri, 2, 2, "PathView");
 }
 
 static void initResources()
@@ -260,6 +260,8 @@ QQuickItemView::~QQuickItemView()
     d->clear();
     if (d->ownModel)
         delete d->model;
+    else if (QQmlDelegateModel *dataModel = qobject_cast<QQmlDelegateModel *>(d->model))
+        dataModel->drainReusableItems();
     delete d->header;
     delete d->footer;
 }
@@ -293,6 +295,11 @@ void QQuickItemView::setModel(const QVariant &model)
     QQmlInstanceModel *oldModel = d->model;
 
     d->clear();
+    if (!d->ownModel) {
+        // pooled items of a model used elsewhere are still children of this view
+        if (QQmlDelegateModel *dataModel = qobject_cast<QQmlDelegateModel *>(oldModel))
+            dataModel->drainReusableItems();
+    }
     d->model = 0;
     d->setPosition(d->contentStartOffset());
     d->modelVariant = model;
@@ -309,6 +316,7 @@ void QQuickItemView::setModel(const QVariant &model)
         if (!d->ownModel) {
             d->model = new QQmlDelegateModel(qmlContext(this), this);
             d->ownModel = true;
+            static_cast<QQmlDelegateModel *>(d->model.data())->setReuseItems(d->reuseItems);
             if (isComponentComplete())
                 static_cast<QQmlDelegateModel *>(d->model.data())->componentComplete();
         } else {
@@ -362,6 +370,7 @@ void QQuickItemView::setDelegate(QQmlComponent *delegate)
     if (!d->ownModel) {
         d->model = new QQmlDelegateModel(qmlContext(this));
         d->ownModel = true;
+        static_cast<QQmlDelegateModel *>(d->model.data())->setReuseItems(d->reuseItems);
     }
     if (QQmlDelegateModel *dataModel = qobject_cast<QQmlDelegateModel*>(d->model)) {
         int oldCount = dataModel->count();
@@ -496,6 +505,25 @@ void QQuickItemView::setDisplayMarginEnd(int margin)
     }
 }
 
+bool QQuickItemView::reuseItems() const
+{
+    Q_D(const QQuickItemView);
+    return d->reuseItems;
+}
+
+void QQuickItemView::setReuseItems(bool reuse)
+{
+    Q_D(QQuickItemView);
+    if (d->reuseItems != reuse) {
+        d->reuseItems = reuse;
+        if (d->ownModel) {
+            if (QQmlDelegateModel *dataModel = qobject_cast<QQmlDelegateModel *>(d->model))
+                dataModel->setReuseItems(reuse);
+        }
+        emit reuseItemsChanged();
+    }
+}
+
 Qt::LayoutDirection QQuickItemView::layoutDirection() const
 {
     Q_D(const QQuickItemView);
@@ -1496,7 +1524,7 @@ QQuickItemViewPrivate::QQuickItemViewPrivate()
     , inLayout(false), inViewportMoved(false), forceLayout(false), currentIndexCleared(false)
     , haveHighlightRange(false), autoHighlight(true), highlightRangeStartValid(false), highlightRangeEndValid(false)
     , fillCacheBuffer(false), inRequest(false)
-    , runDelayedRemoveTransition(false), delegateValidated(false)
+    , runDelayedRemoveTransition(false), delegateValidated(false), reuseItems(false)
 {
     bufferPause.addAnimationChangeListener(this, QAbstractAnimationJob::Completion);
     bufferPause.setLoopCount(1);
@@ -1909,6 +1937,7 @@ bool QQuickItemViewPrivate::applyModelChanges(ChangeResult *totalInsertionResult
     }
 
     updateUnrequestedIndexes();
+    applySizeIndexChanges(currentChanges.pendingChanges);
     moveReason = QQuickItemViewPrivate::Other;
 
     FxViewItem *prevVisibleItemsFirst = visibleItems.count() ? *visibleItems.constBegin() : 0;
@@ -2342,6 +2371,10 @@ bool QQuickItemViewPrivate::releaseItem(FxViewItem *item)
         // item was not destroyed, and we no longer reference it.
         QQuickItemPrivate::get(item->item)->setCulled(true);
         unrequestedItems.insert(item->item, model->indexOf(item->item, q));
+    } else if (flags & QQmlInstanceModel::Pooled) {
+        // keep the item a child of the view, so that bindings to its parent
+        // stay valid until it is reused
+        QQuickItemPrivate::get(item->item)->setCulled(true);
     } else if (flags & QQmlInstanceModel::Destroyed) {
         item->item->setParentItem(0);
     }
@@ -65,6 +65,7 @@ class Q_AUTOTEST_EXPORT QQuickItemView : public QQuickFlickable
     Q_PROPERTY(int cacheBuffer READ cacheBuffer WRITE setCacheBuffer NOTIFY cacheBufferChanged)
     Q_PROPERTY(int displayMarginBeginning READ displayMarginBeginning WRITE setDisplayMarginBeginning NOTIFY displayMarginBeginningChanged)
     Q_PROPERTY(int displayMarginEnd READ displayMarginEnd WRITE setDisplayMarginEnd NOTIFY displayMarginEndChanged)
+    Q_PROPERTY(bool reuseItems READ reuseItems WRITE setReuseItems NOTIFY reuseItemsChanged REVISION 2)
 
     Q_PROPERTY(Qt::LayoutDirection layoutDirection READ layoutDirection WRITE setLayoutDirection NOTIFY layoutDirectionChanged)
     Q_PROPERTY(Qt::LayoutDirection effectiveLayoutDirection READ effectiveLayoutDirection NOTIFY effectiveLayoutDirectionChanged)
@@ -141,6 +142,9 @@ public:
     int displayMarginEnd() const;
     void setDisplayMarginEnd(int);
 
+    bool reuseItems() const;
+    void setReuseItems(bool);
+
     Qt::LayoutDirection layoutDirection() const;
     void setLayoutDirection(Qt::LayoutDirection);
     Qt::LayoutDirection effectiveLayoutDirection() const;
@@ -228,6 +232,7 @@ Q_SIGNALS:
     void cacheBufferChanged();
     void displayMarginBeginningChanged();
     void displayMarginEndChanged();
+    Q_REVISION(2) void reuseItemsChanged();
 
     void layoutDirectionChanged();
     void effectiveLayoutDirectionChanged();
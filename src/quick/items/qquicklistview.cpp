@@ -49,6 +49,7 @@
 #include <QtGui/qevent.h>
 #include <QtCore/qmath.h>
 #include <QtCore/qcoreapplication.h>
+#include <QtCore/qhash.h>
 
 #include <private/qquicksmoothedanimation_p_p.h>
 #include "qplatformdefs.h"
@@ -61,6 +62,207 @@ QT_BEGIN_NAMESPACE
 
 //#define DEBUG_DELEGATE_LIFECYCLE
 
+/*
+    Records the size of every model row that has been laid out and estimates the size of the
+    rows that haven't with the mean of the measured ones.  The sizes are summed in a Fenwick
+    tree, so the offset of a row from the start of the list and the row at an offset are both
+    found in O(log n) rather than by walking the visible items.
+
+    Model changes shift the recorded sizes and mark the tree for a rebuild on the next query.
+    Rows that are moved keep their size.
+*/
+class QQuickListViewSizeIndex
+{
+public:
+    QQuickListViewSizeIndex() : m_measuredSize(0), m_measuredCount(0), m_dirty(false) {}
+
+    int count() const { return m_sizes.count(); }
+
+    void reset(int count);
+    void setSize(int index, qreal size);
+    void remove(const QQmlChangeSet::Remove &removal);
+    void insert(const QQmlChangeSet::Insert &insertion);
+    void clearMoves() { m_movedSizes.clear(); }
+
+    qreal estimatedSize(qreal fallback) const {
+        return m_measuredCount ? qreal(qRound(m_measuredSize / m_measuredCount)) : fallback; }
+
+    qreal offset(int index, qreal estimate, qreal spacing) const;
+    qreal extent(int from, int to, qreal estimate, qreal spacing) const {
+        return from < to ? offset(to, estimate, spacing) - offset(from, estimate, spacing) : 0; }
+    int indexAt(qreal offset, qreal estimate, qreal spacing) const;
+
+private:
+    void rebuild() const;
+
+    QVector<qreal> m_sizes;     // -1 for rows which haven't been measured
+    mutable QVector<qreal> m_sizeTree;
+    mutable QVector<int> m_countTree;
+    QHash<int, QVector<qreal> > m_movedSizes;
+    qreal m_measuredSize;
+    int m_measuredCount;
+    mutable bool m_dirty;
+};
+
+void QQuickListViewSizeIndex::reset(int count)
+{
+    m_sizes.fill(-1, count);
+    m_movedSizes.clear();
+    m_measuredSize = 0;
+    m_measuredCount = 0;
+    m_dirty = true;
+}
+
+void QQuickListViewSizeIndex::setSize(int index, qreal size)
+{
+    if (index < 0 || index >= m_sizes.count())
+        return;
+    const qreal previous = m_sizes.at(index);
+    if (previous == size)
+        return;
+
+    m_sizes[index] = size;
+    const qreal sizeDelta = previous < 0 ? size : size - previous;
+    const int countDelta = previous < 0 ? 1 : 0;
+    m_measuredSize += sizeDelta;
+    m_measuredCount += countDelta;
+    if (m_dirty)
+        return;
+
+    for (int i = index + 1; i < m_sizeTree.count(); i += i & -i) {
+        m_sizeTree[i] += sizeDelta;
+        m_countTree[i] += countDelta;
+    }
+}
+
+void QQuickListViewSizeIndex::remove(const QQmlChangeSet::Remove &removal)
+{
+    const int from = qBound(0, removal.index, m_sizes.count());
+    const int count = qMin(removal.count, m_sizes.count() - from);
+    if (count <= 0)
+        return;
+
+    QVector<qreal> *moved = 0;
+    if (removal.isMove()) {
+        moved = &m_movedSizes[removal.moveId];
+        if (moved->count() < removal.offset + count)
+            moved->resize(removal.offset + count);
+    }
+    for (int i = 0; i < count; ++i) {
+        const qreal size = m_sizes.at(from + i);
+        if (moved)
+            (*moved)[removal.offset + i] = size;
+        if (size >= 0) {
+            m_measuredSize -= size;
+            --m_measuredCount;
+        }
+    }
+    m_sizes.remove(from, count);
+    m_dirty = true;
+}
+
+void QQuickListViewSizeIndex::insert(const QQmlChangeSet::Insert &insertion)
+{
+    const int at = qBound(0, insertion.index, m_sizes.count());
+    if (insertion.count <= 0)
+        return;
+
+    m_sizes.insert(at, insertion.count, -1);
+    if (insertion.isMove()) {
+        QHash<int, QVector<qreal> >::const_iterator it = m_movedSizes.constFind(insertion.moveId);
+        if (it != m_movedSizes.constEnd()) {
+            for (int i = 0; i < insertion.count && insertion.offset + i < it->count(); ++i) {
+                const qreal size = it->at(insertion.offset + i);
+                m_sizes[at + i] = size;
+                if (size >= 0) {
+                    m_measuredSize += size;
+                    ++m_measuredCount;
+                }
+            }
+        }
+    }
+    m_dirty = true;
+}
+
+void QQuickListViewSizeIndex::rebuild() const
+{
+    const int n = m_sizes.count();
+    m_sizeTree.fill(0, n + 1);
+    m_countTree.fill(0, n + 1);
+    for (int i = 1; i <= n; ++i) {
+        const qreal size = m_sizes.at(i - 1);
+        if (size >= 0) {
+            m_sizeTree[i] += size;
+            m_countTree[i] += 1;
+        }
+        const int parent = i + (i & -i);
+        if (parent <= n) {
+            m_sizeTree[parent] += m_sizeTree.at(i);
+            m_countTree[parent] += m_countTree.at(i);
+        }
+    }
+    m_dirty = false;
+}
+
+/*
+    Returns the distance from the start of row 0 to the start of row \a index, assuming each
+    row is followed by \a spacing.  Rows past the end are estimated.
+*/
+qreal QQuickListViewSizeIndex::offset(int index, qreal estimate, qreal spacing) const
+{
+    if (index <= 0)
+        return index * (estimate + spacing);
+    if (m_dirty)
+        rebuild();
+
+    const int n = qMin(index, m_sizes.count());
+    qreal size = 0;
+    int measured = 0;
+    for (int i = n; i > 0; i -= i & -i) {
+        size += m_sizeTree.at(i);
+        measured += m_countTree.at(i);
+    }
+    return size + (n - measured) * estimate + n * spacing + (index - n) * (estimate + spacing);
+}
+
+/*
+    Returns the row which starts at or before \a offset, i.e. the largest index whose offset()
+    is not greater than \a offset.  Offsets outside the list give estimated indexes outside it.
+*/
+int QQuickListViewSizeIndex::indexAt(qreal offset, qreal estimate, qreal spacing) const
+{
+    if (offset < 0)
+        return estimate + spacing > 0 ? qFloor(offset / (estimate + spacing)) : 0;
+    if (m_dirty)
+        rebuild();
+
+    const int n = m_sizes.count();
+    int step = 1;
+    while (step * 2 <= n)
+        step *= 2;
+
+    int index = 0;
+    qreal size = 0;
+    int measured = 0;
+    for (; step > 0; step /= 2) {
+        const int next = index + step;
+        if (next > n)
+            continue;
+        const qreal nextSize = size + m_sizeTree.at(next);
+        const int nextMeasured = measured + m_countTree.at(next);
+        if (nextSize + (next - nextMeasured) * estimate + next * spacing <= offset) {
+            index = next;
+            size = nextSize;
+            measured = nextMeasured;
+        }
+    }
+    if (index == n && estimate + spacing > 0) {
+        const qreal end = size + (n - measured) * estimate + n * spacing;
+        index += int((offset - end) / (estimate + spacing));
+    }
+    return index;
+}
+
 class FxListItemSG;
 
 class QQuickListViewPrivate : public QQuickItemViewPrivate
@@ -130,6 +332,11 @@ public:
     virtual void initializeCurrentItem();
 
     void updateAverage();
+    void updateSizeIndex();
+    qreal estimatedSize() const { return sizeIndex.estimatedSize(averageSize); }
+    qreal extentOf(int from, int to) const {
+        return sizeIndex.extent(from, to, estimatedSize(), spacing); }
+    virtual void applySizeIndexChanges(const QQmlChangeSet &changes);
 
     void itemGeometryChanged(QQuickItem *item, const QRectF &newGeometry, const QRectF &oldGeometry);
     virtual void fixupPosition();
@@ -142,6 +349,7 @@ public:
     qreal averageSize;
     qreal spacing;
     QQuickListView::SnapMode snapMode;
+    QQuickListViewSizeIndex sizeIndex;
 
     QSmoothedAnimation *highlightPosAnimator;
     QSmoothedAnimation *highlightWidthAnimator;
@@ -423,7 +631,7 @@ qreal QQuickListViewPrivate::originPosition() const
     if (!visibleItems.isEmpty()) {
         pos = (*visibleItems.constBegin())->position();
         if (visibleIndex > 0)
-            pos -= visibleIndex * (averageSize + spacing);
+            pos -= extentOf(0, visibleIndex);
     }
     return pos;
 }
@@ -433,15 +641,21 @@ qreal QQuickListViewPrivate::lastPosition() const
     qreal pos = 0;
     if (!visibleItems.isEmpty()) {
         int invisibleCount = visibleItems.count() - visibleIndex;
+        int lastIndex = -1;
         for (int i = visibleItems.count()-1; i >= 0; --i) {
             if (visibleItems.at(i)->index != -1) {
-                invisibleCount = model->count() - visibleItems.at(i)->index - 1;
+                lastIndex = visibleItems.at(i)->index;
+                invisibleCount = model->count() - lastIndex - 1;
                 break;
             }
         }
-        pos = (*(--visibleItems.constEnd()))->endPosition() + invisibleCount * (averageSize + spacing);
+        pos = (*(--visibleItems.constEnd()))->endPosition();
+        if (lastIndex != -1)
+            pos += extentOf(lastIndex + 1, model->count());
+        else
+            pos += invisibleCount * (estimatedSize() + spacing);
     } else if (model && model->count()) {
-        pos = (model->count() * averageSize + (model->count()-1) * spacing);
+        pos = extentOf(0, model->count()) - spacing;
     }
     return pos;
 }
@@ -453,16 +667,14 @@ qreal QQuickListViewPrivate::positionAt(int modelIndex) const
     }
     if (!visibleItems.isEmpty()) {
         if (modelIndex < visibleIndex) {
-            int count = visibleIndex - modelIndex;
-            qreal cs = 0;
             if (modelIndex == currentIndex && currentItem) {
-                cs = currentItem->size() + spacing;
-                --count;
+                return (*visibleItems.constBegin())->position() - extentOf(modelIndex + 1, visibleIndex)
+                        - currentItem->size() - spacing;
             }
-            return (*visibleItems.constBegin())->position() - count * (averageSize + spacing) - cs;
+            return (*visibleItems.constBegin())->position() - extentOf(modelIndex, visibleIndex);
         } else {
-            int count = modelIndex - findLastVisibleIndex(visibleIndex) - 1;
-            return (*(--visibleItems.constEnd()))->endPosition() + spacing + count * (averageSize + spacing);
+            int lastIndex = findLastVisibleIndex(visibleIndex);
+            return (*(--visibleItems.constEnd()))->endPosition() + spacing + extentOf(lastIndex + 1, modelIndex);
         }
     }
     return 0;
@@ -474,11 +686,10 @@ qreal QQuickListViewPrivate::endPositionAt(int modelIndex) const
         return item->endPosition();
     if (!visibleItems.isEmpty()) {
         if (modelIndex < visibleIndex) {
-            int count = visibleIndex - modelIndex;
-            return (*visibleItems.constBegin())->position() - (count - 1) * (averageSize + spacing) - spacing;
+            return (*visibleItems.constBegin())->position() - extentOf(modelIndex + 1, visibleIndex) - spacing;
         } else {
-            int count = modelIndex - findLastVisibleIndex(visibleIndex) - 1;
-            return (*(--visibleItems.constEnd()))->endPosition() + count * (averageSize + spacing);
+            int lastIndex = findLastVisibleIndex(visibleIndex);
+            return (*(--visibleItems.constEnd()))->endPosition() + extentOf(lastIndex + 1, modelIndex);
         }
     }
     return 0;
@@ -505,10 +716,15 @@ qreal QQuickListViewPrivate::snapPosAt(qreal pos)
     if (visibleItems.count()) {
         qreal firstPos = (*visibleItems.constBegin())->position();
         qreal endPos = (*(--visibleItems.constEnd()))->position();
-        if (pos < firstPos) {
-            return firstPos - qRound((firstPos - pos) / averageSize) * averageSize;
-        } else if (pos > endPos)
-            return endPos + qRound((pos - endPos) / averageSize) * averageSize;
+        if (pos < firstPos || pos > endPos) {
+            // snap to the nearer of the estimated starts of the rows either side of pos
+            const qreal estimate = estimatedSize();
+            const qreal origin = originPosition();
+            const int index = sizeIndex.indexAt(pos - origin, estimate, spacing);
+            const qreal start = origin + sizeIndex.offset(index, estimate, spacing);
+            const qreal next = origin + sizeIndex.offset(index + 1, estimate, spacing);
+            return pos - start < next - pos ? start : next;
+        }
     }
     return qRound((pos - originPosition()) / averageSize) * averageSize + originPosition();
 }
@@ -555,6 +771,7 @@ void QQuickListViewPrivate::clear()
     releaseSectionItem(nextSectionItem);
     nextSectionItem = 0;
     lastVisibleSection = QString();
+    sizeIndex.reset(0);
     QQuickItemViewPrivate::clear();
 }
 
@@ -638,20 +855,24 @@ bool QQuickListViewPrivate::addVisibleItems(qreal fillFrom, qreal fillTo, qreal
     bool haveValidItems = modelIndex >= 0;
     modelIndex = modelIndex < 0 ? visibleIndex : modelIndex + 1;
 
-    if (haveValidItems && (bufferFrom > itemEnd+averageSize+spacing
-        || bufferTo < visiblePos - averageSize - spacing)) {
+    if (sizeIndex.count() != model->count())
+        sizeIndex.reset(model->count());
+
+    const qreal estimate = estimatedSize();
+    if (haveValidItems && (bufferFrom > itemEnd+estimate+spacing
+        || bufferTo < visiblePos - estimate - spacing)) {
         // We've jumped more than a page.  Estimate which items are now
         // visible and fill from there.
-        int count = (fillFrom - itemEnd) / (averageSize + spacing);
-        int newModelIdx = qBound(0, modelIndex + count, model->count());
-        count = newModelIdx - modelIndex;
-        if (count) {
+        const qreal modelIndexOffset = sizeIndex.offset(modelIndex, estimate, spacing);
+        int newModelIdx = sizeIndex.indexAt(modelIndexOffset + fillFrom - itemEnd, estimate, spacing);
+        newModelIdx = qBound(0, newModelIdx, model->count());
+        if (newModelIdx != modelIndex) {
             for (int i = 0; i < visibleItems.count(); ++i)
                 releaseItem(visibleItems.at(i));
             visibleItems.clear();
+            visiblePos = itemEnd + sizeIndex.offset(newModelIdx, estimate, spacing) - modelIndexOffset;
             modelIndex = newModelIdx;
             visibleIndex = modelIndex;
-            visiblePos = itemEnd + count * (averageSize + spacing);
             itemEnd = visiblePos;
         }
     }
@@ -797,6 +1018,7 @@ void QQuickListViewPrivate::layoutVisibleItems(int fromModelIndex)
             fixedCurrent = fixedCurrent || (currentItem && item->item == currentItem->item);
         }
         averageSize = qRound(sum / visibleItems.count());
+        updateSizeIndex();
 
         // move current item if it is not a visible item.
         if (currentIndex >= 0 && currentItem && !fixedCurrent)
@@ -1276,6 +1498,31 @@ void QQuickListViewPrivate::updateAverage()
     for (int i = 0; i < visibleItems.count(); ++i)
         sum += visibleItems.at(i)->size();
     averageSize = qRound(sum / visibleItems.count());
+    updateSizeIndex();
+}
+
+void QQuickListViewPrivate::updateSizeIndex()
+{
+    for (int i = 0; i < visibleItems.count(); ++i) {
+        const FxViewItem *item = visibleItems.at(i);
+        if (item->index != -1)
+            sizeIndex.setSize(item->index, item->size());
+    }
+}
+
+void QQuickListViewPrivate::applySizeIndexChanges(const QQmlChangeSet &changes)
+{
+    if (sizeIndex.count() != itemCount) {
+        sizeIndex.reset(model ? model->count() : 0);
+        return;
+    }
+    const QVector<QQmlChangeSet::Remove> &removals = changes.removes();
+    for (int i = 0; i < removals.count(); ++i)
+        sizeIndex.remove(removals.at(i));
+    const QVector<QQmlChangeSet::Insert> &insertions = changes.inserts();
+    for (int i = 0; i < insertions.count(); ++i)
+        sizeIndex.insert(insertions.at(i));
+    sizeIndex.clearMoves();
 }
 
 qreal QQuickListViewPrivate::headerSize() const
@@ -2173,6 +2420,25 @@ void QQuickListView::setOrientation(QQuickListView::Orientation orientation)
     want to use the cacheBuffer property instead.
 */
 
+/*!
+    \qmlproperty bool QtQuick::ListView::reuseItems
+    \since QtQuick 2.2
+
+    This property holds whether delegate instances are reused rather than destroyed when they
+    move out of the visible area and the cacheBuffer.
+
+    When true, a delegate that is no longer needed is hidden and kept in a pool, and the next
+    delegate the view needs is taken from the pool and bound to its new model item instead of being created from scratch.  This avoids most of the cost of
+    instantiating delegates while flicking through long lists.  A reused delegate receives
+    new values for \c index and the model roles, so any other state it keeps should be reset
+    in the \l {DelegateModel::reused}{DelegateModel.onReused} handler.
+
+    This property only affects the model created by the view; when \l model is a
+    \l DelegateModel set its \l {DelegateModel::reuseItems}{reuseItems} property instead.
+
+    The default value is false.
+*/
+
 /*!
     \qmlpropertygroup QtQuick::ListView::section
     \qmlproperty string QtQuick::ListView::section.property
@@ -2969,8 +3235,8 @@ bool QQuickListViewPrivate::applyInsertionChange(const QQmlChangeSet::Insert &ch
         for (i = count-1; i >= 0; --i) {
             if (pos > from && insertionIdx < visibleIndex) {
                 // item won't be visible, just note the size for repositioning
-                insertResult->sizeChangesBeforeVisiblePos += averageSize + spacing;
-                pos -= averageSize + spacing;
+                insertResult->sizeChangesBeforeVisiblePos += estimatedSize() + spacing;
+                pos -= estimatedSize() + spacing;
             } else {
                 // item is before first visible e.g. in cache buffer
                 FxViewItem *item = 0;
@@ -3059,7 +3325,7 @@ void QQuickListViewPrivate::translateAndTransitionItemsAfter(int afterModelIndex
 
     const qreal viewEndPos = isContentFlowReversed() ? -position() : position() + size();
     qreal sizeRemoved = -removalResult.sizeChangesAfterVisiblePos
-            - (removalResult.countChangeAfterVisibleItems * (averageSize + spacing));
+            - (removalResult.countChangeAfterVisibleItems * (estimatedSize() + spacing));
 
     for (int i=markerItemIndex+1; i<visibleItems.count() && visibleItems.at(i)->position() < viewEndPos; i++) {
         FxListItemSG *listItem = static_cast<FxListItemSG *>(visibleItems[i]);
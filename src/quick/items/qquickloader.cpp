@@ -120,7 +120,8 @@ void QQuickLoaderPrivate::clear()
         item = 0;
     }
     if (object) {
-        object->deleteLater();
+        // Tear the old object tree down in the incubation controller's spare time
+        QQmlEnginePrivate::deferDestruction(qmlEngine(q), object);
         object = 0;
     }
 }
@@ -363,7 +364,7 @@ void QQuickLoader::setActive(bool newVal)
             d->item = 0;
         }
         if (d->object) {
-            d->object->deleteLater();
+            QQmlEnginePrivate::deferDestruction(qmlEngine(this), d->object);
             d->object = 0;
             emit itemChanged();
         }
@@ -104,6 +104,7 @@ QQuickPathViewPrivate::QQuickPathViewPrivate()
     , stealMouse(false), ownModel(false), interactive(true), haveHighlightRange(true)
     , autoHighlight(true), highlightUp(false), layoutScheduled(false)
     , moving(false), flicking(false), dragging(false), inRequest(false), delegateValidated(false)
+    , reuseItems(false)
     , dragMargin(0), deceleration(100), maximumFlickVelocity(QML_FLICK_DEFAULTMAXVELOCITY)
     , moveOffset(this, &QQuickPathViewPrivate::setAdjustedOffset), flickDuration(0)
     , firstIndex(-1), pathItems(-1), requestedIndex(-1), cacheSize(0), requestedZ(0)
@@ -212,6 +213,12 @@ void QQuickPathViewPrivate::releaseItem(QQuickItem *item)
         // item was not destroyed, and we no longer reference it.
         if (QQuickPathViewAttached *att = attached(item))
             att->setOnPath(false);
+    } else if (flags & QQmlInstanceModel::Pooled) {
+        // keep the item a child of the view, so that bindings to its parent
+        // stay valid until it is reused
+        itemPrivate->setCulled(true);
+        if (QQuickPathViewAttached *att = attached(item))
+            att->setOnPath(false);
     } else if (flags & QQmlInstanceModel::Destroyed) {
         // but we still reference it
         item->setParentItem(0);
@@ -556,6 +563,8 @@ QQuickPathView::~QQuickPathView()
         d->attType->release();
     if (d->ownModel)
         delete d->model;
+    else if (QQmlDelegateModel *dataModel = qobject_cast<QQmlDelegateModel *>(d->model))
+        dataModel->drainReusableItems();
 }
 
 /*!
@@ -628,6 +637,11 @@ void QQuickPathView::setModel(const QVariant &model)
         qmlobject_disconnect(d->model, QQmlInstanceModel, SIGNAL(initItem(int,QObject*)),
                              this, QQuickPathView, SLOT(initItem(int,QObject*)));
         d->clear();
+        // pooled items of a model used elsewhere are still children of this view
+        if (!d->ownModel) {
+            if (QQmlDelegateModel *dataModel = qobject_cast<QQmlDelegateModel *>(d->model))
+                dataModel->drainReusableItems();
+        }
     }
 
     d->modelVariant = model;
@@ -643,6 +657,7 @@ void QQuickPathView::setModel(const QVariant &model)
         if (!d->ownModel) {
             d->model = new QQmlDelegateModel(qmlContext(this));
             d->ownModel = true;
+            static_cast<QQmlDelegateModel *>(d->model.data())->setReuseItems(d->reuseItems);
             if (isComponentComplete())
                 static_cast<QQmlDelegateModel *>(d->model.data())->componentComplete();
         }
@@ -1230,6 +1245,7 @@ void QQuickPathView::setDelegate(QQmlComponent *delegate)
     if (!d->ownModel) {
         d->model = new QQmlDelegateModel(qmlContext(this));
         d->ownModel = true;
+        static_cast<QQmlDelegateModel *>(d->model.data())->setReuseItems(d->reuseItems);
     }
     if (QQmlDelegateModel *dataModel = qobject_cast<QQmlDelegateModel*>(d->model)) {
         int oldCount = dataModel->count();
@@ -1319,6 +1335,45 @@ void QQuickPathView::setCacheItemCount(int i)
     emit cacheItemCountChanged();
 }
 
+/*!
+    \qmlproperty bool QtQuick::PathView::reuseItems
+    \since QtQuick 2.2
+
+    This property holds whether delegate instances are reused rather than destroyed when they
+    move off the path and out of the cached items.
+
+    When true, a delegate that is no longer needed is hidden and kept in a pool, and the next
+    delegate the view needs is taken from the pool and bound to its new model item.  A reused delegate receives new values for \c index and the model roles, so
+    any other state it keeps should be reset in the
+    \l {DelegateModel::reused}{DelegateModel.onReused} handler.
+
+    This property only affects the model created by the view; when \l model is a
+    \l DelegateModel set its \l {DelegateModel::reuseItems}{reuseItems} property instead.
+
+    The default value is false.
+
+    \sa cacheItemCount
+*/
+bool QQuickPathView::reuseItems() const
+{
+    Q_D(const QQuickPathView);
+    return d->reuseItems;
+}
+
+void QQuickPathView::setReuseItems(bool reuse)
+{
+    Q_D(QQuickPathView);
+    if (reuse == d->reuseItems)
+        return;
+
+    d->reuseItems = reuse;
+    if (d->ownModel) {
+        if (QQmlDelegateModel *dataModel = qobject_cast<QQmlDelegateModel *>(d->model))
+            dataModel->setReuseItems(reuse);
+    }
+    emit reuseItemsChanged();
+}
+
 /*!
     \qmlproperty enumeration QtQuick::PathView::snapMode
 
@@ -85,6 +85,7 @@ class Q_AUTOTEST_EXPORT QQuickPathView : public QQuickItem
     Q_PROPERTY(SnapMode snapMode READ snapMode WRITE setSnapMode NOTIFY snapModeChanged)
 
     Q_PROPERTY(int cacheItemCount READ cacheItemCount WRITE setCacheItemCount NOTIFY cacheItemCountChanged)
+    Q_PROPERTY(bool reuseItems READ reuseItems WRITE setReuseItems NOTIFY reuseItemsChanged REVISION 1)
 
     Q_ENUMS(HighlightRangeMode)
     Q_ENUMS(SnapMode)
@@ -153,6 +154,9 @@ public:
     int cacheItemCount() const;
     void setCacheItemCount(int);
 
+    bool reuseItems() const;
+    void setReuseItems(bool);
+
     enum SnapMode { NoSnap, SnapToItem, SnapOneItem };
     SnapMode snapMode() const;
     void setSnapMode(SnapMode mode);
@@ -199,6 +203,7 @@ Q_SIGNALS:
     void dragEnded();
     void snapModeChanged();
     void cacheItemCountChanged();
+    Q_REVISION(1) void reuseItemsChanged();
 
 protected:
     virtual void updatePolish();
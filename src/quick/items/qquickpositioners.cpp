@@ -72,6 +72,22 @@ void QQuickBasePositionerPrivate::unwatchChanges(QQuickItem* other)
     otherPrivate->removeItemChangeListener(this, watchedChanges);
 }
 
+void QQuickBasePositionerPrivate::setItemResized(QQuickItem *item)
+{
+    Q_Q(QQuickBasePositioner);
+    if (relayoutAll)
+        return;
+
+    // The cached index is stale if an item was removed since the last rebuild
+    int index = positionedIndexes.value(item, -1);
+    if (index < 0 || index >= q->positionedItems.count() || q->positionedItems.at(index).item != item) {
+        setChildrenDirty();
+        return;
+    }
+    firstResizedIndex = firstResizedIndex < 0 ? index : qMin(firstResizedIndex, index);
+    schedulePositioning();
+}
+
 
 QQuickBasePositioner::PositionedItem::PositionedItem(QQuickItem *i)
     : item(i)
@@ -175,8 +191,14 @@ QQuickBasePositioner::~QQuickBasePositioner()
 void QQuickBasePositioner::updatePolish()
 {
     Q_D(QQuickBasePositioner);
-    if (d->positioningDirty)
+    if (d->positioningDirty) {
+        // Only relayout from the first changed item, unless something affecting
+        // every item changed.  Transitions need every item queued, so they
+        // always get a full pass.
+        d->partialRelayout = !d->relayoutAll && !d->transitioner;
         prePositioning();
+        d->partialRelayout = false;
+    }
 }
 
 qreal QQuickBasePositioner::spacing() const
@@ -264,7 +286,7 @@ void QQuickBasePositioner::itemChange(ItemChange change, const ItemChangeData &v
 {
     Q_D(QQuickBasePositioner);
     if (change == ItemChildAddedChange) {
-        d->setPositioningDirty();
+        d->setChildrenDirty();
     } else if (change == ItemChildRemovedChange) {
         QQuickItem *child = value.item;
         QQuickBasePositioner::PositionedItem posItem(child);
@@ -276,7 +298,7 @@ void QQuickBasePositioner::itemChange(ItemChange change, const ItemChangeData &v
             d->unwatchChanges(child);
             removePositionedItem(&unpositionedItems, idx);
         }
-        d->setPositioningDirty();
+        d->setChildrenDirty();
     }
 
     QQuickItem::itemChange(change, value);
@@ -291,70 +313,108 @@ void QQuickBasePositioner::prePositioning()
     if (d->doingPositioning)
         return;
 
+    const bool partial = d->partialRelayout;
+    const bool rebuild = !partial || d->childrenDirty;
+    int positionFrom = partial && d->firstResizedIndex >= 0 ? d->firstResizedIndex : INT_MAX;
+    if (!partial)
+        positionFrom = 0;
+
     d->positioningDirty = false;
+    d->relayoutAll = false;
+    d->childrenDirty = false;
+    d->partialRelayout = false;
+    d->firstResizedIndex = -1;
     d->doingPositioning = true;
-    //Need to order children by creation order modified by stacking order
-    QList<QQuickItem *> children = childItems();
-
-    QPODVector<PositionedItem,8> oldItems;
-    positionedItems.copyAndClear(oldItems);
-    for (int ii = 0; ii < unpositionedItems.count(); ii++)
-        oldItems.append(unpositionedItems[ii]);
-    unpositionedItems.clear();
-    int addedIndex = -1;
 
-    for (int ii = 0; ii < children.count(); ++ii) {
-        QQuickItem *child = children.at(ii);
-        QQuickItemPrivate *childPrivate = QQuickItemPrivate::get(child);
-        PositionedItem posItem(child);
-        int wIdx = oldItems.find(posItem);
-        if (wIdx < 0) {
-            d->watchChanges(child);
-            posItem.isNew = true;
-            if (!childPrivate->explicitVisible || !child->width() || !child->height()) {
-                posItem.isVisible = false;
-                posItem.index = -1;
-                unpositionedItems.append(posItem);
-            } else {
-                posItem.index = positionedItems.count();
-                positionedItems.append(posItem);
-
-                if (d->transitioner) {
-                    if (addedIndex < 0)
-                        addedIndex = posItem.index;
-                    PositionedItem *theItem = &positionedItems[positionedItems.count()-1];
-                    if (d->transitioner->canTransition(QQuickItemViewTransitioner::PopulateTransition, true))
-                        theItem->transitionNextReposition(d->transitioner, QQuickItemViewTransitioner::PopulateTransition, true);
-                    else if (!d->transitioner->populateTransitionEnabled())
-                        theItem->transitionNextReposition(d->transitioner, QQuickItemViewTransitioner::AddTransition, true);
+    int addedIndex = -1;
+    if (rebuild) {
+        //Need to order children by creation order modified by stacking order
+        QList<QQuickItem *> children = childItems();
+
+        QPODVector<PositionedItem,8> oldItems;
+        positionedItems.copyAndClear(oldItems);
+        for (int ii = 0; ii < unpositionedItems.count(); ii++)
+            oldItems.append(unpositionedItems[ii]);
+        unpositionedItems.clear();
+
+        // Children mostly keep their order, so try the old item following the
+        // last match before falling back to a lookup table.
+        QHash<QQuickItem *, int> oldIndexes;
+        int nextOldIndex = 0;
+
+        for (int ii = 0; ii < children.count(); ++ii) {
+            QQuickItem *child = children.at(ii);
+            QQuickItemPrivate *childPrivate = QQuickItemPrivate::get(child);
+            PositionedItem posItem(child);
+            int wIdx = -1;
+            if (nextOldIndex < oldItems.count() && oldItems.at(nextOldIndex).item == child) {
+                wIdx = nextOldIndex;
+            } else if (oldItems.count()) {
+                if (oldIndexes.isEmpty()) {
+                    oldIndexes.reserve(oldItems.count());
+                    for (int jj = 0; jj < oldItems.count(); ++jj)
+                        oldIndexes.insert(oldItems.at(jj).item, jj);
                 }
+                wIdx = oldIndexes.value(child, -1);
             }
-        } else {
-            PositionedItem *item = &oldItems[wIdx];
-            // Items are only omitted from positioning if they are explicitly hidden
-            // i.e. their positioning is not affected if an ancestor is hidden.
-            if (!childPrivate->explicitVisible || !child->width() || !child->height()) {
-                item->isVisible = false;
-                item->index = -1;
-                unpositionedItems.append(*item);
-            } else if (!item->isVisible) {
-                // item changed from non-visible to visible, treat it as a "new" item
-                item->isVisible = true;
-                item->isNew = true;
-                item->index = positionedItems.count();
-                positionedItems.append(*item);
-
-                if (d->transitioner) {
-                    if (addedIndex < 0)
-                        addedIndex = item->index;
-                    positionedItems[positionedItems.count()-1].transitionNextReposition(d->transitioner, QQuickItemViewTransitioner::AddTransition, true);
+            if (wIdx < 0) {
+                d->watchChanges(child);
+                posItem.isNew = true;
+                if (!childPrivate->explicitVisible || !child->width() || !child->height()) {
+                    posItem.isVisible = false;
+                    posItem.index = -1;
+                    unpositionedItems.append(posItem);
+                } else {
+                    posItem.index = positionedItems.count();
+                    positionFrom = qMin(positionFrom, posItem.index);
+                    positionedItems.append(posItem);
+
+                    if (d->transitioner) {
+                        if (addedIndex < 0)
+                            addedIndex = posItem.index;
+                        PositionedItem *theItem = &positionedItems[positionedItems.count()-1];
+                        if (d->transitioner->canTransition(QQuickItemViewTransitioner::PopulateTransition, true))
+                            theItem->transitionNextReposition(d->transitioner, QQuickItemViewTransitioner::PopulateTransition, true);
+                        else if (!d->transitioner->populateTransitionEnabled())
+                            theItem->transitionNextReposition(d->transitioner, QQuickItemViewTransitioner::AddTransition, true);
+                    }
                 }
             } else {
-                item->isNew = false;
-                item->index = positionedItems.count();
-                positionedItems.append(*item);
+                nextOldIndex = wIdx + 1;
+                PositionedItem *item = &oldItems[wIdx];
+                // Items are only omitted from positioning if they are explicitly hidden
+                // i.e. their positioning is not affected if an ancestor is hidden.
+                if (!childPrivate->explicitVisible || !child->width() || !child->height()) {
+                    item->isVisible = false;
+                    item->index = -1;
+                    unpositionedItems.append(*item);
+                } else if (!item->isVisible) {
+                    // item changed from non-visible to visible, treat it as a "new" item
+                    item->isVisible = true;
+                    item->isNew = true;
+                    item->index = positionedItems.count();
+                    positionFrom = qMin(positionFrom, item->index);
+                    positionedItems.append(*item);
+
+                    if (d->transitioner) {
+                        if (addedIndex < 0)
+                            addedIndex = item->index;
+                        positionedItems[positionedItems.count()-1].transitionNextReposition(d->transitioner, QQuickItemViewTransitioner::AddTransition, true);
+                    }
+                } else {
+                    item->isNew = false;
+                    if (item->index != positionedItems.count())
+                        positionFrom = qMin(positionFrom, positionedItems.count());
+                    item->index = positionedItems.count();
+                    positionedItems.append(*item);
+                }
             }
         }
+
+        d->positionedIndexes.clear();
+        d->positionedIndexes.reserve(positionedItems.count());
+        for (int ii = 0; ii < positionedItems.count(); ++ii)
+            d->positionedIndexes.insert(positionedItems.at(ii).item, ii);
     }
 
     if (d->transitioner) {
@@ -371,12 +431,22 @@ void QQuickBasePositioner::prePositioning()
         }
     }
 
+    // When items were only removed from the end, nothing needs moving but the
+    // content size still has to be recalculated from the remaining items.
+    d->positionFrom = qMin(positionFrom, positionedItems.count());
+
     QSizeF contentSize(0,0);
     reportConflictingAnchors();
     if (!d->anchorConflict) {
         doPositioning(&contentSize);
-        updateAttachedProperties();
+        // only the items from the one before the first moved item can have a new index or
+        // have become the last item
+        if (rebuild)
+            updateAttachedProperties(0, 0, qMax(0, d->positionFrom - 1));
+    } else {
+        d->contentExtents.clear();
     }
+    d->positionFrom = 0;
 
     if (d->transitioner) {
         QRectF viewBounds(QPointF(), contentSize);
@@ -443,7 +513,7 @@ QQuickPositionerAttached *QQuickBasePositioner::qmlAttachedProperties(QObject *o
     return new QQuickPositionerAttached(obj);
 }
 
-void QQuickBasePositioner::updateAttachedProperties(QQuickPositionerAttached *specificProperty, QQuickItem *specificPropertyOwner) const
+void QQuickBasePositioner::updateAttachedProperties(QQuickPositionerAttached *specificProperty, QQuickItem *specificPropertyOwner, int fromIndex) const
 {
     // If this function is deemed too expensive or shows up in profiles, it could
     // be changed to run only when there are attached properties present. This
@@ -452,7 +522,7 @@ void QQuickBasePositioner::updateAttachedProperties(QQuickPositionerAttached *sp
     QQuickPositionerAttached *prevLastProperty = 0;
     QQuickPositionerAttached *lastProperty = 0;
 
-    for (int ii = 0; ii < positionedItems.count(); ++ii) {
+    for (int ii = fromIndex; ii < positionedItems.count(); ++ii) {
         const PositionedItem &child = positionedItems.at(ii);
         if (!child.item)
             continue;
@@ -722,12 +792,28 @@ QQuickColumn::QQuickColumn(QQuickItem *parent)
 void QQuickColumn::doPositioning(QSizeF *contentSize)
 {
     //Precondition: All items in the positioned list have a valid item pointer and should be positioned
+    QQuickBasePositionerPrivate *d = static_cast<QQuickBasePositionerPrivate* >(QQuickBasePositionerPrivate::get(this));
     qreal voffset = 0;
 
-    for (int ii = 0; ii < positionedItems.count(); ++ii) {
+    // Items before positionFrom are already in place, so continue from the last of them
+    const int from = d->positionFrom;
+    if (from > 0) {
+        if (from <= d->contentExtents.count()) {
+            *contentSize = d->contentExtents.at(from - 1);
+        } else {
+            for (int ii = 0; ii < from; ++ii)
+                contentSize->setWidth(qMax(contentSize->width(), positionedItems.at(ii).item->width()));
+        }
+        const PositionedItem &previous = positionedItems.at(from - 1);
+        voffset = previous.itemY() + previous.item->height() + spacing();
+    }
+
+    d->contentExtents.resize(positionedItems.count());
+    for (int ii = from; ii < positionedItems.count(); ++ii) {
         PositionedItem &child = positionedItems[ii];
         positionItemY(voffset, &child);
         contentSize->setWidth(qMax(contentSize->width(), child.item->width()));
+        d->contentExtents[ii] = *contentSize;
 
         voffset += child.item->height();
         voffset += spacing();
@@ -949,8 +1035,23 @@ void QQuickRow::doPositioning(QSizeF *contentSize)
     QQuickBasePositionerPrivate *d = static_cast<QQuickBasePositionerPrivate* >(QQuickBasePositionerPrivate::get(this));
     qreal hoffset = 0;
 
+    // Right to left positions depend on the total width, so only left to right
+    // layouts can continue from the items that are already in place
+    const int from = d->isLeftToRight() ? d->positionFrom : 0;
+    if (from > 0) {
+        if (from <= d->contentExtents.count()) {
+            *contentSize = d->contentExtents.at(from - 1);
+        } else {
+            for (int ii = 0; ii < from; ++ii)
+                contentSize->setHeight(qMax(contentSize->height(), positionedItems.at(ii).item->height()));
+        }
+        const PositionedItem &previous = positionedItems.at(from - 1);
+        hoffset = previous.itemX() + previous.item->width() + spacing();
+    }
+
+    d->contentExtents.resize(positionedItems.count());
     QList<qreal> hoffsets;
-    for (int ii = 0; ii < positionedItems.count(); ++ii) {
+    for (int ii = from; ii < positionedItems.count(); ++ii) {
         PositionedItem &child = positionedItems[ii];
 
         if (d->isLeftToRight()) {
@@ -960,6 +1061,7 @@ void QQuickRow::doPositioning(QSizeF *contentSize)
         }
 
         contentSize->setHeight(qMax(contentSize->height(), child.item->height()));
+        d->contentExtents[ii] = *contentSize;
 
         hoffset += child.item->width();
         hoffset += spacing();
@@ -1798,7 +1900,34 @@ void QQuickFlow::doPositioning(QSizeF *contentSize)
     qreal linemax = 0;
     QList<qreal> hoffsets;
 
-    for (int i = 0; i < positionedItems.count(); ++i) {
+    // Lines before the one holding positionFrom are unchanged, so continue from the
+    // start of that line.  A line starts at the item placed at offset 0 across it,
+    // which only identifies it reliably when spacing isn't negative.
+    int from = 0;
+    if (d->positionFrom > 0 && d->isLeftToRight() && spacing() >= 0) {
+        from = qMin(d->positionFrom, positionedItems.count() - 1);
+        while (from > 0 && (d->flow == LeftToRight ? positionedItems.at(from).itemX()
+                                                   : positionedItems.at(from).itemY()) != 0) {
+            --from;
+        }
+        if (from <= d->contentExtents.count()) {
+            if (from > 0)
+                *contentSize = d->contentExtents.at(from - 1);
+        } else {
+            for (int i = 0; i < from; ++i) {
+                const PositionedItem &child = positionedItems.at(i);
+                contentSize->setWidth(qMax(contentSize->width(), child.itemX() + child.item->width()));
+                contentSize->setHeight(qMax(contentSize->height(), child.itemY() + child.item->height()));
+            }
+        }
+        if (d->flow == LeftToRight)
+            voffset = positionedItems.at(from).itemY();
+        else
+            hoffset = positionedItems.at(from).itemX();
+    }
+
+    d->contentExtents.resize(positionedItems.count());
+    for (int i = from; i < positionedItems.count(); ++i) {
         PositionedItem &child = positionedItems[i];
 
         if (d->flow == LeftToRight)  {
@@ -1824,6 +1953,7 @@ void QQuickFlow::doPositioning(QSizeF *contentSize)
 
         contentSize->setWidth(qMax(contentSize->width(), hoffset + child.item->width()));
         contentSize->setHeight(qMax(contentSize->height(), voffset + child.item->height()));
+        d->contentExtents[i] = *contentSize;
 
         if (d->flow == LeftToRight)  {
             hoffset += child.item->width();
@@ -114,7 +114,7 @@ public:
 
     static QQuickPositionerAttached *qmlAttachedProperties(QObject *obj);
 
-    void updateAttachedProperties(QQuickPositionerAttached *specificProperty = 0, QQuickItem *specificPropertyOwner = 0) const;
+    void updateAttachedProperties(QQuickPositionerAttached *specificProperty = 0, QQuickItem *specificPropertyOwner = 0, int fromIndex = 0) const;
 
 protected:
     QQuickBasePositioner(QQuickBasePositionerPrivate &dd, PositionerType at, QQuickItem *parent);
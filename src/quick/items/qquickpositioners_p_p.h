@@ -63,6 +63,8 @@
 #include <QtCore/qobject.h>
 #include <QtCore/qstring.h>
 #include <QtCore/qtimer.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qvector.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -75,8 +77,9 @@ class QQuickBasePositionerPrivate : public QQuickImplicitSizeItemPrivate, public
 public:
     QQuickBasePositionerPrivate()
         : spacing(0), type(QQuickBasePositioner::None)
-        , transitioner(0), positioningDirty(false)
-        , doingPositioning(false), anchorConflict(false), layoutDirection(Qt::LeftToRight)
+        , transitioner(0), firstResizedIndex(-1), positionFrom(0), positioningDirty(false)
+        , doingPositioning(false), anchorConflict(false), relayoutAll(false), childrenDirty(false)
+        , partialRelayout(false), layoutDirection(Qt::LeftToRight)
     {
     }
 
@@ -92,17 +95,40 @@ public:
 
     void watchChanges(QQuickItem *other);
     void unwatchChanges(QQuickItem* other);
-    void setPositioningDirty() {
+    void schedulePositioning() {
         Q_Q(QQuickBasePositioner);
         if (!positioningDirty) {
             positioningDirty = true;
             q->polish();
         }
     }
+    void setPositioningDirty() {
+        relayoutAll = true;
+        childrenDirty = true;
+        schedulePositioning();
+    }
+    void setChildrenDirty() {
+        childrenDirty = true;
+        schedulePositioning();
+    }
+    void setItemResized(QQuickItem *item);
+
+    // Index of the first positioned item resized since the last positioning, or -1
+    int firstResizedIndex;
+    // Index of the first item doPositioning() must place; the ones before it haven't moved
+    int positionFrom;
+    // Index of each positioned item as of the last rebuild of the positioned item list
+    QHash<QQuickItem *, int> positionedIndexes;
+    // Content size covering the positioned items up to and including each index,
+    // as left by the last doPositioning(), so a partial pass needn't rescan them
+    QVector<QSizeF> contentExtents;
 
     bool positioningDirty : 1;
     bool doingPositioning : 1;
     bool anchorConflict : 1;
+    bool relayoutAll : 1;
+    bool childrenDirty : 1;
+    bool partialRelayout : 1;
 
     Qt::LayoutDirection layoutDirection;
 
@@ -119,18 +145,28 @@ public:
     virtual void itemSiblingOrderChanged(QQuickItem* other)
     {
         Q_UNUSED(other);
-        setPositioningDirty();
+        setChildrenDirty();
     }
 
-    void itemGeometryChanged(QQuickItem *, const QRectF &newGeometry, const QRectF &oldGeometry)
+    void itemGeometryChanged(QQuickItem *item, const QRectF &newGeometry, const QRectF &oldGeometry)
     {
-        if (newGeometry.size() != oldGeometry.size())
+        Q_Q(QQuickBasePositioner);
+        if (newGeometry.size() == oldGeometry.size())
+            return;
+        // Flow, and Row and Grid laid out right to left, watch their own size
+        if (item == q)
             setPositioningDirty();
+        // Items without a width or height aren't positioned, so resizing one
+        // to or from an empty size changes which children are positioned.
+        else if (newGeometry.isEmpty() || oldGeometry.isEmpty())
+            setChildrenDirty();
+        else
+            setItemResized(item);
     }
 
     virtual void itemVisibilityChanged(QQuickItem *)
     {
-        setPositioningDirty();
+        setChildrenDirty();
     }
 
     void itemDestroyed(QQuickItem *item)
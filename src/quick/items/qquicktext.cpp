@@ -60,6 +60,8 @@
 #include <QtGui/qtextcursor.h>
 #include <QtGui/qguiapplication.h>
 #include <QtGui/qinputmethod.h>
+#include <QtCore/qcache.h>
+#include <QtCore/qthreadpool.h>
 
 #include <private/qtextengine_p.h>
 #include <private/qquickstyledtext_p.h>
@@ -73,8 +75,81 @@ QT_BEGIN_NAMESPACE
 
 const QChar QQuickTextPrivate::elideChar = QChar(0x2026);
 
+// Laid out texts are shared between all items with an identical QQuickTextLayoutKey.  Entries
+// are evicted least recently used first once the total length of the cached strings exceeds
+// the cache size; items keep a reference to the layout they display.
+static const int textLayoutCacheSize = 64 * 1024;
+
+static void clearTextLayoutCache();
+
+class QQuickTextLayoutCache
+{
+public:
+    QQuickTextLayoutCache() : cache(textLayoutCacheSize)
+    {
+        // Cached layouts hold font engines, which are invalid once the available fonts change
+        // and must be released before the application tears down the font database.
+        if (QGuiApplication *app = qobject_cast<QGuiApplication *>(QCoreApplication::instance()))
+            QObject::connect(app, &QGuiApplication::fontDatabaseChanged, clearTextLayoutCache);
+        qAddPostRoutine(clearTextLayoutCache);
+    }
+
+    QSharedPointer<QQuickTextSharedLayout> find(const QQuickTextLayoutKey &key)
+    {
+        QSharedPointer<QQuickTextSharedLayout> *shared = cache.object(key);
+        return shared ? *shared : QSharedPointer<QQuickTextSharedLayout>();
+    }
+
+    void insert(const QQuickTextLayoutKey &key, const QSharedPointer<QQuickTextSharedLayout> &shared)
+    {
+        cache.insert(key, new QSharedPointer<QQuickTextSharedLayout>(shared), key.text.length() + 1);
+    }
+
+    QQuickTextLayoutTask *pendingTask(const QQuickTextLayoutKey &key) const
+    {
+        return pending.value(key);
+    }
+
+    void addPendingTask(QQuickTextLayoutTask *task)
+    {
+        pending.insert(task->key, task);
+    }
+
+    void removePendingTask(QQuickTextLayoutTask *task)
+    {
+        QHash<QQuickTextLayoutKey, QQuickTextLayoutTask *>::iterator it = pending.find(task->key);
+        if (it != pending.end() && it.value() == task)
+            pending.erase(it);
+    }
+
+    void clear()
+    {
+        cache.clear();
+        // Tasks already running may have resolved the old fonts, so don't cache their results.
+        for (QHash<QQuickTextLayoutKey, QQuickTextLayoutTask *>::const_iterator it = pending.constBegin();
+                it != pending.constEnd(); ++it) {
+            it.value()->cacheable = false;
+        }
+        pending.clear();
+    }
+
+private:
+    QCache<QQuickTextLayoutKey, QSharedPointer<QQuickTextSharedLayout> > cache;
+    // Tasks still laying out a cacheable text, so that items asking for the same text in
+    // the meantime wait for the same result.
+    QHash<QQuickTextLayoutKey, QQuickTextLayoutTask *> pending;
+};
+
+Q_GLOBAL_STATIC(QQuickTextLayoutCache, textLayoutCache)
+
+static void clearTextLayoutCache()
+{
+    if (textLayoutCache.exists())
+        textLayoutCache()->clear();
+}
+
 QQuickTextPrivate::QQuickTextPrivate()
-    : elideLayout(0), textLine(0), lineWidth(0)
+    : elideLayout(0), layoutTask(0), textLine(0), lineWidth(0)
     , color(0xFF000000), linkColor(0xFF0000FF), styleColor(0xFF000000)
     , lineCount(1), multilengthEos(-1)
     , elideMode(QQuickText::ElideNone), hAlign(QQuickText::AlignLeft), vAlign(QQuickText::AlignTop)
@@ -87,6 +162,7 @@ QQuickTextPrivate::QQuickTextPrivate()
     , requireImplicitSize(false), implicitWidthValid(false), implicitHeightValid(false)
     , truncated(false), hAlignImplicit(true), rightToLeftText(false)
     , layoutTextElided(false), textHasChanged(true), needToUpdateLayout(false), formatModifiesFontSize(false)
+    , asynchronous(false)
 {
 }
 
@@ -269,6 +345,7 @@ QSet<QUrl> QQuickTextDocumentWithImageResources::errors;
 
 QQuickTextPrivate::~QQuickTextPrivate()
 {
+    cancelAsynchronousLayout();
     delete elideLayout;
     delete textLine; textLine = 0;
     qDeleteAll(imgTags);
@@ -421,6 +498,9 @@ void QQuickTextPrivate::updateSize()
         return;
     }
 
+    // Any layout started before this point is out of date.
+    cancelAsynchronousLayout();
+
     if (!requireImplicitSize) {
         emit q->implicitWidthChanged();
         emit q->implicitHeightChanged();
@@ -453,6 +533,34 @@ void QQuickTextPrivate::updateSize()
     QSizeF size(0, 0);
     QSizeF previousSize = layedOutTextRect.size();
 
+    if (canLayoutAsynchronously()) {
+        // Plain texts are shared between items, so if another item has already laid out the
+        // same text its layout is used immediately.
+        const QQuickTextLayoutKey key = layoutKey();
+        const bool cacheable = layout.additionalFormats().isEmpty();
+        QSharedPointer<QQuickTextSharedLayout> shared;
+        if (cacheable)
+            shared = textLayoutCache()->find(key);
+
+        // A small caps font keeps a second QFontPrivate which copies of it still share, so
+        // it can't be handed to a pool thread.
+        if (!shared && asynchronous && font.capitalization() != QFont::SmallCaps) {
+            // The size and paint node are updated once the layout task has finished.
+            startAsynchronousLayout(key, cacheable);
+            return;
+        }
+        if (!shared && cacheable) {
+            shared = QSharedPointer<QQuickTextSharedLayout>(
+                        new QQuickTextSharedLayout(key, QList<QTextLayout::FormatRange>()));
+            textLayoutCache()->insert(key, shared);
+        }
+        if (shared) {
+            applySharedLayout(shared);
+            return;
+        }
+    }
+    sharedLayout.clear();
+
     //setup instance of QTextLayout for all cases other than richtext
     if (!richText) {
         qreal baseline = 0;
@@ -526,6 +634,271 @@ void QQuickTextPrivate::updateSize()
     q->update();
 }
 
+/*
+    Returns true if the text can be laid out by a QQuickTextSharedLayout.
+
+    Only plain and styled text whose lines depend on nothing but the font, the wrapping width
+    and the line height qualifies.  Eliding, font size fitting, maximum line counts, abbreviated
+    strings, inline images and custom line geometry all need the item while lines are created.
+*/
+bool QQuickTextPrivate::canLayoutAsynchronously()
+{
+    return !richText
+            && multilengthEos == -1
+            && imgTags.isEmpty()
+            && elideMode == QQuickText::ElideNone
+            && !maximumLineCountValid
+            && fontSizeMode() == QQuickText::FixedSize
+            && !isLineLaidOutConnected();
+}
+
+QQuickTextLayoutKey QQuickTextPrivate::layoutKey()
+{
+    Q_Q(QQuickText);
+
+    QQuickTextLayoutKey key;
+    key.text = layout.text();
+    key.font = font;
+    key.alignment = Qt::Alignment(q->effectiveHAlign());
+    key.wrapMode = QTextOption::WrapMode(wrapMode);
+    key.lineWidth = q->widthValid() && q->width() > 0 ? q->width() : FLT_MAX;
+    key.lineHeight = lineHeight();
+    key.lineHeightMode = lineHeightMode();
+    key.useDesignMetrics = renderType != QQuickText::NativeRendering;
+    key.relayoutToNaturalWidth = !q->widthValid() && q->effectiveHAlign() != QQuickText::AlignLeft;
+    return key;
+}
+
+void QQuickTextPrivate::startAsynchronousLayout(const QQuickTextLayoutKey &key, bool cacheable)
+{
+    QQuickTextLayoutTask *task = cacheable ? textLayoutCache()->pendingTask(key) : 0;
+    if (!task) {
+        task = new QQuickTextLayoutTask;
+        task->key = key;
+        // The item's font shares its QFontPrivate, which resolves font engines lazily and isn't
+        // thread safe, so give the task a private copy.  Setting a property detaches the font.
+        task->key.font.setKerning(key.font.kerning());
+        task->formats = layout.additionalFormats();
+        task->cacheable = cacheable;
+        if (cacheable)
+            textLayoutCache()->addPendingTask(task);
+        QThreadPool::globalInstance()->start(task);
+    }
+    task->addItem(this);
+    layoutTask = task;
+}
+
+void QQuickTextPrivate::cancelAsynchronousLayout()
+{
+    if (layoutTask) {
+        layoutTask->removeItem(this);
+        layoutTask = 0;
+    }
+}
+
+void QQuickTextPrivate::applySharedLayout(const QSharedPointer<QQuickTextSharedLayout> &shared)
+{
+    Q_Q(QQuickText);
+
+    sharedLayout = shared;
+    layout.clearLayout();
+    delete elideLayout;
+    elideLayout = 0;
+
+    const QSizeF previousSize = layedOutTextRect.size();
+    const bool wasTruncated = truncated;
+
+    layedOutTextRect = shared->boundingRect;
+    lineWidth = q->widthValid() && q->width() > 0 ? q->width() : shared->naturalWidth;
+    widthExceeded = shared->wrapped || (q->widthValid() && q->width() <= 0 && wrapMode != QQuickText::NoWrap);
+    heightExceeded = false;
+    truncated = false;
+
+    const bool wasInLayout = internalWidthUpdate;
+    internalWidthUpdate = true;
+    q->setImplicitSize(shared->naturalWidth, layedOutTextRect.height());
+    internalWidthUpdate = wasInLayout;
+    implicitWidthValid = true;
+    implicitHeightValid = true;
+
+    updateBaseline(shared->baseline, q->height() - layedOutTextRect.height());
+
+    if (lineCount != shared->lineCount) {
+        lineCount = shared->lineCount;
+        emit q->lineCountChanged();
+    }
+    if (wasTruncated)
+        emit q->truncatedChanged();
+    if (layedOutTextRect.size() != previousSize)
+        emit q->contentSizeChanged();
+
+    updateType = UpdatePaintNode;
+    q->update();
+}
+
+QTextLayout *QQuickTextPrivate::textLayout()
+{
+    return sharedLayout ? &sharedLayout->layout : &layout;
+}
+
+const QTextLayout *QQuickTextPrivate::textLayout() const
+{
+    return sharedLayout ? &sharedLayout->layout : &layout;
+}
+
+QQuickTextLayoutKey::QQuickTextLayoutKey()
+    : alignment(Qt::AlignLeft)
+    , wrapMode(QTextOption::NoWrap)
+    , lineWidth(FLT_MAX)
+    , lineHeight(1.0)
+    , lineHeightMode(QQuickText::ProportionalHeight)
+    , useDesignMetrics(true)
+    , relayoutToNaturalWidth(false)
+{
+}
+
+bool QQuickTextLayoutKey::operator==(const QQuickTextLayoutKey &other) const
+{
+    return text == other.text
+            && alignment == other.alignment
+            && wrapMode == other.wrapMode
+            && lineWidth == other.lineWidth
+            && lineHeight == other.lineHeight
+            && lineHeightMode == other.lineHeightMode
+            && useDesignMetrics == other.useDesignMetrics
+            && relayoutToNaturalWidth == other.relayoutToNaturalWidth
+            && font == other.font;
+}
+
+uint qHash(const QQuickTextLayoutKey &key, uint seed)
+{
+    return qHash(key.text, seed)
+            ^ qHash(key.font.family(), seed)
+            ^ uint(key.font.pixelSize())
+            ^ (uint(key.font.pointSizeF() * 64) << 8)
+            ^ (uint(key.alignment) << 16)
+            ^ (uint(key.wrapMode) << 24);
+}
+
+QQuickTextSharedLayout::QQuickTextSharedLayout(
+        const QQuickTextLayoutKey &key, const QList<QTextLayout::FormatRange> &formats)
+    : layout(key.text, key.font)
+    , naturalWidth(0)
+    , baseline(0)
+    , lineCount(0)
+    , wrapped(false)
+{
+    QTextOption textOption;
+    textOption.setAlignment(key.alignment);
+    textOption.setWrapMode(key.wrapMode);
+    textOption.setUseDesignMetrics(key.useDesignMetrics);
+
+    layout.setCacheEnabled(true);
+    layout.setTextOption(textOption);
+    layout.setAdditionalFormats(formats);
+
+    // The implicit width of wrapped text is the width it would have on unwrapped lines, so
+    // when a line width is given lay out without one first to find it.
+    const bool constrained = key.wrapMode != QTextOption::NoWrap && key.lineWidth < FLT_MAX;
+    if (constrained) {
+        layoutLines(key, FLT_MAX);
+        naturalWidth = layout.maximumWidth();
+    }
+    layoutLines(key, key.lineWidth);
+    if (!constrained)
+        naturalWidth = layout.maximumWidth();
+
+    // Lines that aren't left aligned are positioned within the line width, so once the
+    // natural width is known lay out again using it.
+    if (key.relayoutToNaturalWidth && lineCount > 1)
+        layoutLines(key, naturalWidth);
+
+    const QTextLine firstLine = layout.lineAt(0);
+    if (firstLine.isValid())
+        baseline = firstLine.y() + firstLine.ascent();
+}
+
+qreal QQuickTextSharedLayout::layoutLines(const QQuickTextLayoutKey &key, qreal width)
+{
+    qreal height = 0;
+    boundingRect = QRectF();
+    lineCount = 0;
+    wrapped = false;
+
+    layout.beginLayout();
+    for (QTextLine line = layout.createLine(); line.isValid(); line = layout.createLine()) {
+        line.setLineWidth(width);
+        line.setPosition(QPointF(line.position().x(), height));
+        height += key.lineHeightMode == QQuickText::FixedHeight
+                ? key.lineHeight
+                : line.height() * key.lineHeight;
+
+        boundingRect = boundingRect.united(line.naturalTextRect());
+        if (line.textStart() > 0 && key.text.at(line.textStart() - 1) != QChar::LineSeparator)
+            wrapped = true;
+        ++lineCount;
+    }
+    layout.endLayout();
+
+    boundingRect.moveTop(0);
+    boundingRect.setHeight(height);
+    return height;
+}
+
+QQuickTextLayoutTask::QQuickTextLayoutTask()
+    : cacheable(false)
+{
+    setAutoDelete(false);
+    // finished() is emitted from a pool thread, the result is delivered on the GUI thread.
+    connect(this, SIGNAL(finished()), this, SLOT(deliver()), Qt::QueuedConnection);
+}
+
+void QQuickTextLayoutTask::run()
+{
+    if (!cancelled.load())
+        result = QSharedPointer<QQuickTextSharedLayout>(new QQuickTextSharedLayout(key, formats));
+    emit finished();
+}
+
+void QQuickTextLayoutTask::addItem(QQuickTextPrivate *item)
+{
+    items.append(item);
+}
+
+void QQuickTextLayoutTask::removeItem(QQuickTextPrivate *item)
+{
+    items.removeOne(item);
+    if (items.isEmpty()) {
+        cancelled.store(1);
+        if (cacheable)
+            textLayoutCache()->removePendingTask(this);
+    }
+}
+
+void QQuickTextLayoutTask::deliver()
+{
+    // The font engines used to shape the text belong to the pool thread's font cache.  The
+    // layout's font drops them for engines from this thread's cache the next time it is asked
+    // for one, but the text engine keeps a reference to the last engine it used.
+    if (result)
+        result->layout.engine()->resetFontEngineCache();
+
+    if (cacheable) {
+        textLayoutCache()->removePendingTask(this);
+        if (result)
+            textLayoutCache()->insert(key, result);
+    }
+
+    // Applying the layout emits signals whose handlers may cancel the layout of other items
+    // waiting on this task, so take them from the list one at a time.
+    while (!items.isEmpty()) {
+        QQuickTextPrivate *item = items.takeFirst();
+        item->layoutTask = 0;
+        item->applySharedLayout(result);
+    }
+    deleteLater();
+}
+
 QQuickTextLine::QQuickTextLine()
     : QObject(), m_line(0), m_height(0)
 {
@@ -2218,7 +2591,7 @@ QSGNode *QQuickText::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *data
         if (unelidedLineCount > 0) {
             node->addTextLayout(
                         QPointF(dx, dy),
-                        &d->layout,
+                        d->textLayout(),
                         color, d->style, styleColor, linkColor,
                         QColor(), QColor(), -1, -1,
                         0, unelidedLineCount);
@@ -2482,7 +2855,7 @@ QString QQuickTextPrivate::anchorAt(const QPointF &mousePos) const
     QPointF translatedMousePos = mousePos;
     translatedMousePos.ry() -= QQuickTextUtil::alignedY(layedOutTextRect.height(), q->height(), vAlign);
     if (styledText) {
-        QString link = anchorAt(&layout, translatedMousePos);
+        QString link = anchorAt(textLayout(), translatedMousePos);
         if (link.isEmpty() && elideLayout)
             link = anchorAt(elideLayout, translatedMousePos);
         return link;
@@ -2669,4 +3042,45 @@ void QQuickText::doLayout()
     d->updateSize();
 }
 
+/*!
+    \qmlproperty bool QtQuick::Text::asynchronous
+    \since 5.2
+
+    This property holds whether the text is laid out in a separate thread.  The default
+    value is false, in which case the text is laid out synchronously whenever its content
+    or geometry changes.
+
+    When set to true, line breaking and shaping of plain and styled text is performed by a
+    worker thread, and the implicit size, content size, lineCount and baselineOffset of the
+    item are only updated once that layout has finished.  Text that is elided, fitted to the
+    item size, limited to a maximumLineCount, contains inline images, uses a small caps
+    font or is formatted as RichText is always laid out synchronously.
+
+    Items laying out identical plain text with the same font, width and alignment share a
+    single layout whether or not they are asynchronous, so repeated labels in a view are
+    only laid out once.  An asynchronous item whose text has already been laid out is
+    sized immediately.
+
+    Setting \a asynchronous to true is useful when a large number of long texts, for example
+    in the delegates of a view, would otherwise delay the first frame they appear in.
+*/
+bool QQuickText::asynchronous() const
+{
+    Q_D(const QQuickText);
+    return d->asynchronous;
+}
+
+void QQuickText::setAsynchronous(bool asynchronous)
+{
+    Q_D(QQuickText);
+    if (d->asynchronous == asynchronous)
+        return;
+
+    d->asynchronous = asynchronous;
+    emit asynchronousChanged();
+
+    if (isComponentComplete() && d->layoutTask)
+        d->updateSize();    // Finish the outstanding layout synchronously.
+}
+
 QT_END_NAMESPACE
@@ -59,6 +59,8 @@
 #include <QtQml/qqml.h>
 #include <QtGui/qabstracttextdocumentlayout.h>
 #include <QtGui/qtextlayout.h>
+#include <QtCore/qrunnable.h>
+#include <QtCore/qsharedpointer.h>
 #include <private/qquickstyledtext_p.h>
 #include <private/qlazilyallocated_p.h>
 
@@ -66,6 +68,9 @@ QT_BEGIN_NAMESPACE
 
 class QTextLayout;
 class QQuickTextDocumentWithImageResources;
+struct QQuickTextLayoutKey;
+class QQuickTextSharedLayout;
+class QQuickTextLayoutTask;
 
 class Q_AUTOTEST_EXPORT QQuickTextPrivate : public QQuickImplicitSizeItemPrivate
 {
@@ -89,6 +94,16 @@ public:
 
     void processHoverEvent(QHoverEvent *event);
 
+    bool canLayoutAsynchronously();
+    QQuickTextLayoutKey layoutKey();
+    void startAsynchronousLayout(const QQuickTextLayoutKey &key, bool cacheable);
+    void cancelAsynchronousLayout();
+    void applySharedLayout(const QSharedPointer<QQuickTextSharedLayout> &shared);
+
+    // The layout of the unelided lines, either the item's own or one shared with other items.
+    QTextLayout *textLayout();
+    const QTextLayout *textLayout() const;
+
     QRectF layedOutTextRect;
 
     struct ExtraData {
@@ -116,6 +131,8 @@ public:
 
     QTextLayout layout;
     QTextLayout *elideLayout;
+    QSharedPointer<QQuickTextSharedLayout> sharedLayout;
+    QQuickTextLayoutTask *layoutTask;
     QQuickTextLine *textLine;
 
     qreal lineWidth;
@@ -159,6 +176,7 @@ public:
     bool textHasChanged:1;
     bool needToUpdateLayout:1;
     bool formatModifiesFontSize:1;
+    bool asynchronous:1;
 
     static const QChar elideChar;
 
@@ -183,6 +201,78 @@ public:
     static inline QQuickTextPrivate *get(QQuickText *t) { return t->d_func(); }
 };
 
+struct QQuickTextLayoutKey
+{
+    QQuickTextLayoutKey();
+
+    QString text;
+    QFont font;
+    Qt::Alignment alignment;
+    QTextOption::WrapMode wrapMode;
+    qreal lineWidth;
+    qreal lineHeight;
+    QQuickText::LineHeightMode lineHeightMode;
+    bool useDesignMetrics;
+    bool relayoutToNaturalWidth;
+
+    bool operator==(const QQuickTextLayoutKey &other) const;
+};
+
+uint qHash(const QQuickTextLayoutKey &key, uint seed = 0);
+
+// The laid out lines of a text and the metrics derived from them.  Once created an instance is
+// never modified, so it can be shared by every item displaying the same text.
+class QQuickTextSharedLayout
+{
+public:
+    QQuickTextSharedLayout(const QQuickTextLayoutKey &key, const QList<QTextLayout::FormatRange> &formats);
+
+    QTextLayout layout;
+    QRectF boundingRect;
+    qreal naturalWidth;
+    qreal baseline;
+    int lineCount;
+    bool wrapped;
+
+private:
+    qreal layoutLines(const QQuickTextLayoutKey &key, qreal width);
+};
+
+// Lays out a text on a pool thread.  Items waiting for the same cacheable text share a single
+// task, which hands its result to each of them once it has finished.
+//
+// The task only reads its own inputs, and its font doesn't share a QFontPrivate with any
+// item, so font engines are resolved from the pool thread's font cache without touching
+// objects used by the GUI thread.  Once delivered, the layout is only used on the GUI thread,
+// which resolves its font engines again from its own cache.
+class QQuickTextLayoutTask : public QObject, public QRunnable
+{
+    Q_OBJECT
+public:
+    QQuickTextLayoutTask();
+
+    void run();
+
+    void addItem(QQuickTextPrivate *item);
+    void removeItem(QQuickTextPrivate *item);
+
+    // Inputs, copied from the item on the GUI thread before the task is started.
+    QQuickTextLayoutKey key;
+    QList<QTextLayout::FormatRange> formats;
+    bool cacheable;
+
+Q_SIGNALS:
+    void finished();
+
+private Q_SLOTS:
+    void deliver();
+
+private:
+    QSharedPointer<QQuickTextSharedLayout> result;
+    QList<QQuickTextPrivate *> items;
+    QAtomicInt cancelled;
+};
+
 class QQuickPixmap;
 class QQuickTextDocumentWithImageResources : public QTextDocument, public QTextObjectInterface
 {
@@ -1769,16 +1769,103 @@ QSGNode *QQuickTextEdit::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *
 
     d->updateType = QQuickTextEditPrivate::UpdateNone;
 
-    if (!oldNode) // If we had any text node references, they were deleted along with the root node
+    if (oldNode && d->resetTextNodes) {
+        delete oldNode;
+        oldNode = 0;
+    }
+    d->resetTextNodes = false;
+
+    if (!oldNode) { // If we had any text node references, they were deleted along with the root node
+        qDeleteAll(d->textNodeMap);
         d->textNodeMap.clear();
+    }
 
     RootNode *rootNode = static_cast<RootNode *>(oldNode);
     TextNodeIterator nodeIterator = d->textNodeMap.begin();
     while (nodeIterator != d->textNodeMap.end() && !(*nodeIterator)->dirty())
         ++nodeIterator;
 
+    if (!oldNode && d->viewport.isValid()) {
+        rootNode = new RootNode;
+        rootNode->resetFrameDecorations(d->createTextNode());
+
+        // Render the viewport plus its own height above and below it, so short scrolls don't
+        // need new nodes.
+        d->renderedRect = d->viewport.adjusted(0, -d->viewport.height(), 0, d->viewport.height());
+
+        const QPointF basePosition(d->xoff, d->yoff);
+        const QRectF documentRect = d->renderedRect.translated(-basePosition);
+        QAbstractTextDocumentLayout *documentLayout = d->document->documentLayout();
+
+        QList<QTextFrame *> frames;
+        frames.append(d->document->rootFrame());
+        while (!frames.isEmpty()) {
+            QTextFrame *textFrame = frames.takeFirst();
+            if (!documentLayout->frameBoundingRect(textFrame).intersects(documentRect))
+                continue;
+            frames.append(textFrame->childFrames());
+            rootNode->frameDecorationsNode->m_engine->addFrameDecorations(d->document, textFrame);
+
+            if (textFrame->firstPosition() > textFrame->lastPosition()
+                    && textFrame->frameFormat().position() != QTextFrameFormat::InFlow) {
+                QQuickTextNode *node = d->createTextNode();
+                updateNodeTransform(node, documentLayout->frameBoundingRect(textFrame).topLeft());
+                const int pos = textFrame->firstPosition() - 1;
+                ProtectedLayoutAccessor *a = static_cast<ProtectedLayoutAccessor *>(documentLayout);
+                QTextCharFormat format = a->formatAccessor(pos);
+                QTextBlock block = textFrame->firstCursorPosition().block();
+                node->m_engine->setCurrentLine(block.layout()->lineForTextPosition(pos - block.position()));
+                node->m_engine->addTextObject(QPointF(0, 0), format, QQuickTextNodeEngine::Unselected, d->document,
+                                              pos, textFrame->frameFormat().position());
+                nodeIterator = d->textNodeMap.end();
+                d->addCurrentTextNodeToRoot(rootNode, node, nodeIterator, pos);
+            }
+        }
+
+        // Blocks are laid out top to bottom, so start from the block at the top of the rendered
+        // rect, stepping back over any earlier table cells on the same row.
+        QTextBlock block = d->document->findBlock(qMax(0, documentLayout->hitTest(
+                QPointF(qMax<qreal>(0, documentRect.left()), qMax<qreal>(0, documentRect.top())), Qt::FuzzyHit)));
+        while (block.previous().isValid()
+                && documentLayout->blockBoundingRect(block.previous()).bottom() > documentRect.top()) {
+            block = block.previous();
+        }
+
+        QQuickTextNode *node = d->createTextNode();
+        int currentNodeSize = 0;
+        int nodeStart = block.position();
+        QPointF nodeOffset;
+        for (; block.isValid(); block = block.next()) {
+            const QRectF blockRect = documentLayout->blockBoundingRect(block);
+            if (blockRect.top() > documentRect.bottom())
+                break;
+            if (!blockRect.intersects(documentRect))
+                continue;
+
+            if (!node->m_engine->hasContents()) {
+                nodeOffset = blockRect.topLeft();
+                updateNodeTransform(node, nodeOffset);
+                nodeStart = block.position();
+            }
+
+            node->m_engine->addTextBlock(d->document, block, basePosition - nodeOffset, d->color, QColor(), selectionStart(), selectionEnd() - 1);
+            currentNodeSize += block.length();
+
+            if (currentNodeSize > nodeBreakingSize) {
+                currentNodeSize = 0;
+                nodeIterator = d->textNodeMap.end();
+                d->addCurrentTextNodeToRoot(rootNode, node, nodeIterator, nodeStart);
+                node = d->createTextNode();
+            }
+        }
+        nodeIterator = d->textNodeMap.end();
+        d->addCurrentTextNodeToRoot(rootNode, node, nodeIterator, nodeStart);
+
+        rootNode->frameDecorationsNode->m_engine->addToSceneGraph(rootNode->frameDecorationsNode, QQuickText::Normal, QColor());
+        rootNode->prependChildNode(rootNode->frameDecorationsNode);
 
-    if (!oldNode || nodeIterator < d->textNodeMap.end()) {
+        std::sort(d->textNodeMap.begin(), d->textNodeMap.end(), &comesBefore);
+    } else if (!oldNode || nodeIterator < d->textNodeMap.end()) {
 
         if (!oldNode)
             rootNode = new RootNode;
@@ -1805,11 +1892,18 @@ QSGNode *QQuickTextEdit::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *
         QPointF nodeOffset;
         TextNode *firstCleanNode = (nodeIterator != d->textNodeMap.end()) ? *nodeIterator : 0;
 
+        // With a viewport only the nodes around it exist, so patch those and don't create nodes
+        // past the end of the rendered area.
+        const bool inViewport = d->viewport.isValid();
+        const QRectF documentRect = d->renderedRect.translated(-basePosition);
+
         QList<QTextFrame *> frames;
         frames.append(d->document->rootFrame());
 
         while (!frames.isEmpty()) {
             QTextFrame *textFrame = frames.takeFirst();
+            if (inViewport && !d->document->documentLayout()->frameBoundingRect(textFrame).intersects(documentRect))
+                continue;
             frames.append(textFrame->childFrames());
             rootNode->frameDecorationsNode->m_engine->addFrameDecorations(d->document, textFrame);
 
@@ -1850,6 +1944,10 @@ QSGNode *QQuickTextEdit::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *
                     ++it;
                     if (block.position() < firstDirtyPos)
                         continue;
+                    if (inViewport && !firstCleanNode
+                            && d->document->documentLayout()->blockBoundingRect(block).top() > documentRect.bottom()) {
+                        break;
+                    }
 
                     if (!node->m_engine->hasContents()) {
                         nodeOffset = d->document->documentLayout()->blockBoundingRect(block).topLeft();
@@ -1891,6 +1989,14 @@ QSGNode *QQuickTextEdit::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *
                 ++nodeIterator;
             }
 
+            // Text moving up leaves the bottom of the rendered area without nodes.
+            if (inViewport && delta.y() < 0)
+                d->renderedRect.setBottom(d->renderedRect.bottom() + delta.y());
+        }
+
+        if (inViewport && !d->renderedRect.contains(d->viewport)) {
+            delete rootNode;
+            return updatePaintNode(0, updatePaintNodeData);
         }
 
         // Since we iterate over blocks from different text frames that are potentially not sorted
@@ -2071,6 +2177,10 @@ void QQuickTextEdit::q_contentsChange(int pos, int charsRemoved, int charsAdded)
     const int editRange = pos + qMax(charsAdded, charsRemoved);
     const int delta = charsAdded - charsRemoved;
 
+    // An edit before the nodes around the viewport can move the text inside them, so they
+    // are rebuilt.  Other edits only need the nodes they touch to be patched.
+    if (d->viewport.isValid() && (d->textNodeMap.isEmpty() || pos < d->textNodeMap.first()->startPos()))
+        d->resetTextNodes = true;
     markDirtyNodesForRange(pos, editRange, delta);
 
     if (isComponentComplete()) {
@@ -2238,6 +2348,8 @@ void QQuickTextEdit::updateWholeDocument()
         Q_FOREACH (TextNode* node, d->textNodeMap)
             node->setDirty();
     }
+    if (d->viewport.isValid())
+        d->resetTextNodes = true;
 
     if (isComponentComplete()) {
         d->updateType = QQuickTextEditPrivate::UpdatePaintNode;
@@ -2548,6 +2660,68 @@ QString QQuickTextEdit::hoveredLink() const
     return QString();
 }
 
+/*!
+    \qmlproperty rect QtQuick::TextEdit::viewport
+    \since 5.2
+
+    This property holds the part of the TextEdit, in its own coordinates, that is
+    currently visible.  By default it is an empty rectangle and the whole document is
+    rendered.
+
+    When a viewport is set, only the text blocks within it, and within one viewport
+    height above and below it, are rendered.  This keeps the cost of displaying very
+    large documents proportional to the visible text rather than the document size.
+    Moving the viewport within that area reuses the existing rendering.
+
+    This is typically bound to the visible area of an enclosing Flickable:
+
+    \code
+    Flickable {
+        id: flick
+        anchors.fill: parent
+        contentWidth: edit.paintedWidth
+        contentHeight: edit.paintedHeight
+        clip: true
+
+        TextEdit {
+            id: edit
+            width: flick.width
+            wrapMode: TextEdit.Wrap
+            viewport: Qt.rect(flick.contentX, flick.contentY, flick.width, flick.height)
+        }
+    }
+    \endcode
+*/
+QRectF QQuickTextEdit::viewport() const
+{
+    Q_D(const QQuickTextEdit);
+    return d->viewport;
+}
+
+void QQuickTextEdit::setViewport(const QRectF &viewport)
+{
+    Q_D(QQuickTextEdit);
+    if (d->viewport == viewport)
+        return;
+
+    const bool wasValid = d->viewport.isValid();
+    d->viewport = viewport;
+    emit viewportChanged();
+
+    if (viewport.isValid() != wasValid || (viewport.isValid() && !d->renderedRect.contains(viewport))) {
+        d->resetTextNodes = true;
+        if (isComponentComplete()) {
+            d->updateType = QQuickTextEditPrivate::UpdatePaintNode;
+            update();
+        }
+    }
+}
+
+void QQuickTextEdit::resetViewport()
+{
+    setViewport(QRectF());
+}
+
 void QQuickTextEdit::hoverEnterEvent(QHoverEvent *event)
 {
     Q_D(QQuickTextEdit);
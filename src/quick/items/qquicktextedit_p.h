@@ -103,6 +103,7 @@ class Q_QUICK_PRIVATE_EXPORT QQuickTextEdit : public QQuickImplicitSizeItem
     Q_PROPERTY(RenderType renderType READ renderType WRITE setRenderType NOTIFY renderTypeChanged)
     Q_PROPERTY(QQuickTextDocument *textDocument READ textDocument FINAL REVISION 1)
     Q_PROPERTY(QString hoveredLink READ hoveredLink NOTIFY linkHovered REVISION 2)
+    Q_PROPERTY(QRectF viewport READ viewport WRITE setViewport RESET resetViewport NOTIFY viewportChanged REVISION 3)
 
 public:
     QQuickTextEdit(QQuickItem *parent=0);
@@ -258,6 +259,10 @@ public:
 
     QString hoveredLink() const;
 
+    QRectF viewport() const;
+    void setViewport(const QRectF &viewport);
+    void resetViewport();
+
 Q_SIGNALS:
     void textChanged();
     void contentSizeChanged();
@@ -286,6 +291,7 @@ Q_SIGNALS:
     void mouseSelectionModeChanged(SelectionMode mode);
     void linkActivated(const QString &link);
     Q_REVISION(2) void linkHovered(const QString &link);
+    Q_REVISION(3) void viewportChanged();
     void canPasteChanged();
     void canUndoChanged();
     void canRedoChanged();
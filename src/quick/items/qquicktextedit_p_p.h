@@ -107,7 +107,7 @@ public:
         , focusOnPress(true), persistentSelection(false), requireImplicitWidth(false)
         , selectByMouse(false), canPaste(false), canPasteValid(false), hAlignImplicit(true)
         , textCached(true), inLayout(false), selectByKeyboard(false), selectByKeyboardSet(false)
-        , hadSelection(false)
+        , hadSelection(false), resetTextNodes(false)
     {
     }
 
@@ -156,6 +156,9 @@ public:
     QQuickTextDocument *quickDocument;
     QList<Node*> textNodeMap;
 
+    QRectF viewport;
+    QRectF renderedRect;
+
     int lastSelectionStart;
     int lastSelectionEnd;
     int lineCount;
@@ -194,6 +197,7 @@ public:
     bool selectByKeyboard:1;
     bool selectByKeyboardSet:1;
     bool hadSelection : 1;
+    bool resetTextNodes : 1;
 };
 
 QT_END_NAMESPACE
@@ -44,6 +44,7 @@
 
 #include "qquickitem.h"
 #include "qquickitem_p.h"
+#include "qquickanchors_p_p.h"
 #include "qquickevents_p_p.h"
 
 #include <private/qquickdrag_p.h>
@@ -78,6 +79,12 @@ extern Q_GUI_EXPORT QImage qt_gl_read_framebuffer(const QSize &size, bool alpha_
 
 bool QQuickWindowPrivate::defaultAlphaBuffer(0);
 
+// Prune mouse press and hover delivery with a cache of per-subtree target bounds
+static bool qquickwindow_hit_test_index = qEnvironmentVariableIsSet("QML_HIT_TEST_INDEX");
+
+// Defer anchor propagation to the polish pass and resolve it in dependency order
+static bool qquickwindow_batched_anchors = qEnvironmentVariableIsSet("QML_BATCHED_ANCHORS");
+
 void QQuickWindowPrivate::updateFocusItemTransform()
 {
     Q_Q(QQuickWindow);
@@ -259,7 +266,11 @@ void QQuickWindowPrivate::polishItems()
 {
     int maxPolishCycles = 100000;
 
-    while (!itemsToPolish.isEmpty() && --maxPolishCycles > 0) {
+    while ((!itemsToPolish.isEmpty() || !itemsToAnchor.isEmpty()) && --maxPolishCycles > 0) {
+        // anchors first, so items are polished with their final geometry
+        if (!itemsToAnchor.isEmpty())
+            QQuickAnchorsPrivate::resolveScheduledAnchors(itemsToAnchor);
+
         QSet<QQuickItem *> itms = itemsToPolish;
         itemsToPolish.clear();
 
@@ -400,6 +411,8 @@ QQuickWindowPrivate::QQuickWindowPrivate()
     , persistentSceneGraph(true)
     , lastWheelEventAccepted(false)
     , componentCompleted(true)
+    , hitTestIndexEnabled(qquickwindow_hit_test_index)
+    , batchedAnchorsEnabled(qquickwindow_batched_anchors)
     , renderTarget(0)
     , renderTargetId(0)
     , incubationController(0)
@@ -1358,11 +1371,16 @@ bool QQuickWindowPrivate::deliverInitialMousePressEvent(QQuickItem *item, QMouse
             return false;
     }
 
+    QPointF p;
+    if (hitTestIndexEnabled)
+        p = item->mapFromScene(event->windowPos());
     QList<QQuickItem *> children = itemPrivate->paintOrderChildItems();
     for (int ii = children.count() - 1; ii >= 0; --ii) {
         QQuickItem *child = children.at(ii);
         if (!child->isVisible() || !child->isEnabled() || QQuickItemPrivate::get(child)->culled)
             continue;
+        if (hitTestIndexEnabled && !mayContainHitTarget(child, p))
+            continue;
         if (deliverInitialMousePressEvent(child, event))
             return true;
     }
@@ -1385,6 +1403,89 @@ bool QQuickWindowPrivate::deliverInitialMousePressEvent(QQuickItem *item, QMouse
     return false;
 }
 
+/*
+    When enabled, a geometry change of an anchor target no longer updates the
+    anchored items immediately.  They are queued in itemsToAnchor instead and
+    resolved once per polishItems() pass, see QQuickAnchorsPrivate::scheduleUpdate().
+*/
+void QQuickWindowPrivate::setBatchedAnchorsEnabled(bool enabled)
+{
+    batchedAnchorsEnabled = enabled;
+    if (!enabled && !itemsToAnchor.isEmpty())
+        QQuickAnchorsPrivate::resolveScheduledAnchors(itemsToAnchor);
+}
+
+void QQuickWindowPrivate::setHitTestIndexEnabled(bool enabled)
+{
+    hitTestIndexEnabled = enabled;
+    if (!enabled)
+        hitTestIndex.clear();
+}
+
+/*
+    Returns the bounds, in the parent's coordinates, of \a item and those of its
+    visible descendants which accept mouse buttons or hover events, clipped where
+    an item clips its children.  Results are cached in hitTestIndex until
+    invalidateHitTestBounds() is called for the item or one of its descendants.
+
+    This assumes items only accept points inside their bounding rect, i.e. that
+    contains() is not reimplemented to extend past it.
+*/
+QRectF QQuickWindowPrivate::hitTestBounds(QQuickItem *item)
+{
+    QHash<QQuickItem *, QRectF>::const_iterator it = hitTestIndex.constFind(item);
+    if (it != hitTestIndex.constEnd())
+        return *it;
+
+    QQuickItemPrivate *itemPrivate = QQuickItemPrivate::get(item);
+    const QRectF itemRect(0, 0, itemPrivate->width, itemPrivate->height);
+    QRectF bounds;
+    if (itemPrivate->acceptedMouseButtons() || itemPrivate->hoverEnabled)
+        bounds = itemRect;
+    for (int ii = 0; ii < itemPrivate->childItems.count(); ++ii) {
+        QQuickItem *child = itemPrivate->childItems.at(ii);
+        if (QQuickItemPrivate::get(child)->effectiveVisible)
+            bounds |= hitTestBounds(child);
+    }
+    if (itemPrivate->flags & QQuickItem::ItemClipsChildrenToShape)
+        bounds &= itemRect;
+
+    if (!bounds.isEmpty() && item != contentItem) {
+        QTransform t;
+        itemPrivate->itemToParentTransform(t);
+        bounds = t.mapRect(bounds);
+    }
+    hitTestIndex.insert(item, bounds);
+    return bounds;
+}
+
+/*
+    Returns false if neither \a item nor any of its descendants can accept
+    a mouse press or hover event at \a parentPos.
+*/
+bool QQuickWindowPrivate::mayContainHitTarget(QQuickItem *item, const QPointF &parentPos)
+{
+    const QRectF bounds = hitTestBounds(item);
+    // allow for rounding in the mapped bounds; contains() decides exactly
+    return !bounds.isEmpty() && bounds.adjusted(-1, -1, 1, 1).contains(parentPos);
+}
+
+/*
+    Called by QQuickItemPrivate::dirty() when the geometry, transform,
+    visibility or children of \a item change.  A cached item implies cached
+    visible descendants, so invalidation can stop at the first uncached
+    ancestor.
+*/
+void QQuickWindowPrivate::invalidateHitTestBounds(QQuickItem *item)
+{
+    if (hitTestIndex.isEmpty())
+        return;
+    hitTestIndex.remove(item);
+    // the item may have just become visible, so always invalidate its parent
+    for (QQuickItem *parent = item->parentItem(); parent && hitTestIndex.remove(parent); parent = parent->parentItem())
+        ;
+}
+
 bool QQuickWindowPrivate::deliverMouseEvent(QMouseEvent *event)
 {
     Q_Q(QQuickWindow);
@@ -1521,11 +1622,16 @@ bool QQuickWindowPrivate::deliverHoverEvent(QQuickItem *item, const QPointF &sce
             return false;
     }
 
+    QPointF p;
+    if (hitTestIndexEnabled)
+        p = item->mapFromScene(scenePos);
     QList<QQuickItem *> children = itemPrivate->paintOrderChildItems();
     for (int ii = children.count() - 1; ii >= 0; --ii) {
         QQuickItem *child = children.at(ii);
         if (!child->isVisible() || !child->isEnabled() || QQuickItemPrivate::get(child)->culled)
             continue;
+        if (hitTestIndexEnabled && !mayContainHitTarget(child, p))
+            continue;
         if (deliverHoverEvent(child, scenePos, lastScenePos, modifiers, accepted))
             return true;
     }
@@ -160,6 +160,14 @@ public:
 #endif
 
     QList<QQuickItem*> hoverItems;
+
+    // Bounds of the mouse and hover targets in each item's subtree, in its parent's coordinates
+    QHash<QQuickItem *, QRectF> hitTestIndex;
+    void setHitTestIndexEnabled(bool enabled);
+    QRectF hitTestBounds(QQuickItem *item);
+    bool mayContainHitTarget(QQuickItem *item, const QPointF &parentPos);
+    void invalidateHitTestBounds(QQuickItem *item);
+
     enum FocusOption {
         DontChangeFocusProperty = 0x01,
         DontChangeSubFocusItem  = 0x02
@@ -189,6 +197,10 @@ public:
 
     QSet<QQuickItem *> itemsToPolish;
 
+    // Anchored items whose anchors are resolved in the next polishItems()
+    QSet<QQuickItem *> itemsToAnchor;
+    void setBatchedAnchorsEnabled(bool enabled);
+
     void updateDirtyNodes();
     void cleanupNodes();
     void cleanupNodesOnShutdown();
@@ -217,6 +229,8 @@ public:
 
     uint lastWheelEventAccepted : 1;
     bool componentCompleted : 1;
+    uint hitTestIndexEnabled : 1;
+    uint batchedAnchorsEnabled : 1;
 
     QOpenGLFramebufferObject *renderTarget;
     uint renderTargetId;
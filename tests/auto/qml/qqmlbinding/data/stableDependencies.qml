@@ -0,0 +1,10 @@
+import QtQuick 2.0
+
+Item {
+    property bool useFirst: true
+    property int first: 1
+    property int second: 100
+
+    // Math.max() keeps this a JavaScript binding
+    property int result: Math.max(0, useFirst ? first : second)
+}
@@ -0,0 +1,24 @@
+import QtQuick 2.0
+
+Rectangle {
+    id: root
+    width: 200
+    height: 100
+
+    property bool active: false
+    property string label: "item"
+    property real large: 3000000000
+    property int truncated: root.large
+    property real branch: root.active ? root.width : root.height
+
+    Rectangle {
+        id: inner
+        objectName: "inner"
+        width: parent.width - 10
+        height: root.height / 2
+        color: root.active ? "red" : "blue"
+        visible: root.width > 100 && !root.active
+        property string title: root.label + " " + inner.objectName
+        property real fallback: Math.max(root.width, 10)
+    }
+}
@@ -42,6 +42,8 @@
 #include <QtQml/qqmlengine.h>
 #include <QtQml/qqmlcomponent.h>
 #include <private/qqmlbind_p.h>
+#include <private/qqmlproperty_p.h>
+#include <private/qqmlabstractbinding_p.h>
 #include <QtQuick/private/qquickrectangle_p.h>
 #include "../../shared/util.h"
 
@@ -58,6 +60,8 @@ private slots:
     void restoreBindingWithLoop();
     void restoreBindingWithoutCrash();
     void deletedObject();
+    void typedBindings();
+    void stableDependencies();
 
 private:
     QQmlEngine engine;
@@ -232,6 +236,97 @@ void tst_qqmlbinding::deletedObject()
     delete rect;
 }
 
+void tst_qqmlbinding::typedBindings()
+{
+    QQmlEngine engine;
+    QQmlComponent c(&engine, testFileUrl("typedBindings.qml"));
+    QQuickRectangle *rect = qobject_cast<QQuickRectangle*>(c.create());
+    QVERIFY(rect != 0);
+
+    QQuickRectangle *inner = rect->findChild<QQuickRectangle*>("inner");
+    QVERIFY(inner != 0);
+
+    QQmlAbstractBinding *binding = QQmlPropertyPrivate::binding(QQmlProperty(inner, "width"));
+    QVERIFY(binding != 0);
+    QCOMPARE(binding->bindingType(), QQmlAbstractBinding::Typed);
+
+    // Unresolvable expressions still use the JavaScript engine
+    binding = QQmlPropertyPrivate::binding(QQmlProperty(inner, "fallback"));
+    QVERIFY(binding != 0);
+    QCOMPARE(binding->bindingType(), QQmlAbstractBinding::Binding);
+
+    QCOMPARE(inner->width(), qreal(190));
+    QCOMPARE(inner->height(), qreal(50));
+    QCOMPARE(inner->color(), QColor("blue"));
+    QCOMPARE(inner->isVisible(), true);
+    QCOMPARE(inner->property("title").toString(), QLatin1String("item inner"));
+
+    // Out of range numbers are converted with ToInt32
+    binding = QQmlPropertyPrivate::binding(QQmlProperty(rect, "truncated"));
+    QVERIFY(binding != 0);
+    QCOMPARE(binding->bindingType(), QQmlAbstractBinding::Typed);
+    QCOMPARE(rect->property("truncated").toInt(), int(3000000000LL - 4294967296LL));
+    QCOMPARE(rect->property("branch").toReal(), qreal(100));
+
+    rect->setWidth(100);
+    QCOMPARE(inner->width(), qreal(90));
+    QCOMPARE(inner->isVisible(), false);
+
+    rect->setHeight(300);
+    QCOMPARE(inner->height(), qreal(150));
+
+    rect->setProperty("active", true);
+    QCOMPARE(inner->color(), QColor("red"));
+    QCOMPARE(rect->property("branch").toReal(), qreal(100));
+
+    // Only the taken branch is a dependency
+    rect->setHeight(400);
+    QCOMPARE(rect->property("branch").toReal(), qreal(100));
+    rect->setWidth(120);
+    QCOMPARE(rect->property("branch").toReal(), qreal(120));
+
+    rect->setProperty("label", QLatin1String("other"));
+    QCOMPARE(inner->property("title").toString(), QLatin1String("other inner"));
+
+    delete rect;
+}
+
+void tst_qqmlbinding::stableDependencies()
+{
+    QQmlEngine engine;
+    QQmlComponent c(&engine, testFileUrl("stableDependencies.qml"));
+    QObject *o = c.create();
+    QVERIFY(o != 0);
+
+    QCOMPARE(o->property("result").toInt(), 1);
+
+    // Enough evaluations with the same dependencies for the guards to become permanent
+    for (int ii = 2; ii < 10; ++ii) {
+        o->setProperty("first", ii);
+        QCOMPARE(o->property("result").toInt(), ii);
+    }
+
+    // Changing the taken branch must still pick up the new dependency
+    o->setProperty("useFirst", false);
+    QCOMPARE(o->property("result").toInt(), 100);
+    o->setProperty("second", 200);
+    QCOMPARE(o->property("result").toInt(), 200);
+    o->setProperty("first", 50);
+    QCOMPARE(o->property("result").toInt(), 200);
+
+    for (int ii = 0; ii < 10; ++ii) {
+        o->setProperty("second", 300 + ii);
+        QCOMPARE(o->property("result").toInt(), 300 + ii);
+    }
+
+    o->setProperty("useFirst", true);
+    QCOMPARE(o->property("result").toInt(), 50);
+    o->setProperty("first", 60);
+    QCOMPARE(o->property("result").toInt(), 60);
+
+    delete o;
+}
+
 QTEST_MAIN(tst_qqmlbinding)
 
 #include "tst_qqmlbinding.moc"
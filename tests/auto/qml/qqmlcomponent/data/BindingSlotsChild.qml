@@ -0,0 +1,8 @@
+import QtQuick 2.0
+
+Rectangle {
+    property int base: 3
+    width: base * 10
+    height: width / 2
+    border.width: base
+}
@@ -0,0 +1,14 @@
+import QtQuick 2.0
+
+Item {
+    id: root
+    property int count: 4
+    width: count * 25
+    height: width
+
+    BindingSlotsChild { objectName: "first"; base: root.count; anchors.left: parent.left }
+    BindingSlotsChild { objectName: "second"; base: root.count + 1; border.color: "red" }
+
+    Component { id: nested; BindingSlotsChild { base: 7 } }
+    property QtObject fromNested: nested.createObject(root)
+}
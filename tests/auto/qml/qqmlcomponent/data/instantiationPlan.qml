@@ -0,0 +1,7 @@
+import QtQuick 2.0
+
+Rectangle {
+    width: 100
+    color: "red"
+    border.color: "#00ff00"
+}
@@ -48,6 +48,9 @@
 #include <QtQuick>
 #include <QtQuick/private/qquickrectangle_p.h>
 #include <QtQuick/private/qquickmousearea_p.h>
+#include <private/qqmlengine_p.h>
+#include <private/qqmlcomponent_p.h>
+#include <private/qqmlcompiler_p.h>
 #include <qcolor.h>
 #include "../../shared/util.h"
 #include "testhttpserver.h"
@@ -124,6 +127,8 @@ private slots:
     void onDestructionCount();
     void recursion();
     void recursionContinuation();
+    void newCompilerBindingSlots();
+    void newCompilerInstantiationPlan();
 
 private:
     QQmlEngine engine;
@@ -450,6 +455,84 @@ void tst_qqmlcomponent::recursionContinuation()
     QVERIFY(object->property("success").toBool());
 }
 
+void tst_qqmlcomponent::newCompilerBindingSlots()
+{
+    // The same as running with QML_NEW_COMPILER=1, which the engine only reads on construction.
+    QQmlEngine engine;
+    QQmlEnginePrivate::get(&engine)->useNewCompiler = true;
+
+    // Binding slots for the composite types and grouped objects come from one block per instance
+    QQmlComponent component(&engine, testFileUrl("bindingSlots.qml"));
+    for (int i = 0; i < 2; ++i) {
+        QScopedPointer<QObject> root(component.create());
+        QVERIFY2(root, qPrintable(component.errorString()));
+        QCOMPARE(root->property("width").toReal(), qreal(100));
+        QCOMPARE(root->property("height").toReal(), qreal(100));
+
+        QObject *first = root->findChild<QObject *>("first");
+        QVERIFY(first);
+        QCOMPARE(first->property("width").toReal(), qreal(40));
+        QCOMPARE(first->property("height").toReal(), qreal(20));
+        QCOMPARE(QQmlProperty::read(first, "border.width").toInt(), 4);
+
+        QObject *second = root->findChild<QObject *>("second");
+        QVERIFY(second);
+        QCOMPARE(second->property("width").toReal(), qreal(50));
+        QCOMPARE(QQmlProperty::read(second, "border.width").toInt(), 5);
+        QCOMPARE(QQmlProperty::read(second, "border.color").value<QColor>(), QColor(Qt::red));
+
+        QObject *fromNested = root->property("fromNested").value<QObject *>();
+        QVERIFY(fromNested);
+        QCOMPARE(fromNested->property("width").toReal(), qreal(70));
+        QCOMPARE(QQmlProperty::read(fromNested, "border.width").toInt(), 7);
+    }
+}
+
+void tst_qqmlcomponent::newCompilerInstantiationPlan()
+{
+    // The same as running with QML_NEW_COMPILER=1, which the engine only reads on construction.
+    QQmlEngine engine;
+    QQmlEnginePrivate::get(&engine)->useNewCompiler = true;
+
+    QQmlComponent component(&engine, testFileUrl("instantiationPlan.qml"));
+    QScopedPointer<QObject> first(component.create());
+    QVERIFY2(first, qPrintable(component.errorString()));
+
+    // The first instance records the property lookups and literal conversions of the root
+    QQmlCompiledData *cc = QQmlComponentPrivate::get(&component)->cc;
+    QVERIFY(cc);
+    const int rootIndex = cc->qmlUnit->indexOfRootObject;
+    const QVector<QQmlCompiledData::InstantiationStep> &steps = cc->instantiationPlan.at(rootIndex);
+    QCOMPARE(steps.count(), int(cc->qmlUnit->objectAt(rootIndex)->nBindings));
+
+    int colorStep = -1;
+    for (int i = 0; i < steps.count(); ++i) {
+        if (steps.at(i).convertedType == QMetaType::QColor)
+            colorStep = i;
+    }
+    QVERIFY(colorStep != -1);
+    QVERIFY(steps.at(colorStep).propertyCache);
+    QVERIFY(steps.at(colorStep).property);
+    QCOMPARE(steps.at(colorStep).convertedValue.value<QColor>(), QColor(Qt::red));
+
+    const QQmlCompiledData::InstantiationStep *plan = steps.constData();
+    QQmlPropertyCache *propertyCache = steps.at(colorStep).propertyCache;
+    QQmlPropertyData *property = steps.at(colorStep).property;
+
+    // The second instance replays the same plan and ends up identical to the first
+    QScopedPointer<QObject> second(component.create());
+    QVERIFY2(second, qPrintable(component.errorString()));
+    QCOMPARE(cc->instantiationPlan.at(rootIndex).constData(), plan);
+    QCOMPARE(steps.at(colorStep).propertyCache, propertyCache);
+    QCOMPARE(steps.at(colorStep).property, property);
+
+    QCOMPARE(second->property("width"), first->property("width"));
+    QCOMPARE(second->property("color").value<QColor>(), QColor(Qt::red));
+    QCOMPARE(second->property("color"), first->property("color"));
+    QCOMPARE(QQmlProperty::read(second.data(), "border.color").value<QColor>(), QColor(Qt::green));
+    QCOMPARE(QQmlProperty::read(second.data(), "border.color"), QQmlProperty::read(first.data(), "border.color"));
+}
+
 QTEST_MAIN(tst_qqmlcomponent)
 
 #include "tst_qqmlcomponent.moc"
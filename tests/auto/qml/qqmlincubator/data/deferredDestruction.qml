@@ -0,0 +1,17 @@
+import QtQuick 2.0
+
+Item {
+    property int source: 1
+    property bool destructionEmitted: false
+
+    Component.onDestruction: destructionEmitted = true
+
+    Item {
+        objectName: "child"
+        property int value: parent.source * 2
+
+        Item {
+            objectName: "grandChild"
+        }
+    }
+}
@@ -51,6 +51,7 @@
 #include <QQmlProperty>
 #include <QQmlComponent>
 #include <QQmlIncubator>
+#include <private/qqmlengine_p.h>
 #include "../../shared/util.h"
 
 class tst_qqmlincubator : public QQmlDataTest
@@ -79,6 +80,7 @@ private slots:
     void chainedAsynchronousClear();
     void selfDelete();
     void contextDelete();
+    void deferredDestruction();
 
 private:
     QQmlIncubationController controller;
@@ -1142,6 +1144,47 @@ void tst_qqmlincubator::contextDelete()
     }
 }
 
+void tst_qqmlincubator::deferredDestruction()
+{
+    QQmlComponent component(&engine, testFileUrl("deferredDestruction.qml"));
+    QVERIFY(component.isReady());
+
+    QPointer<QObject> object(component.create());
+    QVERIFY(object);
+    QPointer<QObject> child(object->findChild<QObject *>("child"));
+    QPointer<QObject> grandChild(object->findChild<QObject *>("grandChild"));
+    QVERIFY(child);
+    QVERIFY(grandChild);
+    QCOMPARE(child->property("value").toInt(), 2);
+
+    QQmlEnginePrivate::get(&engine)->deferDestruction(object);
+
+    // Nothing is destroyed, or told it is being destroyed, until the controller runs
+    QVERIFY(object);
+    QCOMPARE(object->property("destructionEmitted").toBool(), false);
+    QCOMPARE(controller.incubatingObjectCount(), 1);
+
+    // Each call with a false flag makes a single step of progress
+    bool b = false;
+    controller.incubateWhile(&b);
+    QVERIFY(object);
+    QCOMPARE(object->property("destructionEmitted").toBool(), true);
+
+    int steps = 1;
+    while (object) {
+        // Children are only destroyed with their parent
+        QVERIFY(child);
+        QVERIFY(grandChild);
+        controller.incubateWhile(&b);
+        ++steps;
+    }
+
+    QVERIFY(steps > 1);
+    QVERIFY(child.isNull());
+    QVERIFY(grandChild.isNull());
+    QCOMPARE(controller.incubatingObjectCount(), 0);
+}
+
 QTEST_MAIN(tst_qqmlincubator)
 
 #include "tst_qqmlincubator.moc"
@@ -152,6 +152,7 @@ private slots:
     void find();
     void findInsertPosition_data();
     void findInsertPosition();
+    void findFragmented();
     void insert();
     void clearFlags_data();
     void clearFlags();
@@ -294,6 +295,120 @@ void tst_qqmllistcompositor::findInsertPosition()
     QCOMPARE(it->index, rangeIndex);
 }
 
+static void verifyFragmented(
+        QQmlListCompositor &compositor, const QVector<int> &modelIndexes, const QVector<uint> &flags)
+{
+    // For every item and group the expected index is the number of preceding items in the group.
+    const C::Group groups[] = { C::Cache, C::Default, Visible, Selection };
+    QVector<int> counts(4, 0);
+    QVector<QVector<int> > indexes(flags.count());
+    for (int i = 0; i < flags.count(); ++i) {
+        indexes[i] = counts;
+        for (int g = 0; g < 4; ++g) {
+            if (flags.at(i) & (1 << g))
+                ++counts[g];
+        }
+    }
+
+    for (int g = 0; g < 4; ++g) {
+        const C::Group group = groups[g];
+        QCOMPARE(compositor.count(group), counts.at(g));
+
+        // Seek backwards and in large strides so lookups aren't satisfied by walking from the
+        // last position.
+        QVector<int> items;
+        for (int i = flags.count() - 1; i >= 0; --i) {
+            if (flags.at(i) & (1 << g))
+                items.prepend(i);
+        }
+        for (int stride = 0; stride < 7; ++stride) {
+            for (int index = items.count() - 1 - stride; index >= 0; index -= 7) {
+                C::iterator it = compositor.find(group, index);
+                const int item = items.at(index);
+                QCOMPARE(it.modelIndex(), modelIndexes.at(item));
+                for (int h = 0; h < 4; ++h)
+                    QCOMPARE(it.index[groups[h]], indexes.at(item).at(h));
+
+                C::insert_iterator insertIt = compositor.findInsertPosition(group, index);
+                QCOMPARE(insertIt.index[group], index);
+            }
+        }
+        QCOMPARE(compositor.findInsertPosition(group, counts.at(g)).index[group], counts.at(g));
+    }
+}
+
+void tst_qqmllistcompositor::findFragmented()
+{
+    int listA; void *a = &listA;
+
+    QQmlListCompositor compositor;
+    compositor.setGroupCount(4);
+    compositor.setDefaultGroups(VisibleFlag | C::DefaultFlag);
+
+    // Give every item a different combination of groups so that most ranges are a single item.
+    QVector<int> modelIndexes;
+    QVector<uint> flags;
+    for (int i = 0; i < 500; ++i) {
+        uint itemFlags = C::DefaultFlag;
+        if (i % 2)
+            itemFlags |= VisibleFlag;
+        if (i % 3 == 0)
+            itemFlags |= SelectionFlag;
+        if (i % 5 == 0)
+            itemFlags |= C::CacheFlag;
+        modelIndexes.append(i);
+        flags.append(itemFlags);
+        compositor.append(a, i, 1, itemFlags);
+    }
+    verifyFragmented(compositor, modelIndexes, flags);
+
+    // Modifications must be reflected by subsequent lookups.
+    compositor.setFlags(C::Default, 100, 50, SelectionFlag);
+    for (int i = 100; i < 150; ++i)
+        flags[i] |= SelectionFlag;
+    verifyFragmented(compositor, modelIndexes, flags);
+
+    compositor.clearFlags(C::Default, 300, 100, VisibleFlag);
+    for (int i = 300; i < 400; ++i)
+        flags[i] &= ~VisibleFlag;
+    verifyFragmented(compositor, modelIndexes, flags);
+
+    compositor.setFlags(C::Default, 0, 500, SelectionFlag);
+    for (int i = 0; i < 500; ++i)
+        flags[i] |= SelectionFlag;
+    verifyFragmented(compositor, modelIndexes, flags);
+
+    // Lookups interleaved with modifications far apart.
+    for (int i = 0; i < 200; ++i) {
+        const int index = (i * 211) % 500;
+        QCOMPARE(compositor.find(C::Default, index).modelIndex(), modelIndexes.at(index));
+        if (i % 2) {
+            compositor.clearFlags(C::Default, index, 1, SelectionFlag);
+            flags[index] &= ~SelectionFlag;
+        } else {
+            compositor.setFlags(C::Default, index, 1, VisibleFlag);
+            flags[index] |= VisibleFlag;
+        }
+    }
+    verifyFragmented(compositor, modelIndexes, flags);
+
+    for (int i = 0; i < 50; ++i) {
+        const int from = (i * 137) % 490;
+        const int to = (i * 389) % 490;
+        const int count = 1 + i % 10;
+        compositor.move(C::Default, from, C::Default, to, count, C::Default);
+        const QVector<int> movedIndexes = modelIndexes.mid(from, count);
+        const QVector<uint> movedFlags = flags.mid(from, count);
+        modelIndexes.remove(from, count);
+        flags.remove(from, count);
+        for (int j = 0; j < count; ++j) {
+            modelIndexes.insert(to + j, movedIndexes.at(j));
+            flags.insert(to + j, movedFlags.at(j));
+        }
+    }
+    verifyFragmented(compositor, modelIndexes, flags);
+}
+
 void tst_qqmllistcompositor::insert()
 {
     QQmlListCompositor compositor;
@@ -130,6 +130,10 @@ private slots:
     void empty_element_warning_data();
     void datetime();
     void datetime_data();
+    void positional_operations();
+    void scattered_removal();
+    void bulk_insert();
+    void bulk_insert_data();
 };
 
 bool tst_qqmllistmodel::compareVariantList(const QVariantList &testList, QVariant object)
@@ -1255,6 +1259,182 @@ void tst_qqmllistmodel::datetime()
     QVERIFY(expected == dtResult);
 }
 
+void tst_qqmllistmodel::positional_operations()
+{
+    QQmlEngine engine;
+    QQmlListModel model;
+    QQmlEngine::setContextForObject(&model, engine.rootContext());
+    engine.rootContext()->setContextObject(&model);
+
+    // Enough elements for the row storage to need several levels, and an object
+    // obtained through get() that has to keep track of its element's index
+    QQmlExpression e(engine.rootContext(), &model,
+                     "{ for (var i = 0; i < 5000; ++i) insert(0, {'value': i});"
+                     "  var o = get(10);"
+                     "  move(0, 4000, 100);"
+                     "  move(4500, 20, 30);"
+                     "  remove(1000, 2000);"
+                     "  insert(2500, {'value': -1});"
+                     "  o.value = -3;"
+                     "  get(10).value = -2; }");
+    e.evaluate();
+    QVERIFY(!e.hasError());
+
+    QList<int> expected;
+    for (int i = 0; i < 5000; ++i)
+        expected.prepend(i);
+    const int cached = expected.at(10);
+    QList<int> moved = expected.mid(0, 100);
+    expected.erase(expected.begin(), expected.begin() + 100);
+    for (int i = 0; i < moved.count(); ++i)
+        expected.insert(4000 + i, moved.at(i));
+    moved = expected.mid(4500, 30);
+    expected.erase(expected.begin() + 4500, expected.begin() + 4530);
+    for (int i = 0; i < moved.count(); ++i)
+        expected.insert(20 + i, moved.at(i));
+    expected.erase(expected.begin() + 1000, expected.begin() + 3000);
+    expected.insert(2500, -1);
+    expected[expected.indexOf(cached)] = -3;
+    expected[10] = -2;
+
+    int role = roleFromName(&model, "value");
+    QVERIFY(role >= 0);
+    QCOMPARE(model.count(), expected.count());
+    for (int i = 0; i < expected.count(); ++i)
+        QCOMPARE(model.data(i, role).toInt(), expected.at(i));
+
+    QQmlExpression clear(engine.rootContext(), &model, "{ remove(0, count); append({'value': 7}); }");
+    clear.evaluate();
+    QVERIFY(!clear.hasError());
+    QCOMPARE(model.count(), 1);
+    QCOMPARE(model.data(0, role).toInt(), 7);
+}
+
+void tst_qqmllistmodel::scattered_removal()
+{
+    QQmlEngine engine;
+    QQmlListModel model;
+    QQmlEngine::setContextForObject(&model, engine.rootContext());
+    engine.rootContext()->setContextObject(&model);
+
+    // Thin out the rows unevenly, leaving some parts of the row storage nearly empty
+    // next to full ones, then insert into and remove from the sparse parts again
+    QQmlExpression e(engine.rootContext(), &model,
+                     "{ for (var i = 0; i < 5000; ++i) append({'value': i});"
+                     "  for (var i = 4999; i >= 0; i -= 3) remove(i);"
+                     "  for (var i = 2000; i < count; i += 1) remove(i);"
+                     "  remove(100, 500);"
+                     "  for (var i = 0; i < 200; ++i) insert(150, {'value': -i}); }");
+    e.evaluate();
+    QVERIFY(!e.hasError());
+
+    QList<int> expected;
+    for (int i = 0; i < 5000; ++i)
+        expected.append(i);
+    for (int i = 4999; i >= 0; i -= 3)
+        expected.removeAt(i);
+    for (int i = 2000; i < expected.count(); i += 1)
+        expected.removeAt(i);
+    expected.erase(expected.begin() + 100, expected.begin() + 600);
+    for (int i = 0; i < 200; ++i)
+        expected.insert(150, -i);
+
+    int role = roleFromName(&model, "value");
+    QVERIFY(role >= 0);
+    QCOMPARE(model.count(), expected.count());
+    for (int i = 0; i < expected.count(); ++i)
+        QCOMPARE(model.data(i, role).toInt(), expected.at(i));
+
+    QQmlExpression drain(engine.rootContext(), &model, "{ while (count > 1) remove(count > 10 ? 5 : 0); }");
+    drain.evaluate();
+    QVERIFY(!drain.hasError());
+    QCOMPARE(model.count(), 1);
+    QCOMPARE(model.data(0, role).toInt(), expected.last());
+}
+
+void tst_qqmllistmodel::bulk_insert_data()
+{
+    QTest::addColumn<bool>("dynamicRoles");
+
+    QTest::newRow("static") << false;
+    QTest::newRow("dynamic") << true;
+}
+
+void tst_qqmllistmodel::bulk_insert()
+{
+    QFETCH(bool, dynamicRoles);
+
+    QQmlEngine engine;
+    QQmlListModel model;
+    model.setDynamicRoles(dynamicRoles);
+    QQmlEngine::setContextForObject(&model, engine.rootContext());
+    engine.rootContext()->setContextObject(&model);
+
+    QSignalSpy spyInserted(&model, SIGNAL(rowsInserted(QModelIndex,int,int)));
+    QSignalSpy spyCount(&model, SIGNAL(countChanged()));
+
+    QVector<QVariantMap> rows;
+    for (int i = 0; i < 100; ++i) {
+        QVariantMap row;
+        row.insert(QStringLiteral("name"), QString::number(i));
+        row.insert(QStringLiteral("value"), i);
+        rows.append(row);
+    }
+    model.insertBulk(0, rows);
+
+    QCOMPARE(model.count(), 100);
+    QCOMPARE(spyInserted.count(), 1);
+    QCOMPARE(spyInserted.at(0).at(1).toInt(), 0);
+    QCOMPARE(spyInserted.at(0).at(2).toInt(), 99);
+    QCOMPARE(spyCount.count(), 1);
+
+    QVariantList names;
+    QVariantList values;
+    for (int i = 0; i < 50; ++i) {
+        names.append(QString::fromLatin1("c%1").arg(i));
+        values.append(i % 2 ? QVariant(i * 2) : QVariant());
+    }
+    QVector<QVariantList> columns;
+    columns << names << values;
+    model.insertBulk(10, QStringList() << QStringLiteral("name") << QStringLiteral("value"), columns);
+
+    QCOMPARE(model.count(), 150);
+    QCOMPARE(spyInserted.count(), 2);
+    QCOMPARE(spyInserted.at(1).at(1).toInt(), 10);
+    QCOMPARE(spyInserted.at(1).at(2).toInt(), 59);
+
+    int nameRole = roleFromName(&model, "name");
+    int valueRole = roleFromName(&model, "value");
+    QVERIFY(nameRole >= 0);
+    QVERIFY(valueRole >= 0);
+    QCOMPARE(model.data(9, nameRole).toString(), QString("9"));
+    QCOMPARE(model.data(9, valueRole).toInt(), 9);
+    QCOMPARE(model.data(11, nameRole).toString(), QString("c1"));
+    QCOMPARE(model.data(11, valueRole).toInt(), 2);
+    QCOMPARE(model.data(60, nameRole).toString(), QString("10"));
+    QCOMPARE(model.data(149, valueRole).toInt(), 99);
+
+    // Mismatched column lengths are rejected without touching the model
+    QTest::ignoreMessage(QtWarningMsg, "<Unknown File>: QML ListModel: insert: column 'value' has 1 values, expected 2");
+    columns.clear();
+    columns << (QVariantList() << QString("a") << QString("b")) << (QVariantList() << 1);
+    model.insertBulk(0, QStringList() << QStringLiteral("name") << QStringLiteral("value"), columns);
+    QCOMPARE(model.count(), 150);
+    QCOMPARE(spyInserted.count(), 2);
+
+    // Arrays passed from JavaScript are inserted as one block as well
+    QQmlExpression e(engine.rootContext(), &model,
+                     "{ var a = []; for (var i = 0; i < 20; ++i) a.push({'name': 'js' + i, 'value': -i});"
+                     "  insert(5, a); append(a); }");
+    e.evaluate();
+    QVERIFY(!e.hasError());
+    QCOMPARE(model.count(), 190);
+    QCOMPARE(spyInserted.count(), 4);
+    QCOMPARE(model.data(5, nameRole).toString(), QString("js0"));
+    QCOMPARE(model.data(24, valueRole).toInt(), -19);
+    QCOMPARE(model.data(189, nameRole).toString(), QString("js19"));
+}
+
 QTEST_MAIN(tst_qqmllistmodel)
 
 #include "tst_qqmllistmodel.moc"
@@ -117,6 +117,7 @@ private slots:
     void worker_remove_list();
     void dynamic_role_data();
     void dynamic_role();
+    void worker_incremental_sync();
 };
 
 bool tst_qqmllistmodelworkerscript::compareVariantList(const QVariantList &testList, QVariant object)
@@ -854,6 +855,91 @@ void tst_qqmllistmodelworkerscript::dynamic_role()
     qApp->processEvents();
 }
 
+void tst_qqmllistmodelworkerscript::worker_incremental_sync()
+{
+    QQmlListModel model;
+    QQmlEngine eng;
+    QQmlComponent component(&eng, testFileUrl("model.qml"));
+    QQuickItem *item = createWorkerTest(&eng, &component, &model);
+    QVERIFY(item != 0);
+
+    QVERIFY(QMetaObject::invokeMethod(item, "evalExpressionViaWorker",
+            Q_ARG(QVariant, QStringList("append((function() { var a = []; for (var i = 0; i < 1000; ++i) a.push({'value': i}); return a; })())"))));
+    waitForWorker(item);
+    QCOMPARE(model.count(), 1000);
+
+    int role = roleFromName(&model, "value");
+    QVERIFY(role >= 0);
+
+    QQmlExpression getExpr(eng.rootContext(), &model, "get(30)");
+    QObject *cached = getExpr.evaluate().value<QObject *>();
+    QVERIFY(cached);
+
+    QSignalSpy spyInserted(&model, SIGNAL(rowsInserted(QModelIndex,int,int)));
+    QSignalSpy spyRemoved(&model, SIGNAL(rowsRemoved(QModelIndex,int,int)));
+    QSignalSpy spyMoved(&model, SIGNAL(rowsMoved(QModelIndex,int,int,QModelIndex,int)));
+    QSignalSpy spyChanged(&model, SIGNAL(dataChanged(QModelIndex,QModelIndex,QVector<int>)));
+    QSignalSpy spyReset(&model, SIGNAL(modelReset()));
+
+    // Only the touched rows travel to the main thread; the changes are replayed there
+    QStringList commands;
+    commands << "setProperty(10, 'value', -1)"
+             << "remove(20, 5)"
+             << "insert(0, {'value': -2})"
+             << "move(0, 500, 1)"
+             << "setProperty(25, 'value', -3)";
+    QVERIFY(QMetaObject::invokeMethod(item, "evalExpressionViaWorker", Q_ARG(QVariant, commands)));
+    waitForWorker(item);
+
+    QList<int> expected;
+    for (int i = 0; i < 1000; ++i)
+        expected.append(i);
+    expected[10] = -1;
+    expected.erase(expected.begin() + 20, expected.begin() + 25);
+    expected.insert(500, -2);
+    expected[25] = -3;
+
+    QCOMPARE(model.count(), expected.count());
+    for (int i = 0; i < expected.count(); ++i)
+        QCOMPARE(model.data(i, role).toInt(), expected.at(i));
+
+    QCOMPARE(spyInserted.count(), 1);
+    QCOMPARE(spyRemoved.count(), 1);
+    QCOMPARE(spyMoved.count(), 1);
+    QCOMPARE(spyChanged.count(), 2);
+    QCOMPARE(spyReset.count(), 0);
+    QCOMPARE(cached->property("value").toInt(), -3);
+
+    // Changes made on the main thread are replaced by the worker's rows on the next sync
+    model.setProperty(0, "value", 12345);
+    QVERIFY(QMetaObject::invokeMethod(item, "evalExpressionViaWorker",
+            Q_ARG(QVariant, QStringList("setProperty(1, 'value', 7)"))));
+    waitForWorker(item);
+
+    QCOMPARE(model.count(), expected.count());
+    QCOMPARE(model.data(0, role).toInt(), 0);
+    QCOMPARE(model.data(1, role).toInt(), 7);
+
+    // Rows touched more than once carry their latest values; removed ones are dropped
+    commands.clear();
+    commands << "setProperty(3, 'value', 100)"
+             << "setProperty(3, 'value', 101)"
+             << "insert(0, {'value': -5})"
+             << "setProperty(0, 'value', -6)"
+             << "insert(0, {'value': -7})"
+             << "remove(1, 1)";
+    QVERIFY(QMetaObject::invokeMethod(item, "evalExpressionViaWorker", Q_ARG(QVariant, commands)));
+    waitForWorker(item);
+
+    QCOMPARE(model.count(), expected.count() + 1);
+    QCOMPARE(model.data(0, role).toInt(), -7);
+    QCOMPARE(model.data(1, role).toInt(), 0);
+    QCOMPARE(model.data(4, role).toInt(), 101);
+
+    delete item;
+    qApp->processEvents();
+}
+
 QTEST_MAIN(tst_qqmllistmodelworkerscript)
 
 #include "tst_qqmllistmodelworkerscript.moc"
@@ -0,0 +1,48 @@
+.import QtQuick.LocalStorage 2.0 as Sql
+
+function test(done) {
+    var db = Sql.LocalStorage.openDatabase("QmlTestDB-async-serialized", "", "Test database from Qt autotests", 1000000);
+    var order = "";
+
+    // Requested back to back: each may only begin once the previous one has committed
+    db.transaction(
+        function(tx) {
+            order += "1";
+            tx.executeSql('CREATE TABLE IF NOT EXISTS Counter(n INTEGER)');
+            tx.executeSql('INSERT INTO Counter VALUES(1)', [], function(tx, rs) {
+                tx.executeSql('INSERT INTO Counter VALUES(2)');
+            });
+        },
+        function(error) {
+            done("first transaction failed: " + error.message);
+        },
+        function() {
+            order += "c";
+        });
+
+    db.transaction(
+        function(tx) {
+            order += "2";
+            tx.executeSql('INSERT INTO Counter VALUES(3)');
+        },
+        function(error) {
+            done("second transaction failed: " + error.message);
+        },
+        function() {
+            order += "c";
+        });
+
+    db.readTransaction(
+        function(tx) {
+            order += "3";
+            tx.executeSql('SELECT COUNT(*) AS n FROM Counter', [], function(tx, rs) {
+                order += rs.rows.item(0).n;
+            });
+        },
+        function(error) {
+            done("read transaction failed: " + error.message);
+        },
+        function() {
+            done(order == "1c2c33" ? "passed" : order);
+        });
+}
@@ -0,0 +1,53 @@
+.import QtQuick.LocalStorage 2.0 as Sql
+
+function test(done) {
+    var db = Sql.LocalStorage.openDatabase("QmlTestDB-async", "", "Test database from Qt autotests", 1000000);
+    var synchronous = true;
+    var selected = "";
+
+    db.transaction(
+        function(tx) {
+            if (synchronous)
+                done("transaction callback called synchronously");
+            tx.executeSql('CREATE TABLE IF NOT EXISTS Greeting(salutation TEXT, salutee TEXT)');
+            tx.executeSql('INSERT INTO Greeting VALUES(?, ?)', [ [ 'hello', 'world' ], [ 'goodbye', 'world' ] ],
+                function(tx, rs) {
+                    if (rs.rowsAffected != 2)
+                        done("BATCH AFFECTED " + rs.rowsAffected + " ROWS");
+                    tx.executeSql('SELECT * FROM Greeting', [], function(tx, rs) {
+                        selected = rs.rows.length + ":" + rs.rows.item(0).salutation + ":" + rs.rows[1].salutation;
+                    });
+                });
+        },
+        function(error) {
+            done("transaction failed: " + error.message);
+        },
+        function() {
+            // A failing statement rolls back the whole transaction
+            db.transaction(
+                function(tx) {
+                    tx.executeSql('INSERT INTO Greeting VALUES(?, ?)', [ 'hello', 'again' ]);
+                    tx.executeSql('INSERT INTO NoSuchTable VALUES(1)');
+                },
+                function(error) {
+                    db.readTransaction(
+                        function(tx) {
+                            tx.executeSql('SELECT COUNT(*) AS n FROM Greeting', [], function(tx, rs) {
+                                if (rs.rows.item(0).n != 2)
+                                    selected = "ROLLBACK FAILED: " + rs.rows.item(0).n;
+                            });
+                        },
+                        function(error) {
+                            done("read transaction failed: " + error.message);
+                        },
+                        function() {
+                            done(selected == "2:hello:goodbye" ? "passed" : selected);
+                        });
+                },
+                function() {
+                    done("failing transaction succeeded");
+                });
+        });
+
+    synchronous = false;
+}
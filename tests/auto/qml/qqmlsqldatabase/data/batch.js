@@ -0,0 +1,35 @@
+.import QtQuick.LocalStorage 2.0 as Sql
+
+function test() {
+    var db = Sql.LocalStorage.openDatabaseSync("QmlTestDB-batch", "", "Test database from Qt autotests", 1000000);
+    var r="transaction_not_finished";
+
+    db.transaction(
+        function(tx) {
+            tx.executeSql('CREATE TABLE IF NOT EXISTS Greeting(salutation TEXT, salutee TEXT)');
+            var rs = tx.executeSql('INSERT INTO Greeting VALUES(?, ?)',
+                                   [ [ 'hello', 'world' ], [ 'goodbye', 'world' ], [ 'hello', 'again' ] ]);
+            if (rs.rowsAffected != 3) {
+                r = "BATCH AFFECTED " + rs.rowsAffected + " ROWS";
+                return;
+            }
+
+            // Executes the same cached statement repeatedly
+            for (var i = 0; i < 100; ++i)
+                tx.executeSql('INSERT INTO Greeting VALUES(?, ?)', [ 'hi', 'row ' + i ]);
+            tx.executeSql('INSERT INTO Greeting VALUES(?, ?)', [ 'last', null ]);
+
+            rs = tx.executeSql('SELECT * FROM Greeting WHERE salutee = ?', [ 'world' ]);
+            if (rs.rows.length != 2)
+                r = "SELECT RETURNED WRONG VALUE " + rs.rows.length;
+            else if (tx.executeSql('SELECT COUNT(*) AS n FROM Greeting').rows.item(0).n != 104)
+                r = "WRONG NUMBER OF ROWS";
+            else if (tx.executeSql('SELECT * FROM Greeting WHERE salutation = ?', [ 'last' ]).rows.item(0).salutee != null)
+                r = "CACHED STATEMENT KEPT A STALE VALUE";
+            else
+                r = "passed";
+        }
+    );
+
+    return r;
+}
@@ -81,6 +81,8 @@ private slots:
     void testQml();
     void testQml_cleanopen_data();
     void testQml_cleanopen();
+    void testQml_async_data();
+    void testQml_async();
     void totalDatabases();
 
     void cleanupTestCase();
@@ -135,7 +137,7 @@ void tst_qqmlsqldatabase::checkDatabasePath()
     QVERIFY(engine->offlineStoragePath().contains("OfflineStorage"));
 }
 
-static const int total_databases_created_by_tests = 12;
+static const int total_databases_created_by_tests = 15;
 void tst_qqmlsqldatabase::testQml_data()
 {
     QTest::addColumn<QString>("jsfile"); // The input file
@@ -152,6 +154,7 @@ void tst_qqmlsqldatabase::testQml_data()
     QTest::newRow("selection-bindnames") << "selection-bindnames.js";
     QTest::newRow("iteration") << "iteration.js";
     QTest::newRow("iteration-forwardonly") << "iteration-forwardonly.js";
+    QTest::newRow("batch") << "batch.js";
     QTest::newRow("error-a") << "error-a.js";
     QTest::newRow("error-notransaction") << "error-notransaction.js";
     QTest::newRow("error-outsidetransaction") << "error-outsidetransaction.js"; // reuse above
@@ -246,6 +249,35 @@ void tst_qqmlsqldatabase::testQml_cleanopen()
     }
 }
 
+void tst_qqmlsqldatabase::testQml_async_data()
+{
+    QTest::addColumn<QString>("jsfile"); // The input file
+    QTest::newRow("async") << "async.js";
+    QTest::newRow("async-serialized") << "async-serialized.js";
+}
+
+void tst_qqmlsqldatabase::testQml_async()
+{
+    if (engine->offlineStoragePath().isEmpty())
+        QSKIP("offlineStoragePath is empty, skip this test.");
+
+    QFETCH(QString, jsfile);
+
+    QString qml=
+        "import QtQuick 2.0\n"
+        "import \""+jsfile+"\" as JS\n"
+        "Text { Component.onCompleted: JS.test(function(result) { if (text == \"\") text = result }) }";
+
+    engine->setOfflineStoragePath(dbDir());
+    QQmlComponent component(engine);
+    component.setData(qml.toUtf8(), testFileUrl("empty.qml")); // just a file for relative local imports
+    QVERIFY(!component.isError());
+    QQuickText *text = qobject_cast<QQuickText*>(component.create());
+    QVERIFY(text != 0);
+    QCOMPARE(text->text(), QString());
+    QTRY_COMPARE(text->text(), QString("passed"));
+}
+
 void tst_qqmlsqldatabase::totalDatabases()
 {
     if (engine->offlineStoragePath().isEmpty())
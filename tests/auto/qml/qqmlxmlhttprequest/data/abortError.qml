@@ -0,0 +1,32 @@
+import QtQuick 2.0
+
+QtObject {
+    property string url
+
+    property bool seenDone: false
+    property bool seenLoading: false
+    property bool endStateUnsent: false
+    property bool dataOK: false
+
+    Component.onCompleted: {
+        var x = new XMLHttpRequest;
+
+        x.open("GET", url);
+        x.setRequestHeader("Accept-Language", "en-US");
+
+        // Abort the error reply as soon as its headers are known
+        x.onreadystatechange = function() {
+            if (x.readyState == XMLHttpRequest.HEADERS_RECEIVED) {
+                x.abort();
+                endStateUnsent = (x.readyState == XMLHttpRequest.UNSENT);
+                dataOK = true;
+            } else if (x.readyState == XMLHttpRequest.LOADING) {
+                seenLoading = true;
+            } else if (x.readyState == XMLHttpRequest.DONE) {
+                seenDone = true;
+            }
+        }
+
+        x.send()
+    }
+}
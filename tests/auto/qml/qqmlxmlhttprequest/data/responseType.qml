@@ -0,0 +1,59 @@
+import QtQuick 2.0
+
+QtObject {
+    property string fileName
+    property string responseType
+
+    property bool dataOK: false
+
+    property bool typeOK: false
+    property bool sameResponse: false
+    property bool responseTextThrows: false
+    property bool responseXMLThrows: false
+    property bool setAfterDoneThrows: false
+    property string responseText
+    property string result
+
+    function startRequest() {
+        var x = new XMLHttpRequest;
+
+        x.responseType = "arraybuffer";
+        x.responseType = responseType;
+        typeOK = (x.responseType == responseType);
+
+        x.open("GET", fileName);
+
+        // Test to the end
+        x.onreadystatechange = function() {
+            if (x.readyState == XMLHttpRequest.DONE) {
+                try {
+                    responseText = x.responseText;
+                } catch (e) {
+                    responseTextThrows = true;
+                }
+                try {
+                    x.responseXML;
+                } catch (e) {
+                    responseXMLThrows = true;
+                }
+                try {
+                    x.responseType = "text";
+                } catch (e) {
+                    setAfterDoneThrows = true;
+                }
+
+                var r = x.response;
+                sameResponse = (r === x.response);
+                if (responseType == "json")
+                    result = r.name + ":" + r.values.join(",") + ":" + r.nested.ok;
+                else if (responseType == "document")
+                    result = r.documentElement.nodeName;
+                else
+                    result = r;
+
+                dataOK = true;
+            }
+        }
+        x.send()
+    }
+}
@@ -0,0 +1,30 @@
+import QtQuick 2.0
+
+QtObject {
+    property string url
+
+    property int status: 0
+    property string result
+    property bool dataOK: false
+
+    Component.onCompleted: {
+        var x = new XMLHttpRequest;
+        x.responseType = "json";
+
+        x.open("GET", url);
+        x.setRequestHeader("Accept-Language", "en-US");
+
+        // Test to the end
+        x.onreadystatechange = function() {
+            if (x.readyState == XMLHttpRequest.DONE) {
+                status = x.status;
+                var r = x.response;
+                if (r)
+                    result = r.name + ":" + r.values.join(",") + ":" + r.nested.ok;
+                dataOK = true;
+            }
+        }
+
+        x.send()
+    }
+}
@@ -103,6 +103,10 @@ private slots:
     void redirects();
     void nonUtf8();
     void nonUtf8_data();
+    void responseType();
+    void responseType_data();
+    void responseTypeError();
+    void abortError();
 
     // Attributes
     void document();
@@ -908,6 +912,95 @@ void tst_qqmlxmlhttprequest::nonUtf8_data()
     QTest::newRow("responseXML") << "utf16.xml" << "<?xml version=\"1.0\" encoding=\"UTF-16\" standalone='yes'?>\n<root>\n" + uc + "\n</root>\n" << QString('\n' + uc + '\n');
 }
 
+// Test that the response is decoded according to responseType
+void tst_qqmlxmlhttprequest::responseType()
+{
+    QFETCH(QString, fileName);
+    QFETCH(QString, responseType);
+    QFETCH(QString, result);
+    QFETCH(bool, hasResponseText);
+    QFETCH(bool, hasResponseXML);
+
+    QQmlComponent component(&engine, testFileUrl("responseType.qml"));
+    QScopedPointer<QObject> object(component.create());
+    QVERIFY(!object.isNull());
+
+    object->setProperty("fileName", fileName);
+    object->setProperty("responseType", responseType);
+    QMetaObject::invokeMethod(object.data(), "startRequest");
+
+    QTRY_VERIFY(object->property("dataOK").toBool() == true);
+
+    QCOMPARE(object->property("typeOK").toBool(), true);
+    QCOMPARE(object->property("result").toString(), result);
+    QCOMPARE(object->property("sameResponse").toBool(), true);
+    QCOMPARE(object->property("responseTextThrows").toBool(), !hasResponseText);
+    QCOMPARE(object->property("responseXMLThrows").toBool(), !hasResponseXML);
+    QCOMPARE(object->property("setAfterDoneThrows").toBool(), true);
+    if (hasResponseText)
+        QCOMPARE(object->property("responseText").toString(), result);
+}
+
+void tst_qqmlxmlhttprequest::responseType_data()
+{
+    QTest::addColumn<QString>("fileName");
+    QTest::addColumn<QString>("responseType");
+    QTest::addColumn<QString>("result");
+    QTest::addColumn<bool>("hasResponseText");
+    QTest::addColumn<bool>("hasResponseXML");
+
+    QString text = QString::fromUtf8("<?xml version=\"1.0\" encoding=\"UTF-8\" standalone='yes'?>\n<root>\n</root>\n");
+
+    QTest::newRow("default") << "document.xml" << "" << text << true << true;
+    QTest::newRow("text") << "document.xml" << "text" << text << true << false;
+    QTest::newRow("json") << "responseType.json" << "json" << "response:1,2,3:true" << false << false;
+    QTest::newRow("document") << "document.xml" << "document" << "root" << false << true;
+}
+
+// The body of an HTTP error is processed like any other response
+void tst_qqmlxmlhttprequest::responseTypeError()
+{
+    TestHTTPServer server(SERVER_PORT);
+    QVERIFY(server.isValid());
+    QVERIFY(server.wait(testFileUrl("status.expect"),
+                        testFileUrl("status.404.json.reply"),
+                        testFileUrl("responseType.json")));
+
+    QQmlComponent component(&engine, testFileUrl("responseTypeError.qml"));
+    QScopedPointer<QObject> object(component.beginCreate(engine.rootContext()));
+    QVERIFY(!object.isNull());
+    object->setProperty("url", "http://127.0.0.1:14445/testdocument.html");
+    component.completeCreate();
+
+    QTRY_VERIFY(object->property("dataOK").toBool() == true);
+
+    QCOMPARE(object->property("status").toInt(), 404);
+    QCOMPARE(object->property("result").toString(), QString("response:1,2,3:true"));
+}
+
+// Aborting from a callback stops the processing of an HTTP error reply
+void tst_qqmlxmlhttprequest::abortError()
+{
+    TestHTTPServer server(SERVER_PORT);
+    QVERIFY(server.isValid());
+    QVERIFY(server.wait(testFileUrl("status.expect"),
+                        testFileUrl("status.404.json.reply"),
+                        testFileUrl("responseType.json")));
+
+    QQmlComponent component(&engine, testFileUrl("abortError.qml"));
+    QScopedPointer<QObject> object(component.beginCreate(engine.rootContext()));
+    QVERIFY(!object.isNull());
+    object->setProperty("url", "http://127.0.0.1:14445/testdocument.html");
+    component.completeCreate();
+
+    QTRY_VERIFY(object->property("dataOK").toBool() == true);
+    QTest::qWait(100);
+
+    QCOMPARE(object->property("endStateUnsent").toBool(), true);
+    QCOMPARE(object->property("seenDone").toBool(), true);
+    QCOMPARE(object->property("seenLoading").toBool(), false);
+}
+
 // Test that calling hte XMLHttpRequest methods on a non-XMLHttpRequest object
 // throws an exception
 void tst_qqmlxmlhttprequest::invalidMethodUsage()
@@ -44,6 +44,7 @@
 #include <QtQml/qqmlcomponent.h>
 #include <QtCore/qdir.h>
 #include <QtCore/qfile.h>
+#include <QtCore/qtemporarydir.h>
 #include <QtCore/qabstractitemmodel.h>
 #include <QDebug>
 #include "../../shared/util.h"
@@ -82,6 +83,9 @@ private slots:
     void showDotAndDotDot();
     void showDotAndDotDot_data();
     void sortReversed();
+    void largeFolder();
+    void scatteredListing();
+    void supersededListing();
 
 private:
     void checkNoErrors(const QQmlComponent& component);
@@ -341,6 +345,125 @@ void tst_qquickfolderlistmodel::sortReversed()
     QCOMPARE(flm->data(flm->index(0),FileNameRole).toString(), QLatin1String("sortReversed.qml"));
 }
 
+void tst_qquickfolderlistmodel::largeFolder()
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+
+    const int fileCount = 2000;
+    for (int i = fileCount - 1; i >= 0; --i) {
+        QFile file(tempDir.path() + QString::fromLatin1("/file%1.qml").arg(i, 5, 10, QLatin1Char('0')));
+        QVERIFY(file.open(QIODevice::WriteOnly));
+    }
+
+    QQmlComponent component(&engine, testFileUrl("basic.qml"));
+    checkNoErrors(component);
+    QAbstractListModel *flm = qobject_cast<QAbstractListModel*>(component.create());
+    QVERIFY(flm != 0);
+
+    flm->setProperty("folder", QUrl::fromLocalFile(tempDir.path()));
+    QTRY_COMPARE(flm->property("count").toInt(), fileCount);
+    for (int i = 0; i < fileCount; i += 97)
+        QCOMPARE(flm->data(flm->index(i), FileNameRole).toString(), QString::fromLatin1("file%1.qml").arg(i, 5, 10, QLatin1Char('0')));
+
+#ifndef QT_NO_FILESYSTEMWATCHER
+    // a new file is inserted at its place, leaving the other rows alone
+    QSignalSpy insertedSpy(flm, SIGNAL(rowsInserted(QModelIndex,int,int)));
+    QSignalSpy removedSpy(flm, SIGNAL(rowsRemoved(QModelIndex,int,int)));
+    QFile file(tempDir.path() + QLatin1String("/file00100a.qml"));
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.close();
+
+    QTRY_COMPARE(flm->property("count").toInt(), fileCount + 1);
+    QCOMPARE(removedSpy.count(), 0);
+    QCOMPARE(insertedSpy.count(), 1);
+    QCOMPARE(insertedSpy.at(0).at(1).toInt(), 101);
+    QCOMPARE(insertedSpy.at(0).at(2).toInt(), 101);
+    QCOMPARE(flm->data(flm->index(101), FileNameRole).toString(), QLatin1String("file00100a.qml"));
+#endif
+
+    delete flm;
+}
+
+void tst_qquickfolderlistmodel::scatteredListing()
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+
+    // create the files out of order, so that later chunks of the listing
+    // are merged at many places between the rows already listed
+    const int fileCount = 1000;
+    for (int i = 0; i < fileCount; ++i) {
+        const int n = (i * 389) % fileCount;
+        QFile file(tempDir.path() + QString::fromLatin1("/file%1.qml").arg(n, 5, 10, QLatin1Char('0')));
+        QVERIFY(file.open(QIODevice::WriteOnly));
+    }
+
+    QQmlComponent component(&engine, testFileUrl("basic.qml"));
+    checkNoErrors(component);
+    QAbstractListModel *flm = qobject_cast<QAbstractListModel*>(component.beginCreate(engine.rootContext()));
+    QVERIFY(flm != 0);
+
+    QSignalSpy resetSpy(flm, SIGNAL(modelReset()));
+    QSignalSpy insertedSpy(flm, SIGNAL(rowsInserted(QModelIndex,int,int)));
+    QSignalSpy removedSpy(flm, SIGNAL(rowsRemoved(QModelIndex,int,int)));
+    flm->setProperty("folder", QUrl::fromLocalFile(tempDir.path()));
+    component.completeCreate();
+
+    QTRY_COMPARE(flm->property("count").toInt(), fileCount);
+    for (int i = 0; i < fileCount; ++i)
+        QCOMPARE(flm->data(flm->index(i), FileNameRole).toString(), QString::fromLatin1("file%1.qml").arg(i, 5, 10, QLatin1Char('0')));
+
+    // only the reset of setting the folder, which the first chunk of 256
+    // files completes; all later files are inserted, however scattered,
+    // replacing the rows after the first one inserted when there are too
+    // many runs to announce them one by one
+    QCOMPARE(resetSpy.count(), 1);
+    int insertedRows = 0;
+    for (int i = 0; i < insertedSpy.count(); ++i)
+        insertedRows += insertedSpy.at(i).at(2).toInt() - insertedSpy.at(i).at(1).toInt() + 1;
+    int removedRows = 0;
+    for (int i = 0; i < removedSpy.count(); ++i)
+        removedRows += removedSpy.at(i).at(2).toInt() - removedSpy.at(i).at(1).toInt() + 1;
+    QCOMPARE(insertedRows - removedRows, fileCount - 256);
+    QVERIFY(removedSpy.count() > 0);
+    QVERIFY(insertedSpy.count() == removedSpy.count());
+
+    delete flm;
+}
+
+void tst_qquickfolderlistmodel::supersededListing()
+{
+    QTemporaryDir firstDir;
+    QTemporaryDir secondDir;
+    QVERIFY(firstDir.isValid());
+    QVERIFY(secondDir.isValid());
+
+    for (int i = 0; i < 1000; ++i) {
+        QFile file(firstDir.path() + QString::fromLatin1("/file%1.qml").arg(i));
+        QVERIFY(file.open(QIODevice::WriteOnly));
+    }
+    QFile file(secondDir.path() + QLatin1String("/only.qml"));
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.close();
+
+    QQmlComponent component(&engine, testFileUrl("basic.qml"));
+    checkNoErrors(component);
+    QAbstractListModel *flm = qobject_cast<QAbstractListModel*>(component.create());
+    QVERIFY(flm != 0);
+
+    // the listing of the first folder may still be delivered after the
+    // second folder is set, but must not end up in the model
+    flm->setProperty("folder", QUrl::fromLocalFile(firstDir.path()));
+    flm->setProperty("folder", QUrl::fromLocalFile(secondDir.path()));
+    QTRY_COMPARE(flm->property("count").toInt(), 1);
+    QTest::qWait(100);
+    QCOMPARE(flm->property("count").toInt(), 1);
+    QCOMPARE(flm->data(flm->index(0), FileNameRole).toString(), QLatin1String("only.qml"));
+
+    delete flm;
+}
+
 QTEST_MAIN(tst_qquickfolderlistmodel)
 
 #include "tst_qquickfolderlistmodel.moc"
@@ -43,6 +43,8 @@
 #include <QtCore/qtimer.h>
 #include <QtCore/qdir.h>
 #include <QtCore/qfileinfo.h>
+#include <QtCore/qthread.h>
+#include <QSignalSpy>
 #include <QtQml/qjsengine.h>
 
 #include <QtQml/qqmlcomponent.h>
@@ -56,7 +58,7 @@ class tst_QQuickWorkerScript : public QQmlDataTest
 {
     Q_OBJECT
 public:
-    tst_QQuickWorkerScript() {}
+    tst_QQuickWorkerScript() { qputenv("QML_WORKERSCRIPT_THREADS", "2"); }
 private slots:
     void source();
     void messaging();
@@ -72,6 +74,7 @@ private slots:
     void script_var();
     void script_global();
     void stressDispose();
+    void workerThread();
 
 private:
     void waitForEchoMessage(QQuickWorkerScript *worker) {
@@ -139,6 +142,8 @@ void tst_QQuickWorkerScript::messaging_data()
     QTest::newRow("real") << qVariantFromValue(10334.375);
     QTest::newRow("string") << qVariantFromValue(QString("More cheeeese, Gromit!"));
     QTest::newRow("variant list") << qVariantFromValue((QVariantList() << "a" << "b" << "c"));
+    QTest::newRow("long string") << qVariantFromValue(QString(5000, QLatin1Char('x')));
+    QTest::newRow("long string list") << qVariantFromValue((QVariantList() << QString(300, QLatin1Char('a')) << "b" << QString(1000, QLatin1Char('c'))));
     QTest::newRow("date time") << qVariantFromValue(QDateTime::currentDateTime());
 #ifndef QT_NO_REGEXP
     // Qt Script's QScriptValue -> QRegExp uses RegExp2 pattern syntax
@@ -377,6 +382,46 @@ void tst_QQuickWorkerScript::stressDispose()
     }
 }
 
+void tst_QQuickWorkerScript::workerThread()
+{
+    QQmlComponent component(&m_engine, testFileUrl("worker.qml"));
+    QQuickWorkerScript *first = qobject_cast<QQuickWorkerScript*>(component.create());
+    QQuickWorkerScript *second = qobject_cast<QQuickWorkerScript*>(component.create());
+    QVERIFY(first != 0);
+    QVERIFY(second != 0);
+    QCOMPARE(first->workerThread(), -1);
+
+    // Moving a running script restarts it on the other thread
+    QSignalSpy spy(second, SIGNAL(workerThreadChanged()));
+    first->setWorkerThread(0);
+    second->setWorkerThread(1);
+    QCOMPARE(second->workerThread(), 1);
+    QCOMPARE(spy.count(), 1);
+
+    QQmlEnginePrivate *ep = QQmlEnginePrivate::get(&m_engine);
+    QVERIFY(ep->getWorkerScriptEngine(0) != ep->getWorkerScriptEngine(1));
+
+    // Threads beyond QML_WORKERSCRIPT_THREADS are never started
+    QTest::ignoreMessage(QtWarningMsg, "WorkerScript: workerThread 2 is out of range, QML_WORKERSCRIPT_THREADS allows 2 thread(s)");
+    QQuickWorkerScriptEngine *outOfRange = ep->getWorkerScriptEngine(2);
+    QVERIFY(outOfRange == ep->getWorkerScriptEngine(0) || outOfRange == ep->getWorkerScriptEngine(1));
+    QCOMPARE(ep->workerScriptEngines.count(), 2);
+
+    const QMetaObject *mo = first->metaObject();
+    QVariant value(42);
+    QVERIFY(QMetaObject::invokeMethod(first, "testSend", Q_ARG(QVariant, value)));
+    waitForEchoMessage(first);
+    QCOMPARE(mo->property(mo->indexOfProperty("response")).read(first).value<QVariant>(), value);
+
+    QVERIFY(QMetaObject::invokeMethod(second, "testSend", Q_ARG(QVariant, value)));
+    waitForEchoMessage(second);
+    QCOMPARE(mo->property(mo->indexOfProperty("response")).read(second).value<QVariant>(), value);
+
+    qApp->processEvents();
+    delete first;
+    delete second;
+}
+
 QTEST_MAIN(tst_QQuickWorkerScript)
 
 #include "tst_qquickworkerscript.moc"
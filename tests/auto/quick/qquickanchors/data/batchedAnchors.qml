@@ -0,0 +1,24 @@
+import QtQuick 2.0
+
+Rectangle {
+    width: 200; height: 200
+
+    Rectangle {
+        id: first; objectName: "first"
+        width: 20; height: 20
+        anchors.right: parent.right
+    }
+
+    Rectangle {
+        id: second; objectName: "second"
+        width: 20; height: 20
+        anchors.right: first.left
+    }
+
+    Rectangle {
+        objectName: "last"
+        height: 20
+        anchors.left: second.left
+        anchors.right: parent.right
+    }
+}
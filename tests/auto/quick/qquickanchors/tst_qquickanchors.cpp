@@ -48,6 +48,7 @@
 #include <QtQuick/private/qquicktext_p.h>
 #include <QtQuick/private/qquickanchors_p_p.h>
 #include <QtQuick/private/qquickitem_p.h>
+#include <QtQuick/private/qquickwindow_p.h>
 #include "../../shared/util.h"
 #include "../shared/visualtestutil.h"
 
@@ -87,6 +88,8 @@ private slots:
     void marginsRTL();
     void stretch();
     void baselineOffset();
+    void batchedAnchors();
+    void batchedAnchorChain();
 };
 
 void tst_qquickanchors::basicAnchors()
@@ -815,6 +818,95 @@ void tst_qquickanchors::baselineOffset()
     QCOMPARE(anchoredItem->y(), 90.0);
 }
 
+void tst_qquickanchors::batchedAnchors()
+{
+    QQuickView *view = new QQuickView(testFileUrl("batchedAnchors.qml"));
+    QQuickWindowPrivate *windowPrivate = QQuickWindowPrivate::get(view);
+    windowPrivate->setBatchedAnchorsEnabled(true);
+
+    QQuickItem *root = view->rootObject();
+    QQuickItem *first = findItem<QQuickItem>(root, QLatin1String("first"));
+    QQuickItem *second = findItem<QQuickItem>(root, QLatin1String("second"));
+    QQuickItem *last = findItem<QQuickItem>(root, QLatin1String("last"));
+    QVERIFY(first && second && last);
+
+    QCOMPARE(first->x(), 180.0);
+    QCOMPARE(second->x(), 160.0);
+    QCOMPARE(last->x(), 160.0);
+    QCOMPARE(last->width(), 40.0);
+
+    QSignalSpy xSpy(last, SIGNAL(xChanged()));
+    QSignalSpy widthSpy(last, SIGNAL(widthChanged()));
+
+    // anchored items follow the resize in the next polish pass
+    root->setWidth(300);
+    QCOMPARE(first->x(), 180.0);
+    QCOMPARE(last->width(), 40.0);
+    QVERIFY(windowPrivate->itemsToAnchor.contains(first));
+    QVERIFY(windowPrivate->itemsToAnchor.contains(last));
+
+    windowPrivate->polishItems();
+    QVERIFY(windowPrivate->itemsToAnchor.isEmpty());
+    QCOMPARE(first->x(), 280.0);
+    QCOMPARE(second->x(), 260.0);
+    QCOMPARE(last->x(), 260.0);
+    QCOMPARE(last->width(), 40.0);
+
+    // the chain is resolved in dependency order, so the last item moves once
+    QCOMPARE(xSpy.count(), 1);
+    QCOMPARE(widthSpy.count(), 0);
+
+    // disabling batching resolves anything still queued
+    root->setWidth(200);
+    QCOMPARE(first->x(), 280.0);
+    windowPrivate->setBatchedAnchorsEnabled(false);
+    QVERIFY(windowPrivate->itemsToAnchor.isEmpty());
+    QCOMPARE(first->x(), 180.0);
+    QCOMPARE(last->x(), 160.0);
+    QCOMPARE(last->width(), 40.0);
+
+    root->setWidth(300);
+    QCOMPARE(last->x(), 260.0);
+
+    delete view;
+}
+
+void tst_qquickanchors::batchedAnchorChain()
+{
+    QQuickView view;
+    QQuickWindowPrivate *windowPrivate = QQuickWindowPrivate::get(&view);
+    windowPrivate->setBatchedAnchorsEnabled(true);
+
+    QQuickItem *root = new QQuickItem(view.contentItem());
+    root->setWidth(200000);
+
+    // each item is anchored to the previous one while batching is enabled,
+    // so the whole chain is resolved in a single pass
+    const int count = 10000;
+    QQuickItem *previous = 0;
+    for (int i = 0; i < count; ++i) {
+        QQuickItem *item = new QQuickItem(root);
+        item->setWidth(10);
+        QQuickAnchors *anchors = QQuickItemPrivate::get(item)->anchors();
+        if (previous)
+            anchors->setRight(QQuickAnchorLine(previous, QQuickAnchorLine::Left));
+        else
+            anchors->setRight(QQuickAnchorLine(root, QQuickAnchorLine::Right));
+        previous = item;
+    }
+
+    windowPrivate->polishItems();
+    QVERIFY(windowPrivate->itemsToAnchor.isEmpty());
+    QCOMPARE(previous->x(), 200000.0 - count * 10);
+
+    root->setWidth(100000);
+    windowPrivate->polishItems();
+    QVERIFY(windowPrivate->itemsToAnchor.isEmpty());
+    QCOMPARE(previous->x(), 100000.0 - count * 10);
+
+    windowPrivate->setBatchedAnchorsEnabled(false);
+}
+
 QTEST_MAIN(tst_qquickanchors)
 
 #include "tst_qquickanchors.moc"
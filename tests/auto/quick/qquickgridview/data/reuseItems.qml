@@ -0,0 +1,22 @@
+import QtQuick 2.2
+import QtQml.Models 2.2
+
+GridView {
+    width: 240
+    height: 320
+    cellWidth: 60
+    cellHeight: 20
+    cacheBuffer: 0
+    reuseItems: true
+
+    model: 400
+    delegate: Rectangle {
+        objectName: "delegate"
+        width: parent.width / 4
+        height: 20
+        property int pooledCount: 0
+        property int reusedCount: 0
+        DelegateModel.onPooled: pooledCount += 1
+        DelegateModel.onReused: reusedCount += 1
+    }
+}
@@ -208,6 +208,7 @@ private slots:
     void moved_topToBottom_RtL_BtT_data();
 
     void displayMargin();
+    void reuseItems();
 
 private:
     QList<int> toIntList(const QVariantList &list);
@@ -6346,6 +6347,44 @@ void tst_QQuickGridView::displayMargin()
     delete window;
 }
 
+void tst_QQuickGridView::reuseItems()
+{
+    QQmlTestMessageHandler messageHandler;
+    QScopedPointer<QQuickView> window(createView());
+    window->setSource(testFileUrl("reuseItems.qml"));
+    window->show();
+    QVERIFY(QTest::qWaitForWindowExposed(window.data()));
+
+    QQuickGridView *gridview = qobject_cast<QQuickGridView*>(window->rootObject());
+    QVERIFY(gridview != 0);
+    QQuickItem *content = gridview->contentItem();
+
+    for (int i = 0; i < 320; i += 16) {
+        gridview->positionViewAtIndex(i, QQuickGridView::Beginning);
+        QQUICK_VERIFY_POLISH(gridview);
+    }
+
+    // pooled delegates stay hidden children of the view, so their bindings
+    // to the parent keep working while they wait to be reused
+    gridview->setWidth(200);
+    QTRY_COMPARE(content->width(), qreal(200));
+    int pooled = 0;
+    int reused = 0;
+    foreach (QQuickItem *item, findItems<QQuickItem>(content, "delegate", false)) {
+        QCOMPARE(item->parentItem(), content);
+        QCOMPARE(item->width(), qreal(50));
+        if (item->property("pooledCount").toInt() > item->property("reusedCount").toInt()) {
+            QVERIFY(!delegateVisible(item));
+            ++pooled;
+        }
+        if (item->property("reusedCount").toInt() > 0)
+            ++reused;
+    }
+    QVERIFY(pooled > 0);
+    QVERIFY(reused > 0);
+    QVERIFY2(messageHandler.messages().isEmpty(), qPrintable(messageHandler.messageString()));
+}
+
 QTEST_MAIN(tst_QQuickGridView)
 
 #include "tst_qquickgridview.moc"
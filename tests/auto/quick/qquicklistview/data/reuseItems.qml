@@ -0,0 +1,20 @@
+import QtQuick 2.2
+import QtQml.Models 2.2
+
+ListView {
+    width: 240
+    height: 320
+    cacheBuffer: 0
+    reuseItems: true
+
+    model: 100
+    delegate: Rectangle {
+        objectName: "delegate"
+        width: parent.width
+        height: 20
+        property int pooledCount: 0
+        property int reusedCount: 0
+        DelegateModel.onPooled: pooledCount += 1
+        DelegateModel.onReused: reusedCount += 1
+    }
+}
@@ -221,6 +221,9 @@ private slots:
 
     void QTBUG_36481();
 
+    void variableSizeDelegates();
+    void reuseItems();
+
 private:
     template <class T> void items(const QUrl &source);
     template <class T> void changed(const QUrl &source);
@@ -7117,6 +7120,73 @@ void tst_QQuickListView::displayMargin()
     delete window;
 }
 
+void tst_QQuickListView::variableSizeDelegates()
+{
+    QQuickView *window = createView();
+    window->setSource(testFileUrl("variableSizeDelegates.qml"));
+    window->show();
+    QVERIFY(QTest::qWaitForWindowExposed(window));
+
+    QQuickListView *listview = qobject_cast<QQuickListView*>(window->rootObject());
+    QVERIFY(listview != 0);
+    QTRY_COMPARE(QQuickItemPrivate::get(listview)->polishScheduled, false);
+
+    // jumping straight into the unmeasured rows positions the view by estimate only
+    listview->positionViewAtIndex(75, QQuickListView::Beginning);
+    QTRY_COMPARE(QQuickItemPrivate::get(listview)->polishScheduled, false);
+    QVERIFY(findItem<QQuickItem>(listview->contentItem(), "delegate", 75) != 0);
+
+    // once every row has been laid out the extent is exact, wherever the view is
+    for (int i = 0; i < listview->count(); i += 2) {
+        listview->positionViewAtIndex(i, QQuickListView::Beginning);
+        QTRY_COMPARE(QQuickItemPrivate::get(listview)->polishScheduled, false);
+    }
+    listview->positionViewAtIndex(75, QQuickListView::Beginning);
+    QTRY_COMPARE(QQuickItemPrivate::get(listview)->polishScheduled, false);
+    QCOMPARE(listview->contentHeight(), qreal(50 * 20 + 50 * 100));
+    QCOMPARE(listview->contentY() - listview->originY(), qreal(50 * 20 + 25 * 100));
+
+    delete window;
+}
+
+void tst_QQuickListView::reuseItems()
+{
+    QQmlTestMessageHandler messageHandler;
+    QScopedPointer<QQuickView> window(createView());
+    window->setSource(testFileUrl("reuseItems.qml"));
+    window->show();
+    QVERIFY(QTest::qWaitForWindowExposed(window.data()));
+
+    QQuickListView *listview = qobject_cast<QQuickListView*>(window->rootObject());
+    QVERIFY(listview != 0);
+    QQuickItem *content = listview->contentItem();
+
+    for (int i = 0; i < 80; i += 4) {
+        listview->positionViewAtIndex(i, QQuickListView::Beginning);
+        QQUICK_VERIFY_POLISH(listview);
+    }
+
+    // pooled delegates stay hidden children of the view, so their bindings
+    // to the parent keep working while they wait to be reused
+    listview->setWidth(200);
+    QTRY_COMPARE(content->width(), qreal(200));
+    int pooled = 0;
+    int reused = 0;
+    foreach (QQuickItem *item, findItems<QQuickItem>(content, "delegate", false)) {
+        QCOMPARE(item->parentItem(), content);
+        QCOMPARE(item->width(), qreal(200));
+        if (item->property("pooledCount").toInt() > item->property("reusedCount").toInt()) {
+            QVERIFY(!delegateVisible(item));
+            ++pooled;
+        }
+        if (item->property("reusedCount").toInt() > 0)
+            ++reused;
+    }
+    QVERIFY(pooled > 0);
+    QVERIFY(reused > 0);
+    QVERIFY2(messageHandler.messages().isEmpty(), qPrintable(messageHandler.messageString()));
+}
+
 QTEST_MAIN(tst_QQuickListView)
 
 #include "tst_qquicklistview.moc"
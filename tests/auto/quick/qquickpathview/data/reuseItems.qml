@@ -0,0 +1,24 @@
+import QtQuick 2.2
+import QtQml.Models 2.2
+
+PathView {
+    width: 240
+    height: 320
+    pathItemCount: 5
+    reuseItems: true
+
+    model: 40
+    delegate: Rectangle {
+        objectName: "delegate"
+        width: parent.width / 10
+        height: 20
+        property int pooledCount: 0
+        property int reusedCount: 0
+        DelegateModel.onPooled: pooledCount += 1
+        DelegateModel.onReused: reusedCount += 1
+    }
+    path: Path {
+        startX: 0; startY: 160
+        PathLine { x: 240; y: 160 }
+    }
+}
@@ -142,6 +142,7 @@ private slots:
     void indexAt_itemAt();
     void indexAt_itemAt_data();
     void cacheItemCount();
+    void reuseItems();
 };
 
 class TestObject : public QObject
@@ -2120,6 +2121,40 @@ void tst_QQuickPathView::cacheItemCount()
 
 }
 
+void tst_QQuickPathView::reuseItems()
+{
+    QQmlTestMessageHandler messageHandler;
+    QScopedPointer<QQuickView> window(createView());
+    window->setSource(testFileUrl("reuseItems.qml"));
+    window->show();
+    QVERIFY(QTest::qWaitForWindowExposed(window.data()));
+
+    QQuickPathView *pathview = qobject_cast<QQuickPathView*>(window->rootObject());
+    QVERIFY(pathview != 0);
+
+    for (int i = 0; i < 20; ++i)
+        pathview->setOffset(i);
+
+    // pooled delegates stay hidden children of the view, so their bindings
+    // to the parent keep working while they wait to be reused
+    pathview->setWidth(200);
+    int pooled = 0;
+    int reused = 0;
+    foreach (QQuickItem *item, findItems<QQuickItem>(pathview, "delegate", false)) {
+        QCOMPARE(item->parentItem(), static_cast<QQuickItem *>(pathview));
+        QCOMPARE(item->width(), qreal(20));
+        if (item->property("pooledCount").toInt() > item->property("reusedCount").toInt()) {
+            QVERIFY(!delegateVisible(item));
+            ++pooled;
+        }
+        if (item->property("reusedCount").toInt() > 0)
+            ++reused;
+    }
+    QVERIFY(pooled > 0);
+    QVERIFY(reused > 0);
+    QVERIFY2(messageHandler.messages().isEmpty(), qPrintable(messageHandler.messageString()));
+}
+
 QTEST_MAIN(tst_QQuickPathView)
 
 #include "tst_qquickpathview.moc"
@@ -0,0 +1,47 @@
+import QtQuick 2.0
+
+Item {
+    width: 400
+    height: 400
+    property int count: 20
+
+    Column {
+        objectName: "column"
+        Repeater {
+            model: count
+            Rectangle {
+                objectName: "column" + index
+                width: 10
+                height: 10
+                property bool isLastItem: Positioner.isLastItem
+            }
+        }
+    }
+
+    Row {
+        objectName: "row"
+        y: 250
+        Repeater {
+            model: count
+            Rectangle {
+                objectName: "row" + index
+                width: 10
+                height: 10
+            }
+        }
+    }
+
+    Flow {
+        objectName: "flow"
+        y: 300
+        width: 100
+        Repeater {
+            model: count
+            Rectangle {
+                objectName: "flow" + index
+                width: 10
+                height: 10
+            }
+        }
+    }
+}
@@ -94,6 +94,7 @@ private slots:
     void test_attachedproperties();
     void test_attachedproperties_data();
     void test_attachedproperties_dynamic();
+    void test_incrementalRelayout();
 
     void populateTransitions_row();
     void populateTransitions_row_data();
@@ -2114,6 +2115,70 @@ void tst_qquickpositioners::test_attachedproperties_dynamic()
 
 }
 
+void tst_qquickpositioners::test_incrementalRelayout()
+{
+    QScopedPointer<QQuickView> window(createView(testFile("incrementalRelayout.qml")));
+    QQuickItem *root = window->rootObject();
+    QVERIFY(root);
+
+    QQuickItem *column = root->findChild<QQuickItem *>("column");
+    QVERIFY(column);
+    QQuickItem *row = root->findChild<QQuickItem *>("row");
+    QVERIFY(row);
+    QQuickItem *flow = root->findChild<QQuickItem *>("flow");
+    QVERIFY(flow);
+    QCOMPARE(column->height(), 200.0);
+
+    // resizing an item moves only the items after it
+    root->findChild<QQuickItem *>("column10")->setHeight(30);
+    QTRY_COMPARE(root->findChild<QQuickItem *>("column11")->y(), 130.0);
+    QCOMPARE(root->findChild<QQuickItem *>("column9")->y(), 90.0);
+    QCOMPARE(root->findChild<QQuickItem *>("column19")->y(), 210.0);
+    QCOMPARE(column->height(), 220.0);
+
+    // the width of the items before the resized one is kept from the last pass
+    root->findChild<QQuickItem *>("column3")->setWidth(50);
+    QTRY_COMPARE(column->width(), 50.0);
+    root->findChild<QQuickItem *>("column12")->setHeight(20);
+    QTRY_COMPARE(root->findChild<QQuickItem *>("column13")->y(), 160.0);
+    QCOMPARE(column->width(), 50.0);
+    QCOMPARE(column->height(), 230.0);
+    root->findChild<QQuickItem *>("column12")->setHeight(10);
+    QTRY_COMPARE(column->height(), 220.0);
+    root->findChild<QQuickItem *>("column3")->setWidth(10);
+    QTRY_COMPARE(column->width(), 10.0);
+
+    root->findChild<QQuickItem *>("row5")->setWidth(20);
+    QTRY_COMPARE(root->findChild<QQuickItem *>("row6")->x(), 70.0);
+    QCOMPARE(root->findChild<QQuickItem *>("row4")->x(), 40.0);
+    QCOMPARE(row->width(), 210.0);
+
+    // the rest of the line, and the lines after it, are laid out again
+    root->findChild<QQuickItem *>("flow15")->setWidth(20);
+    QTRY_COMPARE(root->findChild<QQuickItem *>("flow16")->x(), 70.0);
+    QCOMPARE(root->findChild<QQuickItem *>("flow16")->y(), 10.0);
+    QCOMPARE(root->findChild<QQuickItem *>("flow19")->x(), 0.0);
+    QCOMPARE(root->findChild<QQuickItem *>("flow19")->y(), 20.0);
+    QCOMPARE(flow->height(), 30.0);
+
+    // appending places the new item and updates the previous last item
+    root->setProperty("count", 21);
+    QQuickItem *column20 = 0;
+    QTRY_VERIFY((column20 = root->findChild<QQuickItem *>("column20")) != 0);
+    QTRY_COMPARE(column20->y(), 220.0);
+    QCOMPARE(column20->property("isLastItem").toBool(), true);
+    QCOMPARE(root->findChild<QQuickItem *>("column19")->property("isLastItem").toBool(), false);
+    QCOMPARE(column->height(), 230.0);
+    QTRY_COMPARE(root->findChild<QQuickItem *>("flow20")->x(), 10.0);
+    QCOMPARE(root->findChild<QQuickItem *>("flow20")->y(), 20.0);
+
+    // removing the last item shrinks the content without moving anything
+    root->setProperty("count", 20);
+    QTRY_COMPARE(column->height(), 220.0);
+    QTRY_COMPARE(root->findChild<QQuickItem *>("column19")->property("isLastItem").toBool(), true);
+    QCOMPARE(root->findChild<QQuickItem *>("column19")->y(), 210.0);
+}
+
 QQuickView *tst_qquickpositioners::createView(const QString &filename, bool wait)
 {
     QQuickView *window = new QQuickView(0);
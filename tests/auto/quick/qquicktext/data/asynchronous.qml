@@ -0,0 +1,23 @@
+import QtQuick 2.2
+
+Item {
+    width: 200
+    height: 200
+
+    property string longText: "Testing that text laid out in a worker thread ends up with the same geometry as text laid out synchronously. The quick brown fox jumped over the lazy dog."
+
+    Text {
+        objectName: "syncText"
+        width: 200
+        wrapMode: Text.WordWrap
+        text: longText
+    }
+
+    Text {
+        objectName: "asyncText"
+        width: 200
+        wrapMode: Text.WordWrap
+        asynchronous: true
+        text: longText
+    }
+}
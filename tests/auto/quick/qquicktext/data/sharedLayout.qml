@@ -0,0 +1,14 @@
+import QtQuick 2.2
+
+Column {
+    width: 200
+
+    Repeater {
+        model: 3
+        Text {
+            width: 200
+            asynchronous: true
+            text: "Repeated caption"
+        }
+    }
+}
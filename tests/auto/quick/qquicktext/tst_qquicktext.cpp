@@ -154,6 +154,10 @@ private slots:
 
     void hover();
 
+    void asynchronous();
+    void sharedLayout();
+    void sharedLayoutImplicitSize();
+
 private:
     QStringList standard;
     QStringList richText;
@@ -738,24 +742,24 @@ void tst_qquicktext::horizontalAlignment_RightToLeft()
     QQuickTextPrivate *textPrivate = QQuickTextPrivate::get(text);
     QVERIFY(textPrivate != 0);
 
-    QTRY_VERIFY(textPrivate->layout.lineCount());
+    QTRY_VERIFY(textPrivate->textLayout()->lineCount());
 
     // implicit alignment should follow the reading direction of RTL text
     QCOMPARE(text->hAlign(), QQuickText::AlignRight);
     QCOMPARE(text->effectiveHAlign(), text->hAlign());
-    QVERIFY(textPrivate->layout.lineAt(0).naturalTextRect().left() > window->width()/2);
+    QVERIFY(textPrivate->textLayout()->lineAt(0).naturalTextRect().left() > window->width()/2);
 
     // explicitly left aligned text
     text->setHAlign(QQuickText::AlignLeft);
     QCOMPARE(text->hAlign(), QQuickText::AlignLeft);
     QCOMPARE(text->effectiveHAlign(), text->hAlign());
-    QVERIFY(textPrivate->layout.lineAt(0).naturalTextRect().left() < window->width()/2);
+    QVERIFY(textPrivate->textLayout()->lineAt(0).naturalTextRect().left() < window->width()/2);
 
     // explicitly right aligned text
     text->setHAlign(QQuickText::AlignRight);
     QCOMPARE(text->hAlign(), QQuickText::AlignRight);
     QCOMPARE(text->effectiveHAlign(), text->hAlign());
-    QVERIFY(textPrivate->layout.lineAt(0).naturalTextRect().left() > window->width()/2);
+    QVERIFY(textPrivate->textLayout()->lineAt(0).naturalTextRect().left() > window->width()/2);
 
     // change to rich text
     QString textString = text->text();
@@ -788,13 +792,13 @@ void tst_qquicktext::horizontalAlignment_RightToLeft()
     text->setHAlign(QQuickText::AlignHCenter);
     QCOMPARE(text->hAlign(), QQuickText::AlignHCenter);
     QCOMPARE(text->effectiveHAlign(), text->hAlign());
-    QVERIFY(textPrivate->layout.lineAt(0).naturalTextRect().left() < window->width()/2);
-    QVERIFY(textPrivate->layout.lineAt(0).naturalTextRect().right() > window->width()/2);
+    QVERIFY(textPrivate->textLayout()->lineAt(0).naturalTextRect().left() < window->width()/2);
+    QVERIFY(textPrivate->textLayout()->lineAt(0).naturalTextRect().right() > window->width()/2);
 
     // reseted alignment should go back to following the text reading direction
     text->resetHAlign();
     QCOMPARE(text->hAlign(), QQuickText::AlignRight);
-    QVERIFY(textPrivate->layout.lineAt(0).naturalTextRect().left() > window->width()/2);
+    QVERIFY(textPrivate->textLayout()->lineAt(0).naturalTextRect().left() > window->width()/2);
 
     // mirror the text item
     QQuickItemPrivate::get(text)->setLayoutMirror(true);
@@ -802,19 +806,19 @@ void tst_qquicktext::horizontalAlignment_RightToLeft()
     // mirrored implicit alignment should continue to follow the reading direction of the text
     QCOMPARE(text->hAlign(), QQuickText::AlignRight);
     QCOMPARE(text->effectiveHAlign(), QQuickText::AlignRight);
-    QVERIFY(textPrivate->layout.lineAt(0).naturalTextRect().left() > window->width()/2);
+    QVERIFY(textPrivate->textLayout()->lineAt(0).naturalTextRect().left() > window->width()/2);
 
     // mirrored explicitly right aligned behaves as left aligned
     text->setHAlign(QQuickText::AlignRight);
     QCOMPARE(text->hAlign(), QQuickText::AlignRight);
     QCOMPARE(text->effectiveHAlign(), QQuickText::AlignLeft);
-    QVERIFY(textPrivate->layout.lineAt(0).naturalTextRect().left() < window->width()/2);
+    QVERIFY(textPrivate->textLayout()->lineAt(0).naturalTextRect().left() < window->width()/2);
 
     // mirrored explicitly left aligned behaves as right aligned
     text->setHAlign(QQuickText::AlignLeft);
     QCOMPARE(text->hAlign(), QQuickText::AlignLeft);
     QCOMPARE(text->effectiveHAlign(), QQuickText::AlignRight);
-    QVERIFY(textPrivate->layout.lineAt(0).naturalTextRect().left() > window->width()/2);
+    QVERIFY(textPrivate->textLayout()->lineAt(0).naturalTextRect().left() > window->width()/2);
 
     // disable mirroring
     QQuickItemPrivate::get(text)->setLayoutMirror(false);
@@ -823,7 +827,7 @@ void tst_qquicktext::horizontalAlignment_RightToLeft()
     // English text should be implicitly left aligned
     text->setText("Hello world!");
     QCOMPARE(text->hAlign(), QQuickText::AlignLeft);
-    QVERIFY(textPrivate->layout.lineAt(0).naturalTextRect().left() < window->width()/2);
+    QVERIFY(textPrivate->textLayout()->lineAt(0).naturalTextRect().left() < window->width()/2);
 
     // empty text with implicit alignment follows the system locale-based
     // keyboard input direction from QInputMethod::inputDirection()
@@ -3790,6 +3794,136 @@ void tst_qquicktext::hover()
     QVERIFY(mouseArea->property("wasHovered").toBool());
 }
 
+void tst_qquicktext::asynchronous()
+{
+    QQmlComponent component(&engine, testFileUrl("asynchronous.qml"));
+    QScopedPointer<QObject> object(component.create());
+    QVERIFY(object);
+
+    QQuickText *syncText = object->findChild<QQuickText *>("syncText");
+    QVERIFY(syncText);
+    QQuickText *asyncText = object->findChild<QQuickText *>("asyncText");
+    QVERIFY(asyncText);
+
+    QVERIFY(!syncText->asynchronous());
+    QVERIFY(asyncText->asynchronous());
+    QVERIFY(syncText->lineCount() > 1);
+
+    QTRY_COMPARE(asyncText->lineCount(), syncText->lineCount());
+    QTRY_COMPARE(asyncText->contentHeight(), syncText->contentHeight());
+    QCOMPARE(asyncText->contentWidth(), syncText->contentWidth());
+    QCOMPARE(asyncText->baselineOffset(), syncText->baselineOffset());
+
+    // Size changes are delivered once the new layout has finished.
+    QSignalSpy contentSizeSpy(asyncText, SIGNAL(contentSizeChanged()));
+    syncText->setWidth(100);
+    asyncText->setWidth(100);
+    QTRY_VERIFY(contentSizeSpy.count() > 0);
+    QCOMPARE(asyncText->lineCount(), syncText->lineCount());
+    QCOMPARE(asyncText->contentHeight(), syncText->contentHeight());
+
+    // Turning the property off completes any outstanding layout immediately.
+    syncText->setText(QStringLiteral("Short text"));
+    asyncText->setText(QStringLiteral("Short text"));
+    asyncText->setAsynchronous(false);
+    QCOMPARE(asyncText->lineCount(), syncText->lineCount());
+    QCOMPARE(asyncText->contentWidth(), syncText->contentWidth());
+
+    // Elided text is always laid out synchronously.
+    asyncText->setAsynchronous(true);
+    asyncText->setText(object->property("longText").toString());
+    asyncText->setElideMode(QQuickText::ElideRight);
+    asyncText->setMaximumLineCount(2);
+    QCOMPARE(asyncText->lineCount(), 2);
+    QVERIFY(asyncText->truncated());
+}
+
+void tst_qquicktext::sharedLayout()
+{
+    QQmlComponent component(&engine, testFileUrl("sharedLayout.qml"));
+    QScopedPointer<QObject> object(component.create());
+    QVERIFY(object);
+
+    QQuickItem *column = qobject_cast<QQuickItem *>(object.data());
+    QVERIFY(column);
+
+    QList<QQuickText *> texts;
+    foreach (QQuickItem *child, column->childItems()) {
+        if (QQuickText *text = qobject_cast<QQuickText *>(child))
+            texts.append(text);
+    }
+    QCOMPARE(texts.count(), 3);
+
+    foreach (QQuickText *text, texts)
+        QTRY_VERIFY(QQuickTextPrivate::get(text)->sharedLayout);
+
+    // Identical texts share a single layout.
+    QQuickTextPrivate *first = QQuickTextPrivate::get(texts.at(0));
+    for (int i = 1; i < texts.count(); ++i) {
+        QCOMPARE(QQuickTextPrivate::get(texts.at(i))->sharedLayout.data(), first->sharedLayout.data());
+        QCOMPARE(texts.at(i)->contentWidth(), texts.at(0)->contentWidth());
+        QCOMPARE(texts.at(i)->lineCount(), 1);
+    }
+
+    // A text already in the cache is laid out without waiting for a worker thread.
+    texts.at(1)->setText(QStringLiteral("Other caption"));
+    QTRY_VERIFY(QQuickTextPrivate::get(texts.at(1))->sharedLayout != first->sharedLayout);
+    texts.at(1)->setText(QStringLiteral("Repeated caption"));
+    QCOMPARE(QQuickTextPrivate::get(texts.at(1))->sharedLayout.data(), first->sharedLayout.data());
+
+    // Changing the width changes the key, so the layout is no longer shared.
+    texts.at(2)->setWidth(150);
+    QTRY_VERIFY(QQuickTextPrivate::get(texts.at(2))->sharedLayout != first->sharedLayout);
+    QCOMPARE(texts.at(2)->contentWidth(), texts.at(0)->contentWidth());
+
+    // Synchronous items lay out an uncached text immediately and share it as well.
+    texts.at(0)->setAsynchronous(false);
+    texts.at(1)->setAsynchronous(false);
+    texts.at(0)->setText(QStringLiteral("Synchronous caption"));
+    QVERIFY(first->sharedLayout);
+    QCOMPARE(texts.at(0)->lineCount(), 1);
+    texts.at(1)->setText(QStringLiteral("Synchronous caption"));
+    QCOMPARE(QQuickTextPrivate::get(texts.at(1))->sharedLayout.data(), first->sharedLayout.data());
+    QCOMPARE(texts.at(1)->contentWidth(), texts.at(0)->contentWidth());
+
+    // Changing the available fonts flushes the cache.
+    QMetaObject::invokeMethod(qApp, "fontDatabaseChanged");
+    texts.at(2)->setAsynchronous(false);
+    texts.at(2)->setWidth(200);
+    texts.at(2)->setText(QStringLiteral("Synchronous caption"));
+    QVERIFY(QQuickTextPrivate::get(texts.at(2))->sharedLayout);
+    QVERIFY(QQuickTextPrivate::get(texts.at(2))->sharedLayout != first->sharedLayout);
+    QCOMPARE(texts.at(2)->contentWidth(), texts.at(0)->contentWidth());
+}
+
+void tst_qquicktext::sharedLayoutImplicitSize()
+{
+    // Without a maximumLineCount wrapped text is laid out by a shared layout, whose implicit
+    // width must still be that of the unwrapped text.
+    QString componentStr = "import QtQuick 2.0\nText { "
+            "property real iWidth: implicitWidth; "
+            "text: \"Lorem ipsum dolor sit amet, consectetur adipiscing elit\"; "
+            "width: 50; "
+            "wrapMode: Text.Wrap }";
+    QQmlComponent textComponent(&engine);
+    textComponent.setData(componentStr.toLatin1(), QUrl::fromLocalFile(""));
+    QScopedPointer<QObject> object(textComponent.create());
+    QQuickText *textObject = qobject_cast<QQuickText *>(object.data());
+    QVERIFY(textObject);
+    QVERIFY(QQuickTextPrivate::get(textObject)->sharedLayout);
+
+    QVERIFY(textObject->lineCount() > 1);
+    QVERIFY(textObject->width() < textObject->implicitWidth());
+    QVERIFY(textObject->height() == textObject->implicitHeight());
+    QCOMPARE(textObject->property("iWidth").toReal(), textObject->implicitWidth());
+
+    const qreal implicitWidth = textObject->implicitWidth();
+    textObject->resetWidth();
+    QCOMPARE(textObject->width(), implicitWidth);
+    QCOMPARE(textObject->lineCount(), 1);
+    QVERIFY(textObject->height() == textObject->implicitHeight());
+}
+
 QTEST_MAIN(tst_qquicktext)
 
 #include "tst_qquicktext.moc"
@@ -0,0 +1,12 @@
+import QtQuick 2.2
+
+Rectangle {
+    width: 200
+    height: 200
+
+    TextEdit {
+        objectName: "edit"
+        width: 200
+        viewport: Qt.rect(0, 0, 200, 100)
+    }
+}
@@ -206,6 +206,8 @@ private slots:
 
     void emptytags_QTBUG_22058();
 
+    void viewport();
+
 private:
     void simulateKeys(QWindow *window, const QList<Key> &keys);
     void simulateKeys(QWindow *window, const QKeySequence &sequence);
@@ -5191,6 +5193,63 @@ void tst_qquicktextedit::emptytags_QTBUG_22058()
     QCOMPARE(input->text(), QString("<b>Bold<>"));
 }
 
+void tst_qquicktextedit::viewport()
+{
+    QQuickView view(testFileUrl("viewport.qml"));
+    view.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&view));
+
+    QQuickTextEdit *edit = view.rootObject()->findChild<QQuickTextEdit *>("edit");
+    QVERIFY(edit);
+    QQuickTextEditPrivate *editPrivate = QQuickTextEditPrivate::get(edit);
+
+    QStringList lines;
+    for (int i = 0; i < 1000; ++i)
+        lines.append(QString::number(i));
+    edit->setText(lines.join(QLatin1Char('\n')));
+    QVERIFY(edit->contentHeight() > 10000);
+
+    // Only the blocks around the viewport have nodes.
+    QTRY_VERIFY(!editPrivate->textNodeMap.isEmpty());
+    QCOMPARE(editPrivate->textNodeMap.first()->startPos(), 0);
+    QVERIFY(editPrivate->textNodeMap.last()->startPos() <= edit->positionAt(0, 200));
+
+    // Moving the viewport within the rendered area keeps the existing nodes.
+    QSignalSpy viewportSpy(edit, SIGNAL(viewportChanged()));
+    QQuickTextEditPrivate::Node *firstNode = editPrivate->textNodeMap.first();
+    edit->setViewport(QRectF(0, 50, 200, 100));
+    QCOMPARE(viewportSpy.count(), 1);
+    QVERIFY(!editPrivate->resetTextNodes);
+    QCOMPARE(editPrivate->textNodeMap.first(), firstNode);
+
+    // Moving it further away builds nodes for the blocks that have come into view.
+    edit->setViewport(QRectF(0, 5000, 200, 100));
+    QTRY_VERIFY(editPrivate->textNodeMap.first()->startPos() >= edit->positionAt(0, 4900 - edit->cursorRectangle().height()));
+    QVERIFY(editPrivate->textNodeMap.last()->startPos() <= edit->positionAt(0, 5200));
+
+    // Edits above the viewport rebuild the nodes at their new positions.
+    edit->insert(0, QStringLiteral("new line\n"));
+    QVERIFY(editPrivate->resetTextNodes);
+    QTRY_VERIFY(!editPrivate->resetTextNodes);
+    QVERIFY(editPrivate->textNodeMap.first()->startPos() >= edit->positionAt(0, 4900 - edit->cursorRectangle().height()));
+
+    // Edits within the rendered area only patch the nodes they touch.
+    const int firstRenderedPos = editPrivate->textNodeMap.first()->startPos();
+    const int nodeCount = editPrivate->textNodeMap.count();
+    edit->insert(edit->positionAt(0, 5050), QStringLiteral("x"));
+    QVERIFY(!editPrivate->resetTextNodes);
+    QTRY_VERIFY(!editPrivate->textNodeMap.last()->dirty());
+    QCOMPARE(editPrivate->textNodeMap.first()->startPos(), firstRenderedPos);
+    QCOMPARE(editPrivate->textNodeMap.count(), nodeCount);
+    QVERIFY(editPrivate->textNodeMap.last()->startPos() <= edit->positionAt(0, 5200));
+
+    // Without a viewport the whole document is rendered again.
+    edit->resetViewport();
+    QCOMPARE(edit->viewport(), QRectF());
+    QTRY_COMPARE(editPrivate->textNodeMap.first()->startPos(), 0);
+    QVERIFY(editPrivate->textNodeMap.last()->startPos() > edit->positionAt(0, 5200));
+}
+
 QTEST_MAIN(tst_qquicktextedit)
 
 #include "tst_qquicktextedit.moc"
@@ -0,0 +1,23 @@
+import QtQuick 2.2
+import QtQml.Models 2.2
+
+DelegateModel {
+    property int changedCount: 0
+    property int removedCount: 0
+    property int insertedCount: 0
+    property int countChangedCount: 0
+
+    coalesceChanges: true
+
+    items.onChanged: {
+        changedCount += 1
+        for (var i = 0; i < removed.length; ++i)
+            removedCount += removed[i].count
+        for (var i = 0; i < inserted.length; ++i)
+            insertedCount += inserted[i].count
+    }
+    items.onCountChanged: countChangedCount += 1
+
+    model: myModel
+    delegate: Item {}
+}
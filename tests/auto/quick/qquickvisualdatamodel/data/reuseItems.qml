@@ -0,0 +1,18 @@
+import QtQuick 2.2
+import QtQml.Models 2.2
+
+DelegateModel {
+    reuseItems: true
+
+    model: myModel
+    delegate: Item {
+        property int modelIndex: index
+        property string modelName: name
+        property int itemsIndex: DelegateModel.itemsIndex
+        property int pooledCount: 0
+        property int reusedCount: 0
+
+        DelegateModel.onPooled: pooledCount += 1
+        DelegateModel.onReused: reusedCount += 1
+    }
+}
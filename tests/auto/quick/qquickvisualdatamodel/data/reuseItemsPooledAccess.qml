@@ -0,0 +1,24 @@
+import QtQuick 2.2
+import QtQml.Models 2.2
+
+DelegateModel {
+    reuseItems: true
+
+    groups: DelegateModelGroup { name: "selected" }
+
+    model: myModel
+    delegate: Item {
+        property int pooledItemsIndex: 0
+        property int pooledSelectedIndex: 0
+        property bool pooledInSelected: true
+
+        DelegateModel.onPooled: {
+            // The item belongs to no group while it waits in the pool.
+            DelegateModel.inSelected = true
+            DelegateModel.groups = [ "items", "selected" ]
+            pooledInSelected = DelegateModel.inSelected
+            pooledItemsIndex = DelegateModel.itemsIndex
+            pooledSelectedIndex = DelegateModel.selectedIndex
+        }
+    }
+}
@@ -0,0 +1,34 @@
+import QtQuick 2.2
+import QtQml.Models 2.2
+
+DelegateModel {
+    id: visualModel
+
+    property QtObject sourceModel: listModel
+    property QtObject fruit: fruitGroup
+
+    filterOnGroup: "fruit"
+
+    model: ListModel {
+        id: listModel
+        ListElement { name: "pear"; type: "fruit" }
+        ListElement { name: "carrot"; type: "vegetable" }
+        ListElement { name: "apple"; type: "fruit" }
+        ListElement { name: "leek"; type: "vegetable" }
+        ListElement { name: "banana"; type: "fruit" }
+    }
+
+    groups: DelegateModelGroup {
+        id: fruitGroup
+        name: "fruit"
+        sortRole: "name"
+        filterRole: "type"
+        filterValue: "fruit"
+    }
+
+    delegate: Item {
+        objectName: "delegate"
+        width: 100
+        height: 20
+    }
+}
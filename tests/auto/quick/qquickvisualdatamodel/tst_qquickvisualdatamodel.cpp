@@ -438,6 +438,10 @@ private slots:
     void asynchronousMove_data();
     void asynchronousCancel();
     void invalidContext();
+    void sortAndFilter();
+    void coalesceChanges();
+    void reuseItems();
+    void reuseItemsPooledAccess();
 
 private:
     template <int N> void groups_verify(
@@ -4243,6 +4247,224 @@ void tst_qquickvisualdatamodel::invalidContext()
     QVERIFY(!item);
 }
 
+static QStringList groupValues(QQmlDelegateModel *model, const QString &role)
+{
+    QStringList values;
+    for (int i = 0; i < model->count(); ++i)
+        values.append(model->stringValue(i, role));
+    return values;
+}
+
+void tst_qquickvisualdatamodel::sortAndFilter()
+{
+    QQmlComponent component(&engine, testFileUrl("sortFilter.qml"));
+    QScopedPointer<QObject> object(component.create());
+    QQmlDelegateModel *visualModel = qobject_cast<QQmlDelegateModel *>(object.data());
+    QVERIFY(visualModel);
+
+    QObject *listModel = visualModel->property("sourceModel").value<QObject *>();
+    QVERIFY(listModel);
+    QQmlDelegateModelGroup *fruit = visualModel->property("fruit").value<QQmlDelegateModelGroup *>();
+    QVERIFY(fruit);
+
+    QCOMPARE(groupValues(visualModel, "name"), QStringList() << "apple" << "banana" << "pear");
+
+    QSignalSpy spy(visualModel, SIGNAL(modelUpdated(QQmlChangeSet,bool)));
+    QQmlChangeSet changeSet;
+
+    // A change that leaves the item in place doesn't move anything.
+    QMetaObject::invokeMethod(listModel, "setProperty",
+            Q_ARG(int, 0), Q_ARG(QString, "name"), Q_ARG(QVariant, QVariant(QStringLiteral("cherry"))));
+    QCOMPARE(groupValues(visualModel, "name"), QStringList() << "apple" << "banana" << "cherry");
+    QCOMPARE(spy.count(), 1);
+    changeSet = spy.last().at(0).value<QQmlChangeSet>();
+    QCOMPARE(changeSet.removes().count(), 0);
+    QCOMPARE(changeSet.inserts().count(), 0);
+    QCOMPARE(changeSet.changes().count(), 1);
+
+    // A change that puts an item out of order moves only that item.
+    QMetaObject::invokeMethod(listModel, "setProperty",
+            Q_ARG(int, 2), Q_ARG(QString, "name"), Q_ARG(QVariant, QVariant(QStringLiteral("date"))));
+    QCOMPARE(groupValues(visualModel, "name"), QStringList() << "banana" << "cherry" << "date");
+    QCOMPARE(spy.count(), 2);
+    changeSet = spy.last().at(0).value<QQmlChangeSet>();
+    QCOMPARE(changeSet.removes().count(), 1);
+    QCOMPARE(changeSet.removes().at(0).index, 0);
+    QCOMPARE(changeSet.removes().at(0).count, 1);
+    QCOMPARE(changeSet.inserts().count(), 1);
+    QCOMPARE(changeSet.inserts().at(0).index, 2);
+    QCOMPARE(changeSet.inserts().at(0).count, 1);
+    QVERIFY(changeSet.inserts().at(0).isMove());
+
+    // Inserted items are filtered and then sorted into place.
+    QQmlExpression expression(qmlContext(visualModel), visualModel,
+            "listModel.append({ name: \"onion\", type: \"vegetable\" });"
+            "listModel.insert(0, { name: \"apricot\", type: \"fruit\" })");
+    expression.evaluate();
+    QVERIFY(!expression.hasError());
+    QCOMPARE(groupValues(visualModel, "name"), QStringList() << "apricot" << "banana" << "cherry" << "date");
+    QCOMPARE(fruit->count(), 4);
+
+    // Changing the filtered role adds the item to the group.
+    QMetaObject::invokeMethod(listModel, "setProperty",
+            Q_ARG(int, 2), Q_ARG(QString, "type"), Q_ARG(QVariant, QVariant(QStringLiteral("fruit"))));
+    QCOMPARE(groupValues(visualModel, "name"), QStringList() << "apricot" << "banana" << "carrot" << "cherry" << "date");
+
+    fruit->setSortOrder(Qt::DescendingOrder);
+    QCOMPARE(groupValues(visualModel, "name"), QStringList() << "date" << "cherry" << "carrot" << "banana" << "apricot");
+
+    fruit->setFilterValue(QRegExp("^veg"));
+    QCOMPARE(groupValues(visualModel, "name"), QStringList() << "onion" << "leek");
+
+    // Without a filter value the group keeps its items.
+    fruit->setFilterValue(QVariant());
+    fruit->setSortRole(QString());
+    fruit->setSortOrder(Qt::AscendingOrder);
+    QCOMPARE(groupValues(visualModel, "name"), QStringList() << "onion" << "leek");
+    fruit->setSortRole("name");
+    QCOMPARE(groupValues(visualModel, "name"), QStringList() << "leek" << "onion");
+}
+
+void tst_qquickvisualdatamodel::coalesceChanges()
+{
+    QQmlEngine engine;
+    QaimModel model;
+    for (int i = 0; i < 5; i++)
+        model.addItem("Original item" + QString::number(i), "");
+    engine.rootContext()->setContextProperty("myModel", &model);
+
+    QQmlComponent component(&engine, testFileUrl("coalesceChanges.qml"));
+    QScopedPointer<QObject> object(component.create());
+    QQmlDelegateModel *visualModel = qobject_cast<QQmlDelegateModel *>(object.data());
+    QVERIFY(visualModel);
+    QTRY_COMPARE(visualModel->property("changedCount").toInt(), 1);
+    QCOMPARE(visualModel->property("insertedCount").toInt(), 5);
+    visualModel->setProperty("insertedCount", 0);
+
+    QSignalSpy spy(visualModel, SIGNAL(modelUpdated(QQmlChangeSet,bool)));
+
+    // Views are updated immediately.
+    for (int i = 0; i < 10; ++i)
+        model.insertItem(i, "New item" + QString::number(i), "");
+    model.removeItems(12, 2);
+    QCOMPARE(spy.count(), 11);
+    QCOMPARE(visualModel->count(), 13);
+
+    // Notifications to QML are merged until control returns to the event loop.
+    QCOMPARE(visualModel->property("changedCount").toInt(), 1);
+    QTRY_COMPARE(visualModel->property("changedCount").toInt(), 2);
+    QCOMPARE(visualModel->property("insertedCount").toInt(), 10);
+    QCOMPARE(visualModel->property("removedCount").toInt(), 2);
+    QCOMPARE(visualModel->property("countChangedCount").toInt(), 2);
+
+    // Disabling coalescing delivers pending notifications and returns to immediate delivery.
+    model.removeItem(0);
+    QCOMPARE(visualModel->property("changedCount").toInt(), 2);
+    visualModel->setCoalesceChanges(false);
+    QCOMPARE(visualModel->property("changedCount").toInt(), 3);
+    QCOMPARE(visualModel->property("removedCount").toInt(), 3);
+
+    // The flush that was scheduled while coalescing is dropped.
+    QCoreApplication::processEvents();
+    QCOMPARE(visualModel->property("changedCount").toInt(), 3);
+
+    // Turning coalescing on again schedules a new flush.
+    visualModel->setCoalesceChanges(true);
+    model.removeItem(0);
+    QCOMPARE(visualModel->property("changedCount").toInt(), 3);
+    QTRY_COMPARE(visualModel->property("changedCount").toInt(), 4);
+    QCOMPARE(visualModel->property("removedCount").toInt(), 4);
+    visualModel->setCoalesceChanges(false);
+
+    model.removeItem(0);
+    QCOMPARE(visualModel->property("changedCount").toInt(), 5);
+    QCOMPARE(visualModel->property("removedCount").toInt(), 5);
+}
+
+void tst_qquickvisualdatamodel::reuseItems()
+{
+    QQmlEngine engine;
+    QaimModel model;
+    for (int i = 0; i < 5; i++)
+        model.addItem("Original item" + QString::number(i), "");
+    engine.rootContext()->setContextProperty("myModel", &model);
+
+    QQmlComponent component(&engine, testFileUrl("reuseItems.qml"));
+    QScopedPointer<QObject> object(component.create());
+    QQmlDelegateModel *visualModel = qobject_cast<QQmlDelegateModel *>(object.data());
+    QVERIFY(visualModel);
+    QVERIFY(visualModel->reuseItems());
+
+    QObject *item = visualModel->object(0);
+    QVERIFY(item);
+    QCOMPARE(item->property("modelName").toString(), QString("Original item0"));
+    QCOMPARE(visualModel->release(item), QQmlInstanceModel::ReleaseFlags(QQmlInstanceModel::Pooled));
+    QCOMPARE(item->property("pooledCount").toInt(), 1);
+    QCOMPARE(item->property("reusedCount").toInt(), 0);
+
+    // The next request is served from the pool and rebound to the new index.
+    QCOMPARE(visualModel->object(3), item);
+    QCOMPARE(item->property("reusedCount").toInt(), 1);
+    QCOMPARE(item->property("modelIndex").toInt(), 3);
+    QCOMPARE(item->property("itemsIndex").toInt(), 3);
+    QCOMPARE(item->property("modelName").toString(), QString("Original item3"));
+
+    // A reused item receives changes to its new model item.
+    model.modifyItem(3, "Changed item3", "");
+    QCOMPARE(item->property("modelName").toString(), QString("Changed item3"));
+    model.modifyItem(0, "Changed item0", "");
+    QCOMPARE(item->property("modelName").toString(), QString("Changed item3"));
+
+    // Items that are still referenced are created as normal.
+    QObject *other = visualModel->object(1);
+    QVERIFY(other);
+    QVERIFY(other != item);
+    QCOMPARE(other->property("reusedCount").toInt(), 0);
+
+    // Disabling reuse destroys the pooled items.
+    QCOMPARE(visualModel->release(item), QQmlInstanceModel::ReleaseFlags(QQmlInstanceModel::Pooled));
+    QPointer<QObject> guard(item);
+    visualModel->setReuseItems(false);
+    QCoreApplication::sendPostedEvents(0, QEvent::DeferredDelete);
+    QVERIFY(guard.isNull());
+
+    QCOMPARE(visualModel->release(other), QQmlInstanceModel::ReleaseFlags(QQmlInstanceModel::Destroyed));
+    guard = other;
+    QCoreApplication::sendPostedEvents(0, QEvent::DeferredDelete);
+    QVERIFY(guard.isNull());
+}
+
+void tst_qquickvisualdatamodel::reuseItemsPooledAccess()
+{
+    QQmlEngine engine;
+    QaimModel model;
+    for (int i = 0; i < 5; i++)
+        model.addItem("Original item" + QString::number(i), "");
+    engine.rootContext()->setContextProperty("myModel", &model);
+
+    QQmlComponent component(&engine, testFileUrl("reuseItemsPooledAccess.qml"));
+    QScopedPointer<QObject> object(component.create());
+    QQmlDelegateModel *visualModel = qobject_cast<QQmlDelegateModel *>(object.data());
+    QVERIFY(visualModel);
+
+    QObject *item = visualModel->object(2);
+    QVERIFY(item);
+    QCOMPARE(visualModel->indexOf(item, 0), 2);
+
+    // Group membership can't be changed, and there are no indexes, while pooled.
+    QCOMPARE(visualModel->release(item), QQmlInstanceModel::ReleaseFlags(QQmlInstanceModel::Pooled));
+    QCOMPARE(item->property("pooledInSelected").toBool(), false);
+    QCOMPARE(item->property("pooledItemsIndex").toInt(), -1);
+    QCOMPARE(item->property("pooledSelectedIndex").toInt(), -1);
+    QCOMPARE(visualModel->indexOf(item, 0), -1);
+    QCOMPARE(evaluate<int>(visualModel, "selected.count"), 0);
+
+    QCOMPARE(visualModel->object(4), item);
+    QCOMPARE(visualModel->indexOf(item, 0), 4);
+    QCOMPARE(evaluate<bool>(item, "DelegateModel.inSelected"), false);
+    QCOMPARE(evaluate<int>(item, "DelegateModel.itemsIndex"), 4);
+}
+
 QTEST_MAIN(tst_qquickvisualdatamodel)
 
 #include "tst_qquickvisualdatamodel.moc"
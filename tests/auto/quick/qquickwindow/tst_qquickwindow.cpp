@@ -301,6 +301,7 @@ private slots:
     void constantUpdatesOnWindow_data();
     void constantUpdatesOnWindow();
     void mouseFiltering();
+    void hitTestIndex();
     void headless();
     void noUpdateWhenNothingChanges();
 
@@ -960,6 +961,59 @@ void tst_qquickwindow::mouseFiltering()
     QTest::mouseRelease(window, Qt::LeftButton, 0, pos);
 }
 
+void tst_qquickwindow::hitTestIndex()
+{
+    TestTouchItem::clearMousePressCounter();
+
+    QQuickWindow *window = new QQuickWindow;
+    QScopedPointer<QQuickWindow> cleanup(window);
+    QQuickWindowPrivate *windowPrivate = QQuickWindowPrivate::get(window);
+    windowPrivate->setHitTestIndexEnabled(true);
+    window->resize(250, 250);
+    window->setPosition(100, 100);
+    window->show();
+    QVERIFY(QTest::qWaitForWindowExposed(window));
+
+    // the target lies outside its unclipped parent, which accepts no input itself
+    QQuickItem *container = new QQuickItem(window->contentItem());
+    container->setSize(QSizeF(50, 50));
+
+    TestTouchItem *target = new TestTouchItem(container);
+    target->setPosition(QPointF(100, 100));
+    target->setSize(QSizeF(50, 50));
+
+    QTest::mouseClick(window, Qt::LeftButton, 0, QPoint(125, 125));
+    QTRY_COMPARE(target->mousePressId, 1);
+    QVERIFY(windowPrivate->hitTestIndex.contains(container));
+
+    // moving the target invalidates the bounds of its ancestors
+    target->setPosition(QPointF(150, 0));
+    QVERIFY(!windowPrivate->hitTestIndex.contains(container));
+    QTest::mouseClick(window, Qt::LeftButton, 0, QPoint(125, 125));
+    QCOMPARE(target->mousePressId, 1);
+    QTest::mouseClick(window, Qt::LeftButton, 0, QPoint(175, 25));
+    QTRY_COMPARE(target->mousePressId, 2);
+
+    // items becoming visible are indexed again
+    TestTouchItem *hidden = new TestTouchItem(container);
+    hidden->setVisible(false);
+    hidden->setPosition(QPointF(0, 150));
+    hidden->setSize(QSizeF(50, 50));
+    QTest::mouseClick(window, Qt::LeftButton, 0, QPoint(25, 175));
+    QCOMPARE(hidden->mousePressId, 0);
+    hidden->setVisible(true);
+    QTest::mouseClick(window, Qt::LeftButton, 0, QPoint(25, 175));
+    QTRY_COMPARE(hidden->mousePressId, 3);
+
+    // clipping excludes targets outside the clipped item
+    container->setClip(true);
+    QTest::mouseClick(window, Qt::LeftButton, 0, QPoint(175, 25));
+    QCOMPARE(target->mousePressId, 2);
+
+    windowPrivate->setHitTestIndexEnabled(false);
+    QVERIFY(windowPrivate->hitTestIndex.isEmpty());
+}
+
 void tst_qquickwindow::qmlCreation()
 {
     QQmlEngine engine;
@@ -0,0 +1,11 @@
+import QtQuick 2.0
+import QtQuick.XmlListModel 2.0
+
+XmlListModel {
+    query: "//item[@kind='a']"
+    XmlRole { name: "title"; query: "title/string()" }
+    XmlRole { name: "size"; query: "size/number()" }
+    XmlRole { name: "id"; query: "@id/string()" }
+    XmlRole { name: "href"; query: "link[@rel='enclosure']/@href/string()" }
+    XmlRole { name: "tag"; query: "tags/tag[2]/string()" }
+}
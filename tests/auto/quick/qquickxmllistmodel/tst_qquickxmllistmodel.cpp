@@ -104,6 +104,7 @@ private slots:
     void threading_data();
     void propertyChanges();
     void selectAncestor();
+    void streaming();
 
     void roleCrash();
 
@@ -979,6 +980,64 @@ void tst_qquickxmllistmodel::selectAncestor()
     QCOMPARE(model->data(index, Qt::UserRole+1).toString(), QLatin1String("cats"));
 }
 
+void tst_qquickxmllistmodel::streaming()
+{
+    QQmlComponent component(&engine, testFileUrl("streaming.qml"));
+    QAbstractItemModel *model = qobject_cast<QAbstractItemModel *>(component.create());
+    QVERIFY(model != 0);
+
+    const int itemCount = 20000;
+    QString xml = QLatin1String("<feed><group>");
+    for (int i = 0; i < itemCount; ++i) {
+        if (i % 100 == 0)
+            xml += QLatin1String("</group><group>");
+        xml += QString::fromLatin1("<item kind=\"%1\" id=\"%2\">"
+                                   "<title>Item <![CDATA[<%2>]]></title>"
+                                   "<size> %2.5 </size>"
+                                   "<link rel=\"alternate\" href=\"alt%2\"/>"
+                                   "<link rel=\"enclosure\" href=\"enc%2\"/>"
+                                   "<tags><tag>first</tag><tag>second%2</tag></tags>"
+                                   "</item>").arg(i % 2 ? QLatin1String("b") : QLatin1String("a")).arg(i);
+    }
+    xml += QLatin1String("</group></feed>");
+
+    QSignalSpy countSpy(model, SIGNAL(countChanged()));
+    model->setProperty("xml", xml);
+    QTRY_COMPARE(qvariant_cast<QQuickXmlListModel::Status>(model->property("status")),
+                 QQuickXmlListModel::Ready);
+    QCOMPARE(model->rowCount(), itemCount / 2);
+    QVERIFY(countSpy.count() >= 1);
+
+    QHash<int, QByteArray> roleNames = model->roleNames();
+    for (int row = 0; row < model->rowCount(); row += 997) {
+        const int i = row * 2;
+        QModelIndex index = model->index(row, 0);
+        QCOMPARE(model->data(index, roleNames.key("title")).toString(), QString("Item <%1>").arg(i));
+        QCOMPARE(model->data(index, roleNames.key("size")).toDouble(), i + 0.5);
+        QCOMPARE(model->data(index, roleNames.key("id")).toString(), QString::number(i));
+        QCOMPARE(model->data(index, roleNames.key("href")).toString(), QString("enc%1").arg(i));
+        QCOMPARE(model->data(index, roleNames.key("tag")).toString(), QString("second%1").arg(i));
+    }
+
+    // a default element namespace is resolved by the streaming query as well
+    model->setProperty("namespaceDeclarations", "declare default element namespace 'http://www.qt-project.org/feed';");
+    model->setProperty("xml", "<feed xmlns=\"http://www.qt-project.org/feed\"><item kind=\"a\"><title>One</title></item>"
+                              "<item kind=\"a\"><title>Two</title></item><item kind=\"b\"/></feed>");
+    QTRY_COMPARE(model->rowCount(), 2);
+    QCOMPARE(model->data(model->index(1, 0), roleNames.key("title")).toString(), QLatin1String("Two"));
+    QCOMPARE(model->data(model->index(1, 0), roleNames.key("size")).toString(), QString());
+
+    // a malformed document keeps the rows read so far but reports an error
+    model->setProperty("xml", "<feed xmlns=\"http://www.qt-project.org/feed\"><item kind=\"a\"><title>One</title></item>"
+                              "<item kind=\"a\"><title>Two</title></feed>");
+    QTRY_COMPARE(qvariant_cast<QQuickXmlListModel::Status>(model->property("status")),
+                 QQuickXmlListModel::Error);
+    QCOMPARE(model->rowCount(), 1);
+    QVERIFY(!errorString(model).isEmpty());
+
+    delete model;
+}
+
 void tst_qquickxmllistmodel::roleCrash()
 {
     // don't crash